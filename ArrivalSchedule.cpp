@@ -0,0 +1,106 @@
+/**
+ * @file ArrivalSchedule.cpp
+ * @brief Implementation file for the ArrivalSchedule class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ArrivalSchedule.h"
+#include <stdexcept>
+
+/**
+ * @brief Create the schedule for one thread
+ * @param kind Arrival process
+ * @param workload Request mix; for CYCLES also the arrival rate per cycle
+ * @param requestsPerSecond Total rate over all threads (ignored for CYCLES)
+ * @param cycleMicroseconds Wall time per simulator cycle (CYCLES only)
+ * @param seed Seed shared by all threads
+ * @param thread This thread's index
+ * @param threads Number of threads
+ * @throws std::invalid_argument if the rate is not positive
+ */
+ArrivalSchedule::ArrivalSchedule(ArrivalProcess kind, const WorkloadParams& workload, double requestsPerSecond,
+                                 double cycleMicroseconds, unsigned int seed, int thread, int threads)
+    : process(kind), shard(thread), shards(threads > 0 ? threads : 1), interval(0.0),
+      cycleSeconds(cycleMicroseconds / 1e6),
+      // CYCLES threads share one stream; the others draw independent contents
+      generator(workload, kind == ArrivalProcess::CYCLES ? seed : seed + 7919U * static_cast<unsigned int>(thread)),
+      engine(seed + 104729ULL * static_cast<unsigned long long>(thread)), nextTime(0.0), cycle(-1),
+      remainingInCycle(0), sequence(0) {
+    double rate = meanRate(workload, kind, requestsPerSecond, cycleMicroseconds);
+    if (!(rate > 0)) {
+        throw std::invalid_argument("arrival rate must be positive");
+    }
+    interval = shards / rate;
+    if (process == ArrivalProcess::CONSTANT) {
+        // Interleave the threads' evenly spaced requests
+        nextTime = interval * shard / shards;
+    } else if (process == ArrivalProcess::POISSON) {
+        nextTime = std::exponential_distribution<double>(1.0 / interval)(engine);
+    }
+}
+
+/**
+ * @brief Get the next request of this thread
+ * @param request Set to the request
+ * @return Intended send time in seconds after the start
+ */
+double ArrivalSchedule::next(Request& request) {
+    if (process != ArrivalProcess::CYCLES) {
+        double time = nextTime;
+        request = generator.generateRequest();
+        nextTime += process == ArrivalProcess::CONSTANT
+                        ? interval
+                        : std::exponential_distribution<double>(1.0 / interval)(engine);
+        return time;
+    }
+    while (true) {
+        while (remainingInCycle == 0) {
+            ++cycle;
+            remainingInCycle = generator.drawArrivals();
+        }
+        --remainingInCycle;
+        // Every thread draws every request so all see the simulator's stream
+        Request drawn = generator.generateRequest();
+        if (sequence++ % shards == shard) {
+            request = std::move(drawn);
+            return cycle * cycleSeconds;
+        }
+    }
+}
+
+/**
+ * @brief Get the total rate over all threads
+ * @param workload Workload parameters
+ * @param kind Arrival process
+ * @param requestsPerSecond Configured rate (POISSON and CONSTANT)
+ * @param cycleMicroseconds Wall time per simulator cycle (CYCLES)
+ * @return Mean requests per second
+ */
+double ArrivalSchedule::meanRate(const WorkloadParams& workload, ArrivalProcess kind, double requestsPerSecond,
+                                 double cycleMicroseconds) {
+    if (kind == ArrivalProcess::CYCLES) {
+        return cycleMicroseconds > 0 ? workload.arrivalRate / (cycleMicroseconds / 1e6) : 0.0;
+    }
+    return requestsPerSecond;
+}
+
+/**
+ * @brief Parse an arrival process name
+ * @param name "poisson", "constant" or "cycles"
+ * @return Arrival process
+ * @throws std::invalid_argument if the name is unknown
+ */
+ArrivalProcess ArrivalSchedule::parseProcess(const std::string& name) {
+    if (name == "poisson") {
+        return ArrivalProcess::POISSON;
+    }
+    if (name == "constant") {
+        return ArrivalProcess::CONSTANT;
+    }
+    if (name == "cycles") {
+        return ArrivalProcess::CYCLES;
+    }
+    throw std::invalid_argument("unknown arrival process: " + name + " (expected poisson, constant or cycles)");
+}
@@ -0,0 +1,98 @@
+/**
+ * @file ArrivalSchedule.h
+ * @brief Header file for the ArrivalSchedule class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef ARRIVALSCHEDULE_H
+#define ARRIVALSCHEDULE_H
+
+#include "Request.h"
+#include "WorkloadGenerator.h"
+#include <random>
+#include <string>
+
+/**
+ * @enum ArrivalProcess
+ * @brief How request send times are spaced
+ */
+enum class ArrivalProcess {
+    POISSON,   ///< Exponential gaps at a mean rate
+    CONSTANT,  ///< Evenly spaced at a fixed rate
+    CYCLES     ///< The simulator's per-cycle arrivals, with cycles mapped to wall time
+};
+
+/**
+ * @class ArrivalSchedule
+ * @brief Open-loop timeline of requests for one load generator thread
+ *
+ * Yields requests with the time each is meant to be sent, fixed in
+ * advance and independent of how fast responses come back. Request
+ * contents (type mix and client addresses) come from a WorkloadGenerator.
+ *
+ * The CYCLES process replays the simulator's own arrival stream: each
+ * thread runs the same seeded generator, calls drawArrivals() once per
+ * cycle exactly as Simulation does, and keeps every shards-th request.
+ * Together the threads send the stream a simulation with the same
+ * workload and seed would admit, with cycle c sent at c * cycle length.
+ * POISSON and CONSTANT split the requested rate evenly between threads.
+ */
+class ArrivalSchedule {
+private:
+    ArrivalProcess process;       ///< Spacing of send times
+    int shard;                    ///< This thread's index
+    int shards;                   ///< Number of threads sharing the stream
+    double interval;              ///< Mean seconds between this thread's requests
+    double cycleSeconds;          ///< Wall time per simulator cycle
+    WorkloadGenerator generator;  ///< Request contents and, for CYCLES, arrivals
+    std::mt19937_64 engine;       ///< Poisson gaps
+    double nextTime;              ///< Send time of the next POISSON or CONSTANT request
+    long long cycle;              ///< Current simulator cycle
+    int remainingInCycle;         ///< Arrivals of the current cycle not yet drawn
+    long long sequence;           ///< Requests drawn from the shared stream
+
+public:
+    /**
+     * @brief Create the schedule for one thread
+     * @param kind Arrival process
+     * @param workload Request mix; for CYCLES also the arrival rate per cycle
+     * @param requestsPerSecond Total rate over all threads (ignored for CYCLES)
+     * @param cycleMicroseconds Wall time per simulator cycle (CYCLES only)
+     * @param seed Seed shared by all threads
+     * @param thread This thread's index
+     * @param threads Number of threads
+     * @throws std::invalid_argument if the rate is not positive
+     */
+    ArrivalSchedule(ArrivalProcess kind, const WorkloadParams& workload, double requestsPerSecond,
+                    double cycleMicroseconds, unsigned int seed, int thread, int threads);
+
+    /**
+     * @brief Get the next request of this thread
+     * @param request Set to the request
+     * @return Intended send time in seconds after the start
+     */
+    double next(Request& request);
+
+    /**
+     * @brief Get the total rate over all threads
+     * @param workload Workload parameters
+     * @param kind Arrival process
+     * @param requestsPerSecond Configured rate (POISSON and CONSTANT)
+     * @param cycleMicroseconds Wall time per simulator cycle (CYCLES)
+     * @return Mean requests per second
+     */
+    static double meanRate(const WorkloadParams& workload, ArrivalProcess kind, double requestsPerSecond,
+                           double cycleMicroseconds);
+
+    /**
+     * @brief Parse an arrival process name
+     * @param name "poisson", "constant" or "cycles"
+     * @return Arrival process
+     * @throws std::invalid_argument if the name is unknown
+     */
+    static ArrivalProcess parseProcess(const std::string& name);
+};
+
+#endif // ARRIVALSCHEDULE_H
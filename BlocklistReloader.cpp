@@ -0,0 +1,152 @@
+/**
+ * @file BlocklistReloader.cpp
+ * @brief Implementation file for the BlocklistReloader class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "BlocklistReloader.h"
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <sys/stat.h>
+
+/**
+ * @brief Load the file and start watching it
+ * @param target Store receiving snapshots
+ * @param filePath Blocklist file
+ * @param pollInterval Delay between change checks in milliseconds
+ */
+BlocklistReloader::BlocklistReloader(BlocklistStore& target, const std::string& filePath, int pollInterval)
+    : store(target), path(filePath), pollMilliseconds(pollInterval > 0 ? pollInterval : 1), stopping(false) {
+    reloadNow();
+    watcher = std::thread(&BlocklistReloader::watchLoop, this);
+}
+
+/**
+ * @brief Stop watching
+ */
+BlocklistReloader::~BlocklistReloader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    watcher.join();
+}
+
+/**
+ * @brief Describe the file's identity and version
+ * @return Signature, empty if the file cannot be examined
+ */
+std::string BlocklistReloader::fileSignature() const {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return std::string();
+    }
+    // The inode changes when a new file is renamed over the old one
+    return std::to_string(info.st_ino) + ":" + std::to_string(info.st_size) + ":" +
+           std::to_string(info.st_mtim.tv_sec) + "." + std::to_string(info.st_mtim.tv_nsec);
+}
+
+/**
+ * @brief Poll the file until stopped
+ */
+void BlocklistReloader::watchLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, std::chrono::milliseconds(pollMilliseconds), [this] { return stopping; })) {
+        std::string signature = fileSignature();
+        if (signature.empty() || signature == lastSignature) {
+            continue;
+        }
+        lock.unlock();
+        reloadNow();
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Read a blocklist file
+ * @param filePath File to read
+ * @param error Set to the reason on failure
+ * @return New blocklist, or null if the file cannot be read or has an invalid address
+ */
+std::unique_ptr<IPBlocklist> BlocklistReloader::loadFile(const std::string& filePath, std::string& error) {
+    std::ifstream file(filePath);
+    if (!file) {
+        error = "cannot open " + filePath;
+        return nullptr;
+    }
+
+    // Collect first so the filter is sized once instead of grown
+    std::vector<IPAddress> addresses;
+    std::string line;
+    long long lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            continue;
+        }
+        size_t last = line.find_last_not_of(" \t\r");
+        IPAddress address;
+        if (!IPAddress::parse(line.data() + first, last - first + 1, address)) {
+            // A typo must not silently unblock the rest of the list
+            error = filePath + ":" + std::to_string(lineNumber) + ": invalid address";
+            return nullptr;
+        }
+        addresses.push_back(address);
+    }
+    if (file.bad()) {
+        error = "read error in " + filePath;
+        return nullptr;
+    }
+
+    std::unique_ptr<IPBlocklist> blocklist(new IPBlocklist(addresses.size()));
+    for (const auto& ip : addresses) {
+        blocklist->add(ip);
+    }
+    return blocklist;
+}
+
+/**
+ * @brief Read the file and publish it whether or not it changed
+ * @return True if a snapshot was published
+ */
+bool BlocklistReloader::reloadNow() {
+    std::lock_guard<std::mutex> reloadLock(reloadMutex);
+    auto start = std::chrono::steady_clock::now();
+    // Taken before reading, so a write during the read triggers another reload
+    std::string signature = fileSignature();
+    std::string error;
+    std::unique_ptr<IPBlocklist> blocklist = loadFile(path, error);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    lastSignature = signature;
+    if (!blocklist) {
+        // Keep serving the previous snapshot
+        stats.failures++;
+        stats.lastError = error;
+        return false;
+    }
+    stats.reloads++;
+    stats.entries = blocklist->size();
+    stats.lastLoadSeconds = seconds;
+    store.publish(std::move(blocklist));
+    return true;
+}
+
+/**
+ * @brief Get the reload counters
+ * @return Copy of the counters
+ */
+BlocklistReloadStats BlocklistReloader::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
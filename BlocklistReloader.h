@@ -0,0 +1,107 @@
+/**
+ * @file BlocklistReloader.h
+ * @brief Header file for the BlocklistReloader class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef BLOCKLISTRELOADER_H
+#define BLOCKLISTRELOADER_H
+
+#include "BlocklistStore.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @struct BlocklistReloadStats
+ * @brief Outcome of the reloads made so far
+ */
+struct BlocklistReloadStats {
+    long long reloads = 0;        ///< Snapshots published from the file
+    long long failures = 0;       ///< Reloads abandoned because the file was unreadable or invalid
+    size_t entries = 0;           ///< Addresses in the last published snapshot
+    double lastLoadSeconds = 0.0; ///< Time to read and build the last snapshot
+    std::string lastError;        ///< Reason for the last failure
+};
+
+/**
+ * @class BlocklistReloader
+ * @brief Watches a blocklist file and publishes it to a BlocklistStore
+ *
+ * A background thread polls the file's inode, size and modification time
+ * and, when they change, builds a new IPBlocklist from it and publishes
+ * it. Building happens entirely on this thread; admission only sees the
+ * pointer swap. The file holds one IPv4 or IPv6 address per line; blank
+ * lines and text after '#' are ignored, and a file with an invalid
+ * address is rejected as a whole, keeping the previous snapshot. Replace
+ * it by renaming a complete file over it so a half-written list is never
+ * loaded.
+ */
+class BlocklistReloader {
+private:
+    BlocklistStore& store;             ///< Store receiving snapshots
+    std::string path;                  ///< Watched file
+    int pollMilliseconds;              ///< Delay between change checks
+    std::string lastSignature;         ///< Inode, size and mtime of the last load
+    mutable std::mutex mutex;          ///< Guards stats, lastSignature and stopping
+    std::mutex reloadMutex;            ///< Serializes reloads
+    std::condition_variable wake;      ///< Signalled to stop the watcher
+    bool stopping;                     ///< Set by the destructor
+    BlocklistReloadStats stats;        ///< Reload counters
+    std::thread watcher;               ///< Polling thread
+
+    /**
+     * @brief Poll the file until stopped
+     */
+    void watchLoop();
+
+    /**
+     * @brief Describe the file's identity and version
+     * @return Signature, empty if the file cannot be examined
+     */
+    std::string fileSignature() const;
+
+public:
+    /**
+     * @brief Load the file and start watching it
+     * @param target Store receiving snapshots
+     * @param filePath Blocklist file
+     * @param pollInterval Delay between change checks in milliseconds
+     */
+    BlocklistReloader(BlocklistStore& target, const std::string& filePath, int pollInterval = 500);
+
+    /**
+     * @brief Stop watching
+     */
+    ~BlocklistReloader();
+
+    BlocklistReloader(const BlocklistReloader&) = delete;
+    BlocklistReloader& operator=(const BlocklistReloader&) = delete;
+
+    /**
+     * @brief Read the file and publish it whether or not it changed
+     * @return True if a snapshot was published
+     */
+    bool reloadNow();
+
+    /**
+     * @brief Get the reload counters
+     * @return Copy of the counters
+     */
+    BlocklistReloadStats getStats() const;
+
+    /**
+     * @brief Read a blocklist file
+     * @param filePath File to read
+     * @param error Set to the reason on failure
+     * @return New blocklist, or null if the file cannot be read or has an invalid address
+     */
+    static std::unique_ptr<IPBlocklist> loadFile(const std::string& filePath, std::string& error);
+};
+
+#endif // BLOCKLISTRELOADER_H
@@ -0,0 +1,129 @@
+/**
+ * @file BlocklistStore.cpp
+ * @brief Implementation file for the BlocklistStore class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "BlocklistStore.h"
+
+/**
+ * @brief Pin the store's current snapshot
+ * @param store Store to read
+ */
+BlocklistStore::Snapshot::Snapshot(const BlocklistStore& store)
+    : guard(store.reclaimer), blocklist(store.current.load()) {
+}
+
+/**
+ * @brief Create a store holding an empty blocklist
+ */
+BlocklistStore::BlocklistStore() : current(new IPBlocklist()), version(0), entryCount(0) {
+}
+
+/**
+ * @brief Create a store holding a copy of another store's current snapshot
+ * @param other Store to copy
+ */
+BlocklistStore::BlocklistStore(const BlocklistStore& other)
+    : current(new IPBlocklist(*other.acquire())), version(0), entryCount(current.load()->size()) {
+}
+
+/**
+ * @brief Publish a copy of another store's current snapshot
+ * @param other Store to copy
+ * @return Reference to this store
+ */
+BlocklistStore& BlocklistStore::operator=(const BlocklistStore& other) {
+    if (this != &other) {
+        publish(std::unique_ptr<IPBlocklist>(new IPBlocklist(*other.acquire())));
+    }
+    return *this;
+}
+
+/**
+ * @brief Destroy the current snapshot
+ */
+BlocklistStore::~BlocklistStore() {
+    delete current.load();
+}
+
+/**
+ * @brief Pin the current snapshot for several reads
+ * @return Snapshot access
+ */
+BlocklistStore::Snapshot BlocklistStore::acquire() const {
+    return Snapshot(*this);
+}
+
+/**
+ * @brief Swap in a snapshot and retire the old one
+ * @param blocklist New snapshot, owned by the store from now on
+ */
+void BlocklistStore::swapIn(const IPBlocklist* blocklist) {
+    const IPBlocklist* old = current.exchange(blocklist);
+    entryCount.store(blocklist->size(), std::memory_order_relaxed);
+    version.fetch_add(1);
+    reclaimer.retire([old]() { delete old; });
+}
+
+/**
+ * @brief Replace the current snapshot
+ * @param blocklist New snapshot
+ */
+void BlocklistStore::publish(std::unique_ptr<IPBlocklist> blocklist) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    swapIn(blocklist.release());
+}
+
+/**
+ * @brief Block one address by publishing an updated copy
+ * @param ip IP address
+ * @return True if it was not blocked before
+ */
+bool BlocklistStore::block(const IPAddress& ip) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    // Writers hold the lock, so the current snapshot cannot be retired here
+    const IPBlocklist* snapshot = current.load();
+    if (snapshot->contains(ip)) {
+        return false;
+    }
+    std::unique_ptr<IPBlocklist> updated(new IPBlocklist(*snapshot));
+    updated->add(ip);
+    swapIn(updated.release());
+    return true;
+}
+
+/**
+ * @brief Unblock one address by publishing an updated copy
+ * @param ip IP address
+ * @return True if it was blocked
+ */
+bool BlocklistStore::unblock(const IPAddress& ip) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    const IPBlocklist* snapshot = current.load();
+    if (!snapshot->contains(ip)) {
+        return false;
+    }
+    std::unique_ptr<IPBlocklist> updated(new IPBlocklist(*snapshot));
+    updated->remove(ip);
+    swapIn(updated.release());
+    return true;
+}
+
+/**
+ * @brief Get the number of snapshots published
+ * @return Version, 0 for the initial empty snapshot
+ */
+uint64_t BlocklistStore::getVersion() const {
+    return version.load();
+}
+
+/**
+ * @brief Get the number of replaced snapshots not yet destroyed
+ * @return Pending snapshot count
+ */
+size_t BlocklistStore::getPendingSnapshots() const {
+    return reclaimer.getPendingCount();
+}
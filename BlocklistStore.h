@@ -0,0 +1,168 @@
+/**
+ * @file BlocklistStore.h
+ * @brief Header file for the BlocklistStore class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef BLOCKLISTSTORE_H
+#define BLOCKLISTSTORE_H
+
+#include "EpochReclaimer.h"
+#include "IPBlocklist.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * @class BlocklistStore
+ * @brief Immutable IPBlocklist snapshots published by atomic pointer swap
+ *
+ * Admission checks read the current snapshot under an EpochReclaimer guard
+ * and never lock. Changes build a new snapshot off the hot path and
+ * publish it with one pointer exchange; the old snapshot is destroyed once
+ * no reader can still hold it. Single-address changes copy the current
+ * snapshot, so bulk updates should build an IPBlocklist and publish it.
+ *
+ * Pinning costs a few atomic operations per check. contains() skips it
+ * while the list is empty; callers checking many addresses at once should
+ * acquire() one Snapshot for the whole batch.
+ */
+class BlocklistStore {
+public:
+    /**
+     * @class Snapshot
+     * @brief Read access to the snapshot current when it was acquired
+     *
+     * Holds an epoch guard, so keep it short-lived: retired snapshots are
+     * not freed while it exists.
+     */
+    class Snapshot {
+    private:
+        EpochReclaimer::Guard guard;  ///< Keeps the snapshot alive
+        const IPBlocklist* blocklist; ///< Pinned snapshot
+
+    public:
+        /**
+         * @brief Pin the store's current snapshot
+         * @param store Store to read
+         */
+        explicit Snapshot(const BlocklistStore& store);
+
+        /**
+         * @brief Access the pinned snapshot
+         * @return Blocklist
+         */
+        const IPBlocklist& operator*() const { return *blocklist; }
+
+        /**
+         * @brief Access the pinned snapshot's members
+         * @return Blocklist pointer
+         */
+        const IPBlocklist* operator->() const { return blocklist; }
+    };
+
+    /**
+     * @brief Create a store holding an empty blocklist
+     */
+    BlocklistStore();
+
+    /**
+     * @brief Create a store holding a copy of another store's current snapshot
+     * @param other Store to copy
+     */
+    BlocklistStore(const BlocklistStore& other);
+
+    /**
+     * @brief Publish a copy of another store's current snapshot
+     * @param other Store to copy
+     * @return Reference to this store
+     */
+    BlocklistStore& operator=(const BlocklistStore& other);
+
+    /**
+     * @brief Destroy the current snapshot
+     */
+    ~BlocklistStore();
+
+    /**
+     * @brief Check whether an address is blocked in the current snapshot
+     * @param ip IP address
+     * @param stats Optional counters updated with the lookup's outcome
+     * @return True if blocked
+     */
+    bool contains(const IPAddress& ip, BlocklistLookupStats* stats = nullptr) const {
+        // Most stores are empty; skip pinning an epoch for them
+        if (isEmpty()) {
+            return false;
+        }
+        EpochReclaimer::Guard guard(reclaimer);
+        return current.load()->contains(ip, stats);
+    }
+
+    /**
+     * @brief Check whether the current snapshot blocks nothing, without pinning it
+     *
+     * Read relaxed, so a check racing a publish may see the previous
+     * snapshot's answer, as a pinned read racing it could.
+     * @return True if no address is blocked
+     */
+    bool isEmpty() const {
+        return entryCount.load(std::memory_order_relaxed) == 0;
+    }
+
+    /**
+     * @brief Pin the current snapshot for several reads
+     * @return Snapshot access
+     */
+    Snapshot acquire() const;
+
+    /**
+     * @brief Replace the current snapshot
+     * @param blocklist New snapshot
+     */
+    void publish(std::unique_ptr<IPBlocklist> blocklist);
+
+    /**
+     * @brief Block one address by publishing an updated copy
+     * @param ip IP address
+     * @return True if it was not blocked before
+     */
+    bool block(const IPAddress& ip);
+
+    /**
+     * @brief Unblock one address by publishing an updated copy
+     * @param ip IP address
+     * @return True if it was blocked
+     */
+    bool unblock(const IPAddress& ip);
+
+    /**
+     * @brief Get the number of snapshots published
+     * @return Version, 0 for the initial empty snapshot
+     */
+    uint64_t getVersion() const;
+
+    /**
+     * @brief Get the number of replaced snapshots not yet destroyed
+     * @return Pending snapshot count
+     */
+    size_t getPendingSnapshots() const;
+
+private:
+    std::atomic<const IPBlocklist*> current;  ///< Published snapshot
+    mutable EpochReclaimer reclaimer;         ///< Frees replaced snapshots
+    std::mutex writeMutex;                    ///< Serializes copy-and-publish updates
+    std::atomic<uint64_t> version;            ///< Snapshots published
+    std::atomic<size_t> entryCount;           ///< Size of the current snapshot
+
+    /**
+     * @brief Swap in a snapshot and retire the old one
+     * @param blocklist New snapshot, owned by the store from now on
+     */
+    void swapIn(const IPBlocklist* blocklist);
+};
+
+#endif // BLOCKLISTSTORE_H
@@ -0,0 +1,150 @@
+/**
+ * @file BloomFilter.cpp
+ * @brief Implementation file for the BloomFilter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "BloomFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// Odd multipliers deriving the eight in-block bit positions from one hash
+const uint32_t SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                           0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+#if defined(__x86_64__)
+/**
+ * @brief Check whether the CPU supports AVX2
+ * @return True if the vector probe can be used
+ */
+bool detectAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool HAS_AVX2 = detectAvx2();  ///< Selects the probe implementation
+
+/**
+ * @brief Test all eight bits of a block with AVX2
+ * @param words Block words (32-byte aligned)
+ * @param key Lower 32 bits of the key hash
+ * @return True if every bit is set
+ */
+__attribute__((target("avx2"))) bool probeAvx2(const uint32_t* words, uint32_t key) {
+    const __m256i salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALTS));
+    __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)), salts), 27);
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(words));
+    // testc is 1 when every mask bit is also set in the block
+    return _mm256_testc_si256(block, mask) != 0;
+}
+#endif
+
+} // namespace
+
+/**
+ * @brief Size a filter for an expected number of keys
+ * @param expectedKeys Keys the filter should hold
+ * @param bitsPerKey Filter bits per key (16 gives roughly 0.1% false positives)
+ */
+BloomFilter::BloomFilter(size_t expectedKeys, double bitsPerKey) : insertedCount(0) {
+    double bits = std::max(1.0, static_cast<double>(expectedKeys) * bitsPerKey);
+    size_t blockCount = static_cast<size_t>(std::ceil(bits / (8 * sizeof(Block))));
+    blocks.resize(std::max<size_t>(1, blockCount));
+    clear();
+}
+
+/**
+ * @brief Select the block for a hash
+ * @param hash Key hash
+ * @return Block index
+ */
+size_t BloomFilter::blockIndex(uint64_t hash) const {
+    // Multiply-shift maps the upper hash bits onto [0, blocks) without a division
+    return static_cast<size_t>(((hash >> 32) * blocks.size()) >> 32);
+}
+
+/**
+ * @brief Add a key
+ * @param hash Key hash
+ */
+void BloomFilter::insert(uint64_t hash) {
+    Block& block = blocks[blockIndex(hash)];
+    uint32_t key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; ++i) {
+        block.words[i] |= 1U << ((key * SALTS[i]) >> 27);
+    }
+    insertedCount++;
+}
+
+/**
+ * @brief Test a key
+ * @param hash Key hash
+ * @return False if the key was definitely never inserted
+ */
+bool BloomFilter::mayContain(uint64_t hash) const {
+    const Block& block = blocks[blockIndex(hash)];
+    uint32_t key = static_cast<uint32_t>(hash);
+#if defined(__x86_64__)
+    if (HAS_AVX2) {
+        return probeAvx2(block.words, key);
+    }
+#endif
+    for (int i = 0; i < 8; ++i) {
+        if ((block.words[i] & (1U << ((key * SALTS[i]) >> 27))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Remove all keys, keeping the size
+ */
+void BloomFilter::clear() {
+    std::memset(blocks.data(), 0, blocks.size() * sizeof(Block));
+    insertedCount = 0;
+}
+
+/**
+ * @brief Get the number of keys inserted since the last clear
+ * @return Key count
+ */
+size_t BloomFilter::getInsertedCount() const {
+    return insertedCount;
+}
+
+/**
+ * @brief Get the filter size
+ * @return Size in bytes
+ */
+size_t BloomFilter::getSizeBytes() const {
+    return blocks.size() * sizeof(Block);
+}
+
+/**
+ * @brief Compute the false-positive rate of the current bits
+ * 
+ * Exact for uniformly random absent keys: the mean over blocks of the
+ * product of each word's set-bit fraction.
+ * @return Probability that an absent key passes the filter
+ */
+double BloomFilter::getFalsePositiveRate() const {
+    double total = 0.0;
+    for (const auto& block : blocks) {
+        double probability = 1.0;
+        for (uint32_t word : block.words) {
+            probability *= __builtin_popcount(word) / 32.0;
+        }
+        total += probability;
+    }
+    return total / static_cast<double>(blocks.size());
+}
@@ -0,0 +1,95 @@
+/**
+ * @file BloomFilter.h
+ * @brief Header file for the BloomFilter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BloomFilter
+ * @brief Split-block Bloom filter over 64-bit hashes
+ * 
+ * Each key touches a single 32-byte block (half a cache line): the upper
+ * 32 hash bits pick the block, and the lower 32 bits, multiplied by eight
+ * odd salts, set one bit in each of the block's eight 32-bit words. A
+ * probe is therefore one cache miss at most and, with AVX2, a handful of
+ * vector instructions. Bits are never cleared; callers rebuild the filter
+ * to forget keys.
+ */
+class BloomFilter {
+private:
+    /**
+     * @struct Block
+     * @brief Eight 32-bit words probed together
+     */
+    struct alignas(32) Block {
+        uint32_t words[8];  ///< One bit per key in each word
+    };
+
+    std::vector<Block> blocks;  ///< Filter bits
+    size_t insertedCount;       ///< Keys inserted since the last clear
+
+    /**
+     * @brief Select the block for a hash
+     * @param hash Key hash
+     * @return Block index
+     */
+    size_t blockIndex(uint64_t hash) const;
+
+public:
+    /**
+     * @brief Size a filter for an expected number of keys
+     * @param expectedKeys Keys the filter should hold
+     * @param bitsPerKey Filter bits per key (16 gives roughly 0.1% false positives)
+     */
+    explicit BloomFilter(size_t expectedKeys = 0, double bitsPerKey = 16.0);
+
+    /**
+     * @brief Add a key
+     * @param hash Key hash
+     */
+    void insert(uint64_t hash);
+
+    /**
+     * @brief Test a key
+     * @param hash Key hash
+     * @return False if the key was definitely never inserted
+     */
+    bool mayContain(uint64_t hash) const;
+
+    /**
+     * @brief Remove all keys, keeping the size
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of keys inserted since the last clear
+     * @return Key count
+     */
+    size_t getInsertedCount() const;
+
+    /**
+     * @brief Get the filter size
+     * @return Size in bytes
+     */
+    size_t getSizeBytes() const;
+
+    /**
+     * @brief Compute the false-positive rate of the current bits
+     * 
+     * Exact for uniformly random absent keys: the mean over blocks of the
+     * product of each word's set-bit fraction.
+     * @return Probability that an absent key passes the filter
+     */
+    double getFalsePositiveRate() const;
+};
+
+#endif // BLOOMFILTER_H
@@ -0,0 +1,152 @@
+/**
+ * @file BufferPool.cpp
+ * @brief Implementation file for the BufferPool class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "BufferPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+const size_t PAGE_SIZE = 4096;  ///< Slab alignment
+
+} // namespace
+
+/**
+ * @brief Create an empty pool
+ * @param slabSize Bytes per slab, at least one block of the largest class
+ */
+BufferPool::BufferPool(size_t slabSize) : slabBytes(std::max(slabSize, classSize(CLASS_COUNT - 1))) {
+    // Whole pages, so every slab stays page-aligned end to end
+    slabBytes = (slabBytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    for (int i = 0; i < CLASS_COUNT; ++i) {
+        freeLists[i] = nullptr;
+    }
+}
+
+/**
+ * @brief Free every slab
+ */
+BufferPool::~BufferPool() {
+    for (char* slab : slabs) {
+        std::free(slab);
+    }
+    for (BufferBlock* headers : headerArrays) {
+        delete[] headers;
+    }
+}
+
+/**
+ * @brief Carve a new slab into free blocks of a class
+ * @param sizeClass Class index
+ * @throws std::bad_alloc if memory is exhausted
+ */
+void BufferPool::grow(int sizeClass) {
+    size_t blockSize = classSize(sizeClass);
+    size_t count = slabBytes / blockSize;
+    // Reserve first so nothing can throw once the slab is allocated
+    slabs.reserve(slabs.size() + 1);
+    headerArrays.reserve(headerArrays.size() + 1);
+    void* memory = nullptr;
+    if (posix_memalign(&memory, PAGE_SIZE, slabBytes) != 0) {
+        throw std::bad_alloc();
+    }
+    char* slab = static_cast<char*>(memory);
+    BufferBlock* headers = new (std::nothrow) BufferBlock[count];
+    if (headers == nullptr) {
+        std::free(slab);
+        throw std::bad_alloc();
+    }
+    slabs.push_back(slab);
+    headerArrays.push_back(headers);
+    // Link in reverse so blocks are handed out in address order
+    for (size_t i = count; i-- > 0;) {
+        BufferBlock& block = headers[i];
+        block.data = slab + i * blockSize;
+        block.capacity = blockSize;
+        block.sizeClass = sizeClass;
+        block.pool = this;
+        block.nextFree = freeLists[sizeClass];
+        freeLists[sizeClass] = &block;
+    }
+    stats.slabs++;
+    stats.slabBytes += slabBytes;
+}
+
+/**
+ * @brief Take a block back once its last slice is gone
+ * @param block Block
+ */
+void BufferPool::recycle(BufferBlock* block) {
+    stats.blocksInUse--;
+    stats.bytesInUse -= block->capacity;
+    if (block->sizeClass < 0) {
+        std::free(block->data);
+        delete block;
+        return;
+    }
+    block->nextFree = freeLists[block->sizeClass];
+    freeLists[block->sizeClass] = block;
+}
+
+/**
+ * @brief Get a block of at least a given size
+ * @param minimum Bytes needed
+ * @return Slice viewing the whole block
+ * @throws std::bad_alloc if memory is exhausted
+ */
+BufferSlice BufferPool::allocate(size_t minimum) {
+    int sizeClass = 0;
+    while (sizeClass < CLASS_COUNT && classSize(sizeClass) < minimum) {
+        sizeClass++;
+    }
+    BufferBlock* block;
+    if (sizeClass == CLASS_COUNT) {
+        stats.oversize++;
+        char* data = static_cast<char*>(std::malloc(minimum));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        try {
+            block = new BufferBlock();
+        } catch (...) {
+            std::free(data);
+            throw;
+        }
+        block->data = data;
+        block->capacity = minimum;
+        block->sizeClass = -1;
+        block->pool = this;
+    } else {
+        if (freeLists[sizeClass] == nullptr) {
+            grow(sizeClass);
+        }
+        block = freeLists[sizeClass];
+        freeLists[sizeClass] = block->nextFree;
+        block->nextFree = nullptr;
+    }
+    stats.blocksInUse++;
+    stats.bytesInUse += block->capacity;
+    stats.peakBytesInUse = std::max(stats.peakBytesInUse, stats.bytesInUse);
+    return BufferSlice(block, 0, block->capacity);
+}
+
+/**
+ * @brief Get a block holding a copy of some bytes
+ * @param bytes Bytes to copy
+ * @return Slice viewing exactly the copy
+ * @throws std::bad_alloc if memory is exhausted
+ */
+BufferSlice BufferPool::copy(std::string_view bytes) {
+    BufferSlice block = allocate(bytes.size());
+    if (!bytes.empty()) {
+        std::memcpy(block.data(), bytes.data(), bytes.size());
+    }
+    return block.slice(0, bytes.size());
+}
@@ -0,0 +1,301 @@
+/**
+ * @file BufferPool.h
+ * @brief Header file for the BufferPool class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class BufferPool;
+
+/**
+ * @struct BufferBlock
+ * @brief Header of one fixed-size block handed out by a BufferPool
+ */
+struct BufferBlock {
+    char* data = nullptr;          ///< Block storage
+    size_t capacity = 0;           ///< Bytes of storage
+    uint32_t references = 0;       ///< Live BufferSlices on the block
+    int sizeClass = 0;             ///< Size class, -1 for an oversize block
+    BufferPool* pool = nullptr;    ///< Pool the block returns to
+    BufferBlock* nextFree = nullptr; ///< Next block in the free list
+};
+
+/**
+ * @class BufferSlice
+ * @brief Reference-counted view of bytes in a pooled block
+ *
+ * Copying a slice shares the block instead of the bytes, so received data
+ * can be handed from one connection to another without a copy. The block
+ * goes back to its pool when the last slice on it is destroyed. Counts
+ * are not atomic: slices stay on the thread that owns the pool.
+ */
+class BufferSlice {
+private:
+    BufferBlock* block;  ///< Block viewed, nullptr for an empty slice
+    size_t offset;       ///< First byte viewed
+    size_t length;       ///< Bytes viewed
+
+    /**
+     * @brief Drop this slice's reference
+     */
+    void release();
+
+public:
+    /**
+     * @brief Create an empty slice
+     */
+    BufferSlice() : block(nullptr), offset(0), length(0) {}
+
+    /**
+     * @brief Create a slice taking a new reference on a block
+     * @param source Block
+     * @param start First byte viewed
+     * @param size Bytes viewed
+     */
+    BufferSlice(BufferBlock* source, size_t start, size_t size) : block(source), offset(start), length(size) {
+        block->references++;
+    }
+
+    /**
+     * @brief Share another slice's block
+     * @param other Slice
+     */
+    BufferSlice(const BufferSlice& other) : block(other.block), offset(other.offset), length(other.length) {
+        if (block != nullptr) {
+            block->references++;
+        }
+    }
+
+    /**
+     * @brief Take over another slice's reference
+     * @param other Slice, left empty
+     */
+    BufferSlice(BufferSlice&& other) noexcept : block(other.block), offset(other.offset), length(other.length) {
+        other.block = nullptr;
+        other.offset = 0;
+        other.length = 0;
+    }
+
+    /**
+     * @brief Share another slice's block
+     * @param other Slice
+     * @return This slice
+     */
+    BufferSlice& operator=(const BufferSlice& other) {
+        if (other.block != nullptr) {
+            other.block->references++;
+        }
+        release();
+        block = other.block;
+        offset = other.offset;
+        length = other.length;
+        return *this;
+    }
+
+    /**
+     * @brief Take over another slice's reference
+     * @param other Slice, left empty
+     * @return This slice
+     */
+    BufferSlice& operator=(BufferSlice&& other) noexcept {
+        if (this != &other) {
+            release();
+            block = other.block;
+            offset = other.offset;
+            length = other.length;
+            other.block = nullptr;
+            other.offset = 0;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Drop the reference
+     */
+    ~BufferSlice() { release(); }
+
+    /**
+     * @brief Get the first byte viewed
+     * @return Pointer into the block, nullptr for an empty slice
+     */
+    char* data() const { return block != nullptr ? block->data + offset : nullptr; }
+
+    /**
+     * @brief Get the number of bytes viewed
+     * @return Byte count
+     */
+    size_t size() const { return length; }
+
+    /**
+     * @brief Check whether the slice views nothing
+     * @return True if no bytes are viewed
+     */
+    bool empty() const { return length == 0; }
+
+    /**
+     * @brief Get the block's storage from the first byte viewed to its end
+     * @return Writable bytes from data(), 0 for an empty slice
+     */
+    size_t capacity() const { return block != nullptr ? block->capacity - offset : 0; }
+
+    /**
+     * @brief Check whether another slice shares the block
+     *
+     * Bytes of a shared block that any slice may view must not be
+     * overwritten.
+     * @return True if the block has other references
+     */
+    bool isShared() const { return block != nullptr && block->references > 1; }
+
+    /**
+     * @brief Get the bytes viewed
+     * @return View, valid while the slice lives
+     */
+    std::string_view view() const { return std::string_view(data(), length); }
+
+    /**
+     * @brief Create a slice of part of this one sharing its block
+     * @param start First byte, relative to this slice
+     * @param size Bytes to view
+     * @return New slice
+     */
+    BufferSlice slice(size_t start, size_t size) const {
+        return block != nullptr ? BufferSlice(block, offset + start, size) : BufferSlice();
+    }
+
+    /**
+     * @brief Stop viewing leading bytes
+     * @param count Bytes, at most size()
+     */
+    void removePrefix(size_t count) {
+        offset += count;
+        length -= count;
+    }
+
+    /**
+     * @brief Drop the reference and view nothing
+     */
+    void reset() {
+        release();
+        block = nullptr;
+        offset = 0;
+        length = 0;
+    }
+};
+
+/**
+ * @struct BufferPoolStats
+ * @brief Memory held by a BufferPool
+ */
+struct BufferPoolStats {
+    size_t slabs = 0;            ///< Slabs allocated
+    size_t slabBytes = 0;        ///< Bytes of slab storage
+    size_t blocksInUse = 0;      ///< Blocks with live slices, oversize ones included
+    size_t bytesInUse = 0;       ///< Capacity of those blocks
+    size_t peakBytesInUse = 0;   ///< Largest bytesInUse so far
+    long long oversize = 0;      ///< Allocations too large for any size class
+};
+
+/**
+ * @class BufferPool
+ * @brief Per-thread slab allocator of I/O buffers in fixed size classes
+ *
+ * Blocks of 1, 4, 16, 64 and 256 KB are carved from page-aligned slabs,
+ * and freed blocks go on a per-class LIFO free list, so steady-state
+ * proxying allocates nothing and reuses cache-warm blocks. Each slab is
+ * one contiguous array of equal-sized blocks whose addresses never move,
+ * the layout io_uring provided-buffer rings expect. Larger requests get a
+ * dedicated allocation that is freed with its last slice. Slabs are kept
+ * until the pool is destroyed, which must happen after every slice on it
+ * is gone. Not thread-safe: each event-loop thread owns its pool.
+ */
+class BufferPool {
+private:
+    friend class BufferSlice;
+
+    static const int CLASS_COUNT = 5;  ///< Size classes
+
+    size_t slabBytes;                          ///< Bytes per slab
+    BufferBlock* freeLists[CLASS_COUNT];       ///< Free blocks per class
+    std::vector<char*> slabs;                  ///< Slab storage
+    std::vector<BufferBlock*> headerArrays;    ///< Block headers, one array per slab
+    BufferPoolStats stats;                     ///< Memory counters
+
+    /**
+     * @brief Get the block size of a class
+     * @param sizeClass Class index
+     * @return Bytes
+     */
+    static size_t classSize(int sizeClass) { return size_t(1024) << (2 * sizeClass); }
+
+    /**
+     * @brief Carve a new slab into free blocks of a class
+     * @param sizeClass Class index
+     * @throws std::bad_alloc if memory is exhausted
+     */
+    void grow(int sizeClass);
+
+    /**
+     * @brief Take a block back once its last slice is gone
+     * @param block Block
+     */
+    void recycle(BufferBlock* block);
+
+public:
+    /**
+     * @brief Create an empty pool
+     * @param slabSize Bytes per slab, at least one block of the largest class
+     */
+    explicit BufferPool(size_t slabSize = 1 << 20);
+
+    /**
+     * @brief Free every slab
+     */
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Get a block of at least a given size
+     * @param minimum Bytes needed
+     * @return Slice viewing the whole block
+     * @throws std::bad_alloc if memory is exhausted
+     */
+    BufferSlice allocate(size_t minimum);
+
+    /**
+     * @brief Get a block holding a copy of some bytes
+     * @param bytes Bytes to copy
+     * @return Slice viewing exactly the copy
+     * @throws std::bad_alloc if memory is exhausted
+     */
+    BufferSlice copy(std::string_view bytes);
+
+    /**
+     * @brief Get the memory counters
+     * @return Counters
+     */
+    const BufferPoolStats& getStats() const { return stats; }
+};
+
+/**
+ * @brief Drop this slice's reference
+ */
+inline void BufferSlice::release() {
+    if (block != nullptr && --block->references == 0) {
+        block->pool->recycle(block);
+    }
+}
+
+#endif // BUFFERPOOL_H
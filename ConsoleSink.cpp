@@ -0,0 +1,211 @@
+/**
+ * @file ConsoleSink.cpp
+ * @brief Implementation file for the ConsoleSink class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ConsoleSink.h"
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+/**
+ * @brief Start the writer thread
+ * @param level Verbosity
+ * @param fd Descriptor to write to (standard output by default)
+ * @param capacityBytes Buffered bytes beyond which droppable messages are discarded
+ */
+ConsoleSink::ConsoleSink(ConsoleVerbosity level, int fd, size_t capacityBytes)
+    : verbosity(level), outputFd(fd), capacity(capacityBytes), droppedMessages(0), totalDropped(0),
+      writing(false), stopping(false), summaryStartCycle(1), eventsAdmitted(0), eventsRejected(0),
+      eventLinesSuppressed(0), eventTokens(EVENT_LINES_PER_SECOND),
+      lastRefill(std::chrono::steady_clock::now()) {
+    writer = std::thread(&ConsoleSink::writerLoop, this);
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Writes everything still buffered and stops the writer thread
+ */
+ConsoleSink::~ConsoleSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    textReady.notify_one();
+    writer.join();
+}
+
+/**
+ * @brief Writer thread main loop
+ */
+void ConsoleSink::writerLoop() {
+    std::string chunk;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        textReady.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return; // Stopping and nothing left to write
+        }
+        
+        // Take the whole backlog and write it without holding the lock
+        chunk.swap(pending);
+        pending.clear();
+        writing = true;
+        lock.unlock();
+        
+        const char* data = chunk.data();
+        size_t remaining = chunk.size();
+        while (remaining > 0) {
+            ssize_t written = ::write(outputFd, data, remaining);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                break; // Closed terminal or pipe; discard the rest
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        
+        lock.lock();
+        writing = false;
+        if (pending.empty()) {
+            drained.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Parse a verbosity name
+ * @param name "quiet", "normal" or "verbose"
+ * @param level Parsed verbosity (unchanged on failure)
+ * @return True if the name was recognised
+ */
+bool ConsoleSink::parseVerbosity(const std::string& name, ConsoleVerbosity& level) {
+    if (name == "quiet") {
+        level = ConsoleVerbosity::QUIET;
+    } else if (name == "normal") {
+        level = ConsoleVerbosity::NORMAL;
+    } else if (name == "verbose") {
+        level = ConsoleVerbosity::VERBOSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Set the verbosity
+ * @param level New verbosity
+ */
+void ConsoleSink::setVerbosity(ConsoleVerbosity level) {
+    verbosity = level;
+}
+
+/**
+ * @brief Check whether messages of a level are printed
+ * @param level Message level
+ * @return True if shown; callers can skip formatting otherwise
+ */
+bool ConsoleSink::shows(ConsoleVerbosity level) const {
+    return level <= verbosity;
+}
+
+/**
+ * @brief Queue text for the terminal
+ * @param text One or more complete lines
+ * @param level Message level; QUIET messages are never dropped
+ */
+void ConsoleSink::write(const std::string& text, ConsoleVerbosity level) {
+    if (!shows(level)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (level != ConsoleVerbosity::QUIET && pending.size() + text.size() > capacity) {
+            droppedMessages++;
+            totalDropped++;
+            return;
+        }
+        if (droppedMessages > 0) {
+            // First message after a gap says how much the reader missed
+            pending += "  [console: " + std::to_string(droppedMessages) + " messages dropped]\n";
+            droppedMessages = 0;
+        }
+        pending += text;
+    }
+    textReady.notify_one();
+}
+
+/**
+ * @brief Count a new request offered to the load balancer
+ * @param cycle Current cycle
+ * @param clientIP Client address of the request
+ * @param admitted True if the queue accepted it
+ */
+void ConsoleSink::requestOffered(long long cycle, const IPAddress& clientIP, bool admitted) {
+    (admitted ? eventsAdmitted : eventsRejected)++;
+    if (!admitted || !shows(ConsoleVerbosity::VERBOSE)) {
+        return;
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    lastRefill = now;
+    eventTokens = std::min(EVENT_LINES_PER_SECOND, eventTokens + elapsed * EVENT_LINES_PER_SECOND);
+    if (eventTokens < 1.0) {
+        eventLinesSuppressed++;
+        return;
+    }
+    eventTokens -= 1.0;
+    
+    // Formatted only for lines actually shown
+    char address[IPAddress::MAX_TEXT_LENGTH];
+    eventLine.clear();
+    eventLine.append("  [Cycle ").appendInt(cycle).append("] New request added from ")
+        .append(address, clientIP.format(address)).append('\n');
+    write(eventLine.str(), ConsoleVerbosity::VERBOSE);
+}
+
+/**
+ * @brief Print the request summary since the previous call
+ * @param cycle Current cycle
+ */
+void ConsoleSink::summarize(long long cycle) {
+    if (shows(ConsoleVerbosity::NORMAL) && (eventsAdmitted > 0 || eventsRejected > 0)) {
+        eventLine.clear();
+        eventLine.append("  [Cycles ").appendInt(summaryStartCycle).append('-').appendInt(cycle).append("] ")
+            .appendInt(eventsAdmitted).append(" new requests added");
+        if (eventsRejected > 0) {
+            eventLine.append(", ").appendInt(eventsRejected).append(" rejected");
+        }
+        if (eventLinesSuppressed > 0) {
+            eventLine.append(" (").appendInt(eventLinesSuppressed).append(" request lines not shown)");
+        }
+        eventLine.append('\n');
+        write(eventLine.str(), ConsoleVerbosity::NORMAL);
+    }
+    summaryStartCycle = cycle + 1;
+    eventsAdmitted = 0;
+    eventsRejected = 0;
+    eventLinesSuppressed = 0;
+}
+
+/**
+ * @brief Block until all queued text has been written
+ */
+void ConsoleSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+/**
+ * @brief Get the number of messages dropped so far
+ * @return Dropped message count
+ */
+long long ConsoleSink::getDroppedMessages() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalDropped;
+}
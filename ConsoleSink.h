@@ -0,0 +1,151 @@
+/**
+ * @file ConsoleSink.h
+ * @brief Header file for the ConsoleSink class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef CONSOLESINK_H
+#define CONSOLESINK_H
+
+#include "IPAddress.h"
+#include "TextBuffer.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @enum ConsoleVerbosity
+ * @brief How much the interactive simulation prints
+ */
+enum class ConsoleVerbosity {
+    QUIET,    ///< Configuration and final results only
+    NORMAL,   ///< Plus periodic status and request summaries
+    VERBOSE   ///< Plus one line per new request (rate-limited)
+};
+
+/**
+ * @class ConsoleSink
+ * @brief Buffered console output written by a background thread
+ * 
+ * Messages are appended to an in-memory buffer and written to the
+ * terminal by a writer thread, so the simulation never waits on stdout.
+ * If the terminal falls more than the buffer capacity behind, NORMAL and
+ * VERBOSE messages are dropped (and counted) instead of blocking; QUIET
+ * messages, the configuration and results, are always kept.
+ * 
+ * Per-request events are counted and reported as one summary line per
+ * summarize() call. In VERBOSE mode each event also prints its own line,
+ * limited to EVENT_LINES_PER_SECOND; the excess is folded into the
+ * summary.
+ */
+class ConsoleSink {
+private:
+    ConsoleVerbosity verbosity;          ///< Messages above this level are skipped
+    int outputFd;                        ///< Descriptor written to
+    size_t capacity;                     ///< Buffered bytes beyond which messages drop
+    std::string pending;                 ///< Text waiting for the writer thread
+    long long droppedMessages;           ///< Messages dropped since the last notice
+    long long totalDropped;              ///< Messages dropped in total
+    bool writing;                        ///< True while the writer has text in flight
+    bool stopping;                       ///< Set by the destructor
+    std::mutex mutex;                    ///< Guards the state above
+    std::condition_variable textReady;   ///< Signalled when pending gains text
+    std::condition_variable drained;     ///< Signalled when everything is written
+    std::thread writer;                  ///< Writer thread
+
+    // Event coalescing, touched only by the simulation thread
+    long long summaryStartCycle;         ///< First cycle of the current summary
+    long long eventsAdmitted;            ///< Requests admitted since the last summary
+    long long eventsRejected;            ///< Requests rejected since the last summary
+    long long eventLinesSuppressed;      ///< Per-request lines over the rate limit
+    double eventTokens;                  ///< Token bucket for per-request lines
+    std::chrono::steady_clock::time_point lastRefill;  ///< Last token bucket refill
+    TextBuffer eventLine;                ///< Reused formatting buffer
+
+    /**
+     * @brief Writer thread main loop
+     */
+    void writerLoop();
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;  ///< Default buffer limit in bytes
+    static constexpr double EVENT_LINES_PER_SECOND = 200.0;  ///< Per-request line limit
+
+    /**
+     * @brief Start the writer thread
+     * @param level Verbosity
+     * @param fd Descriptor to write to (standard output by default)
+     * @param capacityBytes Buffered bytes beyond which droppable messages are discarded
+     */
+    explicit ConsoleSink(ConsoleVerbosity level = ConsoleVerbosity::NORMAL, int fd = 1,
+                         size_t capacityBytes = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Destructor
+     * 
+     * Writes everything still buffered and stops the writer thread
+     */
+    ~ConsoleSink();
+
+    ConsoleSink(const ConsoleSink&) = delete;
+    ConsoleSink& operator=(const ConsoleSink&) = delete;
+
+    /**
+     * @brief Parse a verbosity name
+     * @param name "quiet", "normal" or "verbose"
+     * @param level Parsed verbosity (unchanged on failure)
+     * @return True if the name was recognised
+     */
+    static bool parseVerbosity(const std::string& name, ConsoleVerbosity& level);
+
+    /**
+     * @brief Set the verbosity
+     * @param level New verbosity
+     */
+    void setVerbosity(ConsoleVerbosity level);
+
+    /**
+     * @brief Check whether messages of a level are printed
+     * @param level Message level
+     * @return True if shown; callers can skip formatting otherwise
+     */
+    bool shows(ConsoleVerbosity level) const;
+
+    /**
+     * @brief Queue text for the terminal
+     * @param text One or more complete lines
+     * @param level Message level; QUIET messages are never dropped
+     */
+    void write(const std::string& text, ConsoleVerbosity level = ConsoleVerbosity::QUIET);
+
+    /**
+     * @brief Count a new request offered to the load balancer
+     * @param cycle Current cycle
+     * @param clientIP Client address of the request
+     * @param admitted True if the queue accepted it
+     */
+    void requestOffered(long long cycle, const IPAddress& clientIP, bool admitted);
+
+    /**
+     * @brief Print the request summary since the previous call
+     * @param cycle Current cycle
+     */
+    void summarize(long long cycle);
+
+    /**
+     * @brief Block until all queued text has been written
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of messages dropped so far
+     * @return Dropped message count
+     */
+    long long getDroppedMessages();
+};
+
+#endif // CONSOLESINK_H
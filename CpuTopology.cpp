@@ -0,0 +1,156 @@
+/**
+ * @file CpuTopology.cpp
+ * @brief Implementation file for the CpuTopology class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "CpuTopology.h"
+#include <algorithm>
+#include <fstream>
+#include <sched.h>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Detect the topology of the running machine
+ */
+CpuTopology::CpuTopology() : nodeCount(1) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                usableCpus.push_back(cpu);
+            }
+        }
+    }
+    if (usableCpus.empty()) {
+        unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int cpu = 0; cpu < count; ++cpu) {
+            usableCpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    cpuNodes.assign(usableCpus.back() + 1, -1);
+    
+    // Node directories are numbered but may have gaps; stop after a run of misses
+    std::vector<bool> nodeUsed;
+    for (int node = 0, misses = 0; misses < 64; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) {
+            misses++;
+            continue;
+        }
+        misses = 0;
+        for (int cpu : parseCpuList(list)) {
+            if (cpu >= 0 && cpu < static_cast<int>(cpuNodes.size())) {
+                cpuNodes[cpu] = node;
+            }
+        }
+    }
+    
+    int maxNode = 0;
+    for (int cpu : usableCpus) {
+        if (cpuNodes[cpu] < 0) {
+            cpuNodes[cpu] = 0;
+        }
+        maxNode = std::max(maxNode, cpuNodes[cpu]);
+    }
+    nodeUsed.assign(maxNode + 1, false);
+    for (int cpu : usableCpus) {
+        nodeUsed[cpuNodes[cpu]] = true;
+    }
+    nodeCount = static_cast<int>(std::count(nodeUsed.begin(), nodeUsed.end(), true));
+}
+
+/**
+ * @brief Get the topology, detecting it on first use
+ * @return Process-wide topology
+ */
+const CpuTopology& CpuTopology::get() {
+    static const CpuTopology topology;
+    return topology;
+}
+
+/**
+ * @brief Parse a kernel CPU list such as "0-3,8,10-11"
+ * @param text CPU list
+ * @return CPU numbers in the order listed
+ */
+std::vector<int> CpuTopology::parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Blank or malformed entry (an empty list is just a newline)
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief Get the number of NUMA nodes with usable CPUs
+ * @return Node count (at least 1)
+ */
+int CpuTopology::getNodeCount() const {
+    return nodeCount;
+}
+
+/**
+ * @brief Get the NUMA node of a CPU
+ * @param cpu CPU number
+ * @return Node number, 0 if unknown
+ */
+int CpuTopology::getNodeOfCpu(int cpu) const {
+    if (cpu < 0 || cpu >= static_cast<int>(cpuNodes.size()) || cpuNodes[cpu] < 0) {
+        return 0;
+    }
+    return cpuNodes[cpu];
+}
+
+/**
+ * @brief Get the NUMA node of the CPU the calling thread is running on
+ * @return Node number, 0 if unknown
+ */
+int CpuTopology::getCurrentNode() const {
+    return getNodeOfCpu(sched_getcpu());
+}
+
+/**
+ * @brief Get usable CPUs in worker placement order
+ * 
+ * Alternates between nodes (first CPU of each node, then the second,
+ * and so on) so that a pool smaller than the machine still spreads
+ * over every node's memory bandwidth.
+ * @return CPU numbers
+ */
+std::vector<int> CpuTopology::getPlacementOrder() const {
+    std::vector<std::vector<int>> byNode;
+    for (int cpu : usableCpus) {
+        int node = getNodeOfCpu(cpu);
+        if (node >= static_cast<int>(byNode.size())) {
+            byNode.resize(node + 1);
+        }
+        byNode[node].push_back(cpu);
+    }
+    
+    std::vector<int> order;
+    for (size_t round = 0; order.size() < usableCpus.size(); ++round) {
+        for (const auto& cpus : byNode) {
+            if (round < cpus.size()) {
+                order.push_back(cpus[round]);
+            }
+        }
+    }
+    return order;
+}
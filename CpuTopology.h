@@ -0,0 +1,77 @@
+/**
+ * @file CpuTopology.h
+ * @brief Header file for the CpuTopology class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @class CpuTopology
+ * @brief CPUs this process may run on, grouped by NUMA node
+ * 
+ * Read once from /sys/devices/system/node and the process affinity mask.
+ * On machines without NUMA information every CPU belongs to node 0.
+ */
+class CpuTopology {
+private:
+    std::vector<int> usableCpus;  ///< CPUs in the affinity mask, ascending
+    std::vector<int> cpuNodes;    ///< NUMA node per CPU number (-1 if unknown)
+    int nodeCount;                ///< Nodes with at least one usable CPU
+
+    /**
+     * @brief Detect the topology of the running machine
+     */
+    CpuTopology();
+
+public:
+    /**
+     * @brief Get the topology, detecting it on first use
+     * @return Process-wide topology
+     */
+    static const CpuTopology& get();
+
+    /**
+     * @brief Parse a kernel CPU list such as "0-3,8,10-11"
+     * @param text CPU list
+     * @return CPU numbers in the order listed
+     */
+    static std::vector<int> parseCpuList(const std::string& text);
+
+    /**
+     * @brief Get the number of NUMA nodes with usable CPUs
+     * @return Node count (at least 1)
+     */
+    int getNodeCount() const;
+
+    /**
+     * @brief Get the NUMA node of a CPU
+     * @param cpu CPU number
+     * @return Node number, 0 if unknown
+     */
+    int getNodeOfCpu(int cpu) const;
+
+    /**
+     * @brief Get the NUMA node of the CPU the calling thread is running on
+     * @return Node number, 0 if unknown
+     */
+    int getCurrentNode() const;
+
+    /**
+     * @brief Get usable CPUs in worker placement order
+     * 
+     * Alternates between nodes (first CPU of each node, then the second,
+     * and so on) so that a pool smaller than the machine still spreads
+     * over every node's memory bandwidth.
+     * @return CPU numbers
+     */
+    std::vector<int> getPlacementOrder() const;
+};
+
+#endif // CPUTOPOLOGY_H
@@ -0,0 +1,99 @@
+/**
+ * @file CycleEngine.cpp
+ * @brief Common interface of cycle-accurate simulation engines
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "CycleEngine.h"
+#include "WebServer.h"
+#include <sstream>
+
+/**
+ * @brief Describe the first difference from another snapshot
+ * @param other Snapshot to compare with
+ * @return Empty if equal, otherwise a description of the first differing field
+ */
+std::string EngineSnapshot::firstDifference(const EngineSnapshot& other) const {
+    std::stringstream ss;
+    if (cycle != other.cycle) {
+        ss << "cycle " << cycle << " vs " << other.cycle;
+    } else if (queueSize != other.queueSize) {
+        ss << "queue size " << queueSize << " vs " << other.queueSize;
+    } else if (totalProcessed != other.totalProcessed) {
+        ss << "processed " << totalProcessed << " vs " << other.totalProcessed;
+    } else if (totalRejected != other.totalRejected) {
+        ss << "rejected " << totalRejected << " vs " << other.totalRejected;
+    } else if (totalLatency != other.totalLatency) {
+        ss << "total latency " << totalLatency << " vs " << other.totalLatency;
+    } else if (serverLoads.size() != other.serverLoads.size()) {
+        ss << "server count " << serverLoads.size() << " vs " << other.serverLoads.size();
+    } else {
+        for (size_t i = 0; i < serverLoads.size(); ++i) {
+            if (serverLoads[i] != other.serverLoads[i]) {
+                ss << "server " << i + 1 << " load " << serverLoads[i] << " vs " << other.serverLoads[i];
+                break;
+            }
+            if (serverProcessed[i] != other.serverProcessed[i]) {
+                ss << "server " << i + 1 << " processed " << serverProcessed[i] << " vs "
+                   << other.serverProcessed[i];
+                break;
+            }
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * @brief Wrap a load balancer
+ * @param balancer Configured load balancer
+ */
+ReferenceEngine::ReferenceEngine(const LoadBalancer& balancer) : loadBalancer(balancer) {
+}
+
+/**
+ * @brief Get a short engine name for reports
+ * @return "reference"
+ */
+std::string ReferenceEngine::getName() const {
+    return "reference";
+}
+
+/**
+ * @brief Offer a request to the queue
+ * @param request Request to admit
+ * @return True if admitted
+ */
+bool ReferenceEngine::addRequest(const Request& request) {
+    return loadBalancer.addRequest(request);
+}
+
+/**
+ * @brief Advance one cycle
+ * @return Requests completed in this cycle
+ */
+int ReferenceEngine::processCycle() {
+    return loadBalancer.processCycle();
+}
+
+/**
+ * @brief Capture the observable state
+ * @param snapshot Output snapshot (buffers are reused)
+ */
+void ReferenceEngine::snapshot(EngineSnapshot& snapshot) const {
+    snapshot.cycle = loadBalancer.getCurrentCycle();
+    snapshot.queueSize = loadBalancer.getQueueSize();
+    snapshot.totalProcessed = loadBalancer.getTotalRequestsProcessed();
+    snapshot.totalRejected = loadBalancer.getTotalRequestsRejected();
+    snapshot.totalLatency = loadBalancer.getTotalLatency();
+    
+    int servers = loadBalancer.getServerCount();
+    snapshot.serverLoads.resize(servers);
+    snapshot.serverProcessed.resize(servers);
+    for (int i = 0; i < servers; ++i) {
+        const WebServer& server = loadBalancer.getServer(i);
+        snapshot.serverLoads[i] = server.getCurrentLoad();
+        snapshot.serverProcessed[i] = server.getTotalRequestsProcessed();
+    }
+}
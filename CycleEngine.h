@@ -0,0 +1,123 @@
+/**
+ * @file CycleEngine.h
+ * @brief Common interface of cycle-accurate simulation engines
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef CYCLEENGINE_H
+#define CYCLEENGINE_H
+
+#include "LoadBalancer.h"
+#include "Request.h"
+#include <string>
+#include <vector>
+
+/**
+ * @struct EngineSnapshot
+ * @brief Observable engine state after a cycle
+ * 
+ * Two engines are equivalent if they produce equal snapshots after every
+ * cycle when fed the same requests.
+ */
+struct EngineSnapshot {
+    long long cycle = 0;                    ///< Cycles processed
+    int queueSize = 0;                      ///< Requests waiting in the queue
+    long long totalProcessed = 0;           ///< Requests completed
+    long long totalRejected = 0;            ///< Requests refused at admission
+    long long totalLatency = 0;             ///< Sum of end-to-end latencies
+    std::vector<int> serverLoads;           ///< In-flight requests per server
+    std::vector<long long> serverProcessed; ///< Requests completed per server
+
+    /**
+     * @brief Describe the first difference from another snapshot
+     * @param other Snapshot to compare with
+     * @return Empty if equal, otherwise a description of the first differing field
+     */
+    std::string firstDifference(const EngineSnapshot& other) const;
+};
+
+/**
+ * @class CycleEngine
+ * @brief Cycle-accurate load balancer engine
+ * 
+ * LoadBalancer::processCycle() defines the reference semantics; faster
+ * engines implement this interface so EquivalenceChecker can hold them to
+ * it cycle by cycle.
+ */
+class CycleEngine {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~CycleEngine() = default;
+
+    /**
+     * @brief Get a short engine name for reports
+     * @return Engine name
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Offer a request to the queue
+     * @param request Request to admit
+     * @return True if admitted
+     */
+    virtual bool addRequest(const Request& request) = 0;
+
+    /**
+     * @brief Advance one cycle
+     * @return Requests completed in this cycle
+     */
+    virtual int processCycle() = 0;
+
+    /**
+     * @brief Capture the observable state
+     * @param snapshot Output snapshot (buffers are reused)
+     */
+    virtual void snapshot(EngineSnapshot& snapshot) const = 0;
+};
+
+/**
+ * @class ReferenceEngine
+ * @brief CycleEngine view of the reference LoadBalancer
+ */
+class ReferenceEngine : public CycleEngine {
+private:
+    LoadBalancer loadBalancer;  ///< Reference implementation
+
+public:
+    /**
+     * @brief Wrap a load balancer
+     * @param balancer Configured load balancer
+     */
+    explicit ReferenceEngine(const LoadBalancer& balancer);
+
+    /**
+     * @brief Get a short engine name for reports
+     * @return "reference"
+     */
+    std::string getName() const override;
+
+    /**
+     * @brief Offer a request to the queue
+     * @param request Request to admit
+     * @return True if admitted
+     */
+    bool addRequest(const Request& request) override;
+
+    /**
+     * @brief Advance one cycle
+     * @return Requests completed in this cycle
+     */
+    int processCycle() override;
+
+    /**
+     * @brief Capture the observable state
+     * @param snapshot Output snapshot (buffers are reused)
+     */
+    void snapshot(EngineSnapshot& snapshot) const override;
+};
+
+#endif // CYCLEENGINE_H
@@ -0,0 +1,140 @@
+/**
+ * @file EpochReclaimer.cpp
+ * @brief Implementation file for the EpochReclaimer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "EpochReclaimer.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/**
+ * @brief Claim a reader slot and pin the current epoch
+ * @param owner Reclaimer to pin
+ */
+EpochReclaimer::Guard::Guard(EpochReclaimer& owner) : reclaimer(owner), slot(owner.pin()) {
+}
+
+/**
+ * @brief Release the reader slot
+ */
+EpochReclaimer::Guard::~Guard() {
+    reclaimer.unpin(slot);
+}
+
+/**
+ * @brief Create a reclaimer with no retired objects
+ */
+EpochReclaimer::EpochReclaimer() : epoch(1) {
+}
+
+/**
+ * @brief Destroy all retired objects
+ */
+EpochReclaimer::~EpochReclaimer() {
+    // No guard can outlive the reclaimer, so everything is unreachable
+    for (auto& object : retired) {
+        object.deleter();
+    }
+}
+
+/**
+ * @brief Claim a free slot and pin the current epoch in it
+ * @return Slot index
+ */
+int EpochReclaimer::pin() {
+    // Start where this thread found a free slot last time, so steady-state
+    // readers claim their own slot on the first try
+    static thread_local int hint = static_cast<int>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS);
+    for (;;) {
+        for (int i = 0; i < MAX_READERS; ++i) {
+            int index = (hint + i) % MAX_READERS;
+            uint64_t expected = IDLE;
+            // Sequentially consistent, so the pin is ordered before the
+            // reader's load of the shared pointer
+            if (slots[index].epoch.compare_exchange_strong(expected, epoch.load())) {
+                hint = index;
+                return index;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Release a slot
+ * @param slot Slot index from pin()
+ */
+void EpochReclaimer::unpin(int slot) {
+    slots[slot].epoch.store(IDLE, std::memory_order_release);
+}
+
+/**
+ * @brief Hand over an object unlinked from the shared pointer
+ *
+ * Call after the pointer has been swapped; the deleter runs once no
+ * reader can hold the object, possibly during this call.
+ * @param deleter Destroys the object
+ */
+void EpochReclaimer::retire(std::function<void()> deleter) {
+    // Readers that pin after this increment already see the new pointer
+    uint64_t unlinked = epoch.fetch_add(1);
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    retired.push_back(Retired{unlinked, std::move(deleter)});
+    reclaimLocked();
+}
+
+/**
+ * @brief Destroy retired objects no reader can still hold
+ * @return Number of objects destroyed
+ */
+size_t EpochReclaimer::reclaim() {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    return reclaimLocked();
+}
+
+/**
+ * @brief Destroy retired objects older than every pinned epoch
+ * @return Number of objects destroyed
+ */
+size_t EpochReclaimer::reclaimLocked() {
+    uint64_t oldestPinned = std::numeric_limits<uint64_t>::max();
+    for (const auto& slot : slots) {
+        uint64_t pinned = slot.epoch.load();
+        if (pinned != IDLE) {
+            oldestPinned = std::min(oldestPinned, pinned);
+        }
+    }
+    // A reader pinned at epoch e may hold anything unlinked at epoch >= e
+    auto firstKept = std::stable_partition(retired.begin(), retired.end(),
+                                           [oldestPinned](const Retired& object) {
+                                               return object.epoch < oldestPinned;
+                                           });
+    size_t destroyed = static_cast<size_t>(firstKept - retired.begin());
+    for (auto it = retired.begin(); it != firstKept; ++it) {
+        it->deleter();
+    }
+    retired.erase(retired.begin(), firstKept);
+    return destroyed;
+}
+
+/**
+ * @brief Get the number of retired objects not yet destroyed
+ * @return Pending object count
+ */
+size_t EpochReclaimer::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    return retired.size();
+}
+
+/**
+ * @brief Get the current epoch
+ * @return Epoch number
+ */
+uint64_t EpochReclaimer::getEpoch() const {
+    return epoch.load();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file EpochReclaimer.h
+ * @brief Header file for the EpochReclaimer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochReclaimer
+ * @brief Epoch-based reclamation for objects shared with lock-free readers
+ *
+ * A reader pins the current epoch in one of a fixed set of slots for as
+ * long as it holds a Guard, then loads the shared pointer. A writer swaps
+ * the pointer and retires the old object with the epoch it replaced; the
+ * object is destroyed once every pinned slot shows a later epoch, so no
+ * reader can still see it. Readers never take a lock and never wait on a
+ * writer; writers free retired objects as readers move on.
+ */
+class EpochReclaimer {
+public:
+    static const int MAX_READERS = 64;  ///< Readers that can hold a guard at once
+
+    /**
+     * @class Guard
+     * @brief Pins the current epoch for the lifetime of the guard
+     */
+    class Guard {
+    private:
+        EpochReclaimer& reclaimer;  ///< Reclaimer the slot belongs to
+        int slot;                   ///< Claimed reader slot
+
+    public:
+        /**
+         * @brief Claim a reader slot and pin the current epoch
+         * @param owner Reclaimer to pin
+         */
+        explicit Guard(EpochReclaimer& owner);
+
+        /**
+         * @brief Release the reader slot
+         */
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    /**
+     * @brief Create a reclaimer with no retired objects
+     */
+    EpochReclaimer();
+
+    /**
+     * @brief Destroy all retired objects
+     */
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    /**
+     * @brief Hand over an object unlinked from the shared pointer
+     *
+     * Call after the pointer has been swapped; the deleter runs once no
+     * reader can hold the object, possibly during this call.
+     * @param deleter Destroys the object
+     */
+    void retire(std::function<void()> deleter);
+
+    /**
+     * @brief Destroy retired objects no reader can still hold
+     * @return Number of objects destroyed
+     */
+    size_t reclaim();
+
+    /**
+     * @brief Get the number of retired objects not yet destroyed
+     * @return Pending object count
+     */
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Get the current epoch
+     * @return Epoch number
+     */
+    uint64_t getEpoch() const;
+
+private:
+    static const uint64_t IDLE = 0;  ///< Slot value when no reader holds it
+
+    /**
+     * @struct ReaderSlot
+     * @brief Epoch pinned by one reader, on its own cache line
+     */
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{IDLE};  ///< Pinned epoch, or IDLE
+    };
+
+    /**
+     * @struct Retired
+     * @brief Object waiting for readers to move past its epoch
+     */
+    struct Retired {
+        uint64_t epoch;                ///< Epoch in which it was unlinked
+        std::function<void()> deleter; ///< Destroys the object
+    };
+
+    ReaderSlot slots[MAX_READERS];    ///< Reader announcements
+    std::atomic<uint64_t> epoch;      ///< Global epoch, starts at 1
+    mutable std::mutex retiredMutex;  ///< Guards retired (writers only)
+    std::vector<Retired> retired;     ///< Objects awaiting destruction
+
+    /**
+     * @brief Claim a free slot and pin the current epoch in it
+     * @return Slot index
+     */
+    int pin();
+
+    /**
+     * @brief Release a slot
+     * @param slot Slot index from pin()
+     */
+    void unpin(int slot);
+
+    /**
+     * @brief Destroy retired objects older than every pinned epoch
+     * @return Number of objects destroyed
+     */
+    size_t reclaimLocked();
+};
+
+#endif // EPOCHRECLAIMER_H
@@ -0,0 +1,146 @@
+/**
+ * @file EquivalenceChecker.cpp
+ * @brief Implementation file for the EquivalenceChecker class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "EquivalenceChecker.h"
+#include "WorkloadGenerator.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Parameterized constructor
+ * @param simulationConfig Run length, initial backlog and arrival cutoff
+ * @param workloadParams Workload parameters
+ * @param workloadSeed Seed of the request stream
+ */
+EquivalenceChecker::EquivalenceChecker(const SimulationConfig& simulationConfig,
+                                       const WorkloadParams& workloadParams, unsigned int workloadSeed)
+    : config(simulationConfig), workload(workloadParams), seed(workloadSeed), cyclesChecked(0),
+      requestsOffered(0), divergenceCycle(-1), referenceSeconds(0.0), candidateSeconds(0.0) {
+}
+
+/**
+ * @brief Drive both engines and compare them cycle by cycle
+ * @param reference Engine defining the expected behaviour
+ * @param candidate Engine under test
+ * @return True if no divergence was found
+ */
+bool EquivalenceChecker::run(CycleEngine& reference, CycleEngine& candidate) {
+    using Clock = std::chrono::steady_clock;
+    
+    referenceName = reference.getName();
+    candidateName = candidate.getName();
+    cyclesChecked = 0;
+    requestsOffered = 0;
+    divergenceCycle = -1;
+    divergence.clear();
+    Clock::duration referenceTime{0};
+    Clock::duration candidateTime{0};
+    
+    WorkloadGenerator generator(workload, seed);
+    std::vector<Request> batch;
+    EngineSnapshot expected, actual;
+    
+    // Feed a batch to one engine and, unless it is a backlog, advance it
+    auto drive = [&batch](CycleEngine& engine, bool advance, Clock::duration& elapsed) {
+        Clock::time_point start = Clock::now();
+        for (const auto& request : batch) {
+            engine.addRequest(request);
+        }
+        if (advance) {
+            engine.processCycle();
+        }
+        elapsed += Clock::now() - start;
+    };
+    
+    for (int i = 0; i < config.initialQueueSize; ++i) {
+        batch.push_back(generator.generateRequest());
+    }
+    
+    long long arrivalEnd = static_cast<long long>(config.cycles * config.arrivalCutoff);
+    for (long long cycle = 0; cycle <= config.cycles; ++cycle) {
+        if (cycle > 0) {
+            // Same draws as advanceCycle(), including those past the cutoff
+            batch.clear();
+            int arrivals = generator.drawArrivals();
+            for (int i = 0; i < arrivals; ++i) {
+                Request request = generator.generateRequest();
+                if (cycle < arrivalEnd) {
+                    batch.push_back(std::move(request));
+                }
+            }
+        }
+        requestsOffered += static_cast<long long>(batch.size());
+        
+        drive(reference, cycle > 0, referenceTime);
+        drive(candidate, cycle > 0, candidateTime);
+        
+        reference.snapshot(expected);
+        candidate.snapshot(actual);
+        cyclesChecked = cycle;
+        std::string difference = expected.firstDifference(actual);
+        if (!difference.empty()) {
+            divergenceCycle = cycle;
+            divergence = difference;
+            break;
+        }
+    }
+    
+    referenceSeconds = std::chrono::duration<double>(referenceTime).count();
+    candidateSeconds = std::chrono::duration<double>(candidateTime).count();
+    return divergenceCycle < 0;
+}
+
+/**
+ * @brief Get the first divergent cycle
+ * @return Cycle number (0 is the initial backlog), or -1 if none
+ */
+long long EquivalenceChecker::getDivergenceCycle() const {
+    return divergenceCycle;
+}
+
+/**
+ * @brief Build a human-readable report of the last run
+ * @return Report lines
+ */
+std::vector<std::string> EquivalenceChecker::getReport() const {
+    std::vector<std::string> report;
+    
+    std::stringstream header;
+    header << "Engine check: " << candidateName << " against " << referenceName << ", seed " << seed;
+    report.push_back(header.str());
+    
+    std::stringstream result;
+    if (divergenceCycle < 0) {
+        result << "  Equivalent for " << cyclesChecked << " cycles (" << requestsOffered
+               << " requests offered)";
+    } else {
+        result << "  DIVERGED at cycle " << divergenceCycle << ": " << divergence << " ("
+               << referenceName << " vs " << candidateName << ")";
+    }
+    report.push_back(result.str());
+    
+    // Per-engine throughput over the cycles both engines actually ran
+    auto rate = [this](double seconds) {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3) << seconds << " s";
+        if (seconds > 0.0 && cyclesChecked > 0) {
+            ss << std::setprecision(0) << " (" << cyclesChecked / seconds << " cycles/s)";
+        }
+        return ss.str();
+    };
+    report.push_back("  " + referenceName + ": " + rate(referenceSeconds));
+    report.push_back("  " + candidateName + ": " + rate(candidateSeconds));
+    if (candidateSeconds > 0.0) {
+        std::stringstream speedup;
+        speedup << std::fixed << std::setprecision(2) << "  Speedup: " << referenceSeconds / candidateSeconds
+                << "x";
+        report.push_back(speedup.str());
+    }
+    return report;
+}
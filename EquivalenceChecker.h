@@ -0,0 +1,73 @@
+/**
+ * @file EquivalenceChecker.h
+ * @brief Header file for the EquivalenceChecker class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef EQUIVALENCECHECKER_H
+#define EQUIVALENCECHECKER_H
+
+#include "CycleEngine.h"
+#include "Simulation.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class EquivalenceChecker
+ * @brief Differential test of a candidate engine against the reference
+ * 
+ * Generates one seeded request stream, exactly as runSimulation() would,
+ * and feeds it to both engines. Their snapshots are compared after the
+ * initial backlog and after every cycle; the run stops at the first
+ * divergence so the report names the cycle and field where the candidate
+ * went wrong. Each engine is timed separately, so the same run also
+ * measures the speedup being bought.
+ */
+class EquivalenceChecker {
+private:
+    SimulationConfig config;     ///< Run length, backlog and cutoff
+    WorkloadParams workload;     ///< Request stream parameters
+    unsigned int seed;           ///< Workload seed
+    std::string referenceName;   ///< Name of the reference engine
+    std::string candidateName;   ///< Name of the candidate engine
+    long long cyclesChecked;     ///< Cycles compared before stopping
+    long long requestsOffered;   ///< Requests fed to both engines
+    long long divergenceCycle;   ///< First divergent cycle, or -1
+    std::string divergence;      ///< Description of the first difference
+    double referenceSeconds;     ///< Time spent inside the reference engine
+    double candidateSeconds;     ///< Time spent inside the candidate engine
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param simulationConfig Run length, initial backlog and arrival cutoff
+     * @param workloadParams Workload parameters
+     * @param workloadSeed Seed of the request stream
+     */
+    EquivalenceChecker(const SimulationConfig& simulationConfig, const WorkloadParams& workloadParams,
+                       unsigned int workloadSeed);
+
+    /**
+     * @brief Drive both engines and compare them cycle by cycle
+     * @param reference Engine defining the expected behaviour
+     * @param candidate Engine under test
+     * @return True if no divergence was found
+     */
+    bool run(CycleEngine& reference, CycleEngine& candidate);
+
+    /**
+     * @brief Get the first divergent cycle
+     * @return Cycle number (0 is the initial backlog), or -1 if none
+     */
+    long long getDivergenceCycle() const;
+
+    /**
+     * @brief Build a human-readable report of the last run
+     * @return Report lines
+     */
+    std::vector<std::string> getReport() const;
+};
+
+#endif // EQUIVALENCECHECKER_H
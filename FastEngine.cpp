@@ -0,0 +1,216 @@
+/**
+ * @file FastEngine.cpp
+ * @brief Implementation file for the FastEngine class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "FastEngine.h"
+#include <algorithm>
+
+/**
+ * @brief Build an engine with the same settings as createLoadBalancer()
+ * @param config Load balancer configuration
+ */
+FastEngine::FastEngine(const SimulationConfig& config)
+    : capacity(LoadBalancer::SERVER_CAPACITY), maxServers(config.maxServers),
+      minServers(config.minServers), loadThreshold(config.loadThreshold), policy(config.policy),
+      serverCount(std::min(config.initialServers, config.maxServers)), nextServerIndex(0),
+      ringHead(0), ringCount(0), maxQueueSize(config.maxQueueSize), currentCycle(0),
+      totalProcessed(0), totalRejected(0), totalLatency(0), totalServiceTime(0) {
+    size_t slots = static_cast<size_t>(std::max(maxServers, serverCount)) * capacity;
+    loads.assign(std::max(maxServers, serverCount), 0);
+    processed.assign(loads.size(), 0);
+    slotCompletion.assign(slots, 0);
+    slotArrival.assign(slots, 0);
+    slotService.assign(slots, 0);
+    ring.resize(16);
+    
+    // Same expression as WebServer::getUtilization(), so sums match bit for bit
+    for (int load = 0; load <= capacity; ++load) {
+        utilizationTerm.push_back((static_cast<double>(load) / capacity) * 100.0);
+    }
+}
+
+/**
+ * @brief Get a short engine name for reports
+ * @return "fast"
+ */
+std::string FastEngine::getName() const {
+    return "fast";
+}
+
+/**
+ * @brief Offer a request to the queue
+ * @param request Request to admit
+ * @return True if admitted
+ */
+bool FastEngine::addRequest(const Request& request) {
+    if (static_cast<int>(ringCount) >= maxQueueSize) {
+        totalRejected++;
+        return false;
+    }
+    
+    if (ringCount == ring.size()) {
+        // Grow by unrolling the ring into a larger buffer
+        PoolVector<QueuedRequest> larger(ring.size() * 2);
+        for (size_t i = 0; i < ringCount; ++i) {
+            larger[i] = ring[(ringHead + i) % ring.size()];
+        }
+        ring.swap(larger);
+        ringHead = 0;
+    }
+    ring[(ringHead + ringCount) % ring.size()] = {request.getProcessingTime(), request.getServiceTime(),
+                                                 currentCycle};
+    ringCount++;
+    return true;
+}
+
+/**
+ * @brief Pick a server with a free slot according to the policy
+ * @return Server index, or -1 if none can accept
+ */
+int FastEngine::selectServer() const {
+    if (policy == DistributionPolicy::LEAST_CONNECTIONS) {
+        int best = -1;
+        for (int i = 0; i < serverCount; ++i) {
+            int index = (nextServerIndex + i) % serverCount;
+            if (loads[index] < capacity && (best < 0 || loads[index] < loads[best])) {
+                best = index;
+            }
+        }
+        return best;
+    }
+    
+    for (int i = 0; i < serverCount; ++i) {
+        int index = (nextServerIndex + i) % serverCount;
+        if (loads[index] < capacity) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Move queued requests onto servers
+ */
+void FastEngine::distributeRequests() {
+    int attempts = 0;
+    int maxAttempts = serverCount * 2;
+    while (ringCount > 0 && attempts < maxAttempts) {
+        int server = selectServer();
+        if (server < 0) {
+            break;
+        }
+        
+        const QueuedRequest& request = ring[ringHead];
+        size_t slot = static_cast<size_t>(server) * capacity + loads[server];
+        // WebServer completes a request once its remaining time drops to zero
+        slotCompletion[slot] = currentCycle + std::max(1, request.processingTime);
+        slotArrival[slot] = request.arrivalCycle;
+        slotService[slot] = request.serviceTime;
+        loads[server]++;
+        ringHead = (ringHead + 1) % ring.size();
+        ringCount--;
+        
+        nextServerIndex = (server + 1) % serverCount;
+        attempts++;
+    }
+}
+
+/**
+ * @brief Get the average utilization of the servers
+ * @return Utilization percentage (0-100)
+ */
+double FastEngine::getSystemUtilization() const {
+    if (serverCount == 0) return 0.0;
+    double total = 0.0;
+    for (int i = 0; i < serverCount; ++i) {
+        total += utilizationTerm[loads[i]];
+    }
+    return total / serverCount;
+}
+
+/**
+ * @brief Add or remove a server based on utilization and queue length
+ */
+void FastEngine::checkLoadBalancing() {
+    if (serverCount == 0) {
+        return;
+    }
+    
+    double averageUtilization = getSystemUtilization() / 100.0;
+    int queueSize = static_cast<int>(ringCount);
+    if ((averageUtilization > loadThreshold || queueSize > 10) && serverCount < maxServers) {
+        loads[serverCount] = 0;
+        processed[serverCount] = 0;
+        serverCount++;
+    }
+    // As in the reference, the removed server's in-flight requests are lost
+    if (averageUtilization < loadThreshold * 0.05 && queueSize == 0 && serverCount > minServers + 3) {
+        serverCount--;
+    }
+}
+
+/**
+ * @brief Advance one cycle
+ * @return Requests completed in this cycle
+ */
+int FastEngine::processCycle() {
+    currentCycle++;
+    int completed = 0;
+    
+    for (int server = 0; server < serverCount; ++server) {
+        size_t base = static_cast<size_t>(server) * capacity;
+        int load = loads[server];
+        for (int i = 0; i < load;) {
+            size_t slot = base + i;
+            if (slotCompletion[slot] > currentCycle) {
+                ++i;
+                continue;
+            }
+            long long latency = currentCycle - slotArrival[slot];
+            totalLatency += latency;
+            totalServiceTime += slotService[slot];
+            latencyHistogram.record(latency);
+            
+            // Fill the hole with the last occupied slot
+            size_t last = base + load - 1;
+            slotCompletion[slot] = slotCompletion[last];
+            slotArrival[slot] = slotArrival[last];
+            slotService[slot] = slotService[last];
+            load--;
+            completed++;
+            processed[server]++;
+        }
+        loads[server] = load;
+    }
+    
+    distributeRequests();
+    checkLoadBalancing();
+    totalProcessed += completed;
+    return completed;
+}
+
+/**
+ * @brief Capture the observable state
+ * @param snapshot Output snapshot (buffers are reused)
+ */
+void FastEngine::snapshot(EngineSnapshot& snapshot) const {
+    snapshot.cycle = currentCycle;
+    snapshot.queueSize = static_cast<int>(ringCount);
+    snapshot.totalProcessed = totalProcessed;
+    snapshot.totalRejected = totalRejected;
+    snapshot.totalLatency = totalLatency;
+    snapshot.serverLoads.assign(loads.begin(), loads.begin() + serverCount);
+    snapshot.serverProcessed.assign(processed.begin(), processed.begin() + serverCount);
+}
+
+/**
+ * @brief Get the distribution of end-to-end latencies
+ * @return Latency histogram in cycles
+ */
+const LatencyHistogram& FastEngine::getLatencyHistogram() const {
+    return latencyHistogram;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file FastEngine.h
+ * @brief Header file for the FastEngine class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef FASTENGINE_H
+#define FASTENGINE_H
+
+#include "CycleEngine.h"
+#include "HugePages.h"
+#include "LatencyHistogram.h"
+#include "Simulation.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class FastEngine
+ * @brief Structure-of-arrays reimplementation of LoadBalancer::processCycle()
+ * 
+ * Keeps the reference tick semantics (server processing, then queue
+ * distribution, then autoscaling, every cycle) but stores state as flat
+ * arrays:
+ * - queued requests are reduced to (processing time, service time, arrival
+ *   cycle) in a ring buffer;
+ * - each server owns SERVER_CAPACITY slots holding the absolute cycle at
+ *   which the request completes, so a cycle compares instead of
+ *   decrementing and nothing is moved unless a request finishes.
+ * The per-server and queue arrays use HugePageAllocator, so large
+ * fleets and backlogs sit on 2 MB pages when HugePages is enabled.
+ * Completion order within a server may differ from the reference, which
+ * changes no observable counter. IP blocking and queue spilling are not
+ * modelled.
+ */
+class FastEngine : public CycleEngine {
+private:
+    /**
+     * @struct QueuedRequest
+     * @brief Queue entry reduced to the fields the engine needs
+     */
+    struct QueuedRequest {
+        int processingTime;      ///< Cycles of work remaining
+        int serviceTime;         ///< Original processing time
+        long long arrivalCycle;  ///< Cycle at admission
+    };
+
+    /// Vector whose storage may be huge-page backed
+    template <typename T>
+    using PoolVector = std::vector<T, HugePageAllocator<T>>;
+
+    int capacity;                              ///< Slots per server
+    int maxServers;                            ///< Upper scaling bound
+    int minServers;                            ///< Lower scaling bound
+    double loadThreshold;                      ///< Scaling threshold (0.0-1.0)
+    DistributionPolicy policy;                 ///< Server selection policy
+    int serverCount;                           ///< Servers currently present
+    int nextServerIndex;                       ///< Round-robin cursor
+    PoolVector<int> loads;                     ///< In-flight requests per server
+    PoolVector<long long> processed;           ///< Completed requests per server
+    PoolVector<long long> slotCompletion;      ///< Completion cycle per slot
+    PoolVector<long long> slotArrival;         ///< Arrival cycle per slot
+    PoolVector<int> slotService;               ///< Service time per slot
+    std::vector<double> utilizationTerm;       ///< Utilization percentage per load value
+    PoolVector<QueuedRequest> ring;            ///< Queue ring buffer
+    size_t ringHead;                           ///< Index of the oldest queued request
+    size_t ringCount;                          ///< Requests queued
+    int maxQueueSize;                          ///< Queue capacity
+    long long currentCycle;                    ///< Cycles processed
+    long long totalProcessed;                  ///< Requests completed
+    long long totalRejected;                   ///< Requests refused at admission
+    long long totalLatency;                    ///< Sum of end-to-end latencies
+    long long totalServiceTime;                ///< Sum of completed service times
+    LatencyHistogram latencyHistogram;         ///< End-to-end latency distribution
+
+    /**
+     * @brief Pick a server with a free slot according to the policy
+     * @return Server index, or -1 if none can accept
+     */
+    int selectServer() const;
+
+    /**
+     * @brief Move queued requests onto servers
+     */
+    void distributeRequests();
+
+    /**
+     * @brief Add or remove a server based on utilization and queue length
+     */
+    void checkLoadBalancing();
+
+public:
+    /**
+     * @brief Build an engine with the same settings as createLoadBalancer()
+     * @param config Load balancer configuration
+     */
+    explicit FastEngine(const SimulationConfig& config);
+
+    /**
+     * @brief Get a short engine name for reports
+     * @return "fast"
+     */
+    std::string getName() const override;
+
+    /**
+     * @brief Offer a request to the queue
+     * @param request Request to admit
+     * @return True if admitted
+     */
+    bool addRequest(const Request& request) override;
+
+    /**
+     * @brief Advance one cycle
+     * @return Requests completed in this cycle
+     */
+    int processCycle() override;
+
+    /**
+     * @brief Capture the observable state
+     * @param snapshot Output snapshot (buffers are reused)
+     */
+    void snapshot(EngineSnapshot& snapshot) const override;
+
+    /**
+     * @brief Get the average utilization of the servers
+     * @return Utilization percentage (0-100)
+     */
+    double getSystemUtilization() const;
+
+    /**
+     * @brief Get the distribution of end-to-end latencies
+     * @return Latency histogram in cycles
+     */
+    const LatencyHistogram& getLatencyHistogram() const;
+};
+
+#endif // FASTENGINE_H
@@ -0,0 +1,255 @@
+/**
+ * @file FleetSizer.cpp
+ * @brief Implementation file for the FleetSizer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "FleetSizer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+const int MAX_FLEET = 100000; ///< Search gives up beyond this many servers
+}
+
+/**
+ * @brief Probability that an arrival has to wait in an M/M/k queue (Erlang C)
+ * @param servers Number of parallel slots k
+ * @param load Offered load in Erlangs
+ * @return Waiting probability, or 1 if the queue is unstable
+ */
+double erlangC(int servers, double load) {
+    if (servers <= 0 || load >= servers) return 1.0;
+    if (load <= 0.0) return 0.0;
+    
+    // Erlang B by the stable recurrence, then convert to Erlang C
+    double blocking = 1.0;
+    for (int k = 1; k <= servers; ++k) {
+        blocking = load * blocking / (k + load * blocking);
+    }
+    return servers * blocking / (servers - load * (1.0 - blocking));
+}
+
+/**
+ * @brief Parameterized constructor
+ * @param workloadParams Workload to size for
+ * @param objective Latency objective
+ * @param baseConfig Run length, warm-up and policy used for every candidate
+ */
+FleetSizer::FleetSizer(const WorkloadParams& workloadParams, const LatencySLO& objective,
+                       const SimulationConfig& baseConfig)
+    : workload(workloadParams), slo(objective), base(baseConfig), replications(8), baseSeed(1),
+      autoscale(false) {
+}
+
+/**
+ * @brief Set the number of replications per candidate
+ * @param count Replications (at least 1)
+ */
+void FleetSizer::setReplications(int count) {
+    replications = std::max(1, count);
+}
+
+/**
+ * @brief Set the seed of the first replication
+ * @param seed Seed
+ */
+void FleetSizer::setSeed(unsigned int seed) {
+    baseSeed = seed;
+}
+
+/**
+ * @brief Search the autoscaler's server cap instead of a fixed fleet size
+ * @param enabled True to size the autoscaler
+ */
+void FleetSizer::setAutoscale(bool enabled) {
+    autoscale = enabled;
+}
+
+/**
+ * @brief Offered load in busy request slots (arrival rate x mean service time)
+ * @return Offered load in Erlangs
+ */
+double FleetSizer::offeredLoad() const {
+    return workload.arrivalRate * workload.meanServiceTime();
+}
+
+/**
+ * @brief Smallest fleet whose slots exceed the offered load
+ * @return Analytic lower bound on the fleet size
+ */
+int FleetSizer::analyticLowerBound() const {
+    int lower = static_cast<int>(std::floor(offeredLoad() / LoadBalancer::SERVER_CAPACITY)) + 1;
+    return std::max(1, lower);
+}
+
+/**
+ * @brief Fleet size at which queueing is negligible for the SLO percentile
+ * @param lower Lower bound to start from
+ * @return Analytic upper bound on the fleet size
+ */
+int FleetSizer::analyticUpperBound(int lower) const {
+    // Once fewer than half of the requests allowed above the percentile
+    // have to wait at all, the percentile is set by service time alone
+    double waitBudget = (1.0 - slo.percentile / 100.0) / 2.0;
+    double load = offeredLoad();
+    
+    for (int servers = lower; servers < MAX_FLEET; ++servers) {
+        if (erlangC(servers * LoadBalancer::SERVER_CAPACITY, load) <= waitBudget) {
+            return servers;
+        }
+    }
+    return MAX_FLEET;
+}
+
+/**
+ * @brief Simulate one candidate with parallel replications
+ * @param servers Fleet size or autoscaler cap
+ * @param pool Thread pool running the replications
+ * @return Evaluation outcome
+ */
+FleetCandidate FleetSizer::evaluate(int servers, ThreadPool& pool) {
+    SimulationConfig config = base;
+    config.maxServers = servers;
+    if (autoscale) {
+        config.minServers = 1;
+        config.initialServers = std::min(servers, analyticLowerBound());
+    } else {
+        config.minServers = servers;
+        config.initialServers = servers;
+    }
+    
+    std::vector<SimulationResult> results(replications);
+    for (int r = 0; r < replications; ++r) {
+        pool.submit([&, r] {
+            results[r] = runSimulation(config, workload, baseSeed + r);
+        });
+    }
+    pool.waitAll();
+    
+    FleetCandidate candidate;
+    candidate.servers = servers;
+    candidate.simulated = true;
+    LatencyHistogram pooled;
+    for (const auto& result : results) {
+        pooled.merge(result.latency);
+        candidate.meanActiveServers += result.meanActiveServers / replications;
+        candidate.meanFinalQueue += static_cast<double>(result.finalQueueSize) / replications;
+        candidate.rejected += result.rejected;
+    }
+    candidate.latency = pooled.getPercentile(slo.percentile);
+    
+    // Completed requests alone hide a growing backlog; by Little's law a queue
+    // longer than arrival rate x SLO means queued requests will miss the SLO
+    bool backlogged = candidate.meanFinalQueue > workload.arrivalRate * slo.maxLatency;
+    candidate.feasible = pooled.getCount() > 0 && candidate.latency <= slo.maxLatency &&
+                         candidate.rejected == 0 && !backlogged;
+    candidates.push_back(candidate);
+    return candidate;
+}
+
+/**
+ * @brief Run the search
+ * @param pool Thread pool running the simulations
+ * @return Smallest feasible fleet size (or cap), or -1 if none was found
+ */
+int FleetSizer::solve(ThreadPool& pool) {
+    candidates.clear();
+    std::stringstream note;
+    note << std::fixed << std::setprecision(2);
+    
+    // Latency can never beat the service time itself
+    double serviceQuantile = workload.serviceTimeQuantile(slo.percentile / 100.0);
+    if (serviceQuantile > slo.maxLatency) {
+        note << "Infeasible: p" << std::defaultfloat << slo.percentile << std::fixed
+             << " service time alone is " << serviceQuantile
+             << " cycles";
+        screenNote = note.str();
+        return -1;
+    }
+    
+    int lower = analyticLowerBound();
+    int upper = analyticUpperBound(lower);
+    note << "Offered load " << offeredLoad() << " slots; analytic bracket [" << lower << ", "
+         << upper << "] servers";
+    screenNote = note.str();
+    
+    // Fleets below the lower bound are unstable and never simulated
+    if (lower > 1) {
+        FleetCandidate screened;
+        screened.servers = lower - 1;
+        candidates.push_back(screened);
+    }
+    
+    // Confirm the upper bound, growing it if the model was optimistic
+    int best = -1;
+    while (upper <= MAX_FLEET) {
+        if (evaluate(upper, pool).feasible) {
+            best = upper;
+            break;
+        }
+        lower = upper + 1;
+        upper *= 2;
+    }
+    if (best < 0) {
+        return -1;
+    }
+    
+    // Bisection: everything below 'lower' is infeasible, 'best' is feasible
+    while (lower < best) {
+        int mid = lower + (best - lower) / 2;
+        if (evaluate(mid, pool).feasible) {
+            best = mid;
+        } else {
+            lower = mid + 1;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Build a human-readable report of the search
+ * @return Report lines
+ */
+std::vector<std::string> FleetSizer::getReport() const {
+    std::vector<std::string> report;
+    std::stringstream ss;
+    ss << "Fleet sizing: p" << slo.percentile << " latency <= " << slo.maxLatency << " cycles, "
+       << (autoscale ? "autoscaler cap" : "fixed fleet") << ", " << replications
+       << " replications x " << base.cycles << " cycles";
+    report.push_back(ss.str());
+    report.push_back("  " + screenNote);
+    
+    int best = -1;
+    for (const auto& candidate : candidates) {
+        ss.str("");
+        ss << std::fixed << std::setprecision(2);
+        ss << "  " << std::setw(5) << candidate.servers << " servers: ";
+        if (!candidate.simulated) {
+            ss << "pruned (unstable)";
+        } else {
+            ss << "latency " << std::setw(6) << candidate.latency
+               << " | cost " << candidate.meanActiveServers << " servers"
+               << " | final queue " << candidate.meanFinalQueue
+               << " | rejected " << candidate.rejected
+               << (candidate.feasible ? " | meets SLO" : " | misses SLO");
+            if (candidate.feasible && (best < 0 || candidate.servers < best)) {
+                best = candidate.servers;
+            }
+        }
+        report.push_back(ss.str());
+    }
+    
+    ss.str("");
+    if (best > 0) {
+        ss << "  Minimum " << (autoscale ? "autoscaler cap" : "fleet size") << ": " << best << " servers";
+    } else {
+        ss << "  No fleet size meets the SLO";
+    }
+    report.push_back(ss.str());
+    return report;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file FleetSizer.h
+ * @brief Header file for the FleetSizer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef FLEETSIZER_H
+#define FLEETSIZER_H
+
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct LatencySLO
+ * @brief Latency service-level objective on end-to-end cycles
+ */
+struct LatencySLO {
+    double percentile = 99.0; ///< Percentile the objective applies to (0-100)
+    int maxLatency = 200;     ///< Highest acceptable latency at that percentile, in cycles
+};
+
+/**
+ * @struct FleetCandidate
+ * @brief Outcome of evaluating one fleet size
+ */
+struct FleetCandidate {
+    int servers = 0;                ///< Fixed fleet size, or autoscaler cap
+    bool feasible = false;          ///< Whether the SLO was met
+    bool simulated = false;         ///< False if decided by the analytic pre-screen
+    int64_t latency = 0;            ///< Latency at the SLO percentile (pooled over replications)
+    double meanActiveServers = 0.0; ///< Time-averaged servers in use (the cost)
+    double meanFinalQueue = 0.0;    ///< Mean queue size at the end of a run
+    long long rejected = 0;         ///< Requests rejected across all replications
+};
+
+/**
+ * @class FleetSizer
+ * @brief Finds the smallest fleet that meets a latency SLO for a workload
+ * 
+ * An analytic M/G/k pre-screen bounds the search: fleets whose slot count
+ * cannot carry the offered load are rejected without simulation, and the
+ * Erlang C waiting probability gives an upper bound that is then confirmed
+ * by simulation. The bracket is narrowed by bisection, with every candidate
+ * evaluated by several seeded replications running in parallel.
+ */
+class FleetSizer {
+private:
+    WorkloadParams workload;                 ///< Arrival and service-time parameters
+    LatencySLO slo;                          ///< Objective to meet
+    SimulationConfig base;                   ///< Run length, warm-up and policy
+    int replications;                        ///< Replications per candidate
+    unsigned int baseSeed;                   ///< Seed of the first replication
+    bool autoscale;                          ///< Search the autoscaler cap instead of a fixed fleet
+    std::vector<FleetCandidate> candidates;  ///< Candidates in evaluation order
+    std::string screenNote;                  ///< Explanation of the analytic bounds
+
+    /**
+     * @brief Offered load in busy request slots (arrival rate x mean service time)
+     * @return Offered load in Erlangs
+     */
+    double offeredLoad() const;
+
+    /**
+     * @brief Smallest fleet whose slots exceed the offered load
+     * @return Analytic lower bound on the fleet size
+     */
+    int analyticLowerBound() const;
+
+    /**
+     * @brief Fleet size at which queueing is negligible for the SLO percentile
+     * @param lower Lower bound to start from
+     * @return Analytic upper bound on the fleet size
+     */
+    int analyticUpperBound(int lower) const;
+
+    /**
+     * @brief Simulate one candidate with parallel replications
+     * @param servers Fleet size or autoscaler cap
+     * @param pool Thread pool running the replications
+     * @return Evaluation outcome
+     */
+    FleetCandidate evaluate(int servers, ThreadPool& pool);
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param workloadParams Workload to size for
+     * @param objective Latency objective
+     * @param baseConfig Run length, warm-up and policy used for every candidate
+     */
+    FleetSizer(const WorkloadParams& workloadParams, const LatencySLO& objective,
+               const SimulationConfig& baseConfig);
+
+    /**
+     * @brief Set the number of replications per candidate
+     * @param count Replications (at least 1)
+     */
+    void setReplications(int count);
+
+    /**
+     * @brief Set the seed of the first replication
+     * @param seed Seed
+     */
+    void setSeed(unsigned int seed);
+
+    /**
+     * @brief Search the autoscaler's server cap instead of a fixed fleet size
+     * @param enabled True to size the autoscaler
+     */
+    void setAutoscale(bool enabled);
+
+    /**
+     * @brief Run the search
+     * @param pool Thread pool running the simulations
+     * @return Smallest feasible fleet size (or cap), or -1 if none was found
+     */
+    int solve(ThreadPool& pool);
+
+    /**
+     * @brief Build a human-readable report of the search
+     * @return Report lines
+     */
+    std::vector<std::string> getReport() const;
+};
+
+/**
+ * @brief Probability that an arrival has to wait in an M/M/k queue (Erlang C)
+ * @param servers Number of parallel slots k
+ * @param load Offered load in Erlangs
+ * @return Waiting probability, or 1 if the queue is unstable
+ */
+double erlangC(int servers, double load);
+
+#endif // FLEETSIZER_H
@@ -0,0 +1,508 @@
+/**
+ * @file Hpack.cpp
+ * @brief HPACK header compression for HTTP/2 (RFC 7541)
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Hpack.h"
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @struct StaticEntry
+ * @brief Entry of the HPACK static table
+ */
+struct StaticEntry {
+    const char* name;   ///< Field name
+    const char* value;  ///< Field value, empty for name-only entries
+};
+
+const size_t STATIC_TABLE_SIZE = 61;   ///< Entries in the static table
+const size_t ENTRY_OVERHEAD = 32;      ///< Bytes charged per table entry beyond its strings
+const uint32_t HUFFMAN_EOS = 256;      ///< End-of-string symbol
+
+/// RFC 7541 Appendix A
+const StaticEntry STATIC_TABLE[STATIC_TABLE_SIZE] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+/// RFC 7541 Appendix B, codes of symbols 0-255; EOS is thirty 1 bits
+const uint32_t HUFFMAN_CODES[256] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+};
+const uint8_t HUFFMAN_LENGTHS[256] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+};
+
+/**
+ * @struct HuffmanTree
+ * @brief Binary decoding tree of the HPACK Huffman code
+ */
+struct HuffmanTree {
+    /**
+     * @struct Node
+     * @brief Internal node, or leaf if symbol >= 0
+     */
+    struct Node {
+        int16_t child[2] = {-1, -1};  ///< Next node for bit 0 and bit 1
+        int16_t symbol = -1;          ///< Decoded symbol at a leaf
+    };
+
+    std::vector<Node> nodes;  ///< Node 0 is the root
+
+    /**
+     * @brief Build the tree from the code table
+     */
+    HuffmanTree() {
+        nodes.reserve(2 * (HUFFMAN_EOS + 1));
+        nodes.emplace_back();
+        for (uint32_t symbol = 0; symbol <= HUFFMAN_EOS; ++symbol) {
+            uint32_t code = symbol < HUFFMAN_EOS ? HUFFMAN_CODES[symbol] : 0x3fffffff;
+            int length = symbol < HUFFMAN_EOS ? HUFFMAN_LENGTHS[symbol] : 30;
+            size_t node = 0;
+            for (int bit = length - 1; bit >= 0; --bit) {
+                int branch = (code >> bit) & 1;
+                if (nodes[node].child[branch] < 0) {
+                    nodes[node].child[branch] = static_cast<int16_t>(nodes.size());
+                    nodes.emplace_back();
+                }
+                node = static_cast<size_t>(nodes[node].child[branch]);
+            }
+            nodes[node].symbol = static_cast<int16_t>(symbol);
+        }
+    }
+};
+
+/**
+ * @brief Get the shared Huffman decoding tree
+ * @return Tree, built on first use
+ */
+const HuffmanTree& huffmanTree() {
+    static const HuffmanTree tree;
+    return tree;
+}
+
+/**
+ * @brief Decode a Huffman-coded string
+ * @param data Coded bytes
+ * @param out Decoded text is appended here
+ * @return False if the code is malformed or contains EOS
+ */
+bool huffmanDecode(std::string_view data, std::string& out) {
+    const std::vector<HuffmanTree::Node>& nodes = huffmanTree().nodes;
+    size_t node = 0;
+    int pendingBits = 0;     // Bits read since the last symbol
+    bool allOnes = true;     // Those bits were all 1, as padding must be
+    for (unsigned char byte : data) {
+        for (int bit = 7; bit >= 0; --bit) {
+            int branch = (byte >> bit) & 1;
+            int16_t next = nodes[node].child[branch];
+            if (next < 0) {
+                return false;
+            }
+            node = static_cast<size_t>(next);
+            pendingBits++;
+            allOnes = allOnes && branch == 1;
+            int16_t symbol = nodes[node].symbol;
+            if (symbol >= 0) {
+                if (symbol == static_cast<int16_t>(HUFFMAN_EOS)) {
+                    return false;
+                }
+                out.push_back(static_cast<char>(symbol));
+                node = 0;
+                pendingBits = 0;
+                allOnes = true;
+            }
+        }
+    }
+    // Padding is a prefix of EOS shorter than a byte
+    return pendingBits <= 7 && allOnes;
+}
+
+/**
+ * @brief Append an integer with an N-bit prefix
+ * @param value Integer
+ * @param prefixBits Bits of the first byte available to the integer
+ * @param flags Bits of the first byte above the prefix
+ * @param out Bytes are appended here
+ */
+void encodeInteger(uint64_t value, int prefixBits, uint8_t flags, std::string& out) {
+    uint64_t limit = (1ULL << prefixBits) - 1;
+    if (value < limit) {
+        out.push_back(static_cast<char>(flags | value));
+        return;
+    }
+    out.push_back(static_cast<char>(flags | limit));
+    value -= limit;
+    while (value >= 128) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Append a raw (not Huffman-coded) string literal
+ * @param text String
+ * @param out Bytes are appended here
+ */
+void encodeString(std::string_view text, std::string& out) {
+    encodeInteger(text.size(), 7, 0, out);
+    out.append(text.data(), text.size());
+}
+
+/**
+ * @brief Read an integer with an N-bit prefix
+ * @param data Header block
+ * @param position Read position, advanced past the integer
+ * @param prefixBits Bits of the first byte holding the integer
+ * @param value Set to the integer
+ * @return False if truncated or too large
+ */
+bool decodeInteger(std::string_view data, size_t& position, int prefixBits, uint64_t& value) {
+    if (position >= data.size()) {
+        return false;
+    }
+    uint64_t limit = (1ULL << prefixBits) - 1;
+    value = static_cast<unsigned char>(data[position++]) & limit;
+    if (value < limit) {
+        return true;
+    }
+    for (int shift = 0; shift <= 28; shift += 7) {
+        if (position >= data.size()) {
+            return false;
+        }
+        unsigned char byte = static_cast<unsigned char>(data[position++]);
+        value += static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Read a string literal
+ * @param data Header block
+ * @param position Read position, advanced past the string
+ * @param out Set to the decoded string
+ * @return False if truncated or badly coded
+ */
+bool decodeString(std::string_view data, size_t& position, std::string& out) {
+    if (position >= data.size()) {
+        return false;
+    }
+    bool huffman = (static_cast<unsigned char>(data[position]) & 0x80) != 0;
+    uint64_t length;
+    if (!decodeInteger(data, position, 7, length) || length > data.size() - position) {
+        return false;
+    }
+    std::string_view text = data.substr(position, static_cast<size_t>(length));
+    position += static_cast<size_t>(length);
+    out.clear();
+    if (huffman) {
+        return huffmanDecode(text, out);
+    }
+    out.assign(text.data(), text.size());
+    return true;
+}
+
+/**
+ * @brief Find the first static table entry with a name
+ * @param name Lowercase field name
+ * @return 1-based index, 0 if the name is not in the table
+ */
+size_t staticNameIndex(std::string_view name) {
+    static const std::unordered_map<std::string_view, size_t> index = [] {
+        std::unordered_map<std::string_view, size_t> names;
+        for (size_t i = STATIC_TABLE_SIZE; i-- > 0;) {
+            names[STATIC_TABLE[i].name] = i + 1;
+        }
+        return names;
+    }();
+    auto it = index.find(name);
+    return it != index.end() ? it->second : 0;
+}
+
+/**
+ * @brief Check whether a field must never be indexed
+ * @param name Lowercase field name
+ * @return True for credentials
+ */
+bool isSensitive(std::string_view name) {
+    return name == "authorization" || name == "proxy-authorization" || name == "cookie" || name == "set-cookie";
+}
+
+} // namespace
+
+/**
+ * @brief Append one field to a header block
+ * @param name Lowercase field name
+ * @param value Field value
+ * @param block Header block to append to
+ */
+void HpackEncoder::encode(std::string_view name, std::string_view value, std::string& block) {
+    size_t index = staticNameIndex(name);
+    if (index > 0) {
+        // Entries sharing a name are adjacent, so an exact match is close by
+        for (size_t i = index; i <= STATIC_TABLE_SIZE && name == STATIC_TABLE[i - 1].name; ++i) {
+            if (value == STATIC_TABLE[i - 1].value && !value.empty()) {
+                encodeInteger(i, 7, 0x80, block);
+                return;
+            }
+        }
+    }
+    encodeInteger(index, 4, isSensitive(name) ? 0x10 : 0x00, block);
+    if (index == 0) {
+        encodeString(name, block);
+    }
+    encodeString(value, block);
+}
+
+/**
+ * @brief Append the :status pseudo-header of a response
+ * @param status Status code, 100 to 999
+ * @param block Header block to append to
+ */
+void HpackEncoder::encodeStatus(int status, std::string& block) {
+    char digits[3] = {static_cast<char>('0' + status / 100 % 10), static_cast<char>('0' + status / 10 % 10),
+                      static_cast<char>('0' + status % 10)};
+    encode(":status", std::string_view(digits, 3), block);
+}
+
+/**
+ * @brief Create a decoder with an empty dynamic table
+ * @param tableLimit SETTINGS_HEADER_TABLE_SIZE advertised to the peer
+ * @param listLimit Largest decoded header list accepted, in bytes
+ */
+HpackDecoder::HpackDecoder(size_t tableLimit, size_t listLimit)
+    : tableSize(0), maxTableSize(tableLimit), settingsLimit(tableLimit), maxListSize(listLimit) {}
+
+/**
+ * @brief Evict entries until the table fits a limit
+ * @param limit Size limit
+ */
+void HpackDecoder::evict(size_t limit) {
+    while (tableSize > limit && !dynamicTable.empty()) {
+        const HpackField& oldest = dynamicTable.back();
+        tableSize -= oldest.name.size() + oldest.value.size() + ENTRY_OVERHEAD;
+        dynamicTable.pop_back();
+    }
+}
+
+/**
+ * @brief Add an entry, evicting old ones to fit
+ * @param name Field name
+ * @param value Field value
+ */
+void HpackDecoder::insert(std::string_view name, std::string_view value) {
+    size_t size = name.size() + value.size() + ENTRY_OVERHEAD;
+    if (size > maxTableSize) {
+        // An entry larger than the table empties it and is not added
+        evict(0);
+        return;
+    }
+    evict(maxTableSize - size);
+    dynamicTable.push_front(HpackField{std::string(name), std::string(value)});
+    tableSize += size;
+}
+
+/**
+ * @brief Look up a field by table index
+ * @param index 1-based index across the static and dynamic tables
+ * @param name Set to the field name
+ * @param value Set to the field value
+ * @return False if the index is out of range
+ */
+bool HpackDecoder::lookup(uint64_t index, std::string_view& name, std::string_view& value) const {
+    if (index == 0) {
+        return false;
+    }
+    if (index <= STATIC_TABLE_SIZE) {
+        name = STATIC_TABLE[index - 1].name;
+        value = STATIC_TABLE[index - 1].value;
+        return true;
+    }
+    uint64_t dynamic = index - STATIC_TABLE_SIZE - 1;
+    if (dynamic >= dynamicTable.size()) {
+        return false;
+    }
+    name = dynamicTable[static_cast<size_t>(dynamic)].name;
+    value = dynamicTable[static_cast<size_t>(dynamic)].value;
+    return true;
+}
+
+/**
+ * @brief Decode a complete header block
+ * @param block Header block fragments joined together
+ * @param fields Decoded fields are appended here
+ * @return False if the block is malformed (a connection error)
+ */
+bool HpackDecoder::decode(std::string_view block, std::vector<HpackField>& fields) {
+    size_t position = 0;
+    size_t listSize = 0;
+    bool fieldSeen = false;
+    std::string name;
+    std::string value;
+    while (position < block.size()) {
+        unsigned char first = static_cast<unsigned char>(block[position]);
+        uint64_t index;
+        if (first & 0x80) {
+            // Indexed field
+            std::string_view tableName;
+            std::string_view tableValue;
+            if (!decodeInteger(block, position, 7, index) || !lookup(index, tableName, tableValue)) {
+                return false;
+            }
+            name.assign(tableName.data(), tableName.size());
+            value.assign(tableValue.data(), tableValue.size());
+        } else if ((first & 0xe0) == 0x20) {
+            // Dynamic table size update, only before the first field
+            uint64_t size;
+            if (fieldSeen || !decodeInteger(block, position, 5, size) || size > settingsLimit) {
+                return false;
+            }
+            maxTableSize = static_cast<size_t>(size);
+            evict(maxTableSize);
+            continue;
+        } else {
+            // Literal: with incremental indexing (01), without (0000) or never indexed (0001)
+            bool indexing = (first & 0x40) != 0;
+            if (!decodeInteger(block, position, indexing ? 6 : 4, index)) {
+                return false;
+            }
+            if (index > 0) {
+                std::string_view tableName;
+                std::string_view tableValue;
+                if (!lookup(index, tableName, tableValue)) {
+                    return false;
+                }
+                name.assign(tableName.data(), tableName.size());
+            } else if (!decodeString(block, position, name)) {
+                return false;
+            }
+            if (!decodeString(block, position, value)) {
+                return false;
+            }
+            if (indexing) {
+                insert(name, value);
+            }
+        }
+        fieldSeen = true;
+        listSize += name.size() + value.size() + ENTRY_OVERHEAD;
+        if (listSize > maxListSize) {
+            return false;
+        }
+        fields.push_back(HpackField{name, value});
+    }
+    return true;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file Hpack.h
+ * @brief HPACK header compression for HTTP/2 (RFC 7541)
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef HPACK_H
+#define HPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct HpackField
+ * @brief One decoded header field
+ */
+struct HpackField {
+    std::string name;   ///< Lowercase field name, pseudo-headers included
+    std::string value;  ///< Field value
+};
+
+/**
+ * @class HpackEncoder
+ * @brief Stateless HPACK encoder with a static-table fast path
+ *
+ * Fields that match a static table entry exactly (":method: GET",
+ * ":path: /", ":scheme: http", ":status: 200" and so on) are sent as
+ * one-byte indexes. Every other field is a literal that is never added
+ * to the dynamic table, naming a static table entry where one exists.
+ * The encoder therefore keeps no state, never has to track the peer's
+ * table size, and costs one table lookup per field. Credentials are sent
+ * as never-indexed literals so intermediaries will not index them either.
+ * Strings are sent raw rather than Huffman-coded, trading a few bytes on
+ * the wire for no per-byte encoding work.
+ */
+class HpackEncoder {
+public:
+    /**
+     * @brief Append one field to a header block
+     * @param name Lowercase field name
+     * @param value Field value
+     * @param block Header block to append to
+     */
+    static void encode(std::string_view name, std::string_view value, std::string& block);
+
+    /**
+     * @brief Append the :status pseudo-header of a response
+     * @param status Status code, 100 to 999
+     * @param block Header block to append to
+     */
+    static void encodeStatus(int status, std::string& block);
+};
+
+/**
+ * @class HpackDecoder
+ * @brief HPACK decoder for one connection direction
+ *
+ * Keeps the dynamic table the peer's encoder fills and decodes indexed
+ * fields, all literal forms, table size updates and Huffman-coded
+ * strings. Header blocks must be decoded in the order they arrive,
+ * including blocks of streams that are no longer wanted.
+ */
+class HpackDecoder {
+private:
+    std::deque<HpackField> dynamicTable;  ///< Newest entry first
+    size_t tableSize;                     ///< Size of the entries, with 32 bytes overhead each
+    size_t maxTableSize;                  ///< Current limit set by the peer's size updates
+    size_t settingsLimit;                 ///< Largest limit the peer may set
+    size_t maxListSize;                   ///< Largest decoded header list accepted
+
+    /**
+     * @brief Add an entry, evicting old ones to fit
+     * @param name Field name
+     * @param value Field value
+     */
+    void insert(std::string_view name, std::string_view value);
+
+    /**
+     * @brief Evict entries until the table fits a limit
+     * @param limit Size limit
+     */
+    void evict(size_t limit);
+
+    /**
+     * @brief Look up a field by table index
+     * @param index 1-based index across the static and dynamic tables
+     * @param name Set to the field name
+     * @param value Set to the field value
+     * @return False if the index is out of range
+     */
+    bool lookup(uint64_t index, std::string_view& name, std::string_view& value) const;
+
+public:
+    /**
+     * @brief Create a decoder with an empty dynamic table
+     * @param tableLimit SETTINGS_HEADER_TABLE_SIZE advertised to the peer
+     * @param listLimit Largest decoded header list accepted, in bytes
+     */
+    explicit HpackDecoder(size_t tableLimit = 4096, size_t listLimit = 64 * 1024);
+
+    /**
+     * @brief Decode a complete header block
+     * @param block Header block fragments joined together
+     * @param fields Decoded fields are appended here
+     * @return False if the block is malformed (a connection error)
+     */
+    bool decode(std::string_view block, std::vector<HpackField>& fields);
+};
+
+#endif // HPACK_H
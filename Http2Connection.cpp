@@ -0,0 +1,762 @@
+/**
+ * @file Http2Connection.cpp
+ * @brief Implementation file for the Http2Connection class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Http2Connection.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";  ///< Client connection preface
+const size_t FRAME_HEADER = 9;                   ///< Bytes of a frame header
+const uint32_t MAX_FRAME_SIZE = 16384;           ///< Largest frame accepted, the protocol default
+const size_t MAX_HEADER_BLOCK = 256 * 1024;      ///< Largest header block accepted across CONTINUATIONs
+const int64_t DEFAULT_WINDOW = 65535;            ///< Initial flow-control window of the protocol
+const int64_t LOCAL_WINDOW = 1 << 24;            ///< Receive window this side advertises
+const int64_t MAX_WINDOW = 0x7fffffff;           ///< Largest legal flow-control window
+const uint32_t MAX_STREAM_ID = 0x7fffffff;       ///< Largest stream identifier
+const uint32_t ASSUMED_STREAM_LIMIT = 100;       ///< Peer stream limit assumed until its SETTINGS arrive
+
+const uint8_t FRAME_DATA = 0x0;
+const uint8_t FRAME_HEADERS = 0x1;
+const uint8_t FRAME_PRIORITY = 0x2;
+const uint8_t FRAME_RST_STREAM = 0x3;
+const uint8_t FRAME_SETTINGS = 0x4;
+const uint8_t FRAME_PUSH_PROMISE = 0x5;
+const uint8_t FRAME_PING = 0x6;
+const uint8_t FRAME_GOAWAY = 0x7;
+const uint8_t FRAME_WINDOW_UPDATE = 0x8;
+const uint8_t FRAME_CONTINUATION = 0x9;
+
+const uint8_t FLAG_END_STREAM = 0x1;   ///< Also ACK on SETTINGS and PING
+const uint8_t FLAG_ACK = 0x1;
+const uint8_t FLAG_END_HEADERS = 0x4;
+const uint8_t FLAG_PADDED = 0x8;
+const uint8_t FLAG_PRIORITY = 0x20;
+
+const uint16_t SETTINGS_ENABLE_PUSH = 0x2;
+const uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+const uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+const uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+
+/**
+ * @brief Read a big-endian 32-bit integer
+ * @param bytes Four bytes
+ * @return Integer
+ */
+uint32_t readU32(const char* bytes) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(bytes);
+    return (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | uint32_t(b[3]);
+}
+
+/**
+ * @brief Append a big-endian 32-bit integer
+ * @param value Integer
+ * @param out Bytes are appended here
+ */
+void appendU32(uint32_t value, std::string& out) {
+    char bytes[4] = {static_cast<char>(value >> 24), static_cast<char>(value >> 16), static_cast<char>(value >> 8),
+                     static_cast<char>(value)};
+    out.append(bytes, 4);
+}
+
+/**
+ * @brief Append one SETTINGS parameter
+ * @param id Parameter identifier
+ * @param value Parameter value
+ * @param out Bytes are appended here
+ */
+void appendSetting(uint16_t id, uint32_t value, std::string& out) {
+    out.push_back(static_cast<char>(id >> 8));
+    out.push_back(static_cast<char>(id));
+    appendU32(value, out);
+}
+
+/**
+ * @brief Remove the padding of a PADDED frame
+ * @param flags Frame flags
+ * @param payload Frame payload
+ * @param content Set to the payload without padding
+ * @return False if the padding is longer than the payload
+ */
+bool stripPadding(uint8_t flags, std::string_view payload, std::string_view& content) {
+    content = payload;
+    if ((flags & FLAG_PADDED) == 0) {
+        return true;
+    }
+    if (payload.empty()) {
+        return false;
+    }
+    size_t padding = static_cast<unsigned char>(payload[0]);
+    if (padding >= payload.size()) {
+        return false;
+    }
+    content = payload.substr(1, payload.size() - 1 - padding);
+    return true;
+}
+
+/**
+ * @brief Check whether a response header block is an interim 1xx response
+ * @param fields Decoded fields
+ * @return True if :status is 1xx
+ */
+bool isInterim(const std::vector<HpackField>& fields) {
+    for (const HpackField& field : fields) {
+        if (field.name == ":status") {
+            return field.value.size() == 3 && field.value[0] == '1';
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * @brief Create a connection that has exchanged nothing yet
+ * @param side Which end this is
+ * @param maxStreams Concurrent stream limit: a cap for the client, advertised by the server
+ */
+Http2Connection::Http2Connection(Http2Role side, uint32_t maxStreams)
+    : role(side), streamLimit(std::max<uint32_t>(1, maxStreams)), peerStreamLimit(ASSUMED_STREAM_LIMIT),
+      nextStreamID(side == Http2Role::CLIENT ? 1 : 2), lastPeerStream(0), peerInitialWindow(DEFAULT_WINDOW),
+      peerMaxFrame(MAX_FRAME_SIZE), connectionSendWindow(DEFAULT_WINDOW), connectionReceiveWindow(DEFAULT_WINDOW),
+      connectionUnacked(0), prefaceReceived(side == Http2Role::CLIENT), settingsReceived(false), goingAway(false),
+      headerStream(0), headerEndStream(false), error(nullptr) {}
+
+/**
+ * @brief Append a frame
+ * @param output Bytes to send
+ * @param type Frame type
+ * @param flags Frame flags
+ * @param streamID Stream, 0 for the connection
+ * @param payload Frame payload
+ */
+void Http2Connection::writeFrame(std::string& output, uint8_t type, uint8_t flags, uint32_t streamID,
+                                 std::string_view payload) {
+    size_t length = payload.size();
+    char header[FRAME_HEADER] = {static_cast<char>(length >> 16), static_cast<char>(length >> 8),
+                                 static_cast<char>(length), static_cast<char>(type), static_cast<char>(flags)};
+    output.append(header, 5);
+    appendU32(streamID, output);
+    output.append(payload.data(), payload.size());
+}
+
+/**
+ * @brief Append a WINDOW_UPDATE frame
+ * @param output Bytes to send
+ * @param streamID Stream, 0 for the connection
+ * @param increment Window increment
+ */
+void Http2Connection::writeWindowUpdate(std::string& output, uint32_t streamID, uint32_t increment) {
+    std::string payload;
+    appendU32(increment, payload);
+    writeFrame(output, FRAME_WINDOW_UPDATE, 0, streamID, payload);
+}
+
+/**
+ * @brief Append a header block as HEADERS and CONTINUATION frames
+ * @param output Bytes to send
+ * @param streamID Stream
+ * @param block Encoded header block
+ * @param endStream Whether the block ends the stream
+ */
+void Http2Connection::writeHeaders(std::string& output, uint32_t streamID, std::string_view block,
+                                   bool endStream) const {
+    size_t first = std::min<size_t>(block.size(), peerMaxFrame);
+    uint8_t flags = endStream ? FLAG_END_STREAM : 0;
+    if (first == block.size()) {
+        flags |= FLAG_END_HEADERS;
+    }
+    writeFrame(output, FRAME_HEADERS, flags, streamID, block.substr(0, first));
+    for (size_t position = first; position < block.size();) {
+        size_t chunk = std::min<size_t>(block.size() - position, peerMaxFrame);
+        position += chunk;
+        writeFrame(output, FRAME_CONTINUATION, position == block.size() ? FLAG_END_HEADERS : 0, streamID,
+                   block.substr(position - chunk, chunk));
+    }
+}
+
+/**
+ * @brief Send as much of a stream's body as the windows allow
+ * @param streamID Stream
+ * @param stream Stream state
+ * @param output Bytes to send
+ */
+void Http2Connection::sendData(uint32_t streamID, Stream& stream, std::string& output) {
+    while (stream.sent < stream.outgoing.size()) {
+        int64_t allowed = std::min<int64_t>({stream.sendWindow, connectionSendWindow, peerMaxFrame});
+        if (allowed <= 0) {
+            return;
+        }
+        size_t chunk = std::min<size_t>(static_cast<size_t>(allowed), stream.outgoing.size() - stream.sent);
+        bool last = stream.sent + chunk == stream.outgoing.size();
+        writeFrame(output, FRAME_DATA, last ? FLAG_END_STREAM : 0, streamID,
+                   std::string_view(stream.outgoing).substr(stream.sent, chunk));
+        stream.sent += chunk;
+        stream.sendWindow -= static_cast<int64_t>(chunk);
+        connectionSendWindow -= static_cast<int64_t>(chunk);
+    }
+    stream.outgoing.clear();
+    stream.outgoing.shrink_to_fit();
+    stream.sent = 0;
+    stream.localClosed = true;
+}
+
+/**
+ * @brief Send waiting bodies after the windows grew
+ * @param output Bytes to send
+ */
+void Http2Connection::sendBlocked(std::string& output) {
+    std::vector<uint32_t> finished;
+    for (auto& entry : streams) {
+        Stream& stream = entry.second;
+        if (stream.outgoing.empty() || connectionSendWindow <= 0) {
+            continue;
+        }
+        sendData(entry.first, stream, output);
+        if (stream.localClosed && stream.remoteClosed) {
+            finished.push_back(entry.first);
+        }
+    }
+    for (uint32_t id : finished) {
+        streams.erase(id);
+    }
+}
+
+/**
+ * @brief Forget a stream once both ends have closed it
+ * @param streamID Stream
+ */
+void Http2Connection::closeIfDone(uint32_t streamID) {
+    auto it = streams.find(streamID);
+    if (it != streams.end() && it->second.localClosed && it->second.remoteClosed) {
+        streams.erase(it);
+    }
+}
+
+/**
+ * @brief Hand a stream's message to the caller
+ * @param streamID Stream
+ * @param stream Stream state
+ * @param output Bytes to send
+ * @param messages Receives the message
+ */
+void Http2Connection::complete(uint32_t streamID, Stream& stream, std::string& output,
+                               std::vector<Http2Message>& messages) {
+    Http2Message message;
+    message.streamID = streamID;
+    message.tag = stream.tag;
+    message.headers = std::move(stream.headers);
+    message.body = std::move(stream.body);
+    messages.push_back(std::move(message));
+    stream.delivered = true;
+    if (role == Http2Role::CLIENT && !stream.localClosed) {
+        // The response came before the whole request body; stop sending it
+        std::string payload;
+        appendU32(static_cast<uint32_t>(Http2Error::NO_ERROR), payload);
+        writeFrame(output, FRAME_RST_STREAM, 0, streamID, payload);
+        stream.localClosed = true;
+    }
+    closeIfDone(streamID);
+}
+
+/**
+ * @brief Reset a stream because of a stream error and report it
+ * @param streamID Stream
+ * @param code Error code
+ * @param output Bytes to send
+ * @param messages Receives a reset message if the stream was open
+ */
+void Http2Connection::abortStream(uint32_t streamID, Http2Error code, std::string& output,
+                                  std::vector<Http2Message>& messages) {
+    auto it = streams.find(streamID);
+    if (it != streams.end()) {
+        Http2Message message;
+        message.streamID = streamID;
+        message.tag = it->second.tag;
+        message.reset = true;
+        message.error = code;
+        messages.push_back(std::move(message));
+    }
+    resetStream(streamID, code, output);
+}
+
+/**
+ * @brief Fail the connection with GOAWAY
+ * @param code Error code
+ * @param reason Description kept for getError()
+ * @param output Bytes to send
+ * @return False, for the caller to return
+ */
+bool Http2Connection::fail(Http2Error code, const char* reason, std::string& output) {
+    if (error == nullptr) {
+        error = reason;
+        goingAway = true;
+        std::string payload;
+        appendU32(lastPeerStream, payload);
+        appendU32(static_cast<uint32_t>(code), payload);
+        writeFrame(output, FRAME_GOAWAY, 0, 0, payload);
+    }
+    return false;
+}
+
+/**
+ * @brief Decode and apply a complete header block
+ * @param output Bytes to send
+ * @param messages Receives a message if the block ends its stream
+ * @return False on a connection error
+ */
+bool Http2Connection::finishHeaders(std::string& output, std::vector<Http2Message>& messages) {
+    uint32_t id = headerStream;
+    bool endStream = headerEndStream;
+    headerStream = 0;
+    // Every block is decoded, wanted or not, to keep the HPACK table in step
+    std::vector<HpackField> fields;
+    bool decoded = decoder.decode(headerBlock, fields);
+    headerBlock.clear();
+    if (!decoded) {
+        return fail(Http2Error::COMPRESSION_ERROR, "malformed header block", output);
+    }
+    auto it = streams.find(id);
+    if (role == Http2Role::SERVER && it == streams.end()) {
+        if ((id & 1) == 0 || id <= lastPeerStream) {
+            return fail(Http2Error::PROTOCOL_ERROR, "HEADERS on a closed or server stream", output);
+        }
+        lastPeerStream = id;
+        if (goingAway || streams.size() >= streamLimit) {
+            resetStream(id, Http2Error::REFUSED_STREAM, output);
+            return true;
+        }
+        Stream& stream = streams[id];
+        stream.sendWindow = peerInitialWindow;
+        stream.receiveWindow = LOCAL_WINDOW;
+        stream.headers = std::move(fields);
+        stream.headersReceived = true;
+        if (endStream) {
+            stream.remoteClosed = true;
+            complete(id, stream, output, messages);
+        }
+        return true;
+    }
+    if (it == streams.end() || it->second.remoteClosed) {
+        return true;  // A stream this side already reset
+    }
+    Stream& stream = it->second;
+    if (!stream.headersReceived) {
+        if (isInterim(fields)) {
+            return !endStream || fail(Http2Error::PROTOCOL_ERROR, "interim response ends the stream", output);
+        }
+        stream.headers = std::move(fields);
+        stream.headersReceived = true;
+    }
+    // A second block is trailers, which are dropped
+    if (endStream) {
+        stream.remoteClosed = true;
+        complete(id, stream, output, messages);
+    }
+    return true;
+}
+
+/**
+ * @brief Handle one complete frame
+ * @param type Frame type
+ * @param flags Frame flags
+ * @param streamID Stream
+ * @param payload Frame payload
+ * @param output Bytes to send
+ * @param messages Receives completed messages
+ * @return False on a connection error
+ */
+bool Http2Connection::handleFrame(uint8_t type, uint8_t flags, uint32_t streamID, std::string_view payload,
+                                  std::string& output, std::vector<Http2Message>& messages) {
+    if (headerStream != 0 && (type != FRAME_CONTINUATION || streamID != headerStream)) {
+        return fail(Http2Error::PROTOCOL_ERROR, "header block interrupted", output);
+    }
+    if (!settingsReceived && type != FRAME_SETTINGS) {
+        return fail(Http2Error::PROTOCOL_ERROR, "first frame is not SETTINGS", output);
+    }
+    std::string_view content;
+    switch (type) {
+    case FRAME_DATA: {
+        if (streamID == 0 || !stripPadding(flags, payload, content)) {
+            return fail(Http2Error::PROTOCOL_ERROR, "malformed DATA", output);
+        }
+        // Flow control counts the whole payload, padding included
+        int64_t size = static_cast<int64_t>(payload.size());
+        if (size > connectionReceiveWindow) {
+            return fail(Http2Error::FLOW_CONTROL_ERROR, "connection window exceeded", output);
+        }
+        connectionReceiveWindow -= size;
+        connectionUnacked += static_cast<uint32_t>(size);
+        if (connectionUnacked >= LOCAL_WINDOW / 2) {
+            writeWindowUpdate(output, 0, connectionUnacked);
+            connectionReceiveWindow += connectionUnacked;
+            connectionUnacked = 0;
+        }
+        auto it = streams.find(streamID);
+        if (it == streams.end()) {
+            return true;  // A stream this side already reset
+        }
+        Stream& stream = it->second;
+        if (stream.remoteClosed) {
+            abortStream(streamID, Http2Error::STREAM_CLOSED, output, messages);
+            return true;
+        }
+        if (!stream.headersReceived) {
+            return fail(Http2Error::PROTOCOL_ERROR, "DATA before HEADERS", output);
+        }
+        if (size > stream.receiveWindow) {
+            abortStream(streamID, Http2Error::FLOW_CONTROL_ERROR, output, messages);
+            return true;
+        }
+        stream.receiveWindow -= size;
+        stream.body.append(content.data(), content.size());
+        if (flags & FLAG_END_STREAM) {
+            stream.remoteClosed = true;
+            complete(streamID, stream, output, messages);
+            return true;
+        }
+        stream.receivedUnacked += static_cast<uint32_t>(size);
+        if (stream.receivedUnacked >= LOCAL_WINDOW / 2) {
+            writeWindowUpdate(output, streamID, stream.receivedUnacked);
+            stream.receiveWindow += stream.receivedUnacked;
+            stream.receivedUnacked = 0;
+        }
+        return true;
+    }
+    case FRAME_HEADERS:
+        if (streamID == 0 || !stripPadding(flags, payload, content) ||
+            ((flags & FLAG_PRIORITY) && content.size() < 5)) {
+            return fail(Http2Error::PROTOCOL_ERROR, "malformed HEADERS", output);
+        }
+        if (flags & FLAG_PRIORITY) {
+            content.remove_prefix(5);
+        }
+        headerBlock.assign(content.data(), content.size());
+        headerStream = streamID;
+        headerEndStream = (flags & FLAG_END_STREAM) != 0;
+        return (flags & FLAG_END_HEADERS) == 0 || finishHeaders(output, messages);
+    case FRAME_CONTINUATION:
+        if (headerStream == 0) {
+            return fail(Http2Error::PROTOCOL_ERROR, "unexpected CONTINUATION", output);
+        }
+        if (headerBlock.size() + payload.size() > MAX_HEADER_BLOCK) {
+            return fail(Http2Error::ENHANCE_YOUR_CALM, "header block too large", output);
+        }
+        headerBlock.append(payload.data(), payload.size());
+        return (flags & FLAG_END_HEADERS) == 0 || finishHeaders(output, messages);
+    case FRAME_PRIORITY:
+        // Streams are served in arrival order; priorities are only validated
+        if (streamID == 0 || payload.size() != 5) {
+            return fail(Http2Error::PROTOCOL_ERROR, "malformed PRIORITY", output);
+        }
+        return true;
+    case FRAME_RST_STREAM: {
+        if (streamID == 0 || payload.size() != 4) {
+            return fail(Http2Error::PROTOCOL_ERROR, "malformed RST_STREAM", output);
+        }
+        auto it = streams.find(streamID);
+        if (it != streams.end()) {
+            Http2Message message;
+            message.streamID = streamID;
+            message.tag = it->second.tag;
+            message.reset = true;
+            message.error = static_cast<Http2Error>(readU32(payload.data()));
+            messages.push_back(std::move(message));
+            streams.erase(it);
+        }
+        return true;
+    }
+    case FRAME_SETTINGS:
+        if (streamID != 0) {
+            return fail(Http2Error::PROTOCOL_ERROR, "SETTINGS on a stream", output);
+        }
+        if (flags & FLAG_ACK) {
+            return payload.empty() || fail(Http2Error::FRAME_SIZE_ERROR, "SETTINGS ack with payload", output);
+        }
+        if (payload.size() % 6 != 0) {
+            return fail(Http2Error::FRAME_SIZE_ERROR, "malformed SETTINGS", output);
+        }
+        if (!settingsReceived) {
+            // The protocol's default is no limit; 100 was only a guess for the first round trip
+            peerStreamLimit = UINT32_MAX;
+        }
+        for (size_t position = 0; position < payload.size(); position += 6) {
+            uint16_t id = static_cast<uint16_t>((static_cast<unsigned char>(payload[position]) << 8) |
+                                                static_cast<unsigned char>(payload[position + 1]));
+            uint32_t value = readU32(payload.data() + position + 2);
+            if (id == SETTINGS_ENABLE_PUSH && value > 1) {
+                return fail(Http2Error::PROTOCOL_ERROR, "invalid SETTINGS_ENABLE_PUSH", output);
+            } else if (id == SETTINGS_MAX_CONCURRENT_STREAMS) {
+                peerStreamLimit = value;
+            } else if (id == SETTINGS_INITIAL_WINDOW_SIZE) {
+                if (value > MAX_WINDOW) {
+                    return fail(Http2Error::FLOW_CONTROL_ERROR, "invalid SETTINGS_INITIAL_WINDOW_SIZE", output);
+                }
+                int64_t delta = static_cast<int64_t>(value) - static_cast<int64_t>(peerInitialWindow);
+                for (auto& entry : streams) {
+                    entry.second.sendWindow += delta;
+                    if (entry.second.sendWindow > MAX_WINDOW) {
+                        return fail(Http2Error::FLOW_CONTROL_ERROR, "stream window overflow", output);
+                    }
+                }
+                peerInitialWindow = value;
+            } else if (id == SETTINGS_MAX_FRAME_SIZE) {
+                if (value < MAX_FRAME_SIZE || value > 0xffffff) {
+                    return fail(Http2Error::PROTOCOL_ERROR, "invalid SETTINGS_MAX_FRAME_SIZE", output);
+                }
+                peerMaxFrame = value;
+            }
+            // The header table size is irrelevant: the encoder never indexes
+        }
+        settingsReceived = true;
+        writeFrame(output, FRAME_SETTINGS, FLAG_ACK, 0, std::string_view());
+        sendBlocked(output);
+        return true;
+    case FRAME_PUSH_PROMISE:
+        return fail(Http2Error::PROTOCOL_ERROR, "PUSH_PROMISE with push disabled", output);
+    case FRAME_PING:
+        if (streamID != 0 || payload.size() != 8) {
+            return fail(Http2Error::FRAME_SIZE_ERROR, "malformed PING", output);
+        }
+        if ((flags & FLAG_ACK) == 0) {
+            writeFrame(output, FRAME_PING, FLAG_ACK, 0, payload);
+        }
+        return true;
+    case FRAME_GOAWAY: {
+        if (streamID != 0 || payload.size() < 8) {
+            return fail(Http2Error::FRAME_SIZE_ERROR, "malformed GOAWAY", output);
+        }
+        goingAway = true;
+        uint32_t lastStream = readU32(payload.data()) & MAX_STREAM_ID;
+        if (role == Http2Role::CLIENT) {
+            // Streams above the last one were never processed and may be retried
+            for (auto it = streams.begin(); it != streams.end();) {
+                if (it->first <= lastStream) {
+                    ++it;
+                    continue;
+                }
+                Http2Message message;
+                message.streamID = it->first;
+                message.tag = it->second.tag;
+                message.reset = true;
+                message.error = Http2Error::REFUSED_STREAM;
+                messages.push_back(std::move(message));
+                it = streams.erase(it);
+            }
+        }
+        return true;
+    }
+    case FRAME_WINDOW_UPDATE: {
+        if (payload.size() != 4) {
+            return fail(Http2Error::FRAME_SIZE_ERROR, "malformed WINDOW_UPDATE", output);
+        }
+        uint32_t increment = readU32(payload.data()) & MAX_STREAM_ID;
+        if (streamID == 0) {
+            if (increment == 0) {
+                return fail(Http2Error::PROTOCOL_ERROR, "zero WINDOW_UPDATE", output);
+            }
+            connectionSendWindow += increment;
+            if (connectionSendWindow > MAX_WINDOW) {
+                return fail(Http2Error::FLOW_CONTROL_ERROR, "connection window overflow", output);
+            }
+        } else {
+            auto it = streams.find(streamID);
+            if (it == streams.end()) {
+                return true;
+            }
+            it->second.sendWindow += increment;
+            if (increment == 0 || it->second.sendWindow > MAX_WINDOW) {
+                abortStream(streamID, increment == 0 ? Http2Error::PROTOCOL_ERROR : Http2Error::FLOW_CONTROL_ERROR,
+                            output, messages);
+                return true;
+            }
+        }
+        sendBlocked(output);
+        return true;
+    }
+    default:
+        return true;  // Unknown frame types are ignored
+    }
+}
+
+/**
+ * @brief Queue this side's opening frames
+ *
+ * The client sends the preface first. Both sides then send SETTINGS and
+ * a WINDOW_UPDATE enlarging the connection receive window.
+ * @param output Bytes to send
+ */
+void Http2Connection::start(std::string& output) {
+    std::string settings;
+    if (role == Http2Role::CLIENT) {
+        output.append(PREFACE, PREFACE_LENGTH);
+        appendSetting(SETTINGS_ENABLE_PUSH, 0, settings);
+    } else {
+        appendSetting(SETTINGS_MAX_CONCURRENT_STREAMS, streamLimit, settings);
+    }
+    appendSetting(SETTINGS_INITIAL_WINDOW_SIZE, static_cast<uint32_t>(LOCAL_WINDOW), settings);
+    writeFrame(output, FRAME_SETTINGS, 0, 0, settings);
+    writeWindowUpdate(output, 0, static_cast<uint32_t>(LOCAL_WINDOW - DEFAULT_WINDOW));
+    connectionReceiveWindow = LOCAL_WINDOW;
+}
+
+/**
+ * @brief Process received bytes
+ * @param data Received bytes not yet consumed
+ * @param consumed Set to the bytes used; a partial frame is left for the next call
+ * @param output Frames to send in reply are appended here
+ * @param messages Completed and reset streams are appended here
+ * @return False on a connection error: GOAWAY is in output and the connection should close
+ */
+bool Http2Connection::receive(std::string_view data, size_t& consumed, std::string& output,
+                              std::vector<Http2Message>& messages) {
+    consumed = 0;
+    if (error != nullptr) {
+        return false;
+    }
+    if (!prefaceReceived) {
+        if (!isPreface(data)) {
+            return data.empty() || fail(Http2Error::PROTOCOL_ERROR, "missing connection preface", output);
+        }
+        if (data.size() < PREFACE_LENGTH) {
+            return true;
+        }
+        consumed = PREFACE_LENGTH;
+        prefaceReceived = true;
+    }
+    while (data.size() - consumed >= FRAME_HEADER) {
+        const char* header = data.data() + consumed;
+        uint32_t length = readU32(header) >> 8;
+        uint8_t type = static_cast<uint8_t>(header[3]);
+        uint8_t flags = static_cast<uint8_t>(header[4]);
+        uint32_t streamID = readU32(header + 5) & MAX_STREAM_ID;
+        if (length > MAX_FRAME_SIZE) {
+            return fail(Http2Error::FRAME_SIZE_ERROR, "frame too large", output);
+        }
+        if (data.size() - consumed - FRAME_HEADER < length) {
+            break;
+        }
+        std::string_view payload = data.substr(consumed + FRAME_HEADER, length);
+        consumed += FRAME_HEADER + length;
+        if (!handleFrame(type, flags, streamID, payload, output, messages)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a request can be sent now
+ * @return True if under both stream limits and not going away
+ */
+bool Http2Connection::canOpenStream() const {
+    return role == Http2Role::CLIENT && !isGoingAway() && streams.size() < std::min(streamLimit, peerStreamLimit);
+}
+
+/**
+ * @brief Open a stream and send a request on it
+ * @param headerBlock HPACK-encoded request headers
+ * @param body Request body, empty for none
+ * @param tag Caller's tag, returned with the response
+ * @param output Bytes to send
+ * @return Stream ID
+ */
+uint32_t Http2Connection::submitRequest(std::string_view headerBlock, std::string_view body, uint64_t tag,
+                                        std::string& output) {
+    uint32_t id = nextStreamID;
+    nextStreamID += 2;
+    Stream& stream = streams[id];
+    stream.tag = tag;
+    stream.sendWindow = peerInitialWindow;
+    stream.receiveWindow = LOCAL_WINDOW;
+    writeHeaders(output, id, headerBlock, body.empty());
+    if (body.empty()) {
+        stream.localClosed = true;
+    } else {
+        stream.outgoing.assign(body.data(), body.size());
+        sendData(id, stream, output);
+    }
+    return id;
+}
+
+/**
+ * @brief Answer a stream's request
+ * @param streamID Stream whose request was received
+ * @param headerBlock HPACK-encoded response headers
+ * @param body Response body, empty for none
+ * @param output Bytes to send
+ * @return False if the stream is gone, reset by the peer
+ */
+bool Http2Connection::submitResponse(uint32_t streamID, std::string_view headerBlock, std::string_view body,
+                                     std::string& output) {
+    auto it = streams.find(streamID);
+    if (it == streams.end() || it->second.localClosed || error != nullptr) {
+        return false;
+    }
+    Stream& stream = it->second;
+    writeHeaders(output, streamID, headerBlock, body.empty());
+    if (body.empty()) {
+        stream.localClosed = true;
+    } else {
+        stream.outgoing.assign(body.data(), body.size());
+        sendData(streamID, stream, output);
+    }
+    closeIfDone(streamID);
+    return true;
+}
+
+/**
+ * @brief Abandon a stream with RST_STREAM
+ * @param streamID Stream
+ * @param code Error code
+ * @param output Bytes to send
+ */
+void Http2Connection::resetStream(uint32_t streamID, Http2Error code, std::string& output) {
+    std::string payload;
+    appendU32(static_cast<uint32_t>(code), payload);
+    writeFrame(output, FRAME_RST_STREAM, 0, streamID, payload);
+    streams.erase(streamID);
+}
+
+/**
+ * @brief Take every stream still open, as reset messages
+ *
+ * Used when the connection fails, so the caller can answer the
+ * requests that will never complete.
+ * @param messages Receives one reset message per stream
+ */
+void Http2Connection::takeOpenStreams(std::vector<Http2Message>& messages) {
+    for (auto& entry : streams) {
+        Http2Message message;
+        message.streamID = entry.first;
+        message.tag = entry.second.tag;
+        message.reset = true;
+        message.error = Http2Error::CANCEL;
+        messages.push_back(std::move(message));
+    }
+    streams.clear();
+}
+
+/**
+ * @brief Check whether no more streams will ever be opened
+ * @return True after GOAWAY, a connection error or stream ID exhaustion
+ */
+bool Http2Connection::isGoingAway() const {
+    return goingAway || error != nullptr || nextStreamID > MAX_STREAM_ID;
+}
+
+/**
+ * @brief Check whether received bytes are, or may become, the client preface
+ * @param data Bytes at the start of a connection
+ * @return True if data is a non-empty prefix of the preface or starts with all of it
+ */
+bool Http2Connection::isPreface(std::string_view data) {
+    size_t length = std::min(data.size(), PREFACE_LENGTH);
+    return length > 0 && std::memcmp(data.data(), PREFACE, length) == 0;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file Http2Connection.h
+ * @brief Header file for the Http2Connection class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef HTTP2CONNECTION_H
+#define HTTP2CONNECTION_H
+
+#include "Hpack.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @enum Http2Role
+ * @brief Which end of the connection this side is
+ */
+enum class Http2Role {
+    CLIENT,  ///< Sends the preface and opens odd-numbered streams
+    SERVER   ///< Accepts streams and answers them
+};
+
+/**
+ * @enum Http2Error
+ * @brief Error codes of RST_STREAM and GOAWAY frames (RFC 9113 section 7)
+ */
+enum class Http2Error : uint32_t {
+    NO_ERROR = 0x0,
+    PROTOCOL_ERROR = 0x1,
+    INTERNAL_ERROR = 0x2,
+    FLOW_CONTROL_ERROR = 0x3,
+    STREAM_CLOSED = 0x5,
+    FRAME_SIZE_ERROR = 0x6,
+    REFUSED_STREAM = 0x7,
+    CANCEL = 0x8,
+    COMPRESSION_ERROR = 0x9,
+    ENHANCE_YOUR_CALM = 0xb
+};
+
+/**
+ * @struct Http2Message
+ * @brief A complete request or response received on one stream
+ */
+struct Http2Message {
+    uint32_t streamID = 0;             ///< Stream the message arrived on
+    uint64_t tag = 0;                  ///< Caller's tag given to submitRequest(), 0 on the server
+    bool reset = false;                ///< The stream ended without a message
+    Http2Error error = Http2Error::NO_ERROR; ///< Why the stream was reset
+    std::vector<HpackField> headers;   ///< Header fields, pseudo-headers first
+    std::string body;                  ///< Body with DATA framing removed
+};
+
+/**
+ * @class Http2Connection
+ * @brief HTTP/2 framing, flow control and stream state of one connection
+ *
+ * A sans-I/O protocol engine: the caller reads bytes from its socket and
+ * passes them to receive(), which returns completed messages and appends
+ * any frames to send (acknowledgements, WINDOW_UPDATE, PING replies) to
+ * an output string the caller writes to the socket. Requests and
+ * responses are whole messages, buffered until END_STREAM.
+ *
+ * Both sides advertise 16 MB receive windows and top them up once half is
+ * used, so a stream's transfer is rarely stalled on flow control. Bodies
+ * are sent as far as the peer's windows allow and the rest goes out as
+ * the peer opens them. The client never opens more streams than the
+ * smaller of the peer's SETTINGS_MAX_CONCURRENT_STREAMS and its own
+ * limit; the server refuses streams beyond the limit it advertised.
+ *
+ * Cleartext only: the client speaks with prior knowledge (h2c) and the
+ * server recognises the connection preface. Server push is disabled.
+ */
+class Http2Connection {
+private:
+    /**
+     * @struct Stream
+     * @brief State of one open stream
+     */
+    struct Stream {
+        uint64_t tag = 0;              ///< Caller's tag
+        int64_t sendWindow = 0;        ///< Bytes the peer will still accept on this stream
+        int64_t receiveWindow = 0;     ///< Bytes this side will still accept on this stream
+        uint32_t receivedUnacked = 0;  ///< DATA bytes received since the last WINDOW_UPDATE
+        std::string outgoing;          ///< Body bytes not yet sent
+        size_t sent = 0;               ///< Bytes of outgoing already sent
+        bool localClosed = false;      ///< END_STREAM sent
+        bool remoteClosed = false;     ///< END_STREAM received
+        bool headersReceived = false;  ///< A final header block arrived
+        bool delivered = false;        ///< The message was handed to the caller
+        std::vector<HpackField> headers; ///< Received header fields
+        std::string body;              ///< Received body bytes
+    };
+
+    Http2Role role;                    ///< Which end this is
+    HpackDecoder decoder;              ///< Decoding state for the peer's header blocks
+    std::unordered_map<uint32_t, Stream> streams; ///< Open streams
+    uint32_t streamLimit;              ///< Local cap on concurrent streams
+    uint32_t peerStreamLimit;          ///< Peer's SETTINGS_MAX_CONCURRENT_STREAMS
+    uint32_t nextStreamID;             ///< Next stream this side opens
+    uint32_t lastPeerStream;           ///< Highest stream the peer opened
+    uint32_t peerInitialWindow;        ///< Peer's SETTINGS_INITIAL_WINDOW_SIZE
+    uint32_t peerMaxFrame;             ///< Peer's SETTINGS_MAX_FRAME_SIZE
+    int64_t connectionSendWindow;      ///< Bytes the peer will still accept on the connection
+    int64_t connectionReceiveWindow;   ///< Bytes this side will still accept on the connection
+    uint32_t connectionUnacked;        ///< DATA bytes received since the last connection WINDOW_UPDATE
+    bool prefaceReceived;              ///< The client preface was seen, or is not expected
+    bool settingsReceived;             ///< The peer's first SETTINGS frame was seen
+    bool goingAway;                    ///< GOAWAY was sent or received
+    std::string headerBlock;           ///< Fragments of a header block awaiting CONTINUATION
+    uint32_t headerStream;             ///< Stream of that block, 0 if none
+    bool headerEndStream;              ///< That block's HEADERS frame carried END_STREAM
+    const char* error;                 ///< Reason for the connection error, nullptr if none
+
+    /**
+     * @brief Append a frame
+     * @param output Bytes to send
+     * @param type Frame type
+     * @param flags Frame flags
+     * @param streamID Stream, 0 for the connection
+     * @param payload Frame payload
+     */
+    static void writeFrame(std::string& output, uint8_t type, uint8_t flags, uint32_t streamID,
+                           std::string_view payload);
+
+    /**
+     * @brief Append a WINDOW_UPDATE frame
+     * @param output Bytes to send
+     * @param streamID Stream, 0 for the connection
+     * @param increment Window increment
+     */
+    static void writeWindowUpdate(std::string& output, uint32_t streamID, uint32_t increment);
+
+    /**
+     * @brief Append a header block as HEADERS and CONTINUATION frames
+     * @param output Bytes to send
+     * @param streamID Stream
+     * @param block Encoded header block
+     * @param endStream Whether the block ends the stream
+     */
+    void writeHeaders(std::string& output, uint32_t streamID, std::string_view block, bool endStream) const;
+
+    /**
+     * @brief Send as much of a stream's body as the windows allow
+     * @param streamID Stream
+     * @param stream Stream state
+     * @param output Bytes to send
+     */
+    void sendData(uint32_t streamID, Stream& stream, std::string& output);
+
+    /**
+     * @brief Send waiting bodies after the windows grew
+     * @param output Bytes to send
+     */
+    void sendBlocked(std::string& output);
+
+    /**
+     * @brief Forget a stream once both ends have closed it
+     * @param streamID Stream
+     */
+    void closeIfDone(uint32_t streamID);
+
+    /**
+     * @brief Hand a stream's message to the caller
+     * @param streamID Stream
+     * @param stream Stream state
+     * @param output Bytes to send
+     * @param messages Receives the message
+     */
+    void complete(uint32_t streamID, Stream& stream, std::string& output, std::vector<Http2Message>& messages);
+
+    /**
+     * @brief Reset a stream because of a stream error and report it
+     * @param streamID Stream
+     * @param code Error code
+     * @param output Bytes to send
+     * @param messages Receives a reset message if the stream was open
+     */
+    void abortStream(uint32_t streamID, Http2Error code, std::string& output, std::vector<Http2Message>& messages);
+
+    /**
+     * @brief Fail the connection with GOAWAY
+     * @param code Error code
+     * @param reason Description kept for getError()
+     * @param output Bytes to send
+     * @return False, for the caller to return
+     */
+    bool fail(Http2Error code, const char* reason, std::string& output);
+
+    /**
+     * @brief Decode and apply a complete header block
+     * @param output Bytes to send
+     * @param messages Receives a message if the block ends its stream
+     * @return False on a connection error
+     */
+    bool finishHeaders(std::string& output, std::vector<Http2Message>& messages);
+
+    /**
+     * @brief Handle one complete frame
+     * @param type Frame type
+     * @param flags Frame flags
+     * @param streamID Stream
+     * @param payload Frame payload
+     * @param output Bytes to send
+     * @param messages Receives completed messages
+     * @return False on a connection error
+     */
+    bool handleFrame(uint8_t type, uint8_t flags, uint32_t streamID, std::string_view payload, std::string& output,
+                     std::vector<Http2Message>& messages);
+
+public:
+    static constexpr size_t PREFACE_LENGTH = 24;  ///< Bytes of the client connection preface
+
+    /**
+     * @brief Create a connection that has exchanged nothing yet
+     * @param side Which end this is
+     * @param maxStreams Concurrent stream limit: a cap for the client, advertised by the server
+     */
+    Http2Connection(Http2Role side, uint32_t maxStreams);
+
+    /**
+     * @brief Queue this side's opening frames
+     *
+     * The client sends the preface first. Both sides then send SETTINGS and
+     * a WINDOW_UPDATE enlarging the connection receive window.
+     * @param output Bytes to send
+     */
+    void start(std::string& output);
+
+    /**
+     * @brief Process received bytes
+     * @param data Received bytes not yet consumed
+     * @param consumed Set to the bytes used; a partial frame is left for the next call
+     * @param output Frames to send in reply are appended here
+     * @param messages Completed and reset streams are appended here
+     * @return False on a connection error: GOAWAY is in output and the connection should close
+     */
+    bool receive(std::string_view data, size_t& consumed, std::string& output, std::vector<Http2Message>& messages);
+
+    /**
+     * @brief Check whether a request can be sent now
+     * @return True if under both stream limits and not going away
+     */
+    bool canOpenStream() const;
+
+    /**
+     * @brief Open a stream and send a request on it
+     * @param headerBlock HPACK-encoded request headers
+     * @param body Request body, empty for none
+     * @param tag Caller's tag, returned with the response
+     * @param output Bytes to send
+     * @return Stream ID
+     */
+    uint32_t submitRequest(std::string_view headerBlock, std::string_view body, uint64_t tag, std::string& output);
+
+    /**
+     * @brief Answer a stream's request
+     * @param streamID Stream whose request was received
+     * @param headerBlock HPACK-encoded response headers
+     * @param body Response body, empty for none
+     * @param output Bytes to send
+     * @return False if the stream is gone, reset by the peer
+     */
+    bool submitResponse(uint32_t streamID, std::string_view headerBlock, std::string_view body, std::string& output);
+
+    /**
+     * @brief Abandon a stream with RST_STREAM
+     * @param streamID Stream
+     * @param code Error code
+     * @param output Bytes to send
+     */
+    void resetStream(uint32_t streamID, Http2Error code, std::string& output);
+
+    /**
+     * @brief Take every stream still open, as reset messages
+     *
+     * Used when the connection fails, so the caller can answer the
+     * requests that will never complete.
+     * @param messages Receives one reset message per stream
+     */
+    void takeOpenStreams(std::vector<Http2Message>& messages);
+
+    /**
+     * @brief Get the number of open streams
+     * @return Streams not yet completed or reset
+     */
+    size_t getOpenStreams() const { return streams.size(); }
+
+    /**
+     * @brief Check whether no more streams will ever be opened
+     * @return True after GOAWAY, a connection error or stream ID exhaustion
+     */
+    bool isGoingAway() const;
+
+    /**
+     * @brief Get the reason for the connection error
+     * @return Description, nullptr if none
+     */
+    const char* getError() const { return error; }
+
+    /**
+     * @brief Check whether received bytes are, or may become, the client preface
+     * @param data Bytes at the start of a connection
+     * @return True if data is a non-empty prefix of the preface or starts with all of it
+     */
+    static bool isPreface(std::string_view data);
+};
+
+#endif // HTTP2CONNECTION_H
@@ -0,0 +1,696 @@
+/**
+ * @file HttpParser.cpp
+ * @brief Implementation of the incremental HTTP/1.1 request parser
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "HttpParser.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const size_t NOT_FOUND = std::string_view::npos;
+
+/**
+ * @brief Find the blank line ending a header block
+ * @param data Buffer
+ * @param size Buffer length
+ * @param from First position that may start the terminator
+ * @return Position just past "\r\n\r\n", or NOT_FOUND
+ */
+size_t findHeaderEnd(const char* data, size_t size, size_t from) {
+    size_t i = from;
+#if defined(__SSE2__)
+    // Compare 16 bytes against '\r' at once and only inspect the hits
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; i + 16 + 3 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, cr)));
+        while (mask != 0) {
+            size_t hit = i + static_cast<size_t>(__builtin_ctz(mask));
+            if (std::memcmp(data + hit, "\r\n\r\n", 4) == 0) {
+                return hit + 4;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i + 4 <= size; ++i) {
+        if (data[i] == '\r' && std::memcmp(data + i, "\r\n\r\n", 4) == 0) {
+            return i + 4;
+        }
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * @brief Find the end of a CRLF-terminated line
+ * @param data Text
+ * @param from Start of the line
+ * @return Position of the '\n', or NOT_FOUND
+ */
+size_t findLineEnd(std::string_view data, size_t from) {
+    const void* hit = std::memchr(data.data() + from, '\n', data.size() - from);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - data.data()) : NOT_FOUND;
+}
+
+/**
+ * @brief Compare a header name with a lowercase name, ignoring case
+ * @param name Header name as sent
+ * @param lower Lowercase name
+ * @return True if equal
+ */
+bool nameIs(std::string_view name, std::string_view lower) {
+    if (name.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        if ((name[i] | 0x20) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check for an RFC 9110 token character
+ * @param c Character
+ * @return True if c may appear in a method or header name
+ */
+bool isTokenChar(char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+        return true;
+    }
+    return c != '\0' && std::strchr("!#$%&'*+-.^_`|~", c) != nullptr;
+}
+
+/**
+ * @brief Remove surrounding spaces and tabs
+ * @param text Text
+ * @return Trimmed view
+ */
+std::string_view trim(std::string_view text) {
+    size_t first = 0;
+    while (first < text.size() && (text[first] == ' ' || text[first] == '\t')) ++first;
+    size_t last = text.size();
+    while (last > first && (text[last - 1] == ' ' || text[last - 1] == '\t')) --last;
+    return text.substr(first, last - first);
+}
+
+/**
+ * @brief Check whether a comma-separated list contains a token, ignoring case
+ * @param list Header value
+ * @param token Lowercase token
+ * @return True if present
+ */
+bool listContains(std::string_view list, std::string_view token) {
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        if (nameIs(trim(list.substr(0, comma)), token)) {
+            return true;
+        }
+        list = comma == NOT_FOUND ? std::string_view() : list.substr(comma + 1);
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * @brief Create a parser at the start of a connection
+ */
+HttpParser::HttpParser() : scanned(0), requiredLength(0), interimBytes(0), error("") {
+}
+
+/**
+ * @brief Forget partial progress, e.g. after the connection is reset
+ */
+void HttpParser::reset() {
+    scanned = 0;
+    requiredLength = 0;
+    interimBytes = 0;
+}
+
+/**
+ * @brief Get the reason for the last INVALID result
+ * @return Static message
+ */
+const char* HttpParser::getError() const {
+    return error;
+}
+
+/**
+ * @brief Identify a method token
+ * @param token Method as sent
+ * @return Method, OTHER if not one the balancer distinguishes
+ */
+HttpMethod HttpParser::parseMethod(std::string_view token) {
+    switch (token.size()) {
+        case 3:
+            if (token == "GET") return HttpMethod::GET;
+            if (token == "PUT") return HttpMethod::PUT;
+            break;
+        case 4:
+            if (token == "POST") return HttpMethod::POST;
+            if (token == "HEAD") return HttpMethod::HEAD;
+            break;
+        case 5:
+            if (token == "PATCH") return HttpMethod::PATCH;
+            break;
+        case 6:
+            if (token == "DELETE") return HttpMethod::DELETE;
+            break;
+        case 7:
+            if (token == "OPTIONS") return HttpMethod::OPTIONS;
+            break;
+        default:
+            break;
+    }
+    return HttpMethod::OTHER;
+}
+
+/**
+ * @brief Get the simulator request type for a method
+ *
+ * HEAD and OPTIONS are read-only and map to GET; PATCH maps to PUT.
+ * @param method Parsed method
+ * @return GET, POST, PUT or DELETE, or nullptr for OTHER
+ */
+const char* HttpParser::requestTypeOf(HttpMethod method) {
+    switch (method) {
+        case HttpMethod::GET:
+        case HttpMethod::HEAD:
+        case HttpMethod::OPTIONS:
+            return "GET";
+        case HttpMethod::POST:
+            return "POST";
+        case HttpMethod::PUT:
+        case HttpMethod::PATCH:
+            return "PUT";
+        case HttpMethod::DELETE:
+            return "DELETE";
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief Parse the request line and header fields
+ * @param data Header block including the terminating blank line
+ * @param request Output request
+ * @return False if malformed (error is set)
+ */
+bool HttpParser::parseHead(std::string_view data, HttpRequestView& request) {
+    // Request line: method SP target SP HTTP-version CRLF
+    size_t lineEnd = findLineEnd(data, 0);
+    if (lineEnd == 0 || data[lineEnd - 1] != '\r') {
+        error = "request line not terminated by CRLF";
+        return false;
+    }
+    std::string_view line = data.substr(0, lineEnd - 1);
+    size_t methodEnd = line.find(' ');
+    size_t targetEnd = methodEnd == NOT_FOUND ? NOT_FOUND : line.find(' ', methodEnd + 1);
+    if (methodEnd == 0 || targetEnd == NOT_FOUND || targetEnd == methodEnd + 1) {
+        error = "malformed request line";
+        return false;
+    }
+    request.methodText = line.substr(0, methodEnd);
+    for (char c : request.methodText) {
+        if (!isTokenChar(c)) {
+            error = "invalid method";
+            return false;
+        }
+    }
+    request.method = parseMethod(request.methodText);
+    request.target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    for (char c : request.target) {
+        if (static_cast<unsigned char>(c) <= ' ' || c == 0x7F) {
+            error = "invalid request target";
+            return false;
+        }
+    }
+    std::string_view version = line.substr(targetEnd + 1);
+    if (version == "HTTP/1.1") {
+        request.minorVersion = 1;
+    } else if (version == "HTTP/1.0") {
+        request.minorVersion = 0;
+    } else {
+        error = "unsupported HTTP version";
+        return false;
+    }
+
+    request.host = std::string_view();
+    request.forwardedFor = std::string_view();
+    request.contentLength = 0;
+    request.chunked = false;
+    request.keepAlive = request.minorVersion == 1;
+    request.headerCount = 0;
+    bool hasHost = false;
+    bool hasContentLength = false;
+    bool hasTransferEncoding = false;
+
+    size_t position = lineEnd + 1;
+    while (true) {
+        lineEnd = findLineEnd(data, position);
+        if (lineEnd == NOT_FOUND || lineEnd == position || data[lineEnd - 1] != '\r') {
+            error = "header line not terminated by CRLF";
+            return false;
+        }
+        line = data.substr(position, lineEnd - 1 - position);
+        position = lineEnd + 1;
+        if (line.empty()) {
+            break;  // The blank line ending the block
+        }
+        if (line[0] == ' ' || line[0] == '\t') {
+            error = "obsolete header line folding";
+            return false;
+        }
+        size_t colon = line.find(':');
+        if (colon == NOT_FOUND || colon == 0) {
+            error = "malformed header field";
+            return false;
+        }
+        std::string_view name = line.substr(0, colon);
+        for (char c : name) {
+            if (!isTokenChar(c)) {
+                // Includes whitespace before the colon, a smuggling vector
+                error = "invalid header name";
+                return false;
+            }
+        }
+        std::string_view value = trim(line.substr(colon + 1));
+        for (char c : value) {
+            if (c == '\r' || c == '\0') {
+                error = "invalid character in header value";
+                return false;
+            }
+        }
+        if (request.headerCount == HttpRequestView::MAX_HEADERS) {
+            error = "too many header fields";
+            return false;
+        }
+        request.headers[request.headerCount++] = HttpHeader{name, value};
+
+        // Routing- and framing-relevant fields
+        switch (name.size()) {
+            case 4:
+                if (nameIs(name, "host")) {
+                    if (hasHost) {
+                        error = "duplicate Host header";
+                        return false;
+                    }
+                    hasHost = true;
+                    request.host = value;
+                }
+                break;
+            case 10:
+                if (nameIs(name, "connection")) {
+                    if (listContains(value, "close")) {
+                        request.keepAlive = false;
+                    } else if (listContains(value, "keep-alive")) {
+                        request.keepAlive = true;
+                    }
+                }
+                break;
+            case 14:
+                if (nameIs(name, "content-length")) {
+                    size_t length = 0;
+                    if (value.empty() || value.size() > 15) {
+                        error = "invalid Content-Length";
+                        return false;
+                    }
+                    for (char c : value) {
+                        if (c < '0' || c > '9') {
+                            error = "invalid Content-Length";
+                            return false;
+                        }
+                        length = length * 10 + static_cast<size_t>(c - '0');
+                    }
+                    if (hasContentLength && length != request.contentLength) {
+                        error = "conflicting Content-Length headers";
+                        return false;
+                    }
+                    hasContentLength = true;
+                    request.contentLength = length;
+                }
+                break;
+            case 15:
+                if (nameIs(name, "x-forwarded-for") && request.forwardedFor.empty()) {
+                    request.forwardedFor = value;
+                }
+                break;
+            case 17:
+                if (nameIs(name, "transfer-encoding")) {
+                    // Only the final coding matters for framing, and it must be chunked
+                    size_t comma = value.rfind(',');
+                    std::string_view last = trim(comma == NOT_FOUND ? value : value.substr(comma + 1));
+                    if (!nameIs(last, "chunked")) {
+                        error = "unsupported transfer coding";
+                        return false;
+                    }
+                    hasTransferEncoding = true;
+                    request.chunked = true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (hasContentLength && hasTransferEncoding) {
+        error = "both Content-Length and Transfer-Encoding";
+        return false;
+    }
+    if (request.minorVersion == 1 && !hasHost) {
+        error = "missing Host header";
+        return false;
+    }
+    if (request.chunked) {
+        request.contentLength = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a status line and the framing header fields
+ * @param data Header block including the terminating blank line
+ * @param response Output response
+ * @param delimited Set if Content-Length or chunked coding gives the body's end
+ * @return False if malformed (error is set)
+ */
+bool HttpParser::parseResponseHead(std::string_view data, HttpResponseView& response, bool& delimited) {
+    size_t lineEnd = findLineEnd(data, 0);
+    if (lineEnd == NOT_FOUND || lineEnd < 13 || data[lineEnd - 1] != '\r' || data.substr(0, 7) != "HTTP/1." ||
+        (data[7] != '0' && data[7] != '1') || data[8] != ' ' || data[9] < '1' || data[9] > '5' ||
+        data[10] < '0' || data[10] > '9' || data[11] < '0' || data[11] > '9' ||
+        (data[12] != ' ' && data[12] != '\r')) {
+        error = "malformed status line";
+        return false;
+    }
+    response.status = (data[9] - '0') * 100 + (data[10] - '0') * 10 + (data[11] - '0');
+    response.minorVersion = data[7] - '0';
+    response.keepAlive = response.minorVersion == 1;
+    response.chunked = false;
+    response.contentLength = 0;
+    bool hasContentLength = false;
+
+    size_t position = lineEnd + 1;
+    while (true) {
+        lineEnd = findLineEnd(data, position);
+        if (lineEnd == NOT_FOUND || lineEnd == position || data[lineEnd - 1] != '\r') {
+            error = "header line not terminated by CRLF";
+            return false;
+        }
+        std::string_view line = data.substr(position, lineEnd - 1 - position);
+        position = lineEnd + 1;
+        if (line.empty()) {
+            break;
+        }
+        size_t colon = line.find(':');
+        if (colon == NOT_FOUND || colon == 0 || line[0] == ' ' || line[0] == '\t') {
+            error = "malformed header field";
+            return false;
+        }
+        std::string_view name = line.substr(0, colon);
+        std::string_view value = trim(line.substr(colon + 1));
+        if (nameIs(name, "content-length")) {
+            size_t length = 0;
+            if (value.empty() || value.size() > 15) {
+                error = "invalid Content-Length";
+                return false;
+            }
+            for (char c : value) {
+                if (c < '0' || c > '9') {
+                    error = "invalid Content-Length";
+                    return false;
+                }
+                length = length * 10 + static_cast<size_t>(c - '0');
+            }
+            if (hasContentLength && length != response.contentLength) {
+                error = "conflicting Content-Length headers";
+                return false;
+            }
+            hasContentLength = true;
+            response.contentLength = length;
+        } else if (nameIs(name, "transfer-encoding")) {
+            size_t comma = value.rfind(',');
+            response.chunked = nameIs(trim(comma == NOT_FOUND ? value : value.substr(comma + 1)), "chunked");
+            if (!response.chunked) {
+                error = "response delimited by connection close";
+                return false;
+            }
+        } else if (nameIs(name, "connection")) {
+            if (listContains(value, "close")) {
+                response.keepAlive = false;
+            } else if (listContains(value, "keep-alive")) {
+                response.keepAlive = true;
+            }
+        }
+    }
+    if (hasContentLength && response.chunked) {
+        error = "both Content-Length and Transfer-Encoding";
+        return false;
+    }
+    if (response.chunked) {
+        response.contentLength = 0;
+    }
+    delimited = hasContentLength || response.chunked;
+    return true;
+}
+
+/**
+ * @brief Find the end of a chunked body
+ * @param data Bytes after the header block
+ * @param length Set to the body length on success
+ * @return Parse status
+ */
+HttpParseStatus HttpParser::scanChunked(std::string_view data, size_t& length) {
+    // Jumps from chunk header to chunk header without touching chunk data
+    size_t position = 0;
+    while (true) {
+        size_t lineEnd = findLineEnd(data, position);
+        if (lineEnd == NOT_FOUND) {
+            if (data.size() - position > 1024) {
+                error = "chunk header too long";
+                return HttpParseStatus::INVALID;
+            }
+            return HttpParseStatus::INCOMPLETE;
+        }
+        if (lineEnd == position || data[lineEnd - 1] != '\r') {
+            error = "chunk header not terminated by CRLF";
+            return HttpParseStatus::INVALID;
+        }
+        size_t size = 0;
+        size_t digits = 0;
+        for (size_t i = position; i < lineEnd - 1; ++i, ++digits) {
+            char c = data[i];
+            int value = c >= '0' && c <= '9' ? c - '0'
+                      : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? (c | 0x20) - 'a' + 10 : -1;
+            if (value < 0) {
+                if (c != ';' && c != ' ' && c != '\t') {
+                    error = "invalid chunk size";
+                    return HttpParseStatus::INVALID;
+                }
+                break;  // Chunk extensions are ignored
+            }
+            if (digits == 15) {
+                error = "chunk too large";
+                return HttpParseStatus::INVALID;
+            }
+            size = size * 16 + static_cast<size_t>(value);
+        }
+        if (digits == 0) {
+            error = "invalid chunk size";
+            return HttpParseStatus::INVALID;
+        }
+        position = lineEnd + 1;
+
+        if (size == 0) {
+            // Optional trailer fields, then a blank line
+            while (true) {
+                lineEnd = findLineEnd(data, position);
+                if (lineEnd == NOT_FOUND) {
+                    if (data.size() - position > MAX_HEADER_BYTES) {
+                        error = "trailer section too large";
+                        return HttpParseStatus::INVALID;
+                    }
+                    return HttpParseStatus::INCOMPLETE;
+                }
+                if (lineEnd == position || data[lineEnd - 1] != '\r') {
+                    error = "trailer line not terminated by CRLF";
+                    return HttpParseStatus::INVALID;
+                }
+                bool blank = lineEnd == position + 1;
+                position = lineEnd + 1;
+                if (blank) {
+                    length = position;
+                    return HttpParseStatus::COMPLETE;
+                }
+            }
+        }
+        if (data.size() - position < size + 2) {
+            return HttpParseStatus::INCOMPLETE;
+        }
+        if (data[position + size] != '\r' || data[position + size + 1] != '\n') {
+            error = "chunk data not terminated by CRLF";
+            return HttpParseStatus::INVALID;
+        }
+        position += size + 2;
+    }
+}
+
+/**
+ * @brief Parse the request at the start of the unconsumed data
+ * @param data Unconsumed receive buffer, beginning at the current request
+ * @param request Filled in on COMPLETE
+ * @return Parse status
+ */
+HttpParseStatus HttpParser::parse(std::string_view data, HttpRequestView& request) {
+    if (requiredLength > 0 && data.size() < requiredLength) {
+        return HttpParseStatus::INCOMPLETE;  // Still waiting for the body
+    }
+
+    // Empty lines before a request line are ignored (RFC 9112 section 2.2)
+    size_t start = 0;
+    while (start + 2 <= data.size() && data[start] == '\r' && data[start + 1] == '\n') {
+        start += 2;
+    }
+    // Resume where the previous call stopped, backing up over a split terminator
+    size_t from = scanned > start + 3 ? scanned - 3 : start;
+    size_t headerEnd = findHeaderEnd(data.data(), data.size(), from);
+    if (headerEnd == NOT_FOUND) {
+        if (data.size() - start > MAX_HEADER_BYTES) {
+            error = "header block too large";
+            return HttpParseStatus::INVALID;
+        }
+        scanned = data.size();
+        return HttpParseStatus::INCOMPLETE;
+    }
+    if (headerEnd - start > MAX_HEADER_BYTES) {
+        error = "header block too large";
+        return HttpParseStatus::INVALID;
+    }
+    if (!parseHead(data.substr(start, headerEnd - start), request)) {
+        return HttpParseStatus::INVALID;
+    }
+
+    size_t bodyLength = request.contentLength;
+    if (request.chunked) {
+        HttpParseStatus status = scanChunked(data.substr(headerEnd), bodyLength);
+        if (status != HttpParseStatus::COMPLETE) {
+            scanned = headerEnd - 4;
+            return status;
+        }
+    } else if (data.size() - headerEnd < bodyLength) {
+        scanned = headerEnd - 4;
+        requiredLength = headerEnd + bodyLength;
+        return HttpParseStatus::INCOMPLETE;
+    }
+    request.body = data.substr(headerEnd, bodyLength);
+    request.length = headerEnd + bodyLength;
+    reset();
+    return HttpParseStatus::COMPLETE;
+}
+
+/**
+ * @brief Frame the response at the start of upstream data
+ * @param data Unconsumed upstream bytes, beginning at the current response
+ * @param headRequest Whether the request was HEAD, so the response has no body
+ * @param response Filled in on COMPLETE
+ * @return Parse status; a response delimited only by connection close is INVALID
+ */
+HttpParseStatus HttpParser::parseResponse(std::string_view data, bool headRequest, HttpResponseView& response) {
+    if (requiredLength > 0 && data.size() < requiredLength) {
+        return HttpParseStatus::INCOMPLETE;
+    }
+    size_t headerEnd = NOT_FOUND;
+    bool delimited = false;
+    while (true) {
+        size_t from = std::max(interimBytes, scanned > 3 ? scanned - 3 : size_t(0));
+        headerEnd = findHeaderEnd(data.data(), data.size(), from);
+        if (headerEnd == NOT_FOUND) {
+            if (data.size() > MAX_HEADER_BYTES) {
+                error = "header block too large";
+                return HttpParseStatus::INVALID;
+            }
+            scanned = data.size();
+            return HttpParseStatus::INCOMPLETE;
+        }
+        if (headerEnd > MAX_HEADER_BYTES) {
+            error = "header block too large";
+            return HttpParseStatus::INVALID;
+        }
+        if (!parseResponseHead(data.substr(interimBytes, headerEnd - interimBytes), response, delimited)) {
+            return HttpParseStatus::INVALID;
+        }
+        if (response.status == 101) {
+            // The connection would stop carrying HTTP, which a pooled relay cannot follow
+            error = "protocol switch not supported";
+            return HttpParseStatus::INVALID;
+        }
+        if (response.status >= 200) {
+            break;
+        }
+        // Interim responses (100 Continue, 103 Early Hints) precede the final one
+        interimBytes = headerEnd;
+    }
+    response.interimLength = interimBytes;
+
+    size_t bodyLength = 0;
+    if (headRequest || response.status == 204 || response.status == 304) {
+        bodyLength = 0;
+    } else if (response.chunked) {
+        HttpParseStatus status = scanChunked(data.substr(headerEnd), bodyLength);
+        if (status != HttpParseStatus::COMPLETE) {
+            scanned = headerEnd - 4;
+            return status;
+        }
+    } else if (!delimited) {
+        // The body runs to connection close, which a relay cannot frame
+        error = "response delimited by connection close";
+        return HttpParseStatus::INVALID;
+    } else {
+        bodyLength = response.contentLength;
+        if (data.size() - headerEnd < bodyLength) {
+            scanned = headerEnd - 4;
+            requiredLength = headerEnd + bodyLength;
+            return HttpParseStatus::INCOMPLETE;
+        }
+    }
+    response.headerLength = headerEnd;
+    response.length = headerEnd + bodyLength;
+    reset();
+    return HttpParseStatus::COMPLETE;
+}
+
+/**
+ * @brief Build a queued request from a parsed HTTP request
+ *
+ * The client is the first X-Forwarded-For address when present and valid,
+ * else the connection's peer.
+ * @param view Parsed request; an OTHER method keeps its token as the type
+ * @param peer Address of the connection's peer
+ * @param serviceTime Expected processing time in cycles
+ * @param id Request identifier
+ * @return Request with priority 5
+ */
+Request toRequest(const HttpRequestView& view, const IPAddress& peer, int serviceTime, long long id) {
+    IPAddress client = peer;
+    if (!view.forwardedFor.empty()) {
+        std::string_view first = trim(view.forwardedFor.substr(0, view.forwardedFor.find(',')));
+        IPAddress forwarded;
+        if (IPAddress::parse(first.data(), first.size(), forwarded)) {
+            client = forwarded;
+        }
+    }
+    const char* type = HttpParser::requestTypeOf(view.method);
+    return Request(client, type != nullptr ? std::string(type) : std::string(view.methodText), 5, serviceTime,
+                   id);
+}
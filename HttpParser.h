@@ -0,0 +1,213 @@
+/**
+ * @file HttpParser.h
+ * @brief Incremental zero-copy HTTP/1.1 request parser
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef HTTPPARSER_H
+#define HTTPPARSER_H
+
+#include "IPAddress.h"
+#include "Request.h"
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @enum HttpMethod
+ * @brief Request methods the balancer distinguishes
+ */
+enum class HttpMethod {
+    GET,      ///< GET
+    HEAD,     ///< HEAD
+    POST,     ///< POST
+    PUT,      ///< PUT
+    DELETE,   ///< DELETE
+    PATCH,    ///< PATCH
+    OPTIONS,  ///< OPTIONS
+    OTHER     ///< Any other token (CONNECT, TRACE, extensions)
+};
+
+/**
+ * @enum HttpParseStatus
+ * @brief Outcome of one parse call
+ */
+enum class HttpParseStatus {
+    COMPLETE,    ///< A whole request (headers and body) was parsed
+    INCOMPLETE,  ///< More bytes are needed
+    INVALID      ///< The bytes are not a valid request; close the connection
+};
+
+/**
+ * @struct HttpHeader
+ * @brief One header field, viewing the receive buffer
+ */
+struct HttpHeader {
+    std::string_view name;   ///< Field name as sent
+    std::string_view value;  ///< Field value without surrounding whitespace
+};
+
+/**
+ * @struct HttpRequestView
+ * @brief A parsed request whose fields view the receive buffer
+ *
+ * The views stay valid only while the buffer is neither modified nor
+ * reallocated; copy what must outlive it (toRequest() does).
+ */
+struct HttpRequestView {
+    static constexpr size_t MAX_HEADERS = 64;  ///< Header fields kept per request
+
+    HttpMethod method = HttpMethod::OTHER;  ///< Parsed method
+    std::string_view methodText;            ///< Method token
+    std::string_view target;                ///< Request target (path and query)
+    int minorVersion = 1;                   ///< 0 for HTTP/1.0, 1 for HTTP/1.1
+    std::string_view host;                  ///< Host header, empty if absent
+    std::string_view forwardedFor;          ///< X-Forwarded-For header, empty if absent
+    std::string_view body;                  ///< Body bytes (still chunk-framed if chunked)
+    size_t contentLength = 0;               ///< Content-Length, 0 if absent or chunked
+    bool chunked = false;                   ///< Body uses chunked transfer coding
+    bool keepAlive = true;                  ///< Connection stays open after the response
+    size_t length = 0;                      ///< Bytes of the buffer this request occupies
+    HttpHeader headers[MAX_HEADERS];        ///< All header fields in order
+    size_t headerCount = 0;                 ///< Valid entries in headers
+};
+
+/**
+ * @struct HttpResponseView
+ * @brief Framing of a response read from an upstream server
+ */
+struct HttpResponseView {
+    int status = 0;            ///< Status code
+    int minorVersion = 1;      ///< 0 for HTTP/1.0, 1 for HTTP/1.1
+    bool keepAlive = true;     ///< Connection stays open after the response
+    bool chunked = false;      ///< Body uses chunked transfer coding
+    size_t contentLength = 0;  ///< Content-Length, 0 if absent or chunked
+    size_t interimLength = 0;  ///< Bytes of 1xx interim responses ahead of the final one
+    size_t headerLength = 0;   ///< Bytes up to the end of the final response's header block
+    size_t length = 0;         ///< Bytes of the buffer this response occupies, interim responses included
+};
+
+/**
+ * @class HttpParser
+ * @brief Incremental HTTP/1.1 request parser for one connection
+ *
+ * parse() is given the unconsumed part of the receive buffer, starting at
+ * the current request. It returns INCOMPLETE until the request's header
+ * block and body have arrived, remembering how far it searched so each
+ * partial read only scans the new bytes. On COMPLETE the request occupies
+ * the first request.length bytes; anything after is the next pipelined
+ * request, parsed by calling parse() again on the remainder. Nothing is
+ * copied: all fields are views into the buffer. The header terminator is
+ * located with SSE2 compares 16 bytes at a time where available.
+ *
+ * Framing is strict, as befits a proxy: CRLF line endings, no obsolete
+ * line folding, no whitespace before a header colon, and a request with
+ * both Content-Length and Transfer-Encoding, conflicting Content-Length
+ * values or a transfer coding other than chunked is INVALID.
+ */
+class HttpParser {
+private:
+    size_t scanned;        ///< Bytes of the current request searched for the header end
+    size_t requiredLength; ///< Total length once known from Content-Length, else 0
+    size_t interimBytes;   ///< Bytes of interim 1xx responses already framed ahead of the final one
+    const char* error;     ///< Reason for the last INVALID result
+
+    /**
+     * @brief Parse the request line and header fields
+     * @param data Header block including the terminating blank line
+     * @param request Output request
+     * @return False if malformed (error is set)
+     */
+    bool parseHead(std::string_view data, HttpRequestView& request);
+
+    /**
+     * @brief Parse a status line and the framing header fields
+     * @param data Header block including the terminating blank line
+     * @param response Output response
+     * @param delimited Set if Content-Length or chunked coding gives the body's end
+     * @return False if malformed (error is set)
+     */
+    bool parseResponseHead(std::string_view data, HttpResponseView& response, bool& delimited);
+
+    /**
+     * @brief Find the end of a chunked body
+     * @param data Bytes after the header block
+     * @param length Set to the body length on success
+     * @return Parse status
+     */
+    HttpParseStatus scanChunked(std::string_view data, size_t& length);
+
+public:
+    static constexpr size_t MAX_HEADER_BYTES = 64 * 1024;  ///< Largest accepted header block
+
+    /**
+     * @brief Create a parser at the start of a connection
+     */
+    HttpParser();
+
+    /**
+     * @brief Parse the request at the start of the unconsumed data
+     * @param data Unconsumed receive buffer, beginning at the current request
+     * @param request Filled in on COMPLETE
+     * @return Parse status
+     */
+    HttpParseStatus parse(std::string_view data, HttpRequestView& request);
+
+    /**
+     * @brief Frame the response at the start of upstream data
+     *
+     * The counterpart of parse() for the upstream side of a proxy: finds
+     * where the response ends so it can be relayed as-is. Interim 1xx
+     * responses are framed together with the final response that follows
+     * them, and 101 Switching Protocols is INVALID. A parser instance is
+     * used for either requests or responses, not both.
+     * @param data Unconsumed upstream bytes, beginning at the current response
+     * @param headRequest Whether the request was HEAD, so the response has no body
+     * @param response Filled in on COMPLETE
+     * @return Parse status; a response delimited only by connection close is INVALID
+     */
+    HttpParseStatus parseResponse(std::string_view data, bool headRequest, HttpResponseView& response);
+
+    /**
+     * @brief Forget partial progress, e.g. after the connection is reset
+     */
+    void reset();
+
+    /**
+     * @brief Get the reason for the last INVALID result
+     * @return Static message
+     */
+    const char* getError() const;
+
+    /**
+     * @brief Identify a method token
+     * @param token Method as sent
+     * @return Method, OTHER if not one the balancer distinguishes
+     */
+    static HttpMethod parseMethod(std::string_view token);
+
+    /**
+     * @brief Get the simulator request type for a method
+     *
+     * HEAD and OPTIONS are read-only and map to GET; PATCH maps to PUT.
+     * @param method Parsed method
+     * @return GET, POST, PUT or DELETE, or nullptr for OTHER
+     */
+    static const char* requestTypeOf(HttpMethod method);
+};
+
+/**
+ * @brief Build a queued request from a parsed HTTP request
+ *
+ * The client is the first X-Forwarded-For address when present and valid,
+ * else the connection's peer.
+ * @param view Parsed request; an OTHER method keeps its token as the type
+ * @param peer Address of the connection's peer
+ * @param serviceTime Expected processing time in cycles
+ * @param id Request identifier
+ * @return Request with priority 5
+ */
+Request toRequest(const HttpRequestView& view, const IPAddress& peer, int serviceTime, long long id);
+
+#endif // HTTPPARSER_H
@@ -0,0 +1,241 @@
+/**
+ * @file HugePages.cpp
+ * @brief Implementation file for the HugePages class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "HugePages.h"
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <sys/mman.h>
+
+namespace {
+
+/**
+ * @struct Mapping
+ * @brief One live huge-page-eligible mapping
+ */
+struct Mapping {
+    size_t length;  ///< Mapped length in bytes
+    bool hugetlb;   ///< True if from the hugetlb pool
+};
+
+std::atomic<HugePageMode> currentMode(HugePageMode::OFF);  ///< Mode for new allocations
+std::mutex registryMutex;                                  ///< Guards mappings
+std::map<const char*, Mapping> mappings;                   ///< Live mappings by start address
+
+/**
+ * @brief Round up to a whole number of huge pages
+ * @param bytes Size in bytes
+ * @return Rounded size
+ */
+size_t roundToHugePages(size_t bytes) {
+    return (bytes + HugePages::HUGE_PAGE_SIZE - 1) / HugePages::HUGE_PAGE_SIZE * HugePages::HUGE_PAGE_SIZE;
+}
+
+/**
+ * @brief Map anonymous memory aligned to a huge page boundary
+ * @param length Length, a multiple of the huge page size
+ * @return Mapping, or nullptr on failure
+ */
+void* mapAligned(size_t length) {
+    // Over-map by one huge page and trim both ends to the aligned window
+    size_t padded = length + HugePages::HUGE_PAGE_SIZE;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (start + HugePages::HUGE_PAGE_SIZE - 1) & ~(HugePages::HUGE_PAGE_SIZE - 1);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    size_t tail = (start + padded) - (aligned + length);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+} // namespace
+
+/**
+ * @brief Select how subsequent large allocations are backed
+ * @param mode Huge page mode
+ */
+void HugePages::setMode(HugePageMode mode) {
+    currentMode = mode;
+}
+
+/**
+ * @brief Get the current mode
+ * @return Huge page mode
+ */
+HugePageMode HugePages::getMode() {
+    return currentMode;
+}
+
+/**
+ * @brief Parse a mode name
+ * @param name "off", "thp" or "hugetlb"
+ * @param mode Parsed mode (unchanged on failure)
+ * @return True if the name was recognised
+ */
+bool HugePages::parseMode(const std::string& name, HugePageMode& mode) {
+    if (name == "off") {
+        mode = HugePageMode::OFF;
+    } else if (name == "thp") {
+        mode = HugePageMode::TRANSPARENT;
+    } else if (name == "hugetlb") {
+        mode = HugePageMode::EXPLICIT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Allocate memory, huge-page backed if large enough
+ * @param bytes Size in bytes
+ * @return Memory aligned for any fundamental type
+ * @throws std::bad_alloc if no memory is available
+ */
+void* HugePages::allocate(size_t bytes) {
+    HugePageMode mode = currentMode;
+    if (mode == HugePageMode::OFF || bytes < HUGE_PAGE_SIZE) {
+        return ::operator new(bytes);
+    }
+    
+    size_t length = roundToHugePages(bytes);
+    void* memory = nullptr;
+    bool hugetlb = false;
+    if (mode == HugePageMode::EXPLICIT) {
+        // Fails unless the administrator reserved enough pages (vm.nr_hugepages)
+        memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        hugetlb = memory != MAP_FAILED;
+        if (!hugetlb) {
+            memory = nullptr;
+        }
+    }
+    if (memory == nullptr) {
+        memory = mapAligned(length);
+        if (memory == nullptr) {
+            return ::operator new(bytes);
+        }
+        // Ignored where THP is disabled; the mapping then stays on 4 KB pages
+        madvise(memory, length, MADV_HUGEPAGE);
+    }
+    
+    std::lock_guard<std::mutex> lock(registryMutex);
+    mappings[static_cast<const char*>(memory)] = {length, hugetlb};
+    return memory;
+}
+
+/**
+ * @brief Release memory from allocate()
+ * @param pointer Memory to release
+ * @param bytes Size passed to allocate()
+ */
+void HugePages::deallocate(void* pointer, size_t bytes) {
+    if (pointer == nullptr) {
+        return;
+    }
+    if (bytes >= HUGE_PAGE_SIZE) {
+        // The mode may have changed since allocation, so ask the registry
+        std::unique_lock<std::mutex> lock(registryMutex);
+        auto it = mappings.find(static_cast<const char*>(pointer));
+        if (it != mappings.end()) {
+            size_t length = it->second.length;
+            mappings.erase(it);
+            lock.unlock();
+            munmap(pointer, length);
+            return;
+        }
+    }
+    ::operator delete(pointer);
+}
+
+/**
+ * @brief Report the backing of live large allocations
+ * 
+ * Transparent backing is read from /proc/self/smaps, so it reflects
+ * what the kernel actually provided, not what was requested.
+ * @return Backing report
+ */
+HugePageReport HugePages::getReport() {
+    HugePageReport report;
+    std::map<const char*, Mapping> live;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        live = mappings;
+    }
+    for (const auto& entry : live) {
+        report.mappedBytes += entry.second.length;
+        (entry.second.hugetlb ? report.hugetlbBytes : report.advisedBytes) += entry.second.length;
+    }
+    if (report.advisedBytes == 0) {
+        return report;
+    }
+    
+    // Sum AnonHugePages of every smaps region that overlaps an advised mapping
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool overlaps = false;
+    while (std::getline(smaps, line)) {
+        // Region headers start with a lowercase hex range; field names are capitalised
+        if (!line.empty() && (std::isdigit(static_cast<unsigned char>(line[0])) ||
+                              (line[0] >= 'a' && line[0] <= 'f'))) {
+            unsigned long long start = 0, end = 0;
+            char dash = 0;
+            std::istringstream header(line);
+            header >> std::hex >> start >> dash >> end;
+            overlaps = false;
+            auto it = live.lower_bound(reinterpret_cast<const char*>(static_cast<uintptr_t>(end)));
+            while (it != live.begin()) {
+                --it;
+                uintptr_t mapStart = reinterpret_cast<uintptr_t>(it->first);
+                if (mapStart + it->second.length <= start) {
+                    break;
+                }
+                if (!it->second.hugetlb) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            continue;
+        }
+        if (overlaps && line.compare(0, 14, "AnonHugePages:") == 0) {
+            size_t kilobytes = std::stoull(line.substr(14));
+            report.transparentBytes += kilobytes * 1024;
+        }
+    }
+    if (report.transparentBytes > report.advisedBytes) {
+        report.transparentBytes = report.advisedBytes;
+    }
+    return report;
+}
+
+/**
+ * @brief Format a report as one line
+ * @param report Backing report
+ * @return Human-readable summary
+ */
+std::string HugePages::describe(const HugePageReport& report) {
+    const double megabyte = 1024.0 * 1024.0;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << report.mappedBytes / megabyte << " MB in large mappings, "
+       << (report.hugetlbBytes + report.transparentBytes) / megabyte << " MB on huge pages (hugetlb "
+       << report.hugetlbBytes / megabyte << " MB, transparent " << report.transparentBytes / megabyte
+       << " of " << report.advisedBytes / megabyte << " MB advised)";
+    return ss.str();
+}
@@ -0,0 +1,157 @@
+/**
+ * @file HugePages.h
+ * @brief Header file for the HugePages class and HugePageAllocator
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef HUGEPAGES_H
+#define HUGEPAGES_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+
+/**
+ * @enum HugePageMode
+ * @brief How large allocations request 2 MB pages
+ */
+enum class HugePageMode {
+    OFF,          ///< Ordinary heap allocations
+    TRANSPARENT,  ///< 2 MB aligned mappings with madvise(MADV_HUGEPAGE)
+    EXPLICIT      ///< MAP_HUGETLB from the reserved pool, else TRANSPARENT
+};
+
+/**
+ * @struct HugePageReport
+ * @brief What large allocations are actually backed by
+ */
+struct HugePageReport {
+    size_t mappedBytes = 0;       ///< Bytes in live huge-page-eligible mappings
+    size_t hugetlbBytes = 0;      ///< Bytes from the reserved hugetlb pool
+    size_t advisedBytes = 0;      ///< Bytes advised for transparent huge pages
+    size_t transparentBytes = 0;  ///< Advised bytes the kernel backs with huge pages now
+};
+
+/**
+ * @class HugePages
+ * @brief Huge-page backed allocation of large simulation arrays
+ * 
+ * Allocations of at least HUGE_PAGE_SIZE bytes get their own anonymous
+ * mapping while a mode other than OFF is selected; smaller ones, and all
+ * allocations when huge pages are unavailable, fall back silently to the
+ * heap. Backing never changes what is stored, only how many TLB entries
+ * it takes to reach it.
+ */
+class HugePages {
+public:
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;  ///< x86-64 huge page size
+
+    /**
+     * @brief Select how subsequent large allocations are backed
+     * @param mode Huge page mode
+     */
+    static void setMode(HugePageMode mode);
+
+    /**
+     * @brief Get the current mode
+     * @return Huge page mode
+     */
+    static HugePageMode getMode();
+
+    /**
+     * @brief Parse a mode name
+     * @param name "off", "thp" or "hugetlb"
+     * @param mode Parsed mode (unchanged on failure)
+     * @return True if the name was recognised
+     */
+    static bool parseMode(const std::string& name, HugePageMode& mode);
+
+    /**
+     * @brief Allocate memory, huge-page backed if large enough
+     * @param bytes Size in bytes
+     * @return Memory aligned for any fundamental type
+     * @throws std::bad_alloc if no memory is available
+     */
+    static void* allocate(size_t bytes);
+
+    /**
+     * @brief Release memory from allocate()
+     * @param pointer Memory to release
+     * @param bytes Size passed to allocate()
+     */
+    static void deallocate(void* pointer, size_t bytes);
+
+    /**
+     * @brief Report the backing of live large allocations
+     * 
+     * Transparent backing is read from /proc/self/smaps, so it reflects
+     * what the kernel actually provided, not what was requested.
+     * @return Backing report
+     */
+    static HugePageReport getReport();
+
+    /**
+     * @brief Format a report as one line
+     * @param report Backing report
+     * @return Human-readable summary
+     */
+    static std::string describe(const HugePageReport& report);
+};
+
+/**
+ * @class HugePageAllocator
+ * @brief Standard allocator over HugePages for use with std::vector
+ * @tparam T Element type
+ */
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;  ///< Allocated type
+
+    /**
+     * @brief Default constructor
+     */
+    HugePageAllocator() = default;
+
+    /**
+     * @brief Converting constructor (allocators are stateless)
+     */
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    /**
+     * @brief Allocate storage for elements
+     * @param count Element count
+     * @return Uninitialized storage
+     */
+    T* allocate(size_t count) {
+        return static_cast<T*>(HugePages::allocate(count * sizeof(T)));
+    }
+
+    /**
+     * @brief Release storage
+     * @param pointer Storage from allocate()
+     * @param count Element count passed to allocate()
+     */
+    void deallocate(T* pointer, size_t count) {
+        HugePages::deallocate(pointer, count * sizeof(T));
+    }
+
+    /**
+     * @brief Allocators are interchangeable
+     * @return True
+     */
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const { return true; }
+
+    /**
+     * @brief Allocators are interchangeable
+     * @return False
+     */
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const { return false; }
+};
+
+#endif // HUGEPAGES_H
@@ -0,0 +1,230 @@
+/**
+ * @file IPAddress.cpp
+ * @brief Implementation file for the IPAddress class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "IPAddress.h"
+
+namespace {
+
+/**
+ * @brief Parse a dotted-quad IPv4 address
+ * @param text Address text
+ * @param end End of the text
+ * @param address Set to the address, first octet most significant
+ * @return True if the whole text is a dotted quad without leading zeros
+ */
+bool parseIPv4(const char* text, const char* end, uint32_t& address) {
+    uint32_t value = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        if (octet > 0) {
+            if (text == end || *text != '.') return false;
+            ++text;
+        }
+        if (text == end || *text < '0' || *text > '9') return false;
+        // A leading zero is only allowed for the octet 0 itself
+        if (*text == '0' && text + 1 != end && text[1] >= '0' && text[1] <= '9') return false;
+        unsigned int part = 0;
+        int digits = 0;
+        while (text != end && *text >= '0' && *text <= '9' && digits < 3) {
+            part = part * 10 + static_cast<unsigned int>(*text - '0');
+            ++text;
+            ++digits;
+        }
+        if (part > 255 || (text != end && *text >= '0' && *text <= '9')) return false;
+        value = (value << 8) | part;
+    }
+    if (text != end) return false;
+    address = value;
+    return true;
+}
+
+/**
+ * @brief Get the value of a hexadecimal digit
+ * @param c Character
+ * @return Digit value, or -1 if not a hex digit
+ */
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Parse an IPv6 address into eight 16-bit groups
+ * @param text Address text
+ * @param end End of the text
+ * @param groups Set to the groups, first most significant
+ * @return True if the text is a valid IPv6 address
+ */
+bool parseIPv6(const char* text, const char* end, uint16_t groups[8]) {
+    uint16_t parsed[8];
+    int count = 0;
+    int gap = -1;  // Group index where "::" stands
+    if (end - text >= 2 && text[0] == ':' && text[1] == ':') {
+        gap = 0;
+        text += 2;
+    } else if (text != end && *text == ':') {
+        return false;
+    }
+    while (text != end) {
+        if (count == 8) return false;
+        // Trailing dotted quad fills the last two groups
+        const char* groupEnd = text;
+        while (groupEnd != end && *groupEnd != ':') ++groupEnd;
+        uint32_t v4;
+        if (groupEnd == end && count <= 6 && parseIPv4(text, end, v4)) {
+            parsed[count++] = static_cast<uint16_t>(v4 >> 16);
+            parsed[count++] = static_cast<uint16_t>(v4);
+            text = end;
+            break;
+        }
+        if (groupEnd == text || groupEnd - text > 4) return false;
+        unsigned int value = 0;
+        for (const char* c = text; c != groupEnd; ++c) {
+            int digit = hexValue(*c);
+            if (digit < 0) return false;
+            value = (value << 4) | static_cast<unsigned int>(digit);
+        }
+        parsed[count++] = static_cast<uint16_t>(value);
+        text = groupEnd;
+        if (text == end) break;
+        ++text;  // ':'
+        if (text != end && *text == ':') {
+            if (gap >= 0) return false;
+            gap = count;
+            ++text;
+        } else if (text == end) {
+            return false;  // Trailing single ':'
+        }
+    }
+    if (gap < 0) {
+        if (count != 8) return false;
+        for (int i = 0; i < 8; ++i) groups[i] = parsed[i];
+        return true;
+    }
+    if (count > 7) return false;
+    int zeros = 8 - count;
+    for (int i = 0; i < gap; ++i) groups[i] = parsed[i];
+    for (int i = 0; i < zeros; ++i) groups[gap + i] = 0;
+    for (int i = gap; i < count; ++i) groups[zeros + i] = parsed[i];
+    return true;
+}
+
+/**
+ * @brief Write a decimal octet
+ * @param out Output position
+ * @param value Octet value
+ * @return Position after the digits
+ */
+char* putOctet(char* out, unsigned int value) {
+    if (value >= 100) *out++ = static_cast<char>('0' + value / 100);
+    if (value >= 10) *out++ = static_cast<char>('0' + value / 10 % 10);
+    *out++ = static_cast<char>('0' + value % 10);
+    return out;
+}
+
+} // namespace
+
+/**
+ * @brief Parse a dotted-quad IPv4 or RFC 4291 IPv6 address
+ *
+ * IPv4 octets must not have leading zeros, so formatting a parsed
+ * IPv4 address reproduces the text. IPv6 zone identifiers are not
+ * accepted.
+ * @param text Address text
+ * @param length Text length
+ * @param address Set to the parsed address on success
+ * @return True if the text is a valid address
+ */
+bool IPAddress::parse(const char* text, size_t length, IPAddress& address) {
+    const char* end = text + length;
+    uint32_t v4;
+    if (parseIPv4(text, end, v4)) {
+        address = fromIPv4(v4);
+        return true;
+    }
+    uint16_t groups[8];
+    if (!parseIPv6(text, end, groups)) {
+        return false;
+    }
+    uint64_t words[2] = {0, 0};
+    for (int i = 0; i < 8; ++i) {
+        words[i / 4] = (words[i / 4] << 16) | groups[i];
+    }
+    address = IPAddress(words[0], words[1]);
+    return true;
+}
+
+/**
+ * @brief Format the address into a buffer
+ *
+ * IPv4-mapped addresses print as dotted quads; others in RFC 5952
+ * canonical form (lowercase, longest zero run compressed).
+ * @param out Buffer of at least MAX_TEXT_LENGTH characters
+ * @return Characters written (not NUL-terminated)
+ */
+size_t IPAddress::format(char* out) const {
+    char* position = out;
+    if (isIPv4()) {
+        uint32_t v4 = getIPv4();
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            position = putOctet(position, (v4 >> shift) & 0xFF);
+            if (shift > 0) *position++ = '.';
+        }
+        return static_cast<size_t>(position - out);
+    }
+
+    uint16_t groups[8];
+    for (int i = 0; i < 8; ++i) {
+        uint64_t word = i < 4 ? high : low;
+        groups[i] = static_cast<uint16_t>(word >> (48 - 16 * (i % 4)));
+    }
+    // The first longest run of two or more zero groups becomes "::"
+    int bestStart = -1;
+    int bestLength = 1;
+    for (int i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            ++i;
+            continue;
+        }
+        int start = i;
+        while (i < 8 && groups[i] == 0) ++i;
+        if (i - start > bestLength) {
+            bestStart = start;
+            bestLength = i - start;
+        }
+    }
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < 8; ++i) {
+        if (i == bestStart) {
+            *position++ = ':';
+            *position++ = ':';
+            i += bestLength - 1;
+            continue;
+        }
+        if (i > 0 && i != bestStart + bestLength) *position++ = ':';
+        bool started = false;
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            unsigned int digit = (groups[i] >> shift) & 0xF;
+            if (digit != 0 || started || shift == 0) {
+                *position++ = digits[digit];
+                started = true;
+            }
+        }
+    }
+    return static_cast<size_t>(position - out);
+}
+
+/**
+ * @brief Format the address as a string
+ * @return Dotted quad or canonical IPv6 text
+ */
+std::string IPAddress::toString() const {
+    char buffer[MAX_TEXT_LENGTH];
+    return std::string(buffer, format(buffer));
+}
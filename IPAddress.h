@@ -0,0 +1,172 @@
+/**
+ * @file IPAddress.h
+ * @brief Header file for the IPAddress class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef IPADDRESS_H
+#define IPADDRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class IPAddress
+ * @brief Packed 128-bit client address; IPv4 is held IPv4-mapped (::ffff:a.b.c.d)
+ *
+ * The address is two 64-bit words in network order, aligned to 16 bytes,
+ * so comparison is two word compares (one vector compare when the
+ * compiler vectorizes) and hashing is a multiply-xorshift over both
+ * words, with no string or allocation. IPv4 addresses take a fast path
+ * when parsing and formatting and print as dotted quads.
+ */
+class alignas(16) IPAddress {
+private:
+    uint64_t high;  ///< Bytes 0-7, most significant first
+    uint64_t low;   ///< Bytes 8-15, most significant first
+
+    static constexpr uint64_t IPV4_MAPPED_PREFIX = 0xFFFFull << 32;  ///< ::ffff:0:0/96 in the low word
+
+public:
+    static constexpr size_t MAX_TEXT_LENGTH = 39;  ///< Longest formatted address
+
+    /**
+     * @brief Create the unspecified address ::
+     */
+    constexpr IPAddress() : high(0), low(0) {}
+
+    /**
+     * @brief Create an address from its two halves
+     * @param highWord Bytes 0-7, most significant first
+     * @param lowWord Bytes 8-15, most significant first
+     */
+    constexpr IPAddress(uint64_t highWord, uint64_t lowWord) : high(highWord), low(lowWord) {}
+
+    /**
+     * @brief Create an IPv4-mapped address
+     * @param address IPv4 address, first octet most significant
+     * @return Mapped address
+     */
+    static constexpr IPAddress fromIPv4(uint32_t address) {
+        return IPAddress(0, IPV4_MAPPED_PREFIX | address);
+    }
+
+    /**
+     * @brief Parse a dotted-quad IPv4 or RFC 4291 IPv6 address
+     *
+     * IPv4 octets must not have leading zeros, so formatting a parsed
+     * IPv4 address reproduces the text. IPv6 zone identifiers are not
+     * accepted.
+     * @param text Address text
+     * @param length Text length
+     * @param address Set to the parsed address on success
+     * @return True if the text is a valid address
+     */
+    static bool parse(const char* text, size_t length, IPAddress& address);
+
+    /**
+     * @brief Parse a dotted-quad IPv4 or RFC 4291 IPv6 address
+     * @param text Address text
+     * @param address Set to the parsed address on success
+     * @return True if the text is a valid address
+     */
+    static bool parse(const std::string& text, IPAddress& address) {
+        return parse(text.data(), text.size(), address);
+    }
+
+    /**
+     * @brief Check whether this is an IPv4-mapped address
+     * @return True for IPv4 clients
+     */
+    bool isIPv4() const { return high == 0 && (low >> 32) == 0xFFFF; }
+
+    /**
+     * @brief Get the IPv4 address of an IPv4-mapped address
+     * @return IPv4 address, first octet most significant
+     */
+    uint32_t getIPv4() const { return static_cast<uint32_t>(low); }
+
+    /**
+     * @brief Get bytes 0-7
+     * @return High word, most significant byte first
+     */
+    uint64_t getHigh() const { return high; }
+
+    /**
+     * @brief Get bytes 8-15
+     * @return Low word, most significant byte first
+     */
+    uint64_t getLow() const { return low; }
+
+    /**
+     * @brief Hash the address
+     * @return 64-bit hash with every input bit affecting every output bit
+     */
+    uint64_t hash() const {
+        uint64_t h = high * 0x9E3779B97F4A7C15ull ^ low;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        return h ^ (h >> 33);
+    }
+
+    /**
+     * @brief Format the address into a buffer
+     *
+     * IPv4-mapped addresses print as dotted quads; others in RFC 5952
+     * canonical form (lowercase, longest zero run compressed).
+     * @param out Buffer of at least MAX_TEXT_LENGTH characters
+     * @return Characters written (not NUL-terminated)
+     */
+    size_t format(char* out) const;
+
+    /**
+     * @brief Format the address as a string
+     * @return Dotted quad or canonical IPv6 text
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Compare two addresses
+     * @param other Address to compare with
+     * @return True if equal
+     */
+    bool operator==(const IPAddress& other) const {
+        return ((high ^ other.high) | (low ^ other.low)) == 0;
+    }
+
+    /**
+     * @brief Compare two addresses
+     * @param other Address to compare with
+     * @return True if different
+     */
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+
+    /**
+     * @brief Order addresses numerically
+     * @param other Address to compare with
+     * @return True if this address sorts first
+     */
+    bool operator<(const IPAddress& other) const {
+        return high != other.high ? high < other.high : low < other.low;
+    }
+};
+
+/**
+ * @struct IPAddressHash
+ * @brief Hash functor for unordered containers of addresses
+ */
+struct IPAddressHash {
+    /**
+     * @brief Hash an address
+     * @param address Address to hash
+     * @return Hash value
+     */
+    size_t operator()(const IPAddress& address) const { return static_cast<size_t>(address.hash()); }
+};
+
+#endif // IPADDRESS_H
@@ -0,0 +1,116 @@
+/**
+ * @file IPBlocklist.cpp
+ * @brief Implementation file for the IPBlocklist class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "IPBlocklist.h"
+#include <algorithm>
+
+/**
+ * @brief Get the observed false-positive rate of the filter
+ * @return False positives per lookup of an unblocked address
+ */
+double BlocklistLookupStats::getFalsePositiveRate() const {
+    uint64_t negatives = lookups - (filterPasses - falsePositives);
+    return negatives == 0 ? 0.0 : static_cast<double>(falsePositives) / negatives;
+}
+
+/**
+ * @brief Create an empty blocklist
+ */
+IPBlocklist::IPBlocklist()
+    : filter(MIN_FILTER_CAPACITY), filterCapacity(MIN_FILTER_CAPACITY), staleKeys(0), rebuilds(0) {
+}
+
+/**
+ * @brief Create an empty blocklist sized for a bulk load
+ * @param expectedEntries Addresses about to be added
+ */
+IPBlocklist::IPBlocklist(size_t expectedEntries)
+    : filter(std::max(MIN_FILTER_CAPACITY, expectedEntries)),
+      filterCapacity(std::max(MIN_FILTER_CAPACITY, expectedEntries)), staleKeys(0), rebuilds(0) {
+    entries.reserve(expectedEntries);
+}
+
+/**
+ * @brief Recreate the filter from the entries
+ * @param capacity Keys to size the filter for
+ */
+void IPBlocklist::rebuildFilter(size_t capacity) {
+    filterCapacity = std::max(MIN_FILTER_CAPACITY, capacity);
+    filter = BloomFilter(filterCapacity);
+    for (const auto& ip : entries) {
+        filter.insert(ip.hash());
+    }
+    staleKeys = 0;
+    rebuilds++;
+}
+
+/**
+ * @brief Block an address
+ * @param ip IP address
+ * @return True if it was not blocked before
+ */
+bool IPBlocklist::add(const IPAddress& ip) {
+    if (!entries.insert(ip).second) {
+        return false;
+    }
+    if (filter.getInsertedCount() >= filterCapacity) {
+        // Doubling keeps rebuild work amortized O(1) per insert
+        rebuildFilter(entries.size() * 2);
+    } else {
+        filter.insert(ip.hash());
+    }
+    return true;
+}
+
+/**
+ * @brief Unblock an address
+ * @param ip IP address
+ * @return True if it was blocked
+ */
+bool IPBlocklist::remove(const IPAddress& ip) {
+    if (entries.erase(ip) == 0) {
+        return false;
+    }
+    staleKeys++;
+    if (staleKeys > MIN_FILTER_CAPACITY / 4 && staleKeys > entries.size() / 4) {
+        rebuildFilter(entries.size() * 2);
+    }
+    return true;
+}
+
+/**
+ * @brief Get the number of blocked addresses
+ * @return Entry count
+ */
+size_t IPBlocklist::size() const {
+    return entries.size();
+}
+
+/**
+ * @brief Get the filter's memory footprint
+ * @return Size in bytes
+ */
+size_t IPBlocklist::getFilterBytes() const {
+    return filter.getSizeBytes();
+}
+
+/**
+ * @brief Get the filter's false-positive rate computed from its bits
+ * @return Probability that an unblocked address passes the filter
+ */
+double IPBlocklist::getFilterFalsePositiveRate() const {
+    return filter.getFalsePositiveRate();
+}
+
+/**
+ * @brief Get the number of filter rebuilds
+ * @return Rebuild count
+ */
+size_t IPBlocklist::getRebuildCount() const {
+    return rebuilds;
+}
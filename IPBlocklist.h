@@ -0,0 +1,133 @@
+/**
+ * @file IPBlocklist.h
+ * @brief Header file for the IPBlocklist class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef IPBLOCKLIST_H
+#define IPBLOCKLIST_H
+
+#include "BloomFilter.h"
+#include "IPAddress.h"
+#include <cstdint>
+#include <unordered_set>
+
+/**
+ * @struct BlocklistLookupStats
+ * @brief Outcome counts of blocklist lookups, kept by the caller
+ */
+struct BlocklistLookupStats {
+    uint64_t lookups = 0;         ///< Lookups against a non-empty blocklist
+    uint64_t filterPasses = 0;    ///< Lookups the filter could not rule out
+    uint64_t falsePositives = 0;  ///< Filter passes for addresses not blocked
+
+    /**
+     * @brief Get the observed false-positive rate of the filter
+     * @return False positives per lookup of an unblocked address
+     */
+    double getFalsePositiveRate() const;
+};
+
+/**
+ * @class IPBlocklist
+ * @brief Set of blocked client IPs with a Bloom-filter fast path
+ * 
+ * The hash set is authoritative; a split-block BloomFilter in front of it
+ * answers the common "not blocked" case without touching the set. Blocking
+ * inserts into both. The filter cannot forget keys, so unblocked addresses
+ * stay in it as stale bits until they exceed a quarter of the entries,
+ * when the filter is rebuilt; it is also rebuilt at twice the size when
+ * the entries outgrow it.
+ */
+class IPBlocklist {
+private:
+    std::unordered_set<IPAddress, IPAddressHash> entries;  ///< Authoritative blocked addresses
+    BloomFilter filter;                       ///< Fast negative check
+    size_t filterCapacity;                    ///< Keys the filter was sized for
+    size_t staleKeys;                         ///< Unblocked keys still set in the filter
+    size_t rebuilds;                          ///< Filter rebuilds so far
+
+    /**
+     * @brief Recreate the filter from the entries
+     * @param capacity Keys to size the filter for
+     */
+    void rebuildFilter(size_t capacity);
+
+public:
+    static constexpr size_t MIN_FILTER_CAPACITY = 1024;  ///< Smallest filter, in keys
+
+    /**
+     * @brief Create an empty blocklist
+     */
+    IPBlocklist();
+
+    /**
+     * @brief Create an empty blocklist sized for a bulk load
+     * @param expectedEntries Addresses about to be added
+     */
+    explicit IPBlocklist(size_t expectedEntries);
+
+    /**
+     * @brief Check whether an address is blocked
+     * @param ip IP address
+     * @param stats Optional counters updated with the lookup's outcome
+     * @return True if blocked
+     */
+    bool contains(const IPAddress& ip, BlocklistLookupStats* stats = nullptr) const {
+        if (entries.empty()) {
+            return false;
+        }
+        if (stats) stats->lookups++;
+        if (!filter.mayContain(ip.hash())) {
+            return false;
+        }
+        bool blocked = entries.count(ip) > 0;
+        if (stats) {
+            stats->filterPasses++;
+            stats->falsePositives += blocked ? 0 : 1;
+        }
+        return blocked;
+    }
+
+    /**
+     * @brief Block an address
+     * @param ip IP address
+     * @return True if it was not blocked before
+     */
+    bool add(const IPAddress& ip);
+
+    /**
+     * @brief Unblock an address
+     * @param ip IP address
+     * @return True if it was blocked
+     */
+    bool remove(const IPAddress& ip);
+
+    /**
+     * @brief Get the number of blocked addresses
+     * @return Entry count
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the filter's memory footprint
+     * @return Size in bytes
+     */
+    size_t getFilterBytes() const;
+
+    /**
+     * @brief Get the filter's false-positive rate computed from its bits
+     * @return Probability that an unblocked address passes the filter
+     */
+    double getFilterFalsePositiveRate() const;
+
+    /**
+     * @brief Get the number of filter rebuilds
+     * @return Rebuild count
+     */
+    size_t getRebuildCount() const;
+};
+
+#endif // IPBLOCKLIST_H
@@ -0,0 +1,190 @@
+/**
+ * @file JsonlTrace.cpp
+ * @brief Implementation file for the JSONL trace reader and writer
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "JsonlTrace.h"
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Skip spaces and tabs
+ * @param text Line being parsed
+ * @param pos Cursor, advanced past whitespace
+ */
+void skipSpace(const std::string& text, size_t& pos) {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r')) {
+        ++pos;
+    }
+}
+
+/**
+ * @brief Parse a JSON string starting at an opening quote
+ * @param text Line being parsed
+ * @param pos Cursor, advanced past the closing quote
+ * @param value Output string
+ * @return False if the string is malformed
+ */
+bool parseString(const std::string& text, size_t& pos, std::string& value) {
+    if (pos >= text.size() || text[pos] != '"') return false;
+    value.clear();
+    for (++pos; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+        if (c == '\\') {
+            if (++pos >= text.size()) return false;
+            char escaped = text[pos];
+            switch (escaped) {
+                case 'n': value += '\n'; break;
+                case 't': value += '\t'; break;
+                case 'r': value += '\r'; break;
+                default: value += escaped; break;
+            }
+        } else {
+            value += c;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Append a string as a JSON string literal
+ * @param out Output buffer
+ * @param value String to quote
+ */
+void appendQuoted(std::string& out, const std::string& value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+/**
+ * @brief Open a JSONL trace
+ * @param tracePath Trace file path
+ * @throws std::runtime_error if the file cannot be opened
+ */
+JsonlTraceReader::JsonlTraceReader(const std::string& tracePath)
+    : file(tracePath), path(tracePath), lineNumber(0) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open trace file " + tracePath);
+    }
+}
+
+/**
+ * @brief Read the next record
+ * @param record Output record
+ * @return False at the end of the trace
+ * @throws std::runtime_error on malformed lines
+ */
+bool JsonlTraceReader::next(TraceRecord& record) {
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t pos = 0;
+        skipSpace(line, pos);
+        if (pos >= line.size()) {
+            continue;
+        }
+        
+        const std::string error = path + ":" + std::to_string(lineNumber) + ": malformed trace record";
+        if (line[pos] != '{') {
+            throw std::runtime_error(error);
+        }
+        record = TraceRecord();
+        ++pos;
+        std::string key;
+        std::string text;
+        while (true) {
+            skipSpace(line, pos);
+            if (pos < line.size() && line[pos] == '}') break;
+            if (!parseString(line, pos, key)) throw std::runtime_error(error);
+            skipSpace(line, pos);
+            if (pos >= line.size() || line[pos] != ':') throw std::runtime_error(error);
+            ++pos;
+            skipSpace(line, pos);
+            
+            if (pos < line.size() && line[pos] == '"') {
+                if (!parseString(line, pos, text)) throw std::runtime_error(error);
+                if (key == "ip") record.clientIP = text;
+                else if (key == "type") record.requestType = text;
+            } else {
+                const char* start = line.c_str() + pos;
+                char* end = nullptr;
+                long long number = std::strtoll(start, &end, 10);
+                if (end == start) throw std::runtime_error(error);
+                pos += static_cast<size_t>(end - start);
+                // Tolerate fractional values by truncating them
+                while (pos < line.size() && line[pos] != ',' && line[pos] != '}' &&
+                       line[pos] != ' ') {
+                    ++pos;
+                }
+                if (key == "cycle") record.cycle = number;
+                else if (key == "id") record.requestID = number;
+                else if (key == "priority") record.priority = static_cast<int>(number);
+                else if (key == "service") record.serviceTime = static_cast<int>(number);
+            }
+            
+            skipSpace(line, pos);
+            if (pos < line.size() && line[pos] == ',') {
+                ++pos;
+            } else if (pos >= line.size() || line[pos] != '}') {
+                throw std::runtime_error(error);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Create a JSONL trace
+ * @param outputPath File to create (truncated if it exists)
+ * @throws std::runtime_error if the file cannot be created
+ */
+JsonlTraceWriter::JsonlTraceWriter(const std::string& outputPath)
+    : file(outputPath, std::ios::trunc) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create trace file " + outputPath);
+    }
+}
+
+/**
+ * @brief Append a record
+ * @param record Record to append
+ */
+void JsonlTraceWriter::write(const TraceRecord& record) {
+    buffer.clear();
+    buffer += "{\"cycle\":";
+    buffer += std::to_string(record.cycle);
+    buffer += ",\"id\":";
+    buffer += std::to_string(record.requestID);
+    buffer += ",\"ip\":";
+    appendQuoted(buffer, record.clientIP);
+    buffer += ",\"type\":";
+    appendQuoted(buffer, record.requestType);
+    buffer += ",\"priority\":";
+    buffer += std::to_string(record.priority);
+    buffer += ",\"service\":";
+    buffer += std::to_string(record.serviceTime);
+    buffer += "}\n";
+    file << buffer;
+}
+
+/**
+ * @brief Flush and close the file
+ */
+void JsonlTraceWriter::close() {
+    file.close();
+}
@@ -0,0 +1,78 @@
+/**
+ * @file JsonlTrace.h
+ * @brief Header file for the JSONL trace reader and writer
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef JSONLTRACE_H
+#define JSONLTRACE_H
+
+#include "TraceFormat.h"
+#include <fstream>
+#include <string>
+
+/**
+ * @class JsonlTraceReader
+ * @brief Reads request traces stored as one JSON object per line
+ * 
+ * Each line is a flat object such as
+ * {"cycle":12,"id":40,"ip":"10.0.0.1","type":"GET","priority":5,"service":42}.
+ * Unknown keys are ignored and missing keys keep their defaults; blank
+ * lines are skipped.
+ */
+class JsonlTraceReader : public TraceSource {
+private:
+    std::ifstream file;   ///< Input file
+    std::string path;     ///< Input file path
+    std::string line;     ///< Current line buffer
+    long long lineNumber; ///< Current line number for error messages
+
+public:
+    /**
+     * @brief Open a JSONL trace
+     * @param tracePath Trace file path
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit JsonlTraceReader(const std::string& tracePath);
+
+    /**
+     * @brief Read the next record
+     * @param record Output record
+     * @return False at the end of the trace
+     * @throws std::runtime_error on malformed lines
+     */
+    bool next(TraceRecord& record) override;
+};
+
+/**
+ * @class JsonlTraceWriter
+ * @brief Writes request traces as one JSON object per line
+ */
+class JsonlTraceWriter : public TraceSink {
+private:
+    std::ofstream file;  ///< Output file
+    std::string buffer;  ///< Line formatting buffer
+
+public:
+    /**
+     * @brief Create a JSONL trace
+     * @param outputPath File to create (truncated if it exists)
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit JsonlTraceWriter(const std::string& outputPath);
+
+    /**
+     * @brief Append a record
+     * @param record Record to append
+     */
+    void write(const TraceRecord& record) override;
+
+    /**
+     * @brief Flush and close the file
+     */
+    void close() override;
+};
+
+#endif // JSONLTRACE_H
@@ -0,0 +1,162 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation file for the LatencyHistogram class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int SUB_BUCKET_BITS = 7;                          ///< log2 of the exact range
+const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;      ///< Values counted exactly (128)
+const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;       ///< Sub-buckets per power of two (64)
+const int BUCKET_COUNT = 64 - SUB_BUCKET_BITS + 1;      ///< Power-of-two ranges for 63-bit values
+const int INDEX_COUNT = SUB_BUCKET_COUNT + (BUCKET_COUNT - 1) * SUB_BUCKET_HALF;
+}
+
+/**
+ * @brief Default constructor
+ */
+LatencyHistogram::LatencyHistogram()
+    : counts(INDEX_COUNT, 0), totalCount(0), totalValue(0), minValue(0), maxValue(0) {
+}
+
+/**
+ * @brief Map a value to its bucket index
+ * @param value Non-negative value
+ * @return Bucket index
+ */
+int LatencyHistogram::bucketIndex(int64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<int>(value);
+    }
+    // Shift so the top SUB_BUCKET_BITS bits select the sub-bucket
+    int msb = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+    int shift = msb - (SUB_BUCKET_BITS - 1);
+    int subBucket = static_cast<int>(value >> shift); // in [64, 128)
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF);
+}
+
+/**
+ * @brief Highest value that maps to a bucket
+ * @param index Bucket index
+ * @return Upper bound of the bucket
+ */
+int64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    int64_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+/**
+ * @brief Record a value
+ * @param value Value to record (negative values count as 0)
+ */
+void LatencyHistogram::record(int64_t value) {
+    record(value, 1);
+}
+
+/**
+ * @brief Record the same value several times
+ * @param value Value to record
+ * @param count Number of occurrences
+ */
+void LatencyHistogram::record(int64_t value, uint64_t count) {
+    if (count == 0) return;
+    if (value < 0) value = 0;
+    
+    if (totalCount == 0 || value < minValue) minValue = value;
+    if (totalCount == 0 || value > maxValue) maxValue = value;
+    counts[bucketIndex(value)] += count;
+    totalCount += count;
+    totalValue += static_cast<long double>(value) * count;
+}
+
+/**
+ * @brief Add all counts of another histogram
+ * @param other Histogram to merge
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.totalCount == 0) return;
+    
+    if (totalCount == 0 || other.minValue < minValue) minValue = other.minValue;
+    if (totalCount == 0 || other.maxValue > maxValue) maxValue = other.maxValue;
+    for (int i = 0; i < INDEX_COUNT; ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    totalValue += other.totalValue;
+}
+
+/**
+ * @brief Remove all recorded values
+ */
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    totalValue = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+/**
+ * @brief Get the value at a percentile
+ * @param percentile Percentile in the range 0-100
+ * @return Upper bound of the bucket holding that percentile, or 0 if empty
+ */
+int64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+    
+    percentile = std::min(100.0, std::max(0.0, percentile));
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * totalCount));
+    if (rank == 0) rank = 1;
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < INDEX_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+/**
+ * @brief Get the number of recorded values
+ * @return Value count
+ */
+uint64_t LatencyHistogram::getCount() const {
+    return totalCount;
+}
+
+/**
+ * @brief Get the mean of the recorded values
+ * @return Mean, or 0 if empty
+ */
+double LatencyHistogram::getMean() const {
+    if (totalCount == 0) return 0.0;
+    return static_cast<double>(totalValue / totalCount);
+}
+
+/**
+ * @brief Get the smallest recorded value
+ * @return Minimum, or 0 if empty
+ */
+int64_t LatencyHistogram::getMin() const {
+    return minValue;
+}
+
+/**
+ * @brief Get the largest recorded value
+ * @return Maximum, or 0 if empty
+ */
+int64_t LatencyHistogram::getMax() const {
+    return maxValue;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief Header file for the LatencyHistogram class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-memory log-linear histogram for latency percentiles
+ * 
+ * Buckets follow the HDR histogram layout: values below 128 are counted
+ * exactly, and every power-of-two range above that is split into 64
+ * linear sub-buckets, giving better than 1.6% relative precision for any
+ * non-negative 64-bit value in about 30 KB, independent of sample count.
+ */
+class LatencyHistogram {
+private:
+    std::vector<uint64_t> counts; ///< Count per bucket
+    uint64_t totalCount;          ///< Number of recorded values
+    long double totalValue;       ///< Sum of recorded values (for the mean)
+    int64_t minValue;             ///< Smallest recorded value
+    int64_t maxValue;             ///< Largest recorded value
+
+    /**
+     * @brief Map a value to its bucket index
+     * @param value Non-negative value
+     * @return Bucket index
+     */
+    static int bucketIndex(int64_t value);
+
+    /**
+     * @brief Highest value that maps to a bucket
+     * @param index Bucket index
+     * @return Upper bound of the bucket
+     */
+    static int64_t bucketUpperBound(int index);
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Record a value
+     * @param value Value to record (negative values count as 0)
+     */
+    void record(int64_t value);
+
+    /**
+     * @brief Record the same value several times
+     * @param value Value to record
+     * @param count Number of occurrences
+     */
+    void record(int64_t value, uint64_t count);
+
+    /**
+     * @brief Add all counts of another histogram
+     * @param other Histogram to merge
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Remove all recorded values
+     */
+    void reset();
+
+    /**
+     * @brief Get the value at a percentile
+     * @param percentile Percentile in the range 0-100
+     * @return Upper bound of the bucket holding that percentile, or 0 if empty
+     */
+    int64_t getPercentile(double percentile) const;
+
+    /**
+     * @brief Get the number of recorded values
+     * @return Value count
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief Get the mean of the recorded values
+     * @return Mean, or 0 if empty
+     */
+    double getMean() const;
+
+    /**
+     * @brief Get the smallest recorded value
+     * @return Minimum, or 0 if empty
+     */
+    int64_t getMin() const;
+
+    /**
+     * @brief Get the largest recorded value
+     * @return Maximum, or 0 if empty
+     */
+    int64_t getMax() const;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -7,9 +7,8 @@
  */
 
 #include "LoadBalancer.h"
-#include <sstream>
+#include "TextBuffer.h"
 #include <algorithm>
-#include <iomanip>
 
 /**
  * @brief Default constructor
@@ -18,7 +17,8 @@
  */
 LoadBalancer::LoadBalancer() : nextServerIndex(0), totalRequestsProcessed(0), 
                                totalProcessingTime(0), maxServers(20), minServers(1), 
-                               loadThreshold(0.8) {
+                               loadThreshold(0.8), policy(DistributionPolicy::ROUND_ROBIN),
+                               currentCycle(0), totalLatency(0), totalRequestsRejected(0) {
     // Add one default server
     addServer();
 }
@@ -32,7 +32,9 @@ LoadBalancer::LoadBalancer() : nextServerIndex(0), totalRequestsProcessed(0),
  */
 LoadBalancer::LoadBalancer(int initialServers, int maxServerCount, int minServerCount, double threshold)
     : nextServerIndex(0), totalRequestsProcessed(0), totalProcessingTime(0),
-      maxServers(maxServerCount), minServers(minServerCount), loadThreshold(threshold) {
+      maxServers(maxServerCount), minServers(minServerCount), loadThreshold(threshold),
+      policy(DistributionPolicy::ROUND_ROBIN), currentCycle(0), totalLatency(0),
+      totalRequestsRejected(0) {
     
     // Add initial servers
     for (int i = 0; i < initialServers; ++i) {
@@ -40,6 +42,49 @@ LoadBalancer::LoadBalancer(int initialServers, int maxServerCount, int minServer
     }
 }
 
+/**
+ * @brief Copy constructor
+ * @param other Load balancer to copy
+ */
+LoadBalancer::LoadBalancer(const LoadBalancer& other)
+    : requestQueue(other.requestQueue), nextServerIndex(other.nextServerIndex),
+      totalRequestsProcessed(other.totalRequestsProcessed),
+      totalProcessingTime(other.totalProcessingTime), maxServers(other.maxServers),
+      minServers(other.minServers), loadThreshold(other.loadThreshold), policy(other.policy),
+      currentCycle(other.currentCycle), totalLatency(other.totalLatency),
+      totalRequestsRejected(other.totalRequestsRejected),
+      latencyHistogram(other.latencyHistogram) {
+    servers.reserve(other.servers.size());
+    for (const auto& server : other.servers) {
+        servers.push_back(std::make_unique<WebServer>(*server));
+    }
+}
+
+/**
+ * @brief Copy assignment operator
+ * @param other Load balancer to copy
+ * @return Reference to this load balancer
+ */
+LoadBalancer& LoadBalancer::operator=(const LoadBalancer& other) {
+    if (this != &other) {
+        LoadBalancer copy(other);
+        std::swap(servers, copy.servers);
+        requestQueue = copy.requestQueue;
+        nextServerIndex = copy.nextServerIndex;
+        totalRequestsProcessed = copy.totalRequestsProcessed;
+        totalProcessingTime = copy.totalProcessingTime;
+        maxServers = copy.maxServers;
+        minServers = copy.minServers;
+        loadThreshold = copy.loadThreshold;
+        policy = copy.policy;
+        currentCycle = copy.currentCycle;
+        totalLatency = copy.totalLatency;
+        totalRequestsRejected = copy.totalRequestsRejected;
+        latencyHistogram = copy.latencyHistogram;
+    }
+    return *this;
+}
+
 /**
  * @brief Destructor
  */
@@ -58,7 +103,7 @@ bool LoadBalancer::addServer() {
     
     int serverID = static_cast<int>(servers.size()) + 1;
     std::string serverIP = "192.168.1." + std::to_string(serverID);
-    servers.push_back(std::make_unique<WebServer>(serverID, serverIP, 5));
+    servers.push_back(std::make_unique<WebServer>(serverID, serverIP, SERVER_CAPACITY));
     
     return true;
 }
@@ -83,7 +128,30 @@ bool LoadBalancer::removeServer() {
  * @return True if request was added successfully
  */
 bool LoadBalancer::addRequest(const Request& request) {
-    return requestQueue.addRequest(request);
+    Request admitted = request;
+    admitted.setArrivalCycle(currentCycle);
+    if (!requestQueue.addRequest(admitted)) {
+        totalRequestsRejected++;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Add several requests arriving in the same cycle
+ *
+ * Checks them all against one blocklist snapshot instead of pinning
+ * one per request.
+ * @param requests Requests to add, in order; their arrival cycle is set
+ * @return Number of requests added
+ */
+size_t LoadBalancer::addRequests(std::vector<Request>& requests) {
+    for (auto& request : requests) {
+        request.setArrivalCycle(currentCycle);
+    }
+    size_t admitted = requestQueue.addRequests(requests);
+    totalRequestsRejected += static_cast<long long>(requests.size() - admitted);
+    return admitted;
 }
 
 /**
@@ -92,13 +160,21 @@ bool LoadBalancer::addRequest(const Request& request) {
  */
 int LoadBalancer::processCycle() {
     int totalCompleted = 0;
+    currentCycle++;
     
     // Process all servers
+    completedScratch.clear();
     for (auto& server : servers) {
         if (server->getIsActive()) {
-            totalCompleted += server->processCycle();
+            totalCompleted += server->processCycle(&completedScratch);
         }
     }
+    for (const auto& request : completedScratch) {
+        long long latency = currentCycle - request.getArrivalCycle();
+        totalLatency += latency;
+        totalProcessingTime += request.getServiceTime();
+        latencyHistogram.record(latency);
+    }
     
     // Distribute requests from queue to available servers
     distributeRequests();
@@ -111,7 +187,37 @@ int LoadBalancer::processCycle() {
 }
 
 /**
- * @brief Distribute requests to servers using round-robin algorithm
+ * @brief Select the server for the next request according to the policy
+ * @return Index of the chosen server, or -1 if none can accept
+ */
+int LoadBalancer::selectServer() const {
+    int serverCount = static_cast<int>(servers.size());
+    
+    if (policy == DistributionPolicy::LEAST_CONNECTIONS) {
+        // Lowest current load wins; ties go to the earliest server after the cursor
+        int best = -1;
+        for (int i = 0; i < serverCount; ++i) {
+            int currentIndex = (nextServerIndex + i) % serverCount;
+            if (servers[currentIndex]->canAcceptRequest() &&
+                (best < 0 || servers[currentIndex]->getCurrentLoad() < servers[best]->getCurrentLoad())) {
+                best = currentIndex;
+            }
+        }
+        return best;
+    }
+    
+    // Round-robin: first available server starting from nextServerIndex
+    for (int i = 0; i < serverCount; ++i) {
+        int currentIndex = (nextServerIndex + i) % serverCount;
+        if (servers[currentIndex]->canAcceptRequest()) {
+            return currentIndex;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Distribute requests to servers using the configured policy
  */
 void LoadBalancer::distributeRequests() {
     if (requestQueue.isEmpty()) {
@@ -122,32 +228,85 @@ void LoadBalancer::distributeRequests() {
     int maxAttempts = servers.size() * 2; // Prevent infinite loops
     
     while (!requestQueue.isEmpty() && attempts < maxAttempts) {
-        // Find next available server using round-robin
-        int serverIndex = nextServerIndex;
-        bool requestAssigned = false;
-        
-        // Try to find an available server starting from nextServerIndex
-        for (size_t i = 0; i < servers.size(); ++i) {
-            int currentIndex = (serverIndex + i) % servers.size();
-            
-            if (servers[currentIndex]->canAcceptRequest()) {
-                Request request = requestQueue.getNextRequest();
-                if (servers[currentIndex]->addRequest(request)) {
-                    nextServerIndex = (currentIndex + 1) % servers.size();
-                    requestAssigned = true;
-                    break;
-                }
-            }
+        int currentIndex = selectServer();
+        if (currentIndex < 0) {
+            break; // No servers available
         }
         
-        if (!requestAssigned) {
-            break; // No servers available
+        Request request = requestQueue.getNextRequest();
+        if (!servers[currentIndex]->addRequest(request)) {
+            break;
         }
+        nextServerIndex = (currentIndex + 1) % servers.size();
         
         attempts++;
     }
 }
 
+/**
+ * @brief Set the server selection policy
+ * @param newPolicy Policy to use for subsequent distribution
+ */
+void LoadBalancer::setDistributionPolicy(DistributionPolicy newPolicy) {
+    policy = newPolicy;
+}
+
+/**
+ * @brief Get the server selection policy
+ * @return Current distribution policy
+ */
+DistributionPolicy LoadBalancer::getDistributionPolicy() const {
+    return policy;
+}
+
+/**
+ * @brief Get the number of cycles processed so far
+ * @return Current simulation cycle
+ */
+long long LoadBalancer::getCurrentCycle() const {
+    return currentCycle;
+}
+
+/**
+ * @brief Get the average end-to-end latency of completed requests
+ * @return Average cycles from admission to completion, or 0 if none completed
+ */
+double LoadBalancer::getAverageLatency() const {
+    if (totalRequestsProcessed == 0) return 0.0;
+    return static_cast<double>(totalLatency) / totalRequestsProcessed;
+}
+
+/**
+ * @brief Get the distribution of end-to-end latencies
+ * @return Latency histogram in cycles
+ */
+const LatencyHistogram& LoadBalancer::getLatencyHistogram() const {
+    return latencyHistogram;
+}
+
+/**
+ * @brief Discard recorded latencies, e.g. at the end of a warm-up period
+ */
+void LoadBalancer::resetLatencyHistogram() {
+    latencyHistogram.reset();
+}
+
+/**
+ * @brief Get the number of requests refused at admission
+ * @return Total rejected requests
+ */
+long long LoadBalancer::getTotalRequestsRejected() const {
+    return totalRequestsRejected;
+}
+
+/**
+ * @brief Get the sum of end-to-end latencies of completed requests
+ * @return Total latency in cycles
+ */
+long long LoadBalancer::getTotalLatency() const {
+    return totalLatency;
+}
+
 /**
  * @brief Check if load balancing is needed and adjust server count
  */
@@ -188,7 +347,7 @@ int LoadBalancer::getActiveServerCount() const {
  * @brief Get the total number of requests processed
  * @return Total requests processed by all servers
  */
-int LoadBalancer::getTotalRequestsProcessed() const {
+long long LoadBalancer::getTotalRequestsProcessed() const {
     return totalRequestsProcessed;
 }
 
@@ -230,6 +389,23 @@ double LoadBalancer::getQueueUtilization() const {
     return requestQueue.getUtilization();
 }
 
+/**
+ * @brief Get the number of servers, active or not
+ * @return Server count
+ */
+int LoadBalancer::getServerCount() const {
+    return static_cast<int>(servers.size());
+}
+
+/**
+ * @brief Get a server by position
+ * @param index Server index in [0, getServerCount())
+ * @return Server
+ */
+const WebServer& LoadBalancer::getServer(int index) const {
+    return *servers[index];
+}
+
 /**
  * @brief Get server statistics
  * @return Vector of server statistics strings
@@ -237,15 +413,17 @@ double LoadBalancer::getQueueUtilization() const {
 std::vector<std::string> LoadBalancer::getServerStats() const {
     std::vector<std::string> stats;
     
+    stats.reserve(servers.size());
+    TextBuffer line;
     for (const auto& server : servers) {
-        std::stringstream ss;
-        ss << "Server " << server->getServerID() 
-           << " (" << server->getServerIP() << "): "
-           << "Load: " << server->getCurrentLoad() << "/" << server->getMaxCapacity()
-           << " (" << std::fixed << std::setprecision(1) << server->getUtilization() << "%)"
-           << " | Processed: " << server->getTotalRequestsProcessed()
-           << " | Active: " << (server->getIsActive() ? "Yes" : "No");
-        stats.push_back(ss.str());
+        line.clear();
+        line.append("Server ").appendInt(server->getServerID())
+            .append(" (").append(server->getServerIP()).append("): ")
+            .append("Load: ").appendInt(server->getCurrentLoad()).append('/').appendInt(server->getMaxCapacity())
+            .append(" (").appendFixed(server->getUtilization(), 1).append("%)")
+            .append(" | Processed: ").appendInt(server->getTotalRequestsProcessed())
+            .append(" | Active: ").append(server->getIsActive() ? "Yes" : "No");
+        stats.push_back(line.str());
     }
     
     return stats;
@@ -255,7 +433,7 @@ std::vector<std::string> LoadBalancer::getServerStats() const {
  * @brief Block an IP address across all components
  * @param ip IP address to block
  */
-void LoadBalancer::blockIP(const std::string& ip) {
+void LoadBalancer::blockIP(const IPAddress& ip) {
     requestQueue.blockIP(ip);
 }
 
@@ -263,7 +441,7 @@ void LoadBalancer::blockIP(const std::string& ip) {
  * @brief Unblock an IP address across all components
  * @param ip IP address to unblock
  */
-void LoadBalancer::unblockIP(const std::string& ip) {
+void LoadBalancer::unblockIP(const IPAddress& ip) {
     requestQueue.unblockIP(ip);
 }
 
@@ -275,6 +453,48 @@ int LoadBalancer::getQueueSize() const {
     return requestQueue.getSize();
 }
 
+/**
+ * @brief Get the maximum queue size
+ * @return Maximum number of requests the queue accepts
+ */
+int LoadBalancer::getMaxQueueSize() const {
+    return requestQueue.getMaxSize();
+}
+
+/**
+ * @brief Set the maximum queue size
+ * @param maxQueueSize Maximum number of requests the queue accepts
+ */
+void LoadBalancer::setMaxQueueSize(int maxQueueSize) {
+    requestQueue.setMaxSize(maxQueueSize);
+}
+
+/**
+ * @brief Limit the memory used by queued requests, spilling the rest to disk
+ * @param bytes Byte budget (0 keeps everything in memory)
+ * @param directory Directory for spill segment files
+ * @throws std::runtime_error if a budget is set and @p directory is not writable
+ */
+void LoadBalancer::setQueueMemoryBudget(size_t bytes, const std::string& directory) {
+    requestQueue.setMemoryBudget(bytes, directory);
+}
+
+/**
+ * @brief Get the request queue
+ * @return Read-only reference to the queue
+ */
+const RequestQueue& LoadBalancer::getRequestQueue() const {
+    return requestQueue;
+}
+
+/**
+ * @brief Get the blocklist store, e.g. to publish a reloaded blocklist
+ * @return Blocklist store shared by admission checks
+ */
+BlocklistStore& LoadBalancer::getBlocklistStore() {
+    return requestQueue.getBlocklistStore();
+}
+
 /**
  * @brief Check if the system is overloaded
  * @return True if system is overloaded, false otherwise
@@ -11,10 +11,20 @@
 
 #include "WebServer.h"
 #include "RequestQueue.h"
+#include "LatencyHistogram.h"
 #include <vector>
 #include <string>
 #include <memory>
 
+/**
+ * @enum DistributionPolicy
+ * @brief Strategy used to pick the server that receives the next request
+ */
+enum class DistributionPolicy {
+    ROUND_ROBIN,       ///< Rotate through servers in order
+    LEAST_CONNECTIONS  ///< Pick the server with the lowest current load
+};
+
 /**
  * @class LoadBalancer
  * @brief Manages web servers and distributes requests among them
@@ -29,13 +39,27 @@ private:
     std::vector<std::unique_ptr<WebServer>> servers; ///< Vector of web servers
     RequestQueue requestQueue;                        ///< Queue of pending requests
     int nextServerIndex;                              ///< Index for round-robin distribution
-    int totalRequestsProcessed;                       ///< Total requests processed by all servers
-    int totalProcessingTime;                          ///< Total processing time across all servers
+    long long totalRequestsProcessed;                 ///< Total requests processed by all servers
+    long long totalProcessingTime;                    ///< Total service time of processed requests
     int maxServers;                                   ///< Maximum number of servers allowed
     int minServers;                                   ///< Minimum number of servers to maintain
     double loadThreshold;                             ///< Load threshold for adding/removing servers
+    DistributionPolicy policy;                        ///< Server selection policy
+    long long currentCycle;                           ///< Number of cycles processed so far
+    long long totalLatency;                           ///< Sum of end-to-end latencies in cycles
+    long long totalRequestsRejected;                  ///< Requests refused by the queue
+    std::vector<Request> completedScratch;            ///< Reused buffer for completed requests
+    LatencyHistogram latencyHistogram;                ///< Distribution of end-to-end latencies
+
+    /**
+     * @brief Select the server for the next request according to the policy
+     * @return Index of the chosen server, or -1 if none can accept
+     */
+    int selectServer() const;
 
 public:
+    static constexpr int SERVER_CAPACITY = 5;            ///< Concurrent requests per added server
+
     /**
      * @brief Default constructor
      */
@@ -50,6 +74,22 @@ public:
      */
     LoadBalancer(int initialServers, int maxServerCount, int minServerCount, double threshold);
 
+    /**
+     * @brief Copy constructor
+     * 
+     * Deep-copies every server so the copy can be advanced independently,
+     * e.g. when cloning simulation state for rare-event splitting.
+     * @param other Load balancer to copy
+     */
+    LoadBalancer(const LoadBalancer& other);
+
+    /**
+     * @brief Copy assignment operator
+     * @param other Load balancer to copy
+     * @return Reference to this load balancer
+     */
+    LoadBalancer& operator=(const LoadBalancer& other);
+
     /**
      * @brief Destructor
      */
@@ -74,6 +114,16 @@ public:
      */
     bool addRequest(const Request& request);
 
+    /**
+     * @brief Add several requests arriving in the same cycle
+     *
+     * Checks them all against one blocklist snapshot instead of pinning
+     * one per request.
+     * @param requests Requests to add, in order; their arrival cycle is set
+     * @return Number of requests added
+     */
+    size_t addRequests(std::vector<Request>& requests);
+
     /**
      * @brief Process one clock cycle of the load balancer
      * @return Number of requests completed in this cycle
@@ -81,10 +131,57 @@ public:
     int processCycle();
 
     /**
-     * @brief Distribute requests to servers using round-robin algorithm
+     * @brief Distribute requests to servers using the configured policy
      */
     void distributeRequests();
 
+    /**
+     * @brief Set the server selection policy
+     * @param newPolicy Policy to use for subsequent distribution
+     */
+    void setDistributionPolicy(DistributionPolicy newPolicy);
+
+    /**
+     * @brief Get the server selection policy
+     * @return Current distribution policy
+     */
+    DistributionPolicy getDistributionPolicy() const;
+
+    /**
+     * @brief Get the number of cycles processed so far
+     * @return Current simulation cycle
+     */
+    long long getCurrentCycle() const;
+
+    /**
+     * @brief Get the average end-to-end latency of completed requests
+     * @return Average cycles from admission to completion, or 0 if none completed
+     */
+    double getAverageLatency() const;
+
+    /**
+     * @brief Get the distribution of end-to-end latencies
+     * @return Latency histogram in cycles
+     */
+    const LatencyHistogram& getLatencyHistogram() const;
+
+    /**
+     * @brief Discard recorded latencies, e.g. at the end of a warm-up period
+     */
+    void resetLatencyHistogram();
+
+    /**
+     * @brief Get the number of requests refused at admission
+     * @return Total rejected requests
+     */
+    long long getTotalRequestsRejected() const;
+
+    /**
+     * @brief Get the sum of end-to-end latencies of completed requests
+     * @return Total latency in cycles
+     */
+    long long getTotalLatency() const;
+
     /**
      * @brief Check if load balancing is needed and adjust server count
      */
@@ -100,7 +197,7 @@ public:
      * @brief Get the total number of requests processed
      * @return Total requests processed by all servers
      */
-    int getTotalRequestsProcessed() const;
+    long long getTotalRequestsProcessed() const;
 
     /**
      * @brief Get the average processing time across all servers
@@ -120,6 +217,19 @@ public:
      */
     double getQueueUtilization() const;
 
+    /**
+     * @brief Get the number of servers, active or not
+     * @return Server count
+     */
+    int getServerCount() const;
+
+    /**
+     * @brief Get a server by position
+     * @param index Server index in [0, getServerCount())
+     * @return Server
+     */
+    const WebServer& getServer(int index) const;
+
     /**
      * @brief Get server statistics
      * @return Vector of server statistics strings
@@ -130,13 +240,13 @@ public:
      * @brief Block an IP address across all components
      * @param ip IP address to block
      */
-    void blockIP(const std::string& ip);
+    void blockIP(const IPAddress& ip);
 
     /**
      * @brief Unblock an IP address across all components
      * @param ip IP address to unblock
      */
-    void unblockIP(const std::string& ip);
+    void unblockIP(const IPAddress& ip);
 
     /**
      * @brief Get the current queue size
@@ -144,6 +254,38 @@ public:
      */
     int getQueueSize() const;
 
+    /**
+     * @brief Get the maximum queue size
+     * @return Maximum number of requests the queue accepts
+     */
+    int getMaxQueueSize() const;
+
+    /**
+     * @brief Set the maximum queue size
+     * @param maxQueueSize Maximum number of requests the queue accepts
+     */
+    void setMaxQueueSize(int maxQueueSize);
+
+    /**
+     * @brief Limit the memory used by queued requests, spilling the rest to disk
+     * @param bytes Byte budget (0 keeps everything in memory)
+     * @param directory Directory for spill segment files
+     * @throws std::runtime_error if a budget is set and @p directory is not writable
+     */
+    void setQueueMemoryBudget(size_t bytes, const std::string& directory);
+
+    /**
+     * @brief Get the request queue
+     * @return Read-only reference to the queue
+     */
+    const RequestQueue& getRequestQueue() const;
+
+    /**
+     * @brief Get the blocklist store, e.g. to publish a reloaded blocklist
+     * @return Blocklist store shared by admission checks
+     */
+    BlocklistStore& getBlocklistStore();
+
     /**
      * @brief Check if the system is overloaded
      * @return True if system is overloaded, false otherwise
@@ -0,0 +1,294 @@
+/**
+ * @file LoadBalancerAPI.cpp
+ * @brief Implementation of the C API over LoadBalancer
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LoadBalancerAPI.h"
+#include "LoadBalancer.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @struct lb_balancer
+ * @brief Handle wrapping a LoadBalancer
+ */
+struct lb_balancer {
+    LoadBalancer loadBalancer;  ///< Wrapped simulator
+};
+
+namespace {
+
+thread_local std::string lastError;  ///< Message of the last failure on this thread
+
+/**
+ * @brief Record a failure for lb_last_error()
+ * @param message Error message
+ */
+void setError(const std::string& message) {
+    lastError = message;
+}
+
+/**
+ * @brief Run an API body, turning exceptions into an error return
+ * @param failure Value returned on failure
+ * @param body Function implementing the call
+ * @return Result of body, or failure if it threw
+ */
+template <typename T, typename Body>
+T guarded(T failure, Body body) {
+    try {
+        return body();
+    } catch (const std::exception& e) {
+        setError(e.what());
+    } catch (...) {
+        setError("unknown error");
+    }
+    return failure;
+}
+
+/**
+ * @brief Parse a client address passed through the API
+ * @param text Address text, or NULL for 0.0.0.0
+ * @return Packed address
+ * @throws std::invalid_argument if the text is not an IPv4 or IPv6 address
+ */
+IPAddress parseAddress(const char* text) {
+    IPAddress address = IPAddress::fromIPv4(0);
+    if (text != nullptr && !IPAddress::parse(text, std::strlen(text), address)) {
+        throw std::invalid_argument(std::string("invalid client address: ") + text);
+    }
+    return address;
+}
+
+/**
+ * @brief Get the simulator defaults in API form
+ * @return Default configuration
+ */
+lb_config defaultConfig() {
+    SimulationConfig defaults;
+    lb_config config;
+    config.initial_servers = defaults.initialServers;
+    config.max_servers = defaults.maxServers;
+    config.min_servers = defaults.minServers;
+    config.load_threshold = defaults.loadThreshold;
+    config.policy = LB_POLICY_ROUND_ROBIN;
+    config.max_queue_size = defaults.maxQueueSize;
+    return config;
+}
+
+} // namespace
+
+/**
+ * @brief Get the API version the library implements
+ * @return LB_API_VERSION of the library
+ */
+int lb_api_version(void) {
+    return LB_API_VERSION;
+}
+
+/**
+ * @brief Fill a configuration with the simulator defaults
+ * @param config Configuration to initialize
+ * @param config_size sizeof(lb_config) as seen by the caller
+ */
+void lb_config_init(lb_config* config, size_t config_size) {
+    if (config == nullptr) {
+        return;
+    }
+    lb_config defaults = defaultConfig();
+    std::memcpy(config, &defaults, std::min(config_size, sizeof(lb_config)));
+}
+
+/**
+ * @brief Create a load balancer
+ * @param config Settings, or NULL for the defaults
+ * @param config_size sizeof(lb_config) as seen by the caller
+ * @return New handle, or NULL on failure
+ */
+lb_balancer* lb_create(const lb_config* config, size_t config_size) {
+    // Fields an older caller does not know about keep their defaults
+    lb_config settings = defaultConfig();
+    if (config != nullptr) {
+        std::memcpy(&settings, config, std::min(config_size, sizeof(lb_config)));
+    }
+    if (settings.initial_servers < 0 || settings.max_servers < 1 || settings.min_servers < 0 ||
+        settings.max_queue_size < 0) {
+        setError("invalid server or queue limits");
+        return nullptr;
+    }
+    if (settings.policy != LB_POLICY_ROUND_ROBIN && settings.policy != LB_POLICY_LEAST_CONNECTIONS) {
+        setError("unknown distribution policy");
+        return nullptr;
+    }
+    
+    return guarded<lb_balancer*>(nullptr, [&settings]() {
+        SimulationConfig simulationConfig;
+        simulationConfig.initialServers = settings.initial_servers;
+        simulationConfig.maxServers = settings.max_servers;
+        simulationConfig.minServers = settings.min_servers;
+        simulationConfig.loadThreshold = settings.load_threshold;
+        simulationConfig.policy = settings.policy == LB_POLICY_LEAST_CONNECTIONS
+                                      ? DistributionPolicy::LEAST_CONNECTIONS
+                                      : DistributionPolicy::ROUND_ROBIN;
+        simulationConfig.maxQueueSize = settings.max_queue_size;
+        return new lb_balancer{createLoadBalancer(simulationConfig)};
+    });
+}
+
+/**
+ * @brief Destroy a load balancer
+ * @param balancer Handle from lb_create(), or NULL
+ */
+void lb_destroy(lb_balancer* balancer) {
+    delete balancer;
+}
+
+/**
+ * @brief Offer a batch of requests to the queue
+ * @param balancer Load balancer
+ * @param requests Requests to submit
+ * @param count Number of requests
+ * @return Number admitted (the rest were rejected), or -1 on failure; nothing is
+ *         submitted if any client address is invalid
+ */
+long long lb_submit(lb_balancer* balancer, const lb_request* requests, size_t count) {
+    if (balancer == nullptr || (requests == nullptr && count > 0)) {
+        setError("null balancer or request array");
+        return -1;
+    }
+    return guarded<long long>(-1, [balancer, requests, count]() {
+        // Validate every address first so a bad one leaves the balancer untouched
+        for (size_t i = 0; i < count; ++i) {
+            parseAddress(requests[i].client_ip);
+        }
+        std::vector<Request> batch;
+        batch.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const lb_request& submitted = requests[i];
+            batch.emplace_back(parseAddress(submitted.client_ip),
+                               submitted.request_type != nullptr ? submitted.request_type : "GET",
+                               submitted.priority, submitted.service_time, submitted.id);
+        }
+        return static_cast<long long>(balancer->loadBalancer.addRequests(batch));
+    });
+}
+
+/**
+ * @brief Advance the simulation
+ * @param balancer Load balancer
+ * @param cycles Cycles to process
+ * @return Requests completed during these cycles, or -1 on failure
+ */
+long long lb_step(lb_balancer* balancer, long long cycles) {
+    if (balancer == nullptr || cycles < 0) {
+        setError("null balancer or negative cycle count");
+        return -1;
+    }
+    return guarded<long long>(-1, [balancer, cycles]() {
+        long long completed = 0;
+        for (long long cycle = 0; cycle < cycles; ++cycle) {
+            completed += balancer->loadBalancer.processCycle();
+        }
+        return completed;
+    });
+}
+
+/**
+ * @brief Read the balancer's counters
+ * @param balancer Load balancer
+ * @param stats Output statistics
+ * @param stats_size sizeof(lb_stats) as seen by the caller
+ * @return 0 on success, -1 on failure
+ */
+int lb_get_stats(const lb_balancer* balancer, lb_stats* stats, size_t stats_size) {
+    if (balancer == nullptr || stats == nullptr) {
+        setError("null balancer or stats");
+        return -1;
+    }
+    const LoadBalancer& loadBalancer = balancer->loadBalancer;
+    const LatencyHistogram& latencies = loadBalancer.getLatencyHistogram();
+    
+    lb_stats current;
+    current.cycle = loadBalancer.getCurrentCycle();
+    current.processed = loadBalancer.getTotalRequestsProcessed();
+    current.rejected = loadBalancer.getTotalRequestsRejected();
+    current.total_latency = loadBalancer.getTotalLatency();
+    current.queue_size = loadBalancer.getQueueSize();
+    current.servers = loadBalancer.getServerCount();
+    current.active_servers = loadBalancer.getActiveServerCount();
+    current.utilization = loadBalancer.getSystemUtilization();
+    current.average_latency = loadBalancer.getAverageLatency();
+    current.average_processing_time = loadBalancer.getAverageProcessingTime();
+    current.latency_p50 = latencies.getPercentile(50.0);
+    current.latency_p95 = latencies.getPercentile(95.0);
+    current.latency_p99 = latencies.getPercentile(99.0);
+    current.latency_max = latencies.getPercentile(100.0);
+    
+    // A caller built against an older header receives only the fields it knows
+    std::memcpy(stats, &current, std::min(stats_size, sizeof(lb_stats)));
+    return 0;
+}
+
+/**
+ * @brief Refuse further requests from a client
+ * @param balancer Load balancer
+ * @param ip Client IPv4 or IPv6 address
+ * @return 0 on success, -1 on failure (including an invalid address)
+ */
+int lb_block_ip(lb_balancer* balancer, const char* ip) {
+    if (balancer == nullptr || ip == nullptr) {
+        setError("null balancer or address");
+        return -1;
+    }
+    return guarded<int>(-1, [balancer, ip]() {
+        balancer->loadBalancer.blockIP(parseAddress(ip));
+        return 0;
+    });
+}
+
+/**
+ * @brief Accept requests from a previously blocked client again
+ * @param balancer Load balancer
+ * @param ip Client IPv4 or IPv6 address
+ * @return 0 on success, -1 on failure (including an invalid address)
+ */
+int lb_unblock_ip(lb_balancer* balancer, const char* ip) {
+    if (balancer == nullptr || ip == nullptr) {
+        setError("null balancer or address");
+        return -1;
+    }
+    return guarded<int>(-1, [balancer, ip]() {
+        balancer->loadBalancer.unblockIP(parseAddress(ip));
+        return 0;
+    });
+}
+
+/**
+ * @brief Discard recorded latencies, e.g. at the end of a warm-up period
+ * @param balancer Load balancer
+ * @return 0 on success, -1 on failure
+ */
+int lb_reset_latency(lb_balancer* balancer) {
+    if (balancer == nullptr) {
+        setError("null balancer");
+        return -1;
+    }
+    balancer->loadBalancer.resetLatencyHistogram();
+    return 0;
+}
+
+/**
+ * @brief Describe the most recent failure on the calling thread
+ * @return Error message, empty if no call has failed
+ */
+const char* lb_last_error(void) {
+    return lastError.c_str();
+}
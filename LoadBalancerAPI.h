@@ -0,0 +1,182 @@
+/**
+ * @file LoadBalancerAPI.h
+ * @brief Stable C API of the load balancer simulator (libloadbalancer)
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ * 
+ * Lets other programs embed the simulator in-process instead of spawning
+ * the loadbalancer executable and parsing its output. The header is plain
+ * C. Structures passed across the API carry their size as an argument, so
+ * fields can be appended in later versions without breaking callers built
+ * against older headers.
+ * 
+ * Functions never throw: failures return NULL or -1 and lb_last_error()
+ * describes the most recent failure on the calling thread. A balancer
+ * handle must not be used by two threads at once; separate handles are
+ * independent.
+ */
+
+#ifndef LOADBALANCERAPI_H
+#define LOADBALANCERAPI_H
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define LB_API __attribute__((visibility("default")))
+#else
+#define LB_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of this API; incremented when functions or fields are added */
+#define LB_API_VERSION 1
+
+/** Round-robin server selection */
+#define LB_POLICY_ROUND_ROBIN 0
+/** Least-connections server selection */
+#define LB_POLICY_LEAST_CONNECTIONS 1
+
+/**
+ * @struct lb_balancer
+ * @brief Opaque handle to a simulated load balancer
+ */
+typedef struct lb_balancer lb_balancer;
+
+/**
+ * @struct lb_config
+ * @brief Load balancer settings; initialize with lb_config_init()
+ */
+typedef struct lb_config {
+    int initial_servers;    /**< Servers at start */
+    int max_servers;        /**< Upper scaling bound */
+    int min_servers;        /**< Lower scaling bound */
+    double load_threshold;  /**< Scaling threshold (0.0-1.0) */
+    int policy;             /**< LB_POLICY_ROUND_ROBIN or LB_POLICY_LEAST_CONNECTIONS */
+    int max_queue_size;     /**< Request queue capacity */
+} lb_config;
+
+/**
+ * @struct lb_request
+ * @brief One request to submit
+ */
+typedef struct lb_request {
+    const char* client_ip;     /**< Client IPv4 or IPv6 address, NULL for "0.0.0.0" */
+    const char* request_type;  /**< Request type, NULL for "GET" */
+    int priority;              /**< Priority (1-10) */
+    int service_time;          /**< Processing time in cycles */
+    long long id;              /**< Caller-chosen request ID */
+} lb_request;
+
+/**
+ * @struct lb_stats
+ * @brief Numeric state of a balancer
+ */
+typedef struct lb_stats {
+    long long cycle;                  /**< Cycles processed */
+    long long processed;              /**< Requests completed */
+    long long rejected;               /**< Requests refused at admission */
+    long long total_latency;          /**< Sum of end-to-end latencies in cycles */
+    int queue_size;                   /**< Requests waiting in the queue */
+    int servers;                      /**< Servers currently in the fleet */
+    int active_servers;               /**< Servers currently active */
+    double utilization;               /**< Average server utilization (0-100) */
+    double average_latency;           /**< Mean end-to-end latency in cycles */
+    double average_processing_time;   /**< Mean service time of completed requests */
+    long long latency_p50;            /**< Median latency (histogram bucket bound) */
+    long long latency_p95;            /**< 95th percentile latency */
+    long long latency_p99;            /**< 99th percentile latency */
+    long long latency_max;            /**< Largest latency recorded */
+} lb_stats;
+
+/**
+ * @brief Get the API version the library implements
+ * @return LB_API_VERSION of the library
+ */
+LB_API int lb_api_version(void);
+
+/**
+ * @brief Fill a configuration with the simulator defaults
+ * @param config Configuration to initialize
+ * @param config_size sizeof(lb_config) as seen by the caller
+ */
+LB_API void lb_config_init(lb_config* config, size_t config_size);
+
+/**
+ * @brief Create a load balancer
+ * @param config Settings, or NULL for the defaults
+ * @param config_size sizeof(lb_config) as seen by the caller
+ * @return New handle, or NULL on failure
+ */
+LB_API lb_balancer* lb_create(const lb_config* config, size_t config_size);
+
+/**
+ * @brief Destroy a load balancer
+ * @param balancer Handle from lb_create(), or NULL
+ */
+LB_API void lb_destroy(lb_balancer* balancer);
+
+/**
+ * @brief Offer a batch of requests to the queue
+ * @param balancer Load balancer
+ * @param requests Requests to submit
+ * @param count Number of requests
+ * @return Number admitted (the rest were rejected), or -1 on failure; nothing is
+ *         submitted if any client address is invalid
+ */
+LB_API long long lb_submit(lb_balancer* balancer, const lb_request* requests, size_t count);
+
+/**
+ * @brief Advance the simulation
+ * @param balancer Load balancer
+ * @param cycles Cycles to process
+ * @return Requests completed during these cycles, or -1 on failure
+ */
+LB_API long long lb_step(lb_balancer* balancer, long long cycles);
+
+/**
+ * @brief Read the balancer's counters
+ * @param balancer Load balancer
+ * @param stats Output statistics
+ * @param stats_size sizeof(lb_stats) as seen by the caller
+ * @return 0 on success, -1 on failure
+ */
+LB_API int lb_get_stats(const lb_balancer* balancer, lb_stats* stats, size_t stats_size);
+
+/**
+ * @brief Refuse further requests from a client
+ * @param balancer Load balancer
+ * @param ip Client IPv4 or IPv6 address
+ * @return 0 on success, -1 on failure (including an invalid address)
+ */
+LB_API int lb_block_ip(lb_balancer* balancer, const char* ip);
+
+/**
+ * @brief Accept requests from a previously blocked client again
+ * @param balancer Load balancer
+ * @param ip Client IPv4 or IPv6 address
+ * @return 0 on success, -1 on failure (including an invalid address)
+ */
+LB_API int lb_unblock_ip(lb_balancer* balancer, const char* ip);
+
+/**
+ * @brief Discard recorded latencies, e.g. at the end of a warm-up period
+ * @param balancer Load balancer
+ * @return 0 on success, -1 on failure
+ */
+LB_API int lb_reset_latency(lb_balancer* balancer);
+
+/**
+ * @brief Describe the most recent failure on the calling thread
+ * @return Error message, empty if no call has failed
+ */
+LB_API const char* lb_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOADBALANCERAPI_H */
@@ -0,0 +1,515 @@
+/**
+ * @file LoadGenerator.cpp
+ * @brief Implementation file for the LoadGenerator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LoadGenerator.h"
+#include "HttpParser.h"
+#include "SocketUtils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const size_t READ_CHUNK = 16 * 1024;              ///< Bytes requested per read
+const uint64_t TIMER_EVENT = std::numeric_limits<uint64_t>::max(); ///< Epoll tag of the timer
+const uint64_t START_DELAY = 100000000ULL;        ///< Nanoseconds allowed for connecting before the first send
+
+} // namespace
+
+/**
+ * @class LoadGenerator::Worker
+ * @brief One event loop sending its share of the schedule
+ */
+class LoadGenerator::Worker {
+private:
+    /**
+     * @struct Pending
+     * @brief A request awaiting its response
+     */
+    struct Pending {
+        uint64_t intended;  ///< Scheduled send time
+        uint64_t sent;      ///< Actual send time
+        bool head;          ///< HEAD request, answered without a body
+    };
+
+    /**
+     * @struct Connection
+     * @brief State of one keep-alive connection
+     */
+    struct Connection {
+        int fd = -1;                   ///< Socket, -1 if closed
+        bool connecting = false;       ///< Connect still in progress
+        bool writing = false;          ///< Waiting for the socket to become writable
+        HttpParser parser;             ///< Response framing state
+        std::string output;            ///< Requests not yet sent
+        size_t written = 0;            ///< Bytes of output already sent
+        std::vector<char> input;       ///< Receive buffer
+        size_t inputLength = 0;        ///< Valid bytes in input
+        size_t consumed = 0;           ///< Bytes of input already parsed
+        std::deque<Pending> outstanding; ///< Requests in response order
+    };
+
+    const LoadGenConfig& config;          ///< Test settings
+    sockaddr_in target;                   ///< Server address
+    std::string hostHeader;               ///< Value of the Host header
+    ArrivalSchedule schedule;             ///< This thread's requests
+    int epollFd;                          ///< Event queue
+    int timerFd;                          ///< Fires at the next send time
+    uint64_t armedDeadline;               ///< Time timerFd is set to
+    std::vector<Connection> connections;  ///< This thread's connections
+    size_t nextConnection;                ///< Round-robin position
+    std::vector<size_t> dirty;            ///< Connections with requests to flush
+    long long inFlight;                   ///< Requests sent and not yet answered or failed
+    uint64_t startTime;                   ///< Time of schedule offset zero
+    uint64_t endTime;                     ///< No sends are scheduled from here on
+    uint64_t warmupEnd;                   ///< Requests intended before this are not recorded
+    uint64_t lastResponse;                ///< Time of the latest response
+    LoadGenResult result;                 ///< This thread's results
+
+    /**
+     * @brief Set the epoll interest of a connection
+     * @param index Connection index
+     * @param operation EPOLL_CTL_ADD or EPOLL_CTL_MOD
+     * @param output Whether to wait for writability too
+     */
+    void watch(size_t index, int operation, bool output) {
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP | (output ? static_cast<uint32_t>(EPOLLOUT) : 0U);
+        event.data.u64 = index;
+        ::epoll_ctl(epollFd, operation, connections[index].fd, &event);
+    }
+
+    /**
+     * @brief Start connecting a closed connection
+     * @param index Connection index
+     * @return False if the connect failed at once
+     */
+    bool open(size_t index) {
+        Connection& connection = connections[index];
+        int fd = connectNonBlocking(target);
+        if (fd < 0) {
+            return false;
+        }
+        result.connects++;
+        connection.fd = fd;
+        // Writability signals that the connect finished
+        connection.connecting = true;
+        connection.writing = true;
+        watch(index, EPOLL_CTL_ADD, true);
+        return true;
+    }
+
+    /**
+     * @brief Close a connection and count its outstanding requests as failed
+     * @param index Connection index
+     */
+    void fail(size_t index) {
+        Connection& connection = connections[index];
+        result.failed += static_cast<long long>(connection.outstanding.size());
+        inFlight -= static_cast<long long>(connection.outstanding.size());
+        connection.outstanding.clear();
+        if (connection.fd >= 0) {
+            ::close(connection.fd);
+        }
+        connection.fd = -1;
+        connection.connecting = false;
+        connection.writing = false;
+        connection.output.clear();
+        connection.written = 0;
+        connection.inputLength = 0;
+        connection.consumed = 0;
+        connection.parser.reset();
+    }
+
+    /**
+     * @brief Send a connection's queued requests
+     * @param index Connection index
+     */
+    void flush(size_t index) {
+        Connection& connection = connections[index];
+        if (connection.fd < 0 || connection.connecting) {
+            return;
+        }
+        while (connection.written < connection.output.size()) {
+            ssize_t sent = ::send(connection.fd, connection.output.data() + connection.written,
+                                  connection.output.size() - connection.written, MSG_NOSIGNAL);
+            if (sent > 0) {
+                connection.written += static_cast<size_t>(sent);
+            } else if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!connection.writing) {
+                    watch(index, EPOLL_CTL_MOD, true);
+                    connection.writing = true;
+                }
+                return;
+            } else {
+                fail(index);
+                return;
+            }
+        }
+        connection.output.clear();
+        connection.written = 0;
+        if (connection.writing) {
+            watch(index, EPOLL_CTL_MOD, false);
+            connection.writing = false;
+        }
+    }
+
+    /**
+     * @brief Queue a request on the least busy of the next few connections
+     * @param request Request to send
+     * @param intended Scheduled send time
+     * @param now Current time
+     */
+    void send(const Request& request, uint64_t intended, uint64_t now) {
+        size_t chosen = nextConnection;
+        size_t probes = std::min<size_t>(4, connections.size());
+        for (size_t i = 0; i < probes; ++i) {
+            size_t index = (nextConnection + i) % connections.size();
+            if (connections[index].outstanding.empty()) {
+                chosen = index;
+                break;
+            }
+            if (connections[index].outstanding.size() < connections[chosen].outstanding.size()) {
+                chosen = index;
+            }
+        }
+        nextConnection = (chosen + 1) % connections.size();
+
+        Connection& connection = connections[chosen];
+        if (connection.fd < 0 && !open(chosen)) {
+            result.failed++;
+            return;
+        }
+        std::string type = request.getRequestType();
+        char address[IPAddress::MAX_TEXT_LENGTH];
+        size_t addressLength = request.getClientAddress().format(address);
+        if (connection.output.empty()) {
+            dirty.push_back(chosen);
+        }
+        connection.output.append(type).append(" ").append(config.path).append(" HTTP/1.1\r\nHost: ");
+        connection.output.append(hostHeader).append("\r\nX-Forwarded-For: ");
+        connection.output.append(address, addressLength).append("\r\n\r\n");
+        connection.outstanding.push_back(Pending{intended, now, type == "HEAD"});
+        inFlight++;
+        result.sent++;
+    }
+
+    /**
+     * @brief Account for a received response
+     * @param pending Request it answers
+     * @param status Status code
+     * @param now Receive time
+     */
+    void record(const Pending& pending, int status, uint64_t now) {
+        result.completed++;
+        inFlight--;
+        lastResponse = now;
+        switch (status / 100) {
+        case 2: result.status2xx++; break;
+        case 3: result.status3xx++; break;
+        case 4: result.status4xx++; break;
+        case 5: result.status5xx++; break;
+        default: break;
+        }
+        if (pending.intended >= warmupEnd) {
+            result.latency.record(static_cast<int64_t>(now - pending.intended));
+            result.responseTime.record(static_cast<int64_t>(now - pending.sent));
+        }
+    }
+
+    /**
+     * @brief Read and account for every available response
+     * @param index Connection index
+     */
+    void readable(size_t index) {
+        Connection& connection = connections[index];
+        bool closed = false;
+        while (true) {
+            if (connection.consumed == connection.inputLength) {
+                connection.consumed = 0;
+                connection.inputLength = 0;
+            } else if (connection.consumed > 0 && connection.inputLength + READ_CHUNK > connection.input.size()) {
+                std::memmove(connection.input.data(), connection.input.data() + connection.consumed,
+                             connection.inputLength - connection.consumed);
+                connection.inputLength -= connection.consumed;
+                connection.consumed = 0;
+            }
+            if (connection.inputLength + READ_CHUNK > connection.input.size()) {
+                connection.input.resize(std::max(READ_CHUNK, connection.input.size() * 2));
+            }
+            ssize_t got = ::read(connection.fd, connection.input.data() + connection.inputLength, READ_CHUNK);
+            if (got > 0) {
+                connection.inputLength += static_cast<size_t>(got);
+                if (static_cast<size_t>(got) < READ_CHUNK) {
+                    break;
+                }
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                closed = true;
+                break;
+            }
+        }
+
+        uint64_t now = monotonicNanoseconds();
+        HttpResponseView response;
+        while (connection.consumed < connection.inputLength) {
+            if (connection.outstanding.empty()) {
+                // A response nobody asked for: the stream is out of step
+                fail(index);
+                return;
+            }
+            std::string_view unparsed(connection.input.data() + connection.consumed,
+                                      connection.inputLength - connection.consumed);
+            HttpParseStatus framing = connection.parser.parseResponse(unparsed, connection.outstanding.front().head,
+                                                                      response);
+            if (framing == HttpParseStatus::INCOMPLETE) {
+                break;
+            }
+            if (framing == HttpParseStatus::INVALID) {
+                fail(index);
+                return;
+            }
+            record(connection.outstanding.front(), response.status, now);
+            connection.outstanding.pop_front();
+            connection.consumed += response.length;
+            if (!response.keepAlive) {
+                closed = true;
+                break;
+            }
+        }
+        if (closed) {
+            fail(index);
+        }
+    }
+
+    /**
+     * @brief Finish a connect once the socket is writable
+     * @param index Connection index
+     */
+    void connected(size_t index) {
+        Connection& connection = connections[index];
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (::getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+            fail(index);
+            return;
+        }
+        connection.connecting = false;
+        flush(index);
+        if (connection.fd >= 0 && connection.output.empty() && connection.writing) {
+            watch(index, EPOLL_CTL_MOD, false);
+            connection.writing = false;
+        }
+    }
+
+    /**
+     * @brief Set the timer to an absolute time
+     * @param deadline Monotonic time in nanoseconds
+     */
+    void armTimer(uint64_t deadline) {
+        if (deadline == armedDeadline) {
+            return;
+        }
+        itimerspec setting;
+        std::memset(&setting, 0, sizeof(setting));
+        setting.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000ULL);
+        setting.it_value.tv_nsec = static_cast<long>(deadline % 1000000000ULL);
+        ::timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &setting, nullptr);
+        armedDeadline = deadline;
+    }
+
+public:
+    /**
+     * @brief Create one thread's event loop
+     * @param settings Test settings, which must outlive the worker
+     * @param thread Thread index
+     * @param connectionCount Connections of this thread
+     * @param start Time of schedule offset zero
+     * @throws std::runtime_error if the target is invalid or the event loop cannot be created
+     */
+    Worker(const LoadGenConfig& settings, int thread, int connectionCount, uint64_t start)
+        : config(settings), hostHeader(settings.host + ":" + std::to_string(settings.port)),
+          schedule(settings.process, settings.workload, settings.rate, settings.cycleMicroseconds, settings.seed,
+                   thread, settings.threads),
+          epollFd(-1), timerFd(-1), armedDeadline(0), connections(static_cast<size_t>(std::max(1, connectionCount))),
+          nextConnection(0), inFlight(0), startTime(start),
+          endTime(start + static_cast<uint64_t>(settings.duration * 1e9)),
+          warmupEnd(start + static_cast<uint64_t>(settings.warmup * 1e9)), lastResponse(start) {
+        target = makeSocketAddress(settings.host, settings.port);
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (epollFd < 0 || timerFd < 0) {
+            std::string reason = std::strerror(errno);
+            if (epollFd >= 0) ::close(epollFd);
+            if (timerFd >= 0) ::close(timerFd);
+            throw std::runtime_error("cannot create event loop: " + reason);
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = TIMER_EVENT;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+    }
+
+    /**
+     * @brief Close the connections and event descriptors
+     */
+    ~Worker() {
+        for (auto& connection : connections) {
+            if (connection.fd >= 0) {
+                ::close(connection.fd);
+            }
+        }
+        ::close(timerFd);
+        ::close(epollFd);
+    }
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    /**
+     * @brief Send the schedule and collect responses until done
+     */
+    void run() {
+        for (size_t i = 0; i < connections.size(); ++i) {
+            open(i);
+        }
+        const uint64_t drainEnd = endTime + static_cast<uint64_t>(config.drainTimeout * 1e9);
+        Request request;
+        uint64_t nextIntended = startTime + static_cast<uint64_t>(schedule.next(request) * 1e9);
+        epoll_event events[256];
+        while (true) {
+            uint64_t now = monotonicNanoseconds();
+            // Send everything due, however late: the intended times stand
+            while (nextIntended <= now && nextIntended < endTime) {
+                result.maxSendLag = std::max(result.maxSendLag, (now - nextIntended) / 1e9);
+                send(request, nextIntended, now);
+                nextIntended = startTime + static_cast<uint64_t>(schedule.next(request) * 1e9);
+            }
+            for (size_t index : dirty) {
+                flush(index);
+            }
+            dirty.clear();
+
+            bool sending = nextIntended < endTime;
+            if (!sending && (inFlight == 0 || now >= drainEnd)) {
+                break;
+            }
+            armTimer(sending ? nextIntended : drainEnd);
+
+            int ready = ::epoll_wait(epollFd, events, 256, -1);
+            if (ready < 0 && errno != EINTR) {
+                break;
+            }
+            for (int i = 0; i < ready; ++i) {
+                if (events[i].data.u64 == TIMER_EVENT) {
+                    uint64_t expirations;
+                    ssize_t ignored = ::read(timerFd, &expirations, sizeof(expirations));
+                    (void)ignored;
+                    armedDeadline = 0;
+                    continue;
+                }
+                size_t index = static_cast<size_t>(events[i].data.u64);
+                if (connections[index].fd < 0) {
+                    continue;
+                }
+                uint32_t flags = events[i].events;
+                if (flags & EPOLLOUT) {
+                    if (connections[index].connecting) {
+                        connected(index);
+                    } else {
+                        flush(index);
+                    }
+                }
+                if (connections[index].fd >= 0 && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                    readable(index);
+                }
+            }
+        }
+        // Whatever is still unanswered after the drain timeout never will be
+        for (size_t i = 0; i < connections.size(); ++i) {
+            fail(i);
+        }
+        result.elapsedSeconds = (lastResponse - startTime) / 1e9;
+    }
+
+    /**
+     * @brief Get this thread's results
+     * @return Results
+     */
+    const LoadGenResult& getResult() const {
+        return result;
+    }
+};
+
+/**
+ * @brief Create a load generator
+ * @param settings Test settings
+ */
+LoadGenerator::LoadGenerator(const LoadGenConfig& settings) : config(settings) {
+    if (config.threads < 1) {
+        config.threads = 1;
+    }
+    config.connections = std::max(config.connections, config.threads);
+}
+
+/**
+ * @brief Run the test to completion
+ * @return Merged results
+ * @throws std::runtime_error if the target address is invalid
+ * @throws std::invalid_argument if the schedule's rate is not positive
+ */
+LoadGenResult LoadGenerator::run() {
+    uint64_t start = monotonicNanoseconds() + START_DELAY;
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < config.threads; ++i) {
+        int share = config.connections / config.threads + (i < config.connections % config.threads ? 1 : 0);
+        workers.emplace_back(new Worker(config, i, share, start));
+    }
+    std::vector<std::thread> threads;
+    for (auto& worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    LoadGenResult total;
+    for (const auto& worker : workers) {
+        const LoadGenResult& part = worker->getResult();
+        total.sent += part.sent;
+        total.completed += part.completed;
+        total.failed += part.failed;
+        total.status2xx += part.status2xx;
+        total.status3xx += part.status3xx;
+        total.status4xx += part.status4xx;
+        total.status5xx += part.status5xx;
+        total.connects += part.connects;
+        total.elapsedSeconds = std::max(total.elapsedSeconds, part.elapsedSeconds);
+        total.maxSendLag = std::max(total.maxSendLag, part.maxSendLag);
+        total.latency.merge(part.latency);
+        total.responseTime.merge(part.responseTime);
+    }
+    return total;
+}
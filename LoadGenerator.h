@@ -0,0 +1,94 @@
+/**
+ * @file LoadGenerator.h
+ * @brief Header file for the LoadGenerator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include "ArrivalSchedule.h"
+#include "LatencyHistogram.h"
+#include "WorkloadGenerator.h"
+#include <string>
+
+/**
+ * @struct LoadGenConfig
+ * @brief Target, schedule and duration of a load test
+ */
+struct LoadGenConfig {
+    std::string host = "127.0.0.1";                 ///< Target IPv4 address
+    int port = 8080;                                ///< Target port
+    int threads = 1;                                ///< Event-loop threads
+    int connections = 16;                           ///< Keep-alive connections over all threads
+    ArrivalProcess process = ArrivalProcess::POISSON; ///< Spacing of send times
+    double rate = 1000.0;                           ///< Requests per second (POISSON and CONSTANT)
+    double cycleMicroseconds = 100.0;               ///< Wall time per simulator cycle (CYCLES)
+    WorkloadParams workload;                        ///< Request mix and simulator arrival rate
+    std::string path = "/";                         ///< Request target
+    double duration = 10.0;                         ///< Seconds of sending
+    double warmup = 0.0;                            ///< Leading seconds excluded from the histograms
+    double drainTimeout = 2.0;                      ///< Seconds to wait for responses after sending stops
+    unsigned int seed = 1;                          ///< Seed for the schedule and request contents
+};
+
+/**
+ * @struct LoadGenResult
+ * @brief Outcome of a load test summed over threads
+ */
+struct LoadGenResult {
+    long long sent = 0;          ///< Requests written to a connection
+    long long completed = 0;     ///< Responses received
+    long long failed = 0;        ///< Requests lost to closed connections or never answered
+    long long status2xx = 0;     ///< Responses with a 2xx status
+    long long status3xx = 0;     ///< Responses with a 3xx status
+    long long status4xx = 0;     ///< Responses with a 4xx status
+    long long status5xx = 0;     ///< Responses with a 5xx status
+    long long connects = 0;      ///< Connections opened, including reconnects
+    double elapsedSeconds = 0.0; ///< Time from the first send to the last response
+    double maxSendLag = 0.0;     ///< Longest a request was sent after its intended time, in seconds
+    LatencyHistogram latency;      ///< Nanoseconds from intended send time to response
+    LatencyHistogram responseTime; ///< Nanoseconds from actual send time to response
+};
+
+/**
+ * @class LoadGenerator
+ * @brief Open-loop HTTP/1.1 load generator free of coordinated omission
+ *
+ * Requests are sent on a timeline fixed in advance by an ArrivalSchedule,
+ * whether or not earlier responses have arrived; when every connection is
+ * busy the request is pipelined behind the others instead of waiting.
+ * Latency is measured from the intended send time, so a stalled server
+ * (or a generator falling behind its own schedule) shows up as latency
+ * instead of silently lowering the offered load. Response time from the
+ * actual send is recorded separately for comparison.
+ *
+ * Each thread runs its own epoll loop over its share of the connections
+ * and records into its own LatencyHistogram; the histograms are merged
+ * when the run ends.
+ */
+class LoadGenerator {
+private:
+    class Worker;
+
+    LoadGenConfig config;  ///< Test settings
+
+public:
+    /**
+     * @brief Create a load generator
+     * @param settings Test settings
+     */
+    explicit LoadGenerator(const LoadGenConfig& settings);
+
+    /**
+     * @brief Run the test to completion
+     * @return Merged results
+     * @throws std::runtime_error if the target address is invalid
+     * @throws std::invalid_argument if the schedule's rate is not positive
+     */
+    LoadGenResult run();
+};
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,64 @@
+/**
+ * @file LogWriter.cpp
+ * @brief Implementation file for the LogWriter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LogWriter.h"
+
+/**
+ * @brief Open a log file
+ * @param path Output file
+ * @param append Append to an existing file instead of truncating it
+ */
+LogWriter::LogWriter(const std::string& path, bool append)
+    : file(path, append ? std::ios::app : std::ios::trunc) {
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Writes any collected lines
+ */
+LogWriter::~LogWriter() {
+    flush();
+}
+
+/**
+ * @brief Check whether the file could be opened
+ * @return True if open
+ */
+bool LogWriter::isOpen() const {
+    return file.is_open();
+}
+
+/**
+ * @brief Get the buffer to format the next line into
+ * @return Buffer holding the lines not yet written
+ */
+TextBuffer& LogWriter::line() {
+    return pending;
+}
+
+/**
+ * @brief Terminate the current line, writing out a full chunk
+ */
+void LogWriter::endLine() {
+    pending.append('\n');
+    if (pending.size() >= CHUNK_SIZE) {
+        flush();
+    }
+}
+
+/**
+ * @brief Write all queued lines to the file
+ */
+void LogWriter::flush() {
+    if (pending.size() > 0 && file.is_open()) {
+        file.write(pending.str().data(), static_cast<std::streamsize>(pending.size()));
+        file.flush();
+    }
+    pending.clear();
+}
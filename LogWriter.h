@@ -0,0 +1,72 @@
+/**
+ * @file LogWriter.h
+ * @brief Header file for the LogWriter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include "TextBuffer.h"
+#include <fstream>
+#include <string>
+
+/**
+ * @class LogWriter
+ * @brief Log file kept open for a whole run and written in large chunks
+ * 
+ * Lines are formatted into line() and terminated with endLine(); the
+ * collected text is written once it exceeds CHUNK_SIZE bytes, on flush()
+ * and on destruction, instead of reopening and flushing the file per line.
+ */
+class LogWriter {
+private:
+    std::ofstream file;   ///< Open log file
+    TextBuffer pending;   ///< Lines not yet written
+
+public:
+    static const size_t CHUNK_SIZE = 64 * 1024;  ///< Bytes collected per write
+
+    /**
+     * @brief Open a log file
+     * @param path Output file
+     * @param append Append to an existing file instead of truncating it
+     */
+    LogWriter(const std::string& path, bool append);
+
+    /**
+     * @brief Destructor
+     * 
+     * Writes any collected lines
+     */
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    /**
+     * @brief Check whether the file could be opened
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the buffer to format the next line into
+     * @return Buffer holding the lines not yet written
+     */
+    TextBuffer& line();
+
+    /**
+     * @brief Terminate the current line, writing out a full chunk
+     */
+    void endLine();
+
+    /**
+     * @brief Write all queued lines to the file
+     */
+    void flush();
+};
+
+#endif // LOGWRITER_H
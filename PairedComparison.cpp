@@ -0,0 +1,129 @@
+/**
+ * @file PairedComparison.cpp
+ * @brief Implementation file for the PairedComparison class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "PairedComparison.h"
+#include "Statistics.h"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Parameterized constructor
+ * @param workloadParams Workload shared by all configurations
+ * @param replicationCount Number of paired replications
+ * @param seed Seed of the first replication (others use seed + r)
+ */
+PairedComparison::PairedComparison(const WorkloadParams& workloadParams, int replicationCount,
+                                   unsigned int seed)
+    : workload(workloadParams), replications(replicationCount), baseSeed(seed) {
+}
+
+/**
+ * @brief Add a configuration; the first one added is the baseline
+ * @param config Configuration to compare
+ */
+void PairedComparison::addConfiguration(const SimulationConfig& config) {
+    configs.push_back(config);
+}
+
+/**
+ * @brief Run every (replication, configuration) pair on the thread pool
+ * @param pool Thread pool executing the runs
+ */
+void PairedComparison::run(ThreadPool& pool) {
+    results.assign(replications, std::vector<SimulationResult>(configs.size()));
+    
+    for (int r = 0; r < replications; ++r) {
+        for (size_t k = 0; k < configs.size(); ++k) {
+            // Each task writes only its own slot, so no locking is needed
+            pool.submit([this, r, k] {
+                results[r][k] = runSimulation(configs[k], workload, baseSeed + r);
+            });
+        }
+    }
+    pool.waitAll();
+}
+
+/**
+ * @brief Get the result of one run
+ * @param replication Replication index
+ * @param config Configuration index
+ * @return Result of that run
+ */
+const SimulationResult& PairedComparison::getResult(int replication, int config) const {
+    return results[replication][config];
+}
+
+/**
+ * @brief Build a human-readable report of paired differences
+ * @return Report lines
+ */
+std::vector<std::string> PairedComparison::getReport() const {
+    std::vector<std::string> report;
+    if (configs.empty() || results.empty()) {
+        return report;
+    }
+    
+    struct Metric {
+        const char* name;
+        double (*extract)(const SimulationResult&);
+    };
+    static const Metric metrics[] = {
+        {"Processed", [](const SimulationResult& r) { return static_cast<double>(r.processed); }},
+        {"Avg latency", [](const SimulationResult& r) { return r.averageLatency; }},
+        {"Utilization", [](const SimulationResult& r) { return r.meanUtilization; }},
+        {"Final queue", [](const SimulationResult& r) { return static_cast<double>(r.finalQueueSize); }},
+    };
+    
+    std::stringstream header;
+    header << "Paired comparison: " << replications << " replications, baseline '"
+           << configs[0].name << "'";
+    report.push_back(header.str());
+    
+    for (size_t k = 0; k < configs.size(); ++k) {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        ss << "  " << configs[k].name << " (" << distributionPolicyName(configs[k].policy) << ")";
+        report.push_back(ss.str());
+        
+        for (const auto& metric : metrics) {
+            RunningStats value, baseline, difference;
+            for (int r = 0; r < replications; ++r) {
+                double x = metric.extract(results[r][k]);
+                double b = metric.extract(results[r][0]);
+                value.add(x);
+                baseline.add(b);
+                difference.add(x - b);
+            }
+            
+            std::stringstream line;
+            line << std::fixed << std::setprecision(2);
+            line << "    " << std::left << std::setw(12) << metric.name << std::right
+                 << " mean " << std::setw(10) << value.getMean()
+                 << " +/- " << value.getConfidenceHalfWidth();
+            
+            if (k > 0) {
+                // Half-width the same difference would have with independent seeds
+                double unpaired = 0.0;
+                if (replications > 1) {
+                    unpaired = studentT95(2 * replications - 2) *
+                               std::sqrt((value.getVariance() + baseline.getVariance()) / replications);
+                }
+                double half = difference.getConfidenceHalfWidth();
+                bool significant = replications > 1 && std::fabs(difference.getMean()) > half;
+                line << " | diff " << std::showpos << difference.getMean() << std::noshowpos
+                     << " +/- " << half << " (unpaired +/- " << unpaired << ")"
+                     << (significant ? " *" : "");
+            }
+            report.push_back(line.str());
+        }
+    }
+    
+    report.push_back("  (* = 95% confidence interval of the paired difference excludes zero)");
+    return report;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file PairedComparison.h
+ * @brief Header file for the PairedComparison class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef PAIREDCOMPARISON_H
+#define PAIREDCOMPARISON_H
+
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class PairedComparison
+ * @brief Compares load balancer configurations using common random numbers
+ * 
+ * Every replication uses one seed for all configurations, so each
+ * configuration is driven by exactly the same arrival and service-time
+ * stream. Differences are computed per replication against the first
+ * (baseline) configuration, which removes the workload noise shared by
+ * both runs and tightens the confidence interval for the difference.
+ */
+class PairedComparison {
+private:
+    WorkloadParams workload;                          ///< Shared workload parameters
+    std::vector<SimulationConfig> configs;            ///< Configurations; index 0 is the baseline
+    int replications;                                 ///< Number of seeds to run
+    unsigned int baseSeed;                            ///< Seed of the first replication
+    std::vector<std::vector<SimulationResult>> results; ///< results[replication][config]
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param workloadParams Workload shared by all configurations
+     * @param replicationCount Number of paired replications
+     * @param seed Seed of the first replication (others use seed + r)
+     */
+    PairedComparison(const WorkloadParams& workloadParams, int replicationCount, unsigned int seed);
+
+    /**
+     * @brief Add a configuration; the first one added is the baseline
+     * @param config Configuration to compare
+     */
+    void addConfiguration(const SimulationConfig& config);
+
+    /**
+     * @brief Run every (replication, configuration) pair on the thread pool
+     * @param pool Thread pool executing the runs
+     */
+    void run(ThreadPool& pool);
+
+    /**
+     * @brief Get the result of one run
+     * @param replication Replication index
+     * @param config Configuration index
+     * @return Result of that run
+     */
+    const SimulationResult& getResult(int replication, int config) const;
+
+    /**
+     * @brief Build a human-readable report of paired differences
+     * @return Report lines
+     */
+    std::vector<std::string> getReport() const;
+};
+
+#endif // PAIREDCOMPARISON_H
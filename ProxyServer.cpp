@@ -0,0 +1,1562 @@
+/**
+ * @file ProxyServer.cpp
+ * @brief Implementation file for the ProxyServer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ProxyServer.h"
+#include "BufferPool.h"
+#include "CpuTopology.h"
+#include "Http2Connection.h"
+#include "HttpParser.h"
+#include "RequestQueue.h"
+#include "SocketUtils.h"
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+const size_t READ_CHUNK = 16 * 1024;             ///< Receive block size for small messages
+const size_t MIN_READ = 4 * 1024;                ///< Smallest room worth a read before getting more
+const size_t MAX_IOVECS = 16;                    ///< Slices gathered per send
+const size_t MAX_UNPARSED = 4 * 1024 * 1024;     ///< Buffered client bytes allowed behind a busy request
+const uint64_t UPSTREAM_TAG = 1ULL << 63;        ///< Epoll tag bit of upstream connections
+const uint64_t LISTEN_TAG = 1ULL << 62;          ///< Epoll tag of the listening socket
+const uint64_t SYNC_TAG = LISTEN_TAG + 1;        ///< Epoll tag of the load exchange and timeout timer
+const uint64_t STOP_TAG = LISTEN_TAG + 2;        ///< Epoll tag of the stop signal
+const uint64_t BACKEND_RETRY = 1000000000ULL;    ///< Nanoseconds a failed backend is skipped
+const size_t BOARD_LINE = 64 / sizeof(std::atomic<int>); ///< Board entries per cache line
+const uint64_t MILLISECOND = 1000000ULL;          ///< Nanoseconds per millisecond, the timer tick
+
+const char BAD_REQUEST[] = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+const char BAD_GATEWAY[] = "HTTP/1.1 502 Bad Gateway\r\nContent-Length: 0\r\n\r\n";
+const char UNAVAILABLE[] = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+const char GATEWAY_TIMEOUT[] = "HTTP/1.1 504 Gateway Timeout\r\nContent-Length: 0\r\n\r\n";
+const char REQUEST_TIMEOUT[] = "HTTP/1.1 408 Request Timeout\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+/**
+ * @enum ClientTimeout
+ * @brief Which deadline a client connection's timer holds
+ */
+enum class ClientTimeout {
+    IDLE,     ///< Keep-alive connection between requests
+    HEADER,   ///< Part of a request has arrived
+    REQUEST   ///< A request is queued or at a backend
+};
+
+/**
+ * @brief Increment a counter only its owning thread writes
+ * @param counter Counter, read by other threads
+ * @param amount Increment
+ */
+void bump(std::atomic<long long>& counter, long long amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @struct ReceiveBuffer
+ * @brief Pooled receive buffer with a parse cursor
+ *
+ * Holds a block only while bytes are buffered, so an idle connection
+ * costs no buffer memory. Handled bytes may still be viewed by slices
+ * given out with take(), so a shared block is never compacted in place.
+ */
+struct ReceiveBuffer {
+    BufferSlice storage;     ///< Block from offset 0, empty while nothing is buffered
+    size_t length = 0;       ///< Valid bytes
+    size_t consumed = 0;     ///< Bytes already handled
+
+    /**
+     * @brief Get the unhandled bytes
+     * @return View of storage[consumed, length)
+     */
+    std::string_view unparsed() const { return std::string_view(storage.data() + consumed, length - consumed); }
+
+    /**
+     * @brief Share the next unhandled bytes without copying them
+     * @param bytes Byte count, at most length - consumed
+     * @return Slice of storage[consumed, consumed + bytes)
+     */
+    BufferSlice take(size_t bytes) const { return storage.slice(consumed, bytes); }
+
+    /**
+     * @brief Forget all bytes and give up the block
+     */
+    void clear() {
+        storage.reset();
+        length = 0;
+        consumed = 0;
+    }
+
+    /**
+     * @brief Give up the block if every byte has been handled
+     */
+    void releaseIfDrained() {
+        if (consumed == length) {
+            clear();
+        }
+    }
+
+    /**
+     * @brief Read everything available from a socket
+     * @param fd Non-blocking socket
+     * @param pool Pool of the worker that owns the connection
+     * @return False if the peer closed the connection or a read failed
+     */
+    bool fill(int fd, BufferPool& pool) {
+        while (true) {
+            size_t pending = length - consumed;
+            if (storage.capacity() - length < MIN_READ) {
+                if (!storage.isShared() && storage.capacity() - pending >= MIN_READ) {
+                    std::memmove(storage.data(), storage.data() + consumed, pending);
+                } else {
+                    BufferSlice larger = pool.allocate(std::max(READ_CHUNK, 2 * pending));
+                    if (pending > 0) {
+                        std::memcpy(larger.data(), storage.data() + consumed, pending);
+                    }
+                    storage = std::move(larger);
+                }
+                length = pending;
+                consumed = 0;
+            }
+            size_t room = storage.capacity() - length;
+            ssize_t got = ::read(fd, storage.data() + length, room);
+            if (got > 0) {
+                length += static_cast<size_t>(got);
+                if (static_cast<size_t>(got) < room) {
+                    return true;
+                }
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else {
+                releaseIfDrained();
+                return got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+        }
+    }
+};
+
+/**
+ * @struct OutputQueue
+ * @brief Bytes waiting to be sent, as slices of pooled blocks
+ */
+struct OutputQueue {
+    std::vector<BufferSlice> slices;  ///< Pending bytes, oldest first
+    size_t head = 0;                  ///< First slice not yet fully sent
+
+    /**
+     * @brief Check whether anything is waiting
+     * @return True if nothing is waiting
+     */
+    bool empty() const { return head == slices.size(); }
+
+    /**
+     * @brief Queue bytes behind those already waiting
+     * @param bytes Slice, shared rather than copied
+     */
+    void push(BufferSlice bytes) {
+        if (!bytes.empty()) {
+            slices.push_back(std::move(bytes));
+        }
+    }
+
+    /**
+     * @brief Drop everything waiting
+     */
+    void clear() {
+        slices.clear();
+        head = 0;
+    }
+
+    /**
+     * @brief Send as much as the socket takes, several slices per call
+     * @param fd Non-blocking socket
+     * @return False if the connection failed
+     */
+    bool flush(int fd) {
+        while (!empty()) {
+            iovec vectors[MAX_IOVECS];
+            size_t count = 0;
+            size_t offered = 0;
+            for (size_t i = head; i < slices.size() && count < MAX_IOVECS; ++i, ++count) {
+                vectors[count].iov_base = slices[i].data();
+                vectors[count].iov_len = slices[i].size();
+                offered += slices[i].size();
+            }
+            msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+            ssize_t sent = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            for (size_t left = static_cast<size_t>(sent); left > 0;) {
+                BufferSlice& front = slices[head];
+                size_t part = std::min(left, front.size());
+                front.removePrefix(part);
+                left -= part;
+                if (front.empty()) {
+                    front.reset();
+                    head++;
+                }
+            }
+            if (static_cast<size_t>(sent) < offered) {
+                return true;
+            }
+        }
+        clear();
+        return true;
+    }
+};
+
+/**
+ * @brief Check whether a lowercase header applies to one HTTP/1.1 hop only
+ *
+ * HTTP/2 forbids connection-specific fields, and Host travels as
+ * :authority instead.
+ * @param name Lowercase field name
+ * @return True if the field must not be forwarded across protocols
+ */
+bool isHopByHop(std::string_view name) {
+    return name == "connection" || name == "keep-alive" || name == "proxy-connection" ||
+           name == "transfer-encoding" || name == "upgrade" || name == "te" || name == "host";
+}
+
+/**
+ * @brief Remove chunked transfer coding from a body the parser accepted
+ * @param chunked Chunk-framed body, trailers included
+ * @param body Set to the chunk data joined together
+ */
+void dechunk(std::string_view chunked, std::string& body) {
+    body.clear();
+    size_t position = 0;
+    while (position < chunked.size()) {
+        size_t lineEnd = chunked.find('\n', position);
+        if (lineEnd == std::string_view::npos) {
+            return;
+        }
+        size_t size = 0;
+        for (size_t i = position; i < lineEnd; ++i) {
+            int c = static_cast<unsigned char>(chunked[i]);
+            if (!std::isxdigit(c)) {
+                break;  // Extensions and the CR follow the size
+            }
+            size = size * 16 + static_cast<size_t>(std::isdigit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+        }
+        if (size == 0) {
+            return;  // The last chunk; trailers are dropped
+        }
+        body.append(chunked.substr(lineEnd + 1, size));
+        position = lineEnd + 1 + size + 2;
+    }
+}
+
+/**
+ * @brief Get the reason phrase of a status code
+ * @param status Status code
+ * @return Reason phrase, empty for uncommon codes
+ */
+const char* reasonPhrase(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 202: return "Accepted";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 308: return "Permanent Redirect";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 409: return "Conflict";
+    case 413: return "Content Too Large";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    default: return "";
+    }
+}
+
+/**
+ * @brief Send as much of a buffer as the socket takes
+ * @param fd Non-blocking socket
+ * @param data Bytes
+ * @param size Byte count
+ * @return Bytes sent, or -1 if the connection failed
+ */
+ssize_t sendSome(int fd, const char* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = ::send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (result > 0) {
+            sent += static_cast<size_t>(result);
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return -1;
+        }
+    }
+    return static_cast<ssize_t>(sent);
+}
+
+/**
+ * @brief Convert an accepted socket's peer address
+ * @param address Address filled in by accept4
+ * @return IPv4-mapped or IPv6 address, :: for other families
+ */
+IPAddress peerAddress(const sockaddr_storage& address) {
+    if (address.ss_family == AF_INET) {
+        const sockaddr_in& ipv4 = reinterpret_cast<const sockaddr_in&>(address);
+        return IPAddress::fromIPv4(ntohl(ipv4.sin_addr.s_addr));
+    }
+    if (address.ss_family == AF_INET6) {
+        const uint8_t* bytes = reinterpret_cast<const sockaddr_in6&>(address).sin6_addr.s6_addr;
+        uint64_t high = 0;
+        uint64_t low = 0;
+        for (int i = 0; i < 8; ++i) {
+            high = (high << 8) | bytes[i];
+            low = (low << 8) | bytes[8 + i];
+        }
+        return IPAddress(high, low);
+    }
+    return IPAddress();
+}
+
+} // namespace
+
+/**
+ * @class ProxyServer::Worker
+ * @brief One core's listener, event loop, queue shard and upstream pools
+ */
+class ProxyServer::Worker {
+private:
+    /**
+     * @struct Client
+     * @brief State of one client connection
+     */
+    struct Client {
+        int fd = -1;               ///< Socket
+        uint64_t id = 0;           ///< Distinguishes reuses of the same descriptor
+        IPAddress peer;            ///< Address the connection came from
+        HttpParser parser;         ///< Request framing state
+        ReceiveBuffer input;       ///< Received bytes; the busy request starts at input.consumed
+        OutputQueue output;        ///< Responses not yet sent
+        bool writing = false;      ///< Waiting for the socket to become writable
+        bool busy = false;         ///< A request is queued or at a backend
+        bool closeAfter = false;   ///< Close once the busy request is answered
+        size_t requestLength = 0;  ///< Bytes of the busy request
+        bool headRequest = false;  ///< The busy request is HEAD
+        long long requestID = 0;   ///< Queue identifier of the busy request
+        int upstreamSlot = -1;     ///< Pool slot carrying the busy request, -1 while queued
+        uint32_t streamID = 0;     ///< HTTP/2 stream carrying the busy request
+        TimerNode timer;           ///< Deadline of the current state
+        ClientTimeout timeout = ClientTimeout::IDLE; ///< Which deadline timer holds
+    };
+
+    /**
+     * @struct Upstream
+     * @brief One pooled connection to a backend
+     */
+    struct Upstream {
+        int fd = -1;               ///< Socket, -1 if closed
+        int backend = 0;           ///< Backend index
+        bool connecting = false;   ///< Connect still in progress
+        bool writing = false;      ///< Waiting for the socket to become writable
+        bool busy = false;         ///< Carrying an HTTP/1.1 request
+        HttpParser parser;         ///< Response framing state
+        ReceiveBuffer input;       ///< Received bytes
+        OutputQueue output;        ///< Request bytes not yet sent
+        int clientFd = -1;         ///< Client awaiting the response
+        uint64_t clientID = 0;     ///< Identifier of that client
+        bool headRequest = false;  ///< The request is HEAD
+        TimerNode timer;           ///< Idle or connect deadline, disarmed while busy
+        std::unique_ptr<Http2Connection> session; ///< HTTP/2 streams, null for HTTP/1.1
+    };
+
+    const ProxyConfig& config;      ///< Settings shared by all workers
+    BufferPool pool;                ///< I/O buffers, outliving every slice below
+    BufferSlice badRequest;         ///< Canned 400 response
+    BufferSlice badGateway;         ///< Canned 502 response
+    BufferSlice unavailable;        ///< Canned 503 response
+    BufferSlice gatewayTimeout;     ///< Canned 504 response
+    int index;                      ///< Worker number
+    int cpu;                        ///< CPU to bind to, -1 to float
+    int listenFd;                   ///< This worker's listening socket
+    int epollFd;                    ///< Event queue
+    int syncFd;                     ///< Periodic load exchange and timeout timer
+    int stopFd;                     ///< Signalled by requestStop()
+    std::atomic<int>* board;        ///< Shared load board
+    size_t boardStride;             ///< Board entries per worker
+    int workerCount;                ///< Rows on the board
+    std::vector<StreamAddress> backendAddresses; ///< Resolved backends
+    std::vector<std::string> authorities; ///< :authority of each backend for requests without Host
+    std::vector<int> inFlight;      ///< This worker's requests at each backend
+    std::vector<int> remoteLoad;    ///< Other workers' published requests at each backend
+    std::vector<uint64_t> retryAfter; ///< Time each failed backend may be tried again
+    std::vector<Upstream> upstreams; ///< Pool slots, connectionsPerBackend per backend
+    std::vector<std::vector<int>> idle; ///< Idle slots per backend; for HTTP/2, slots with room for a stream
+    std::vector<std::vector<int>> closed; ///< Closed slots per backend
+    int nextBackend;                ///< Round-robin position
+    RequestQueue queue;             ///< This worker's queue shard
+    std::unordered_map<long long, std::pair<int, uint64_t>> waiting; ///< Queued request ID to client
+    std::unordered_map<int, std::unique_ptr<Client>> clients; ///< Open client connections by socket
+    uint64_t nextClientID;          ///< Identifier for the next client
+    long long nextRequestID;        ///< Identifier for the next request
+    HttpRequestView view;           ///< Scratch request parse result
+    HttpParser forwardParser;       ///< Re-parses requests being translated to HTTP/2
+    HttpRequestView forwardView;    ///< Scratch result of forwardParser
+    std::string frames;             ///< Scratch HTTP/2 frames to send
+    std::string headerBlock;        ///< Scratch HPACK block
+    std::string fieldName;          ///< Scratch lowercase header name
+    std::string requestBody;        ///< Scratch dechunked request body
+    std::string responseText;       ///< Scratch HTTP/1.1 response translated from HTTP/2
+    std::vector<Http2Message> arrivals; ///< Scratch messages from an HTTP/2 read
+    TimerWheel timers;              ///< Connection deadlines
+    uint64_t loopTime;              ///< Time the current batch of events was returned
+
+    std::atomic<long long> connectionCount{0};  ///< Clients accepted
+    std::atomic<long long> requestCount{0};     ///< Requests parsed
+    std::atomic<long long> responseCount{0};    ///< Responses relayed
+    std::atomic<long long> rejectedCount{0};    ///< 503 responses
+    std::atomic<long long> invalidCount{0};     ///< 400 responses
+    std::atomic<long long> upstreamErrorCount{0}; ///< 502 responses
+    std::atomic<long long> upstreamConnectCount{0}; ///< Upstream connects
+    std::atomic<long long> syncCount{0};        ///< Load exchanges
+    std::atomic<long long> idleTimeoutCount{0}; ///< Clients closed on an idle or header timeout
+    std::atomic<long long> requestTimeoutCount{0}; ///< 504 responses
+    std::atomic<long long> bufferSlabBytes{0};  ///< Slab memory of the buffer pool, as of the last exchange
+    std::atomic<long long> bufferPeakBytes{0};  ///< Most buffer memory in use, as of the last exchange
+    std::unique_ptr<std::atomic<long long>[]> backendResponses; ///< Responses per backend
+
+    /**
+     * @brief Register a descriptor with the event queue
+     * @param fd Descriptor
+     * @param tag Event tag
+     * @param events Event mask
+     * @param operation EPOLL_CTL_ADD or EPOLL_CTL_MOD
+     * @return True on success
+     */
+    bool watch(int fd, uint64_t tag, uint32_t events, int operation = EPOLL_CTL_ADD) {
+        epoll_event event;
+        event.events = events;
+        event.data.u64 = tag;
+        return ::epoll_ctl(epollFd, operation, fd, &event) == 0;
+    }
+
+    /**
+     * @brief Find a client if it is still connected
+     * @param fd Socket
+     * @param id Client identifier
+     * @return Client, or nullptr if closed
+     */
+    Client* findClient(int fd, uint64_t id) {
+        auto it = clients.find(fd);
+        return it != clients.end() && it->second->id == id ? it->second.get() : nullptr;
+    }
+
+    /**
+     * @brief Accept every pending client connection
+     */
+    void acceptAll() {
+        while (true) {
+            sockaddr_storage address;
+            socklen_t addressLength = sizeof(address);
+            int fd = ::accept4(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength,
+                               SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            if (!watch(fd, static_cast<uint64_t>(fd), EPOLLIN | EPOLLRDHUP)) {
+                ::close(fd);
+                continue;
+            }
+            std::unique_ptr<Client> client(new Client());
+            client->fd = fd;
+            client->id = nextClientID++;
+            client->peer = peerAddress(address);
+            client->timer.tag = static_cast<uint64_t>(fd);
+            timers.arm(client->timer, loopTime + static_cast<uint64_t>(config.idleTimeoutMilliseconds) * MILLISECOND);
+            clients[fd] = std::move(client);
+            bump(connectionCount);
+        }
+    }
+
+    /**
+     * @brief Close a client connection
+     * @param client Client, destroyed by this call
+     */
+    void closeClient(Client& client) {
+        timers.cancel(client.timer);
+        ::close(client.fd);
+        clients.erase(client.fd);
+    }
+
+    /**
+     * @brief Send a client's pending output, closing it if finished
+     * @param client Client
+     * @return False if the client was closed
+     */
+    bool flushClient(Client& client) {
+        if (!client.output.flush(client.fd)) {
+            closeClient(client);
+            return false;
+        }
+        bool pending = !client.output.empty();
+        if (pending != client.writing) {
+            watch(client.fd, static_cast<uint64_t>(client.fd), EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0U),
+                  EPOLL_CTL_MOD);
+            client.writing = pending;
+        }
+        if (!pending && client.closeAfter && !client.busy) {
+            closeClient(client);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Answer a client's busy request and move on to its next one
+     * @param client Client
+     * @param response Response bytes
+     * @return False if the client was closed
+     */
+    bool answer(Client& client, const BufferSlice& response) {
+        size_t sent = 0;
+        if (client.output.empty()) {
+            // Usually the socket takes it all and nothing is queued
+            ssize_t result = sendSome(client.fd, response.data(), response.size());
+            if (result < 0) {
+                closeClient(client);
+                return false;
+            }
+            sent = static_cast<size_t>(result);
+        }
+        if (sent < response.size()) {
+            client.output.push(response.slice(sent, response.size() - sent));
+        }
+        client.busy = false;
+        client.upstreamSlot = -1;
+        client.input.consumed += client.requestLength;
+        client.requestLength = 0;
+        return serve(client) && flushClient(client);
+    }
+
+    /**
+     * @brief Parse a client's buffered requests and admit them to the queue
+     * @param client Client
+     * @return False if the client was closed
+     */
+    bool serve(Client& client) {
+        while (!client.busy && !client.closeAfter) {
+            HttpParseStatus status = client.parser.parse(client.input.unparsed(), view);
+            if (status == HttpParseStatus::INCOMPLETE) {
+                break;
+            }
+            if (status == HttpParseStatus::INVALID) {
+                bump(invalidCount);
+                client.closeAfter = true;
+                client.output.push(badRequest);
+                break;
+            }
+            bump(requestCount);
+            client.requestLength = view.length;
+            client.headRequest = view.method == HttpMethod::HEAD;
+            client.closeAfter = !view.keepAlive;
+            client.busy = true;
+            long long id = nextRequestID++;
+            if (!config.trustForwardedFor) {
+                // Anyone can send the header; only a proxy we sit behind may set the client
+                view.forwardedFor = std::string_view();
+            }
+            if (!queue.addRequest(toRequest(view, client.peer, 0, id))) {
+                bump(rejectedCount);
+                client.output.push(unavailable);
+                client.busy = false;
+                client.input.consumed += client.requestLength;
+                continue;
+            }
+            waiting[id] = std::make_pair(client.fd, client.id);
+            client.requestID = id;
+            setClientTimeout(client, ClientTimeout::REQUEST);
+        }
+        if (!client.busy) {
+            client.input.releaseIfDrained();
+            setClientTimeout(client, client.input.consumed < client.input.length ? ClientTimeout::HEADER
+                                                                                 : ClientTimeout::IDLE);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Arm a client's timer for a new state
+     *
+     * Staying idle or part-way through a request keeps the deadline, so a
+     * client trickling bytes cannot hold the connection open forever.
+     * @param client Client
+     * @param timeout New state
+     */
+    void setClientTimeout(Client& client, ClientTimeout timeout) {
+        if (timeout == client.timeout && timeout != ClientTimeout::REQUEST && client.timer.isArmed()) {
+            return;
+        }
+        int milliseconds = timeout == ClientTimeout::REQUEST  ? config.requestTimeoutMilliseconds
+                           : timeout == ClientTimeout::HEADER ? config.headerTimeoutMilliseconds
+                                                              : config.idleTimeoutMilliseconds;
+        client.timeout = timeout;
+        timers.arm(client.timer, loopTime + static_cast<uint64_t>(milliseconds) * MILLISECOND);
+    }
+
+    /**
+     * @brief Handle a client whose deadline passed
+     * @param client Client
+     */
+    void clientTimedOut(Client& client) {
+        if (client.timeout != ClientTimeout::REQUEST) {
+            bump(idleTimeoutCount);
+            if (client.timeout == ClientTimeout::HEADER && client.output.empty()) {
+                sendSome(client.fd, REQUEST_TIMEOUT, sizeof(REQUEST_TIMEOUT) - 1);
+            }
+            closeClient(client);
+            return;
+        }
+        bump(requestTimeoutCount);
+        if (client.upstreamSlot >= 0 && upstreams[client.upstreamSlot].session != nullptr) {
+            // Only this request's stream is abandoned; the others carry on
+            int slot = client.upstreamSlot;
+            Upstream& upstream = upstreams[slot];
+            frames.clear();
+            upstream.session->resetStream(client.streamID, Http2Error::CANCEL, frames);
+            upstream.output.push(pool.copy(frames));
+            inFlight[upstream.backend]--;
+            waiting.erase(client.requestID);
+            answer(client, gatewayTimeout);
+            updateSession(slot);
+            if (upstreams[slot].fd >= 0) {
+                flushUpstream(slot);
+            }
+            return;
+        }
+        if (client.upstreamSlot >= 0) {
+            // The late response would arrive out of step, so drop the connection
+            Upstream& upstream = upstreams[client.upstreamSlot];
+            upstream.busy = false;
+            inFlight[upstream.backend]--;
+            closeUpstream(client.upstreamSlot, false);
+        } else {
+            waiting.erase(client.requestID);
+        }
+        answer(client, gatewayTimeout);
+    }
+
+    /**
+     * @brief Read a client's requests
+     * @param client Client
+     */
+    void clientReadable(Client& client) {
+        if (!client.input.fill(client.fd, pool) || client.input.length - client.input.consumed > MAX_UNPARSED) {
+            closeClient(client);
+            return;
+        }
+        if (serve(client) && flushClient(client)) {
+            dispatch();
+        }
+    }
+
+    /**
+     * @brief Check whether a backend can take a request now
+     * @param backend Backend index
+     * @param now Current time
+     * @return True if it has an idle or unopened pool slot and has not just failed
+     */
+    bool canTake(int backend, uint64_t now) const {
+        return now >= retryAfter[backend] && (!idle[backend].empty() || !closed[backend].empty());
+    }
+
+    /**
+     * @brief Choose a backend for the next request
+     * @param now Current time
+     * @return Backend index, or -1 if none can take a request
+     */
+    int selectBackend(uint64_t now) {
+        int count = static_cast<int>(backendAddresses.size());
+        if (config.policy == DistributionPolicy::LEAST_CONNECTIONS) {
+            int best = -1;
+            for (int b = 0; b < count; ++b) {
+                if (canTake(b, now) &&
+                    (best < 0 || inFlight[b] + remoteLoad[b] < inFlight[best] + remoteLoad[best])) {
+                    best = b;
+                }
+            }
+            return best;
+        }
+        for (int i = 0; i < count; ++i) {
+            int b = (nextBackend + i) % count;
+            if (canTake(b, now)) {
+                nextBackend = (b + 1) % count;
+                return b;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Take a pooled connection to a backend, connecting if needed
+     * @param backend Backend index
+     * @return Slot index, or -1 if the connect failed
+     */
+    int acquireUpstream(int backend) {
+        if (!idle[backend].empty()) {
+            int slot = idle[backend].back();
+            // An HTTP/2 connection stays listed while it has room for more streams
+            if (upstreams[slot].session == nullptr) {
+                idle[backend].pop_back();
+                timers.cancel(upstreams[slot].timer);
+            }
+            return slot;
+        }
+        int slot = closed[backend].back();
+        int fd = connectNonBlocking(backendAddresses[backend]);
+        if (fd < 0 || !watch(fd, UPSTREAM_TAG | static_cast<uint64_t>(slot), EPOLLIN | EPOLLOUT | EPOLLRDHUP)) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            retryAfter[backend] = monotonicNanoseconds() + BACKEND_RETRY;
+            return -1;
+        }
+        closed[backend].pop_back();
+        bump(upstreamConnectCount);
+        Upstream& upstream = upstreams[slot];
+        upstream.fd = fd;
+        upstream.connecting = true;
+        upstream.writing = true;
+        if (config.upstreamHttp2) {
+            upstream.session.reset(
+                new Http2Connection(Http2Role::CLIENT, static_cast<uint32_t>(config.maxStreamsPerConnection)));
+            frames.clear();
+            upstream.session->start(frames);
+            upstream.output.push(pool.copy(frames));
+            // Streams queue behind the connect, which no single request's timer covers
+            idle[backend].push_back(slot);
+            timers.arm(upstream.timer, loopTime + static_cast<uint64_t>(config.requestTimeoutMilliseconds) * MILLISECOND);
+        }
+        return slot;
+    }
+
+    /**
+     * @brief List or unlist an HTTP/2 connection and set its timer after its streams changed
+     *
+     * A connection is offered to new requests while it has room for a
+     * stream, and its idle timer runs only while it carries none. One that
+     * is going away is closed as soon as its last stream ends.
+     * @param slot Slot index
+     */
+    void updateSession(int slot) {
+        Upstream& upstream = upstreams[slot];
+        if (upstream.fd < 0) {
+            return;
+        }
+        Http2Connection& session = *upstream.session;
+        if (session.isGoingAway() && session.getOpenStreams() == 0) {
+            closeUpstream(slot, false);
+            return;
+        }
+        std::vector<int>& list = idle[upstream.backend];
+        auto position = std::find(list.begin(), list.end(), slot);
+        bool room = session.canOpenStream();
+        if (room && position == list.end()) {
+            list.push_back(slot);
+        } else if (!room && position != list.end()) {
+            list.erase(position);
+        }
+        if (upstream.connecting) {
+            return;
+        }
+        if (session.getOpenStreams() > 0) {
+            timers.cancel(upstream.timer);
+        } else if (!upstream.timer.isArmed()) {
+            timers.arm(upstream.timer, loopTime + static_cast<uint64_t>(config.idleTimeoutMilliseconds) * MILLISECOND);
+        }
+    }
+
+    /**
+     * @brief Send a queued request as a new stream on an HTTP/2 connection
+     * @param slot Slot index with room for a stream
+     * @param requestID Queue identifier of the request
+     */
+    void openStream(int slot, long long requestID) {
+        Upstream& upstream = upstreams[slot];
+        auto entry = waiting.find(requestID);
+        Client* client = entry == waiting.end() ? nullptr : findClient(entry->second.first, entry->second.second);
+        if (client == nullptr) {
+            // The client left while queued
+            if (entry != waiting.end()) {
+                waiting.erase(entry);
+            }
+            updateSession(slot);
+            return;
+        }
+        // The entry stays until the response, whose stream carries the request ID
+        forwardParser.reset();
+        forwardParser.parse(client->input.unparsed(), forwardView);
+        headerBlock.clear();
+        HpackEncoder::encode(":method", forwardView.methodText, headerBlock);
+        HpackEncoder::encode(":scheme", "http", headerBlock);
+        HpackEncoder::encode(":authority", forwardView.host.empty() ? std::string_view(authorities[upstream.backend])
+                                                                    : forwardView.host,
+                             headerBlock);
+        HpackEncoder::encode(":path", forwardView.target, headerBlock);
+        for (size_t i = 0; i < forwardView.headerCount; ++i) {
+            const HttpHeader& header = forwardView.headers[i];
+            fieldName.assign(header.name.data(), header.name.size());
+            for (char& c : fieldName) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            if (!isHopByHop(fieldName)) {
+                HpackEncoder::encode(fieldName, header.value, headerBlock);
+            }
+        }
+        std::string_view body = forwardView.body;
+        if (forwardView.chunked) {
+            dechunk(body, requestBody);
+            body = requestBody;
+        }
+        frames.clear();
+        client->streamID = upstream.session->submitRequest(headerBlock, body, static_cast<uint64_t>(requestID), frames);
+        client->upstreamSlot = slot;
+        inFlight[upstream.backend]++;
+        upstream.output.push(pool.copy(frames));
+        updateSession(slot);
+        flushUpstream(slot);
+    }
+
+    /**
+     * @brief Translate an HTTP/2 response into HTTP/1.1 for the client
+     * @param message Completed response
+     * @param headRequest Whether the request was HEAD
+     * @param response Set to the response bytes
+     * @return False if the response has no valid :status
+     */
+    bool translateResponse(const Http2Message& message, bool headRequest, BufferSlice& response) {
+        int status = 0;
+        for (const HpackField& field : message.headers) {
+            if (field.name == ":status" && field.value.size() == 3 &&
+                std::all_of(field.value.begin(), field.value.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                status = std::stoi(field.value);
+            }
+        }
+        if (status < 200) {
+            return false;
+        }
+        responseText.assign("HTTP/1.1 ");
+        responseText += std::to_string(status);
+        responseText += ' ';
+        responseText += reasonPhrase(status);
+        responseText += "\r\n";
+        for (const HpackField& field : message.headers) {
+            // Only a HEAD response keeps the backend's length; others are framed here
+            if (field.name.empty() || field.name[0] == ':' || isHopByHop(field.name) ||
+                (field.name == "content-length" && !headRequest)) {
+                continue;
+            }
+            responseText += field.name;
+            responseText += ": ";
+            responseText += field.value;
+            responseText += "\r\n";
+        }
+        if (!headRequest && status != 204 && status != 304) {
+            responseText += "Content-Length: ";
+            responseText += std::to_string(message.body.size());
+            responseText += "\r\n";
+        }
+        responseText += "\r\n";
+        if (!headRequest) {
+            responseText += message.body;
+        }
+        response = pool.copy(responseText);
+        return true;
+    }
+
+    /**
+     * @brief Relay a completed or reset HTTP/2 stream to its client
+     * @param backend Backend index
+     * @param message Response, or a reset stream answered 502
+     */
+    void finishStream(int backend, const Http2Message& message) {
+        inFlight[backend]--;
+        auto entry = waiting.find(static_cast<long long>(message.tag));
+        Client* client = nullptr;
+        if (entry != waiting.end()) {
+            client = findClient(entry->second.first, entry->second.second);
+            waiting.erase(entry);
+        }
+        BufferSlice response;
+        if (message.reset || !translateResponse(message, client != nullptr && client->headRequest, response)) {
+            bump(upstreamErrorCount);
+            if (client != nullptr) {
+                answer(*client, badGateway);
+            }
+            return;
+        }
+        bump(responseCount);
+        bump(backendResponses[backend]);
+        if (client != nullptr) {
+            answer(*client, response);
+        }
+    }
+
+    /**
+     * @brief Read an HTTP/2 connection's frames and relay completed streams
+     * @param slot Slot index
+     */
+    void sessionReadable(int slot) {
+        Upstream& upstream = upstreams[slot];
+        bool open = upstream.input.fill(upstream.fd, pool);
+        size_t used = 0;
+        frames.clear();
+        arrivals.clear();
+        bool healthy = upstream.session->receive(upstream.input.unparsed(), used, frames, arrivals);
+        upstream.input.consumed += used;
+        upstream.input.releaseIfDrained();
+        if (!frames.empty()) {
+            upstream.output.push(pool.copy(frames));
+        }
+        for (const Http2Message& message : arrivals) {
+            finishStream(upstream.backend, message);
+        }
+        if (!healthy || !open) {
+            // Streams still open fail with 502
+            closeUpstream(slot, !healthy || upstream.session->getOpenStreams() > 0);
+        } else {
+            updateSession(slot);
+            if (upstream.fd >= 0) {
+                flushUpstream(slot);
+            }
+        }
+        dispatch();
+    }
+
+    /**
+     * @brief Return a connected pooled connection to its backend's idle list
+     * @param slot Slot index
+     */
+    void releaseUpstream(int slot) {
+        Upstream& upstream = upstreams[slot];
+        idle[upstream.backend].push_back(slot);
+        timers.arm(upstream.timer, loopTime + static_cast<uint64_t>(config.idleTimeoutMilliseconds) * MILLISECOND);
+    }
+
+    /**
+     * @brief Close a pooled connection, failing its request with 502
+     * @param slot Slot index
+     * @param failed Whether the backend misbehaved, so it is skipped for a while
+     */
+    void closeUpstream(int slot, bool failed) {
+        Upstream& upstream = upstreams[slot];
+        int backend = upstream.backend;
+        timers.cancel(upstream.timer);
+        ::close(upstream.fd);
+        upstream.fd = -1;
+        upstream.connecting = false;
+        upstream.writing = false;
+        upstream.parser.reset();
+        upstream.input.clear();
+        upstream.output.clear();
+        auto position = std::find(idle[backend].begin(), idle[backend].end(), slot);
+        if (position != idle[backend].end()) {
+            idle[backend].erase(position);
+        }
+        closed[backend].push_back(slot);
+        if (failed) {
+            retryAfter[backend] = monotonicNanoseconds() + BACKEND_RETRY;
+        }
+        if (upstream.session != nullptr) {
+            std::vector<Http2Message> orphans;
+            upstream.session->takeOpenStreams(orphans);
+            upstream.session.reset();
+            for (const Http2Message& orphan : orphans) {
+                finishStream(backend, orphan);
+            }
+        }
+        if (upstream.busy) {
+            upstream.busy = false;
+            inFlight[backend]--;
+            bump(upstreamErrorCount);
+            Client* client = findClient(upstream.clientFd, upstream.clientID);
+            if (client != nullptr) {
+                answer(*client, badGateway);
+            }
+        }
+    }
+
+    /**
+     * @brief Send a pooled connection's request bytes
+     * @param slot Slot index
+     */
+    void flushUpstream(int slot) {
+        Upstream& upstream = upstreams[slot];
+        if (upstream.connecting) {
+            return;
+        }
+        if (!upstream.output.flush(upstream.fd)) {
+            closeUpstream(slot, true);
+            return;
+        }
+        bool pending = !upstream.output.empty();
+        if (pending != upstream.writing) {
+            watch(upstream.fd, UPSTREAM_TAG | static_cast<uint64_t>(slot),
+                  EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0U), EPOLL_CTL_MOD);
+            upstream.writing = pending;
+        }
+    }
+
+    /**
+     * @brief Forward queued requests while a backend can take them
+     */
+    void dispatch() {
+        uint64_t now = loopTime;
+        while (!queue.isEmpty()) {
+            int backend = selectBackend(now);
+            if (backend < 0) {
+                bool anyUp = false;
+                for (size_t b = 0; b < retryAfter.size(); ++b) {
+                    anyUp = anyUp || now >= retryAfter[b];
+                }
+                if (anyUp) {
+                    return;  // Every pool is busy; wait for a response
+                }
+                // Every backend is failing: answer rather than queue indefinitely
+                Request request = queue.getNextRequest();
+                auto entry = waiting.find(request.getRequestID());
+                if (entry != waiting.end()) {
+                    Client* client = findClient(entry->second.first, entry->second.second);
+                    waiting.erase(entry);
+                    if (client != nullptr) {
+                        bump(upstreamErrorCount);
+                        answer(*client, badGateway);
+                    }
+                }
+                continue;
+            }
+            int slot = acquireUpstream(backend);
+            if (slot < 0) {
+                continue;
+            }
+            Request request = queue.getNextRequest();
+            if (upstreams[slot].session != nullptr) {
+                openStream(slot, request.getRequestID());
+                continue;
+            }
+            Upstream& upstream = upstreams[slot];
+            auto entry = waiting.find(request.getRequestID());
+            Client* client = entry == waiting.end() ? nullptr
+                                                     : findClient(entry->second.first, entry->second.second);
+            if (entry != waiting.end()) {
+                waiting.erase(entry);
+            }
+            if (client == nullptr) {
+                // The client left while queued; keep the connection for the next request
+                if (upstream.connecting) {
+                    timers.arm(upstream.timer,
+                               loopTime + static_cast<uint64_t>(config.requestTimeoutMilliseconds) * MILLISECOND);
+                } else {
+                    releaseUpstream(slot);
+                }
+                continue;
+            }
+            upstream.output.push(client->input.take(client->requestLength));
+            upstream.busy = true;
+            upstream.clientFd = client->fd;
+            upstream.clientID = client->id;
+            upstream.headRequest = client->headRequest;
+            client->upstreamSlot = slot;
+            inFlight[backend]++;
+            flushUpstream(slot);
+        }
+    }
+
+    /**
+     * @brief Read a pooled connection's responses and relay them
+     * @param slot Slot index
+     */
+    void upstreamReadable(int slot) {
+        if (upstreams[slot].session != nullptr) {
+            sessionReadable(slot);
+            return;
+        }
+        Upstream& upstream = upstreams[slot];
+        bool open = upstream.input.fill(upstream.fd, pool);
+        while (upstream.busy && upstream.input.consumed < upstream.input.length) {
+            HttpResponseView response;
+            HttpParseStatus status = upstream.parser.parseResponse(upstream.input.unparsed(), upstream.headRequest,
+                                                                   response);
+            if (status == HttpParseStatus::INCOMPLETE) {
+                break;
+            }
+            if (status == HttpParseStatus::INVALID) {
+                closeUpstream(slot, true);
+                return;
+            }
+            int backend = upstream.backend;
+            // Interim responses are dropped: the whole request body has already been sent
+            upstream.input.consumed += response.interimLength;
+            BufferSlice bytes = upstream.input.take(response.length - response.interimLength);
+            upstream.input.consumed += response.length - response.interimLength;
+            upstream.input.releaseIfDrained();
+            upstream.busy = false;
+            inFlight[backend]--;
+            bump(responseCount);
+            bump(backendResponses[backend]);
+            Client* client = findClient(upstream.clientFd, upstream.clientID);
+            bool keep = response.keepAlive && open;
+            if (keep) {
+                releaseUpstream(slot);
+            } else {
+                closeUpstream(slot, false);
+            }
+            if (client != nullptr) {
+                // The slice keeps the bytes alive even if the upstream was closed
+                answer(*client, bytes);
+            }
+            dispatch();
+            return;
+        }
+        if (!open || (!upstream.busy && upstream.input.consumed < upstream.input.length)) {
+            // Closed by the backend, or bytes nobody asked for
+            closeUpstream(slot, upstream.busy);
+        }
+    }
+
+    /**
+     * @brief Handle writability of a pooled connection
+     * @param slot Slot index
+     */
+    void upstreamWritable(int slot) {
+        Upstream& upstream = upstreams[slot];
+        if (upstream.connecting) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (::getsockopt(upstream.fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+                closeUpstream(slot, true);
+                dispatch();
+                return;
+            }
+            upstream.connecting = false;
+            if (upstream.session != nullptr) {
+                timers.cancel(upstream.timer);
+                updateSession(slot);
+            } else if (!upstream.busy) {
+                releaseUpstream(slot);
+            }
+        }
+        if (upstream.fd >= 0) {
+            flushUpstream(slot);
+        }
+    }
+
+    /**
+     * @brief Publish this worker's load and read everyone else's
+     */
+    void exchangeLoad() {
+        uint64_t expirations;
+        ssize_t ignored = ::read(syncFd, &expirations, sizeof(expirations));
+        (void)ignored;
+        size_t count = backendAddresses.size();
+        std::atomic<int>* row = board + boardStride * static_cast<size_t>(index);
+        for (size_t b = 0; b < count; ++b) {
+            row[b].store(inFlight[b], std::memory_order_relaxed);
+        }
+        std::fill(remoteLoad.begin(), remoteLoad.end(), 0);
+        for (int w = 0; w < workerCount; ++w) {
+            if (w == index) {
+                continue;
+            }
+            const std::atomic<int>* other = board + boardStride * static_cast<size_t>(w);
+            for (size_t b = 0; b < count; ++b) {
+                remoteLoad[b] += other[b].load(std::memory_order_relaxed);
+            }
+        }
+        bump(syncCount);
+        const BufferPoolStats& buffers = pool.getStats();
+        bufferSlabBytes.store(static_cast<long long>(buffers.slabBytes), std::memory_order_relaxed);
+        bufferPeakBytes.store(static_cast<long long>(buffers.peakBytesInUse), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Handle every connection whose deadline has passed
+     */
+    void expireTimers() {
+        size_t fired = timers.advance(loopTime, [this](TimerNode& timer) {
+            if (timer.tag & UPSTREAM_TAG) {
+                int slot = static_cast<int>(timer.tag & ~UPSTREAM_TAG);
+                closeUpstream(slot, upstreams[slot].connecting);
+                return;
+            }
+            auto it = clients.find(static_cast<int>(timer.tag));
+            if (it != clients.end()) {
+                clientTimedOut(*it->second);
+            }
+        });
+        if (fired > 0) {
+            dispatch();
+        }
+    }
+
+    /**
+     * @brief Close the worker's own descriptors
+     */
+    void closeDescriptors() {
+        for (int* fd : {&listenFd, &epollFd, &syncFd, &stopFd}) {
+            if (*fd >= 0) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Create a worker
+     * @param settings Settings, which must outlive the worker
+     * @param number Worker number
+     * @param workers Total workers
+     * @param cpuNumber CPU to bind to, -1 to float
+     * @param socket Listening socket, owned by the worker from now on
+     * @param loadBoard Shared load board
+     * @param stride Board entries per worker
+     * @throws std::runtime_error if the event loop cannot be created
+     */
+    Worker(const ProxyConfig& settings, int number, int workers, int cpuNumber, int socket,
+           std::atomic<int>* loadBoard, size_t stride)
+        : config(settings), index(number), cpu(cpuNumber), listenFd(socket), epollFd(-1), syncFd(-1), stopFd(-1),
+          board(loadBoard), boardStride(stride), workerCount(workers), nextBackend(number), queue(settings.queueLimit),
+          nextClientID(0), nextRequestID(0), timers(monotonicNanoseconds(), MILLISECOND),
+          loopTime(monotonicNanoseconds()) {
+        badRequest = pool.copy(std::string_view(BAD_REQUEST, sizeof(BAD_REQUEST) - 1));
+        badGateway = pool.copy(std::string_view(BAD_GATEWAY, sizeof(BAD_GATEWAY) - 1));
+        unavailable = pool.copy(std::string_view(UNAVAILABLE, sizeof(UNAVAILABLE) - 1));
+        gatewayTimeout = pool.copy(std::string_view(GATEWAY_TIMEOUT, sizeof(GATEWAY_TIMEOUT) - 1));
+        size_t count = settings.backends.size();
+        for (const auto& backend : settings.backends) {
+            backendAddresses.push_back(makeStreamAddress(backend.host, backend.port, backend.path));
+            authorities.push_back(backend.path.empty() ? backend.toString() : std::string("localhost"));
+        }
+        inFlight.assign(count, 0);
+        remoteLoad.assign(count, 0);
+        retryAfter.assign(count, 0);
+        idle.resize(count);
+        closed.resize(count);
+        int pool = std::max(1, settings.connectionsPerBackend);
+        upstreams.resize(count * static_cast<size_t>(pool));
+        for (size_t b = 0; b < count; ++b) {
+            for (int k = pool - 1; k >= 0; --k) {
+                int slot = static_cast<int>(b) * pool + k;
+                upstreams[slot].backend = static_cast<int>(b);
+                upstreams[slot].timer.tag = UPSTREAM_TAG | static_cast<uint64_t>(slot);
+                closed[b].push_back(slot);
+            }
+        }
+        backendResponses.reset(new std::atomic<long long>[count]);
+        for (size_t b = 0; b < count; ++b) {
+            backendResponses[b].store(0);
+        }
+        nextBackend = count > 0 ? number % static_cast<int>(count) : 0;
+
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        syncFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || syncFd < 0 || stopFd < 0 || !watch(listenFd, LISTEN_TAG, EPOLLIN) ||
+            !watch(syncFd, SYNC_TAG, EPOLLIN) || !watch(stopFd, STOP_TAG, EPOLLIN)) {
+            std::string reason = std::strerror(errno);
+            closeDescriptors();
+            throw std::runtime_error("cannot create event loop: " + reason);
+        }
+        itimerspec period;
+        std::memset(&period, 0, sizeof(period));
+        long interval = std::max(1, settings.syncMilliseconds) * 1000000L;
+        period.it_interval.tv_sec = interval / 1000000000L;
+        period.it_interval.tv_nsec = interval % 1000000000L;
+        period.it_value = period.it_interval;
+        ::timerfd_settime(syncFd, 0, &period, nullptr);
+    }
+
+    /**
+     * @brief Close every connection and descriptor
+     */
+    ~Worker() {
+        for (auto& entry : clients) {
+            ::close(entry.first);
+        }
+        for (auto& upstream : upstreams) {
+            if (upstream.fd >= 0) {
+                ::close(upstream.fd);
+            }
+        }
+        closeDescriptors();
+    }
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    /**
+     * @brief Run the event loop until requestStop() is called
+     */
+    void run() {
+        if (cpu >= 0) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(cpu, &mask);
+            pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+        }
+        epoll_event events[256];
+        while (true) {
+            int ready = ::epoll_wait(epollFd, events, 256, -1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            loopTime = monotonicNanoseconds();
+            for (int i = 0; i < ready; ++i) {
+                uint64_t tag = events[i].data.u64;
+                uint32_t flags = events[i].events;
+                if (tag == STOP_TAG) {
+                    return;
+                }
+                if (tag == LISTEN_TAG) {
+                    acceptAll();
+                } else if (tag == SYNC_TAG) {
+                    exchangeLoad();
+                    expireTimers();
+                } else if (tag & UPSTREAM_TAG) {
+                    int slot = static_cast<int>(tag & ~UPSTREAM_TAG);
+                    if (upstreams[slot].fd < 0) {
+                        continue;
+                    }
+                    if (flags & EPOLLOUT) {
+                        upstreamWritable(slot);
+                    }
+                    if (upstreams[slot].fd >= 0 && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                        upstreamReadable(slot);
+                    }
+                } else {
+                    auto it = clients.find(static_cast<int>(tag));
+                    if (it == clients.end()) {
+                        continue;
+                    }
+                    Client& client = *it->second;
+                    if ((flags & EPOLLOUT) && !flushClient(client)) {
+                        continue;
+                    }
+                    if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                        clientReadable(client);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Ask the event loop to return
+     */
+    void requestStop() {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(stopFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    /**
+     * @brief Add this worker's counters to a total
+     * @param total Counters to add to
+     */
+    void addStats(ProxyStats& total) const {
+        long long requests = requestCount.load(std::memory_order_relaxed);
+        total.connections += connectionCount.load(std::memory_order_relaxed);
+        total.requests += requests;
+        total.responses += responseCount.load(std::memory_order_relaxed);
+        total.rejected += rejectedCount.load(std::memory_order_relaxed);
+        total.invalid += invalidCount.load(std::memory_order_relaxed);
+        total.upstreamErrors += upstreamErrorCount.load(std::memory_order_relaxed);
+        total.upstreamConnects += upstreamConnectCount.load(std::memory_order_relaxed);
+        total.loadSyncs += syncCount.load(std::memory_order_relaxed);
+        total.idleTimeouts += idleTimeoutCount.load(std::memory_order_relaxed);
+        total.requestTimeouts += requestTimeoutCount.load(std::memory_order_relaxed);
+        total.bufferBytes += bufferSlabBytes.load(std::memory_order_relaxed);
+        total.peakBufferBytes += bufferPeakBytes.load(std::memory_order_relaxed);
+        total.backendResponses.resize(backendAddresses.size(), 0);
+        for (size_t b = 0; b < backendAddresses.size(); ++b) {
+            total.backendResponses[b] += backendResponses[b].load(std::memory_order_relaxed);
+        }
+        total.workerRequests.push_back(requests);
+    }
+};
+
+/**
+ * @brief Parse "HOST:PORT" or "unix:PATH"
+ * @param text Address
+ * @return Backend address
+ * @throws std::invalid_argument if malformed
+ */
+BackendAddress BackendAddress::parse(const std::string& text) {
+    BackendAddress address;
+    if (text.compare(0, 5, "unix:") == 0) {
+        address.path = text.substr(5);
+        if (address.path.empty()) {
+            throw std::invalid_argument("invalid backend address (expected unix:PATH): " + text);
+        }
+        return address;
+    }
+    size_t colon = text.rfind(':');
+    size_t used = 0;
+    try {
+        if (colon != std::string::npos && colon > 0) {
+            address.port = std::stoi(text.substr(colon + 1), &used);
+        }
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (colon == std::string::npos || colon == 0 || used == 0 || used != text.size() - colon - 1 ||
+        address.port <= 0 || address.port > 65535) {
+        throw std::invalid_argument("invalid backend address (expected HOST:PORT): " + text);
+    }
+    address.host = text.substr(0, colon);
+    return address;
+}
+
+/**
+ * @brief Format the address the way parse() accepts it
+ * @return "HOST:PORT" or "unix:PATH"
+ */
+std::string BackendAddress::toString() const {
+    return path.empty() ? host + ":" + std::to_string(port) : "unix:" + path;
+}
+
+/**
+ * @brief Create a stopped proxy
+ * @param settings Settings
+ * @throws std::invalid_argument if no backends are configured
+ */
+ProxyServer::ProxyServer(const ProxyConfig& settings) : config(settings), boundPort(settings.port), boardStride(0) {
+    if (config.backends.empty()) {
+        throw std::invalid_argument("the proxy needs at least one backend");
+    }
+    if (config.workers <= 0) {
+        config.workers = std::max<int>(1, static_cast<int>(CpuTopology::get().getPlacementOrder().size()));
+    }
+    // Each worker's row starts on its own cache line, so publishing never
+    // invalidates another worker's row
+    boardStride = (config.backends.size() + BOARD_LINE - 1) / BOARD_LINE * BOARD_LINE;
+    size_t entries = boardStride * static_cast<size_t>(config.workers);
+    loadBoard.reset(new std::atomic<int>[entries]);
+    for (size_t i = 0; i < entries; ++i) {
+        loadBoard[i].store(0);
+    }
+}
+
+/**
+ * @brief Stop the proxy if running
+ */
+ProxyServer::~ProxyServer() {
+    stop();
+}
+
+/**
+ * @brief Bind the listening sockets and start the workers
+ * @throws std::runtime_error if a socket cannot be created or bound
+ */
+void ProxyServer::start() {
+    if (!threads.empty()) {
+        return;
+    }
+    workers.clear();
+    std::vector<int> cpus = CpuTopology::get().getPlacementOrder();
+    for (int i = 0; i < config.workers; ++i) {
+        int fd = openReusePortListener(config.host, boundPort);
+        if (boundPort == 0) {
+            boundPort = getLocalPort(fd);
+        }
+        int cpu = config.pinWorkers && !cpus.empty() ? cpus[static_cast<size_t>(i) % cpus.size()] : -1;
+        workers.emplace_back(new Worker(config, i, config.workers, cpu, fd, loadBoard.get(), boardStride));
+    }
+    for (auto& worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+}
+
+/**
+ * @brief Close all connections and stop the workers
+ */
+void ProxyServer::stop() {
+    for (auto& worker : workers) {
+        worker->requestStop();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+}
+
+/**
+ * @brief Get the port being listened on
+ * @return Port, resolved if 0 was configured
+ */
+int ProxyServer::getPort() const {
+    return boundPort;
+}
+
+/**
+ * @brief Get the number of workers
+ * @return Worker count
+ */
+int ProxyServer::getWorkerCount() const {
+    return config.workers;
+}
+
+/**
+ * @brief Get the counters so far
+ * @return Counters summed over workers
+ */
+ProxyStats ProxyServer::getStats() const {
+    ProxyStats total;
+    total.backendResponses.assign(config.backends.size(), 0);
+    for (const auto& worker : workers) {
+        worker->addStats(total);
+    }
+    return total;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file ProxyServer.h
+ * @brief Header file for the ProxyServer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef PROXYSERVER_H
+#define PROXYSERVER_H
+
+#include "LoadBalancer.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct BackendAddress
+ * @brief Upstream server the proxy forwards to
+ */
+struct BackendAddress {
+    std::string host;  ///< IPv4 address
+    int port = 0;      ///< Port
+    std::string path;  ///< Unix domain socket path, empty for TCP
+
+    /**
+     * @brief Parse "HOST:PORT" or "unix:PATH"
+     * @param text Address
+     * @return Backend address
+     * @throws std::invalid_argument if malformed
+     */
+    static BackendAddress parse(const std::string& text);
+
+    /**
+     * @brief Format the address the way parse() accepts it
+     * @return "HOST:PORT" or "unix:PATH"
+     */
+    std::string toString() const;
+};
+
+/**
+ * @struct ProxyConfig
+ * @brief Listening address, backends and worker layout of a proxy
+ */
+struct ProxyConfig {
+    std::string host = "127.0.0.1";   ///< Listening IPv4 address
+    int port = 8080;                  ///< Listening port, 0 for any free port
+    std::vector<BackendAddress> backends; ///< Upstream servers
+    int workers = 0;                  ///< Worker threads, 0 for one per usable CPU
+    bool pinWorkers = false;          ///< Bind each worker to its own CPU
+    DistributionPolicy policy = DistributionPolicy::ROUND_ROBIN; ///< Backend selection
+    int queueLimit = 10000;           ///< Requests each worker's queue shard holds
+    int connectionsPerBackend = 32;   ///< Upstream connections per worker and backend
+    int syncMilliseconds = 10;        ///< Interval between load exchanges and timeout checks
+    int idleTimeoutMilliseconds = 60000;    ///< Idle keep-alive connections are closed after this
+    int headerTimeoutMilliseconds = 10000;  ///< A request must arrive in full within this of its first byte
+    int requestTimeoutMilliseconds = 30000; ///< A request must be answered within this of admission, else 504
+    bool upstreamHttp2 = false;       ///< Multiplex requests over HTTP/2 (h2c) upstream connections
+    int maxStreamsPerConnection = 100; ///< Concurrent streams per HTTP/2 upstream connection
+    bool trustForwardedFor = false;   ///< Take the client from X-Forwarded-For instead of the peer address
+};
+
+/**
+ * @struct ProxyStats
+ * @brief Counters summed over a proxy's workers
+ */
+struct ProxyStats {
+    long long connections = 0;       ///< Client connections accepted
+    long long requests = 0;          ///< Requests parsed
+    long long responses = 0;         ///< Upstream responses relayed to clients
+    long long rejected = 0;          ///< 503 responses because a queue shard was full
+    long long invalid = 0;           ///< Malformed requests answered 400
+    long long upstreamErrors = 0;    ///< 502 responses after an upstream failure
+    long long upstreamConnects = 0;  ///< Upstream connections opened
+    long long loadSyncs = 0;         ///< Load exchanges performed
+    long long idleTimeouts = 0;      ///< Client connections closed idle or part-way through a request
+    long long requestTimeouts = 0;   ///< 504 responses because a request ran out of time
+    long long bufferBytes = 0;       ///< Slab memory held by the workers' buffer pools
+    long long peakBufferBytes = 0;   ///< Sum of each worker's most buffer memory in use at once
+    std::vector<long long> backendResponses; ///< Responses relayed per backend
+    std::vector<long long> workerRequests;   ///< Requests parsed per worker
+};
+
+/**
+ * @class ProxyServer
+ * @brief Networked HTTP/1.1 load balancer with shared-nothing workers
+ *
+ * The networked counterpart of LoadBalancer. Each worker owns one
+ * SO_REUSEPORT listening socket, one epoll loop, one RequestQueue shard
+ * and its own keep-alive connection pool to every backend; the kernel
+ * spreads incoming connections across the listeners, and a request is
+ * handled start to finish by the worker that accepted its connection.
+ * Nothing is locked or shared on the request path.
+ *
+ * Workers learn about each other's load only through a board of per-
+ * backend in-flight counts that each worker publishes and reads every
+ * syncMilliseconds. Least-connections selection adds that periodic view
+ * of the other workers to the worker's own exact count; round-robin needs
+ * no exchange at all.
+ *
+ * Requests are parsed with HttpParser, admitted to the worker's queue
+ * shard (refused with 503 when full) and relayed byte-for-byte to the
+ * chosen backend; responses are framed with HttpParser::parseResponse and
+ * relayed back in request order.
+ *
+ * Receive buffers come from the worker's BufferPool and are held only
+ * while bytes are buffered. A request is handed to its upstream, and a
+ * response to its client, as a BufferSlice of the receiving block rather
+ * than a copy.
+ *
+ * With upstreamHttp2 set, backends are spoken to in cleartext HTTP/2 with
+ * prior knowledge. Each pooled connection carries up to
+ * maxStreamsPerConnection requests at once (fewer if the backend says
+ * so), and a new connection is opened only when every open one is full,
+ * so a backend with hundreds of requests in service needs a handful of
+ * sockets rather than hundreds. Requests are translated to HTTP/2 header
+ * blocks at dispatch and responses back to HTTP/1.1 for the client. Each
+ * stream counts as one in-flight request in the load accounting, exactly
+ * as a busy HTTP/1.1 connection does. A request that times out resets
+ * only its own stream.
+ *
+ * A backend on the same host can be given as a Unix domain socket path
+ * instead of a TCP port. This skips the loopback TCP stack and its
+ * handshakes. Pooling, failure handling and selection policies are the
+ * same for both kinds, and the two can be mixed in one backend list.
+ *
+ * A request's client address, which the queue's blocklist is checked
+ * against, is the connection's peer. With trustForwardedFor set it is the
+ * first X-Forwarded-For address instead, for a proxy that sits behind
+ * another one that sets the header.
+ *
+ * Every connection carries one timer in its worker's TimerWheel, re-armed
+ * as the connection changes state: idle, reading a request, or waiting
+ * for the request's response. The wheel advances on the load exchange
+ * timer, so timeouts fire up to syncMilliseconds late.
+ */
+class ProxyServer {
+private:
+    class Worker;
+
+    ProxyConfig config;                            ///< Settings
+    int boundPort;                                 ///< Port actually listened on
+    size_t boardStride;                            ///< Board entries per worker, padded to cache lines
+    std::unique_ptr<std::atomic<int>[]> loadBoard; ///< Published in-flight counts per worker and backend
+    std::vector<std::unique_ptr<Worker>> workers;  ///< Event loops
+    std::vector<std::thread> threads;              ///< Threads running the event loops
+
+public:
+    /**
+     * @brief Create a stopped proxy
+     * @param settings Settings
+     * @throws std::invalid_argument if no backends are configured
+     */
+    explicit ProxyServer(const ProxyConfig& settings);
+
+    /**
+     * @brief Stop the proxy if running
+     */
+    ~ProxyServer();
+
+    ProxyServer(const ProxyServer&) = delete;
+    ProxyServer& operator=(const ProxyServer&) = delete;
+
+    /**
+     * @brief Bind the listening sockets and start the workers
+     * @throws std::runtime_error if a socket cannot be created or bound
+     */
+    void start();
+
+    /**
+     * @brief Close all connections and stop the workers
+     */
+    void stop();
+
+    /**
+     * @brief Get the port being listened on
+     * @return Port, resolved if 0 was configured
+     */
+    int getPort() const;
+
+    /**
+     * @brief Get the number of workers
+     * @return Worker count
+     */
+    int getWorkerCount() const;
+
+    /**
+     * @brief Get the counters so far
+     * @return Counters summed over workers
+     */
+    ProxyStats getStats() const;
+};
+
+#endif // PROXYSERVER_H
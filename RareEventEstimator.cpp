@@ -0,0 +1,378 @@
+/**
+ * @file RareEventEstimator.cpp
+ * @brief Implementation file for the RareEventEstimator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "RareEventEstimator.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+
+/**
+ * @brief Parameterized constructor
+ * @param simulationConfig Load balancer configuration; cycles is the horizon
+ * @param workloadParams Arrival and service-time parameters
+ * @param rareEvent Event to estimate
+ */
+RareEventEstimator::RareEventEstimator(const SimulationConfig& simulationConfig,
+                                       const WorkloadParams& workloadParams, RareEvent rareEvent)
+    : config(simulationConfig), workload(workloadParams), event(rareEvent), levelCount(0),
+      trajectoriesPerLevel(500), repetitions(10), baseSeed(1), simulatedCycles(0) {
+}
+
+/**
+ * @brief Set the number of splitting levels
+ * @param count Levels including the final event level, or 0 to place them adaptively
+ */
+void RareEventEstimator::setLevelCount(int count) {
+    levelCount = std::max(0, count);
+}
+
+/**
+ * @brief Set the number of trajectories started at each level
+ * @param count Trajectories per level (at least 1)
+ */
+void RareEventEstimator::setTrajectoriesPerLevel(int count) {
+    trajectoriesPerLevel = std::max(1, count);
+}
+
+/**
+ * @brief Set the number of independent repetitions
+ * @param count Repetitions (at least 1)
+ */
+void RareEventEstimator::setRepetitions(int count) {
+    repetitions = std::max(1, count);
+}
+
+/**
+ * @brief Set the seed of the first repetition
+ * @param seed Seed
+ */
+void RareEventEstimator::setSeed(unsigned int seed) {
+    baseSeed = seed;
+}
+
+/**
+ * @brief Check whether the rare event has occurred
+ * @param loadBalancer State to check
+ * @return True if the event holds in this state
+ */
+bool RareEventEstimator::eventOccurred(const LoadBalancer& loadBalancer) const {
+    if (event == RareEvent::OVERLOAD) {
+        return loadBalancer.isOverloaded();
+    }
+    return loadBalancer.getQueueSize() >= loadBalancer.getMaxQueueSize();
+}
+
+/**
+ * @brief Importance function used to define levels
+ * @param loadBalancer State to score
+ * @return Progress towards the event in thousandths, or INT_MAX once it has occurred
+ */
+int RareEventEstimator::importance(const LoadBalancer& loadBalancer) const {
+    if (eventOccurred(loadBalancer)) {
+        return INT_MAX;
+    }
+    
+    // isOverloaded() trips at 80% queue or 90% system utilization; score
+    // whichever of the two is closer to its limit
+    double progress;
+    if (event == RareEvent::OVERLOAD) {
+        progress = std::max(loadBalancer.getQueueUtilization() / 80.0,
+                            loadBalancer.getSystemUtilization() / 90.0);
+    } else {
+        progress = static_cast<double>(loadBalancer.getQueueSize()) / loadBalancer.getMaxQueueSize();
+    }
+    return static_cast<int>(progress * 1000.0);
+}
+
+/**
+ * @brief Build the initial state of a repetition
+ * @param seed Seed for the workload generator
+ * @return Initial state
+ */
+RareEventEstimator::State RareEventEstimator::makeInitialState(unsigned int seed) const {
+    State initial{
+        LoadBalancer(config.initialServers, config.maxServers, config.minServers, config.loadThreshold),
+        WorkloadGenerator(workload, seed)};
+    initial.loadBalancer.setDistributionPolicy(config.policy);
+    initial.loadBalancer.setMaxQueueSize(config.maxQueueSize);
+    for (int i = 0; i < config.initialQueueSize; ++i) {
+        initial.loadBalancer.addRequest(initial.generator.generateRequest());
+    }
+    return initial;
+}
+
+/**
+ * @brief Advance a state until it reaches a threshold or the horizon
+ * @param state State to advance in place
+ * @param threshold Importance level that ends the trajectory
+ * @return Highest importance seen along the trajectory
+ */
+int RareEventEstimator::runTrajectory(State& state, int threshold) const {
+    int highest = importance(state.loadBalancer);
+    while (highest < threshold && state.loadBalancer.getCurrentCycle() < config.cycles) {
+        advanceCycle(state.loadBalancer, state.generator, true);
+        highest = std::max(highest, importance(state.loadBalancer));
+    }
+    return highest;
+}
+
+/**
+ * @brief Compute evenly spaced level thresholds
+ * @param initial Initial load balancer state
+ * @return Thresholds on the importance function, the last one being the event
+ */
+std::vector<int> RareEventEstimator::evenThresholds(const LoadBalancer& initial) const {
+    const int target = 1000;
+    int start = std::min(importance(initial), target);
+    
+    std::vector<int> levels;
+    for (int k = 1; k < levelCount; ++k) {
+        int depth = start + static_cast<int>(static_cast<long long>(target - start) * k / levelCount);
+        if (depth > start && (levels.empty() || depth > levels.back())) {
+            levels.push_back(depth);
+        }
+    }
+    levels.push_back(INT_MAX);
+    return levels;
+}
+
+/**
+ * @brief Place level thresholds with an adaptive pilot run
+ * @param pool Thread pool running the trajectories
+ * @return Thresholds on the importance function, the last one being the event
+ */
+std::vector<int> RareEventEstimator::adaptiveThresholds(ThreadPool& pool) {
+    const double survivalFraction = 0.2;
+    const int maxStages = 64;
+    
+    std::vector<int> levels;
+    std::vector<std::shared_ptr<State>> starts = {std::make_shared<State>(makeInitialState(~baseSeed))};
+    int lowest = importance(starts[0]->loadBalancer);
+    std::mt19937 seeder(~baseSeed);
+    int count = trajectoriesPerLevel;
+    
+    for (int stage = 0; stage < maxStages && !starts.empty(); ++stage) {
+        std::vector<unsigned int> seeds(count);
+        std::vector<size_t> origins(count);
+        std::vector<int> highest(count);
+        for (int i = 0; i < count; ++i) {
+            seeds[i] = seeder();
+            origins[i] = seeder() % starts.size();
+        }
+        
+        // Run every trajectory to the horizon (or the event) to see how far it gets
+        for (int i = 0; i < count; ++i) {
+            pool.submit([&, i] {
+                State clone = *starts[origins[i]];
+                clone.generator.reseed(seeds[i]);
+                highest[i] = runTrajectory(clone, INT_MAX);
+            });
+        }
+        pool.waitAll();
+        
+        std::vector<int> sorted = highest;
+        std::sort(sorted.begin(), sorted.end());
+        int level = sorted[static_cast<size_t>((1.0 - survivalFraction) * (count - 1))];
+        if (level == INT_MAX) {
+            break;
+        }
+        if (!levels.empty()) {
+            lowest = levels.back();
+        }
+        if (level <= lowest) {
+            level = lowest + 1; // Always make progress towards the event
+        }
+        if (sorted.back() < level) {
+            break; // Nothing climbs further; let the final level take over
+        }
+        levels.push_back(level);
+        
+        // Replay the surviving trajectories (same seeds) up to the new level
+        std::vector<std::shared_ptr<State>> entrances(count);
+        for (int i = 0; i < count; ++i) {
+            if (highest[i] < level) continue;
+            pool.submit([&, i, level] {
+                auto clone = std::make_shared<State>(*starts[origins[i]]);
+                clone->generator.reseed(seeds[i]);
+                runTrajectory(*clone, level);
+                entrances[i] = clone;
+            });
+        }
+        pool.waitAll();
+        
+        starts.clear();
+        for (const auto& entrance : entrances) {
+            if (entrance) starts.push_back(entrance);
+        }
+    }
+    
+    levels.push_back(INT_MAX);
+    return levels;
+}
+
+/**
+ * @brief Run one independent splitting estimate
+ * @param pool Thread pool running the trajectories
+ * @param seed Seed for this repetition
+ * @param levelProbabilities Output conditional probability of each level
+ * @return Probability estimate
+ */
+double RareEventEstimator::estimateOnce(ThreadPool& pool, unsigned int seed,
+                                        std::vector<double>& levelProbabilities) {
+    auto initial = std::make_shared<State>(makeInitialState(seed));
+    std::vector<std::shared_ptr<State>> starts = {initial};
+    std::mt19937 seeder(seed);
+    double probability = 1.0;
+    levelProbabilities.assign(thresholds.size(), 0.0);
+    
+    for (size_t level = 0; level < thresholds.size(); ++level) {
+        int threshold = thresholds[level];
+        int count = trajectoriesPerLevel;
+        std::vector<std::shared_ptr<State>> entrances(count);
+        std::vector<long long> cycles(count, 0);
+        std::vector<unsigned int> seeds(count);
+        std::vector<size_t> origins(count);
+        for (int i = 0; i < count; ++i) {
+            seeds[i] = seeder();
+            origins[i] = seeder() % starts.size();
+        }
+        
+        // Split trajectories into a few chunks per worker to balance load
+        int chunk = std::max(1, count / (pool.getThreadCount() * 4));
+        for (int first = 0; first < count; first += chunk) {
+            int last = std::min(count, first + chunk);
+            pool.submit([&, first, last] {
+                for (int i = first; i < last; ++i) {
+                    auto clone = std::make_shared<State>(*starts[origins[i]]);
+                    clone->generator.reseed(seeds[i]);
+                    
+                    long long startCycle = clone->loadBalancer.getCurrentCycle();
+                    int highest = runTrajectory(*clone, threshold);
+                    cycles[i] = clone->loadBalancer.getCurrentCycle() - startCycle;
+                    if (highest >= threshold) {
+                        entrances[i] = clone;
+                    }
+                }
+            });
+        }
+        pool.waitAll();
+        
+        starts.clear();
+        for (int i = 0; i < count; ++i) {
+            simulatedCycles += cycles[i];
+            if (entrances[i]) {
+                starts.push_back(entrances[i]);
+            }
+        }
+        
+        levelProbabilities[level] = static_cast<double>(starts.size()) / count;
+        probability *= levelProbabilities[level];
+        if (starts.empty()) {
+            break; // No trajectory survived; the estimate for this repetition is 0
+        }
+    }
+    
+    return probability;
+}
+
+/**
+ * @brief Run all repetitions
+ * @param pool Thread pool running the trajectories
+ */
+void RareEventEstimator::run(ThreadPool& pool) {
+    estimates = RunningStats();
+    levelEstimates.clear();
+    simulatedCycles = 0;
+    
+    if (levelCount > 0) {
+        thresholds = evenThresholds(makeInitialState(baseSeed).loadBalancer);
+    } else {
+        thresholds = adaptiveThresholds(pool);
+    }
+    
+    for (int r = 0; r < repetitions; ++r) {
+        std::vector<double> levelProbabilities;
+        estimates.add(estimateOnce(pool, baseSeed + r, levelProbabilities));
+        
+        if (levelEstimates.size() < levelProbabilities.size()) {
+            levelEstimates.resize(levelProbabilities.size());
+        }
+        for (size_t k = 0; k < levelProbabilities.size(); ++k) {
+            levelEstimates[k].add(levelProbabilities[k]);
+        }
+    }
+}
+
+/**
+ * @brief Get the estimated event probability
+ * @return Mean of the repetition estimates
+ */
+double RareEventEstimator::getProbability() const {
+    return estimates.getMean();
+}
+
+/**
+ * @brief Get the half-width of the 95% confidence interval
+ * @return Half-width, or 0 with a single repetition
+ */
+double RareEventEstimator::getConfidenceHalfWidth() const {
+    return estimates.getConfidenceHalfWidth();
+}
+
+/**
+ * @brief Build a human-readable report
+ * @return Report lines
+ */
+std::vector<std::string> RareEventEstimator::getReport() const {
+    std::vector<std::string> report;
+    double p = getProbability();
+    double half = getConfidenceHalfWidth();
+    
+    std::stringstream ss;
+    ss << "Rare-event estimate (" << (event == RareEvent::OVERLOAD ? "overload" : "queue full")
+       << " within " << config.cycles << " cycles, " << repetitions << " repetitions x "
+       << levelEstimates.size() << " levels x " << trajectoriesPerLevel << " trajectories)";
+    report.push_back(ss.str());
+    
+    ss.str("");
+    ss << std::scientific << std::setprecision(3);
+    ss << "  Probability: " << p << " +/- " << half;
+    if (p > 0.0) {
+        ss << std::fixed << std::setprecision(1) << " (relative error " << 100.0 * half / p << "%)";
+    }
+    report.push_back(ss.str());
+    
+    for (size_t k = 0; k < levelEstimates.size(); ++k) {
+        ss.str("");
+        ss << std::fixed << std::setprecision(1);
+        ss << "  Level " << k + 1 << " (";
+        if (thresholds[k] == INT_MAX) {
+            ss << "event";
+        } else {
+            ss << "progress >= " << thresholds[k] / 10.0 << "%";
+        }
+        ss << std::setprecision(4) << ") conditional probability: " << levelEstimates[k].getMean();
+        report.push_back(ss.str());
+    }
+    
+    ss.str("");
+    ss << "  Simulated cycles: " << simulatedCycles;
+    if (p > 0.0 && half > 0.0) {
+        // Independent horizon-length runs crude Monte Carlo would need for the same relative error
+        double relative = half / (1.96 * p);
+        double crudeRuns = (1.0 - p) / (p * relative * relative);
+        ss << std::scientific << std::setprecision(2) << " (crude Monte Carlo: ~"
+           << crudeRuns * config.cycles << " cycles)";
+    }
+    report.push_back(ss.str());
+    return report;
+}
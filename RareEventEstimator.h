@@ -0,0 +1,183 @@
+/**
+ * @file RareEventEstimator.h
+ * @brief Header file for the RareEventEstimator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef RAREEVENTESTIMATOR_H
+#define RAREEVENTESTIMATOR_H
+
+#include "Simulation.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+
+/**
+ * @enum RareEvent
+ * @brief Event whose probability is estimated
+ */
+enum class RareEvent {
+    QUEUE_FULL, ///< Request queue reaches its maximum size
+    OVERLOAD    ///< LoadBalancer::isOverloaded() becomes true
+};
+
+/**
+ * @class RareEventEstimator
+ * @brief Estimates the probability of a rare overload event by multilevel splitting
+ * 
+ * The estimator uses fixed-effort splitting on progress towards the event:
+ * queue fill for QUEUE_FULL, and the closer of queue and server utilization
+ * to their isOverloaded() limits for OVERLOAD. The path from the initial
+ * state to the event is cut into levels at intermediate progress values,
+ * either evenly spaced or placed by an adaptive pilot run so that
+ * roughly a fifth of the trajectories cross each level; at each level a fixed number of trajectories is started from
+ * clones of the states that reached the previous level, and the fraction
+ * that reaches the next level before the horizon is recorded. The event
+ * probability is the product of these conditional probabilities. Each
+ * clone reseeds its workload generator so the copies diverge, and clones
+ * of one level run in parallel on the thread pool. Independent repetitions
+ * of the whole procedure provide the confidence interval.
+ */
+class RareEventEstimator {
+private:
+    /**
+     * @struct State
+     * @brief Complete simulation state that can be cloned
+     */
+    struct State {
+        LoadBalancer loadBalancer;   ///< Load balancer including queue and servers
+        WorkloadGenerator generator; ///< Workload generator including its random engine
+    };
+
+    SimulationConfig config;        ///< Load balancer configuration; cycles is the horizon
+    WorkloadParams workload;        ///< Arrival and service-time parameters
+    RareEvent event;                ///< Event being estimated
+    int levelCount;                 ///< Number of splitting levels (0 = adaptive)
+    int trajectoriesPerLevel;       ///< Trajectories started at each level
+    int repetitions;                ///< Independent repetitions of the estimator
+    unsigned int baseSeed;          ///< Seed of the first repetition
+    RunningStats estimates;         ///< Per-repetition probability estimates
+    std::vector<RunningStats> levelEstimates; ///< Per-level conditional probabilities
+    long long simulatedCycles;      ///< Total cycles simulated across all trajectories
+
+    /**
+     * @brief Check whether the rare event has occurred
+     * @param loadBalancer State to check
+     * @return True if the event holds in this state
+     */
+    bool eventOccurred(const LoadBalancer& loadBalancer) const;
+
+    /**
+     * @brief Importance function used to define levels
+     * @param loadBalancer State to score
+     * @return Progress towards the event in thousandths, or INT_MAX once it has occurred
+     */
+    int importance(const LoadBalancer& loadBalancer) const;
+
+    std::vector<int> thresholds;    ///< Level thresholds used by all repetitions
+
+    /**
+     * @brief Build the initial state of a repetition
+     * @param seed Seed for the workload generator
+     * @return Initial state
+     */
+    State makeInitialState(unsigned int seed) const;
+
+    /**
+     * @brief Advance a state until it reaches a threshold or the horizon
+     * @param state State to advance in place
+     * @param threshold Importance level that ends the trajectory
+     * @return Highest importance seen along the trajectory
+     */
+    int runTrajectory(State& state, int threshold) const;
+
+    /**
+     * @brief Compute evenly spaced level thresholds
+     * @param initial Initial load balancer state
+     * @return Thresholds on the importance function, the last one being the event
+     */
+    std::vector<int> evenThresholds(const LoadBalancer& initial) const;
+
+    /**
+     * @brief Place level thresholds with an adaptive pilot run
+     * 
+     * At each stage trajectories run to the horizon and the threshold is set
+     * to the progress reached by the top fifth of them. The pilot uses its
+     * own seeds, so the repetitions that follow remain unbiased.
+     * @param pool Thread pool running the trajectories
+     * @return Thresholds on the importance function, the last one being the event
+     */
+    std::vector<int> adaptiveThresholds(ThreadPool& pool);
+
+    /**
+     * @brief Run one independent splitting estimate
+     * @param pool Thread pool running the trajectories
+     * @param seed Seed for this repetition
+     * @param levelProbabilities Output conditional probability of each level
+     * @return Probability estimate
+     */
+    double estimateOnce(ThreadPool& pool, unsigned int seed, std::vector<double>& levelProbabilities);
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param simulationConfig Load balancer configuration; cycles is the horizon
+     * @param workloadParams Arrival and service-time parameters
+     * @param rareEvent Event to estimate
+     */
+    RareEventEstimator(const SimulationConfig& simulationConfig, const WorkloadParams& workloadParams,
+                       RareEvent rareEvent);
+
+    /**
+     * @brief Set the number of splitting levels
+     * @param count Levels including the final event level, or 0 to place them adaptively
+     */
+    void setLevelCount(int count);
+
+    /**
+     * @brief Set the number of trajectories started at each level
+     * @param count Trajectories per level (at least 1)
+     */
+    void setTrajectoriesPerLevel(int count);
+
+    /**
+     * @brief Set the number of independent repetitions
+     * @param count Repetitions (at least 1)
+     */
+    void setRepetitions(int count);
+
+    /**
+     * @brief Set the seed of the first repetition
+     * @param seed Seed
+     */
+    void setSeed(unsigned int seed);
+
+    /**
+     * @brief Run all repetitions
+     * @param pool Thread pool running the trajectories
+     */
+    void run(ThreadPool& pool);
+
+    /**
+     * @brief Get the estimated event probability
+     * @return Mean of the repetition estimates
+     */
+    double getProbability() const;
+
+    /**
+     * @brief Get the half-width of the 95% confidence interval
+     * @return Half-width, or 0 with a single repetition
+     */
+    double getConfidenceHalfWidth() const;
+
+    /**
+     * @brief Build a human-readable report
+     * @return Report lines
+     */
+    std::vector<std::string> getReport() const;
+};
+
+#endif // RAREEVENTESTIMATOR_H
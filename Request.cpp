@@ -14,8 +14,9 @@
  * 
  * Initializes a request with default values
  */
-Request::Request() : clientIP("0.0.0.0"), requestType("GET"), priority(5), 
-                     processingTime(10), arrivalTime(std::chrono::steady_clock::now()), requestID(0) {
+Request::Request() : clientAddress(IPAddress::fromIPv4(0)), requestType("GET"), priority(5), 
+                     processingTime(10), serviceTime(10), arrivalTime(std::chrono::steady_clock::now()), requestID(0),
+                     arrivalCycle(0) {
 }
 
 /**
@@ -26,9 +27,22 @@ Request::Request() : clientIP("0.0.0.0"), requestType("GET"), priority(5),
  * @param procTime Processing time in clock cycles
  * @param id Unique request identifier
  */
-Request::Request(const std::string& ip, const std::string& type, int prio, int procTime, int id)
-    : clientIP(ip), requestType(type), priority(prio), processingTime(procTime), 
-      arrivalTime(std::chrono::steady_clock::now()), requestID(id) {
+Request::Request(const IPAddress& ip, const std::string& type, int prio, int procTime, long long id)
+    : clientAddress(ip), requestType(type), priority(prio), processingTime(procTime), serviceTime(procTime),
+      arrivalTime(std::chrono::steady_clock::now()), requestID(id), arrivalCycle(0) {
+}
+
+/**
+ * @brief Parameterized constructor taking the client address as text
+ * @param ip Client IP address; text that is not an address becomes 0.0.0.0
+ * @param type Type of request
+ * @param prio Priority level (1-10)
+ * @param procTime Processing time in clock cycles
+ * @param id Unique request identifier
+ */
+Request::Request(const std::string& ip, const std::string& type, int prio, int procTime, long long id)
+    : Request(IPAddress::fromIPv4(0), type, prio, procTime, id) {
+    IPAddress::parse(ip, clientAddress);
 }
 
 /**
@@ -36,7 +50,7 @@ Request::Request(const std::string& ip, const std::string& type, int prio, int p
  * @return Client IP as string
  */
 std::string Request::getClientIP() const {
-    return clientIP;
+    return clientAddress.toString();
 }
 
 /**
@@ -71,11 +85,19 @@ std::chrono::steady_clock::time_point Request::getArrivalTime() const {
     return arrivalTime;
 }
 
+/**
+ * @brief Set the arrival time
+ * @param time Arrival time as time_point
+ */
+void Request::setArrivalTime(std::chrono::steady_clock::time_point time) {
+    arrivalTime = time;
+}
+
 /**
  * @brief Get the request ID
  * @return Unique request identifier
  */
-int Request::getRequestID() const {
+long long Request::getRequestID() const {
     return requestID;
 }
 
@@ -95,4 +117,28 @@ int Request::getWaitTime() const {
     auto now = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - arrivalTime);
     return static_cast<int>(duration.count());
-} 
\ No newline at end of file
+}
+
+/**
+ * @brief Get the simulation cycle at which the request was admitted
+ * @return Arrival cycle
+ */
+long long Request::getArrivalCycle() const {
+    return arrivalCycle;
+}
+
+/**
+ * @brief Set the simulation cycle at which the request was admitted
+ * @param cycle Arrival cycle
+ */
+void Request::setArrivalCycle(long long cycle) {
+    arrivalCycle = cycle;
+}
+
+/**
+ * @brief Get the original processing time
+ * @return Service time in clock cycles
+ */
+int Request::getServiceTime() const {
+    return serviceTime;
+}
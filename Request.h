@@ -9,6 +9,7 @@
 #ifndef REQUEST_H
 #define REQUEST_H
 
+#include "IPAddress.h"
 #include <string>
 #include <chrono>
 
@@ -21,12 +22,14 @@
  */
 class Request {
 private:
-    std::string clientIP;           ///< IP address of the client making the request
+    IPAddress clientAddress;        ///< Address of the client making the request
     std::string requestType;        ///< Type of request (GET, POST, etc.)
     int priority;                   ///< Priority level of the request (1-10)
-    int processingTime;             ///< Estimated processing time in clock cycles
+    int processingTime;             ///< Remaining processing time in clock cycles
+    int serviceTime;                ///< Original processing time in clock cycles
     std::chrono::steady_clock::time_point arrivalTime; ///< When the request arrived
-    int requestID;                  ///< Unique identifier for the request
+    long long requestID;            ///< Unique identifier for the request
+    long long arrivalCycle;         ///< Simulation cycle at which the request was admitted
 
 public:
     /**
@@ -42,7 +45,17 @@ public:
      * @param procTime Processing time in clock cycles
      * @param id Unique request identifier
      */
-    Request(const std::string& ip, const std::string& type, int prio, int procTime, int id);
+    Request(const IPAddress& ip, const std::string& type, int prio, int procTime, long long id);
+
+    /**
+     * @brief Parameterized constructor taking the client address as text
+     * @param ip Client IP address; text that is not an address becomes 0.0.0.0
+     * @param type Type of request
+     * @param prio Priority level (1-10)
+     * @param procTime Processing time in clock cycles
+     * @param id Unique request identifier
+     */
+    Request(const std::string& ip, const std::string& type, int prio, int procTime, long long id);
 
     /**
      * @brief Get the client IP address
@@ -50,6 +63,12 @@ public:
      */
     std::string getClientIP() const;
 
+    /**
+     * @brief Get the packed client address
+     * @return Client address
+     */
+    const IPAddress& getClientAddress() const { return clientAddress; }
+
     /**
      * @brief Get the request type
      * @return Request type as string
@@ -74,11 +93,19 @@ public:
      */
     std::chrono::steady_clock::time_point getArrivalTime() const;
 
+    /**
+     * @brief Set the arrival time
+     * 
+     * Used when a request is restored from storage
+     * @param time Arrival time as time_point
+     */
+    void setArrivalTime(std::chrono::steady_clock::time_point time);
+
     /**
      * @brief Get the request ID
      * @return Unique request identifier
      */
-    int getRequestID() const;
+    long long getRequestID() const;
 
     /**
      * @brief Set the processing time
@@ -91,6 +118,26 @@ public:
      * @return Wait time in milliseconds
      */
     int getWaitTime() const;
+
+    /**
+     * @brief Get the simulation cycle at which the request was admitted
+     * @return Arrival cycle
+     */
+    long long getArrivalCycle() const;
+
+    /**
+     * @brief Set the simulation cycle at which the request was admitted
+     * @param cycle Arrival cycle
+     */
+    void setArrivalCycle(long long cycle);
+
+    /**
+     * @brief Get the original processing time
+     * 
+     * Unlike getProcessingTime(), this is not reduced as the request is processed.
+     * @return Service time in clock cycles
+     */
+    int getServiceTime() const;
 };
 
 #endif // REQUEST_H 
\ No newline at end of file
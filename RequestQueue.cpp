@@ -8,20 +8,25 @@
 
 #include "RequestQueue.h"
 #include <algorithm>
+#include <utility>
 
 /**
  * @brief Default constructor
  * 
  * Initializes a request queue with default maximum size
  */
-RequestQueue::RequestQueue() : maxSize(1000), totalRequestsAdded(0), totalRequestsRemoved(0) {
+RequestQueue::RequestQueue() : memoryBudget(0), headBytes(0), tailBytes(0), spilledCount(0),
+                               totalRequestsSpilled(0), maxSize(1000), totalRequestsAdded(0),
+                               totalRequestsRemoved(0) {
 }
 
 /**
  * @brief Parameterized constructor
  * @param maxQueueSize Maximum size of the queue
  */
-RequestQueue::RequestQueue(int maxQueueSize) : maxSize(maxQueueSize), 
+RequestQueue::RequestQueue(int maxQueueSize) : memoryBudget(0), headBytes(0), tailBytes(0),
+                                              spilledCount(0), totalRequestsSpilled(0),
+                                              maxSize(maxQueueSize), 
                                               totalRequestsAdded(0), totalRequestsRemoved(0) {
 }
 
@@ -36,13 +41,46 @@ RequestQueue::~RequestQueue() {
  * @brief Add a request to the queue
  * @param request The request to add
  * @return True if request was added successfully, false if queue is full
+ * @throws std::runtime_error if the tail cannot be spilled; the request stays queued
  */
 bool RequestQueue::addRequest(const Request& request) {
     // Check if IP is blocked
-    if (isIPBlocked(request.getClientIP())) {
+    if (isIPBlocked(request.getClientAddress())) {
         return false;
     }
-    
+    return enqueue(request);
+}
+
+/**
+ * @brief Add several requests, checking them against one blocklist snapshot
+ * @param requests Requests to add, in order
+ * @return Number added; the rest were blocked or found the queue full
+ * @throws std::runtime_error if the tail cannot be spilled; earlier requests stay added
+ */
+size_t RequestQueue::addRequests(const std::vector<Request>& requests) {
+    size_t added = 0;
+    if (blockedIPs.isEmpty()) {
+        for (const auto& request : requests) {
+            added += enqueue(request) ? 1 : 0;
+        }
+        return added;
+    }
+    BlocklistStore::Snapshot blocklist = blockedIPs.acquire();
+    for (const auto& request : requests) {
+        if (!blocklist->contains(request.getClientAddress(), &blocklistStats)) {
+            added += enqueue(request) ? 1 : 0;
+        }
+    }
+    return added;
+}
+
+/**
+ * @brief Add an unblocked request unless the queue is full
+ * @param request The request to add
+ * @return True if added, false if the queue is full
+ * @throws std::runtime_error if the tail cannot be spilled; the request stays queued
+ */
+bool RequestQueue::enqueue(const Request& request) {
     // Check if queue is full
     if (isFull()) {
         return false;
@@ -50,9 +88,69 @@ bool RequestQueue::addRequest(const Request& request) {
     
     requestQueue.push(request);
     totalRequestsAdded++;
+    
+    if (memoryBudget > 0) {
+        tailBytes += estimateRequestBytes(request);
+        // Keep about half the budget for the tail and a quarter for the head
+        if (tailBytes > memoryBudget / 2) {
+            spillTail();
+        }
+    }
     return true;
 }
 
+/**
+ * @brief Move the oldest tail requests into a new spill segment
+ */
+void RequestQueue::spillTail() {
+    std::deque<Request> batch;
+    size_t batchBytes = 0;
+    while (!requestQueue.empty() && batchBytes < memoryBudget / 4) {
+        size_t bytes = estimateRequestBytes(requestQueue.front());
+        batch.push_back(std::move(requestQueue.front()));
+        requestQueue.pop();
+        batchBytes += bytes;
+    }
+    
+    std::shared_ptr<SpillSegment> segment;
+    try {
+        segment = std::make_shared<SpillSegment>(spillDirectory, batch);
+    } catch (...) {
+        // Put the batch back ahead of the newer tail so no request is lost
+        while (!requestQueue.empty()) {
+            batch.push_back(std::move(requestQueue.front()));
+            requestQueue.pop();
+        }
+        for (auto& request : batch) {
+            requestQueue.push(std::move(request));
+        }
+        throw;
+    }
+    segments.push_back(segment);
+    tailBytes -= std::min(tailBytes, batchBytes);
+    spilledCount += static_cast<long long>(batch.size());
+    totalRequestsSpilled += static_cast<long long>(batch.size());
+}
+
+/**
+ * @brief Load the next spill segment into head and prefetch the one after
+ */
+void RequestQueue::loadNextSegment() {
+    std::shared_ptr<SpillSegment> segment = segments.front();
+    size_t before = head.size();
+    // Read before dropping the segment, so a failed read leaves it queued
+    segment->readInto(head);
+    segments.pop_front();
+    spilledCount -= static_cast<long long>(segment->getRequestCount());
+    for (size_t i = before; i < head.size(); ++i) {
+        headBytes += estimateRequestBytes(head[i]);
+    }
+    
+    if (!segments.empty()) {
+        segments.front()->prefetch();
+    }
+}
+
 /**
  * @brief Remove and return the next request from the queue
  * @return The next request, or empty request if queue is empty
@@ -62,8 +160,25 @@ Request RequestQueue::getNextRequest() {
         return Request(); // Return empty request
     }
     
-    Request nextRequest = requestQueue.front();
-    requestQueue.pop();
+    // Order is head, then spilled segments, then the in-memory tail
+    if (head.empty() && !segments.empty()) {
+        loadNextSegment();
+    }
+    
+    Request nextRequest;
+    if (!head.empty()) {
+        nextRequest = std::move(head.front());
+        head.pop_front();
+        if (memoryBudget > 0) {
+            headBytes -= std::min(headBytes, estimateRequestBytes(nextRequest));
+        }
+    } else {
+        nextRequest = std::move(requestQueue.front());
+        requestQueue.pop();
+        if (memoryBudget > 0) {
+            tailBytes -= std::min(tailBytes, estimateRequestBytes(nextRequest));
+        }
+    }
     totalRequestsRemoved++;
     return nextRequest;
 }
@@ -73,7 +188,7 @@ Request RequestQueue::getNextRequest() {
  * @return True if queue is empty, false otherwise
  */
 bool RequestQueue::isEmpty() const {
-    return requestQueue.empty();
+    return requestQueue.empty() && head.empty() && spilledCount == 0;
 }
 
 /**
@@ -89,7 +204,7 @@ bool RequestQueue::isFull() const {
  * @return Number of requests in the queue
  */
 int RequestQueue::getSize() const {
-    return static_cast<int>(requestQueue.size());
+    return static_cast<int>(requestQueue.size() + head.size() + spilledCount);
 }
 
 /**
@@ -104,7 +219,7 @@ int RequestQueue::getMaxSize() const {
  * @brief Get total requests added
  * @return Total number of requests added to the queue
  */
-int RequestQueue::getTotalRequestsAdded() const {
+long long RequestQueue::getTotalRequestsAdded() const {
     return totalRequestsAdded;
 }
 
@@ -112,7 +227,7 @@ int RequestQueue::getTotalRequestsAdded() const {
  * @brief Get total requests removed
  * @return Total number of requests removed from the queue
  */
-int RequestQueue::getTotalRequestsRemoved() const {
+long long RequestQueue::getTotalRequestsRemoved() const {
     return totalRequestsRemoved;
 }
 
@@ -123,6 +238,73 @@ void RequestQueue::clear() {
     while (!requestQueue.empty()) {
         requestQueue.pop();
     }
+    head.clear();
+    segments.clear();
+    headBytes = 0;
+    tailBytes = 0;
+    spilledCount = 0;
+}
+
+/**
+ * @brief Set the maximum size of the queue
+ * @param maxQueueSize Maximum number of requests
+ */
+void RequestQueue::setMaxSize(int maxQueueSize) {
+    maxSize = maxQueueSize;
+}
+
+/**
+ * @brief Limit the memory used by queued requests
+ * @param bytes Byte budget (0 keeps everything in memory)
+ * @param directory Directory for spill segment files
+ */
+void RequestQueue::setMemoryBudget(size_t bytes, const std::string& directory) {
+    if (bytes > 0) {
+        SpillSegment::checkDirectory(directory);
+    }
+    memoryBudget = bytes;
+    spillDirectory = directory;
+    
+    // Account for requests queued before the budget was set
+    headBytes = 0;
+    for (const auto& request : head) {
+        headBytes += estimateRequestBytes(request);
+    }
+    tailBytes = 0;
+    std::queue<Request> rotated;
+    while (!requestQueue.empty()) {
+        tailBytes += estimateRequestBytes(requestQueue.front());
+        rotated.push(std::move(requestQueue.front()));
+        requestQueue.pop();
+    }
+    requestQueue = std::move(rotated);
+}
+
+/**
+ * @brief Get the estimated memory used by in-memory requests
+ * @return Bytes held in memory
+ */
+size_t RequestQueue::getMemoryUsage() const {
+    if (memoryBudget > 0) {
+        return headBytes + tailBytes;
+    }
+    return requestQueue.size() * sizeof(Request);
+}
+
+/**
+ * @brief Get the number of requests currently spilled to disk
+ * @return Spilled request count
+ */
+long long RequestQueue::getSpilledCount() const {
+    return spilledCount;
+}
+
+/**
+ * @brief Get the number of requests ever spilled to disk
+ * @return Total spilled request count
+ */
+long long RequestQueue::getTotalRequestsSpilled() const {
+    return totalRequestsSpilled;
 }
 
 /**
@@ -130,29 +312,48 @@ void RequestQueue::clear() {
  * @param ip IP address to check
  * @return True if IP is blocked, false otherwise
  */
-bool RequestQueue::isIPBlocked(const std::string& ip) const {
-    return std::find(blockedIPs.begin(), blockedIPs.end(), ip) != blockedIPs.end();
+bool RequestQueue::isIPBlocked(const IPAddress& ip) const {
+    return blockedIPs.contains(ip, &blocklistStats);
 }
 
 /**
  * @brief Block an IP address
  * @param ip IP address to block
  */
-void RequestQueue::blockIP(const std::string& ip) {
-    if (!isIPBlocked(ip)) {
-        blockedIPs.push_back(ip);
-    }
+void RequestQueue::blockIP(const IPAddress& ip) {
+    blockedIPs.block(ip);
 }
 
 /**
  * @brief Unblock an IP address
  * @param ip IP address to unblock
  */
-void RequestQueue::unblockIP(const std::string& ip) {
-    auto it = std::find(blockedIPs.begin(), blockedIPs.end(), ip);
-    if (it != blockedIPs.end()) {
-        blockedIPs.erase(it);
-    }
+void RequestQueue::unblockIP(const IPAddress& ip) {
+    blockedIPs.unblock(ip);
+}
+
+/**
+ * @brief Get the blocklist snapshot store, e.g. to publish a reloaded list
+ * @return Blocklist store
+ */
+BlocklistStore& RequestQueue::getBlocklistStore() {
+    return blockedIPs;
+}
+
+/**
+ * @brief Get the blocklist snapshot store
+ * @return Read-only blocklist store
+ */
+const BlocklistStore& RequestQueue::getBlocklistStore() const {
+    return blockedIPs;
+}
+
+/**
+ * @brief Get the outcomes of blocklist checks made so far
+ * @return Lookup counters
+ */
+const BlocklistLookupStats& RequestQueue::getBlocklistStats() const {
+    return blocklistStats;
 }
 
 /**
@@ -9,7 +9,12 @@
 #ifndef REQUESTQUEUE_H
 #define REQUESTQUEUE_H
 
+#include "BlocklistStore.h"
 #include "Request.h"
+#include "SpillSegment.h"
+#include <cstddef>
+#include <deque>
+#include <memory>
 #include <queue>
 #include <vector>
 #include <string>
@@ -21,14 +26,46 @@
  * This class implements a priority queue for web requests, allowing
  * for efficient request management and distribution to web servers.
  * Requests can be added, removed, and prioritized based on various criteria.
+ * 
+ * With a memory budget set, the queue keeps its head (next to be dequeued)
+ * and tail (most recently added) in memory and spills the cold middle to
+ * memory-mapped SpillSegment files, prefetching the next segment ahead of
+ * the dequeue cursor. Queue order is unchanged.
  */
 class RequestQueue {
 private:
-    std::queue<Request> requestQueue; ///< Main queue of requests
+    std::queue<Request> requestQueue; ///< Main queue of requests (the tail when spilling)
+    std::deque<Request> head;         ///< Requests loaded from spill segments, dequeued first
+    std::deque<std::shared_ptr<SpillSegment>> segments; ///< Spilled middle of the queue, in order
+    size_t memoryBudget;              ///< Byte budget for in-memory requests (0 = unlimited)
+    std::string spillDirectory;       ///< Directory for spill segment files
+    size_t headBytes;                 ///< Estimated bytes held in head
+    size_t tailBytes;                 ///< Estimated bytes held in requestQueue
+    long long spilledCount;           ///< Requests currently stored in segments
+    long long totalRequestsSpilled;   ///< Requests ever written to segments
     int maxSize;                      ///< Maximum size of the queue
-    int totalRequestsAdded;           ///< Total number of requests added
-    int totalRequestsRemoved;         ///< Total number of requests removed
-    std::vector<std::string> blockedIPs; ///< List of blocked IP addresses
+    long long totalRequestsAdded;     ///< Total number of requests added
+    long long totalRequestsRemoved;   ///< Total number of requests removed
+    BlocklistStore blockedIPs;        ///< Blocked IP addresses, swapped in as snapshots
+    mutable BlocklistLookupStats blocklistStats; ///< Outcomes of admission-time blocklist checks
+
+    /**
+     * @brief Move the oldest tail requests into a new spill segment
+     */
+    void spillTail();
+
+    /**
+     * @brief Load the next spill segment into head and prefetch the one after
+     */
+    void loadNextSegment();
+
+    /**
+     * @brief Add an unblocked request unless the queue is full
+     * @param request The request to add
+     * @return True if added, false if the queue is full
+     * @throws std::runtime_error if the tail cannot be spilled; the request stays queued
+     */
+    bool enqueue(const Request& request);
 
 public:
     /**
@@ -51,9 +88,18 @@ public:
      * @brief Add a request to the queue
      * @param request The request to add
      * @return True if request was added successfully, false if queue is full
+     * @throws std::runtime_error if the tail cannot be spilled; the request stays queued
      */
     bool addRequest(const Request& request);
 
+    /**
+     * @brief Add several requests, checking them against one blocklist snapshot
+     * @param requests Requests to add, in order
+     * @return Number added; the rest were blocked or found the queue full
+     * @throws std::runtime_error if the tail cannot be spilled; earlier requests stay added
+     */
+    size_t addRequests(const std::vector<Request>& requests);
+
     /**
      * @brief Remove and return the next request from the queue
      * @return The next request, or empty request if queue is empty
@@ -88,13 +134,13 @@ public:
      * @brief Get total requests added
      * @return Total number of requests added to the queue
      */
-    int getTotalRequestsAdded() const;
+    long long getTotalRequestsAdded() const;
 
     /**
      * @brief Get total requests removed
      * @return Total number of requests removed from the queue
      */
-    int getTotalRequestsRemoved() const;
+    long long getTotalRequestsRemoved() const;
 
     /**
      * @brief Clear all requests from the queue
@@ -106,19 +152,72 @@ public:
      * @param ip IP address to check
      * @return True if IP is blocked, false otherwise
      */
-    bool isIPBlocked(const std::string& ip) const;
+    bool isIPBlocked(const IPAddress& ip) const;
 
     /**
      * @brief Block an IP address
      * @param ip IP address to block
      */
-    void blockIP(const std::string& ip);
+    void blockIP(const IPAddress& ip);
 
     /**
      * @brief Unblock an IP address
      * @param ip IP address to unblock
      */
-    void unblockIP(const std::string& ip);
+    void unblockIP(const IPAddress& ip);
+
+    /**
+     * @brief Get the blocklist snapshot store, e.g. to publish a reloaded list
+     * @return Blocklist store
+     */
+    BlocklistStore& getBlocklistStore();
+
+    /**
+     * @brief Get the blocklist snapshot store
+     * @return Read-only blocklist store
+     */
+    const BlocklistStore& getBlocklistStore() const;
+
+    /**
+     * @brief Get the outcomes of blocklist checks made so far
+     * @return Lookup counters
+     */
+    const BlocklistLookupStats& getBlocklistStats() const;
+
+    /**
+     * @brief Set the maximum size of the queue
+     * @param maxQueueSize Maximum number of requests
+     */
+    void setMaxSize(int maxQueueSize);
+
+    /**
+     * @brief Limit the memory used by queued requests
+     * 
+     * Once the in-memory part exceeds the budget, the cold middle of the
+     * queue is written to segment files in @p directory.
+     * @param bytes Byte budget (0 keeps everything in memory)
+     * @param directory Directory for spill segment files
+     * @throws std::runtime_error if a budget is set and @p directory is not writable
+     */
+    void setMemoryBudget(size_t bytes, const std::string& directory);
+
+    /**
+     * @brief Get the estimated memory used by in-memory requests
+     * @return Bytes held in memory
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Get the number of requests currently spilled to disk
+     * @return Spilled request count
+     */
+    long long getSpilledCount() const;
+
+    /**
+     * @brief Get the number of requests ever spilled to disk
+     * @return Total spilled request count
+     */
+    long long getTotalRequestsSpilled() const;
 
     /**
      * @brief Get queue utilization percentage
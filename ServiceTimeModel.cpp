@@ -0,0 +1,142 @@
+/**
+ * @file ServiceTimeModel.cpp
+ * @brief Implementation file for the ServiceTimeModel class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ServiceTimeModel.h"
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Create a model that always answers immediately
+ */
+ServiceTimeModel::ServiceTimeModel() : kind(Kind::FIXED), first(0.0), second(0.0) {
+}
+
+/**
+ * @brief Parse a model description
+ * @param spec Description such as "exp:200"
+ * @return Model
+ * @throws std::invalid_argument if the description is malformed
+ */
+ServiceTimeModel ServiceTimeModel::parse(const std::string& spec) {
+    std::vector<std::string> fields;
+    std::stringstream stream(spec);
+    std::string field;
+    while (std::getline(stream, field, ':')) {
+        fields.push_back(field);
+    }
+    if (fields.empty()) {
+        throw std::invalid_argument("empty service time model");
+    }
+
+    std::vector<double> values;
+    for (size_t i = 1; i < fields.size(); ++i) {
+        size_t used = 0;
+        double value = 0.0;
+        try {
+            value = std::stod(fields[i], &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used == 0 || used != fields[i].size() || !std::isfinite(value) || value < 0) {
+            throw std::invalid_argument("invalid number in service time model: " + spec);
+        }
+        values.push_back(value);
+    }
+
+    ServiceTimeModel model;
+    const std::string& name = fields[0];
+    if (name == "fixed" && values.size() == 1) {
+        model.kind = Kind::FIXED;
+        model.first = values[0];
+    } else if (name == "uniform" && values.size() == 2 && values[0] <= values[1]) {
+        model.kind = Kind::UNIFORM;
+        model.first = values[0];
+        model.second = values[1];
+    } else if (name == "exp" && values.size() == 1) {
+        model.kind = Kind::EXPONENTIAL;
+        model.first = values[0];
+    } else if (name == "lognormal" && values.size() == 2) {
+        model.kind = Kind::LOGNORMAL;
+        model.first = values[0];
+        model.second = values[1];
+    } else {
+        throw std::invalid_argument("unknown service time model: " + spec +
+                                    " (expected fixed:US, uniform:MIN:MAX, exp:MEAN or lognormal:MEDIAN:SIGMA)");
+    }
+    return model;
+}
+
+/**
+ * @brief Draw a service time
+ * @param engine Random engine of the calling thread
+ * @return Service time in microseconds, never negative
+ */
+double ServiceTimeModel::draw(std::mt19937_64& engine) const {
+    switch (kind) {
+    case Kind::UNIFORM:
+        return std::uniform_real_distribution<double>(first, second)(engine);
+    case Kind::EXPONENTIAL:
+        return first > 0 ? std::exponential_distribution<double>(1.0 / first)(engine) : 0.0;
+    case Kind::LOGNORMAL:
+        return first > 0 ? std::lognormal_distribution<double>(std::log(first), second)(engine) : 0.0;
+    case Kind::FIXED:
+    default:
+        return first;
+    }
+}
+
+/**
+ * @brief Get the mean service time
+ * @return Mean in microseconds
+ */
+double ServiceTimeModel::mean() const {
+    switch (kind) {
+    case Kind::UNIFORM:
+        return (first + second) / 2.0;
+    case Kind::LOGNORMAL:
+        return first * std::exp(second * second / 2.0);
+    case Kind::EXPONENTIAL:
+    case Kind::FIXED:
+    default:
+        return first;
+    }
+}
+
+/**
+ * @brief Get the distribution family
+ * @return Kind
+ */
+ServiceTimeModel::Kind ServiceTimeModel::getKind() const {
+    return kind;
+}
+
+/**
+ * @brief Describe the model in the form parse() accepts
+ * @return Description
+ */
+std::string ServiceTimeModel::describe() const {
+    std::ostringstream text;
+    switch (kind) {
+    case Kind::UNIFORM:
+        text << "uniform:" << first << ":" << second;
+        break;
+    case Kind::EXPONENTIAL:
+        text << "exp:" << first;
+        break;
+    case Kind::LOGNORMAL:
+        text << "lognormal:" << first << ":" << second;
+        break;
+    case Kind::FIXED:
+    default:
+        text << "fixed:" << first;
+        break;
+    }
+    return text.str();
+}
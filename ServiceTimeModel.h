@@ -0,0 +1,81 @@
+/**
+ * @file ServiceTimeModel.h
+ * @brief Header file for the ServiceTimeModel class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef SERVICETIMEMODEL_H
+#define SERVICETIMEMODEL_H
+
+#include <random>
+#include <string>
+
+/**
+ * @class ServiceTimeModel
+ * @brief Distribution of a stub backend's per-request service time
+ *
+ * Written as "fixed:US", "uniform:MIN:MAX", "exp:MEAN" or
+ * "lognormal:MEDIAN:SIGMA", with times in microseconds. The lognormal
+ * form gives the long right tail typical of real backends.
+ */
+class ServiceTimeModel {
+public:
+    /**
+     * @enum Kind
+     * @brief Distribution family
+     */
+    enum class Kind {
+        FIXED,        ///< Always the same time
+        UNIFORM,      ///< Uniform between two bounds
+        EXPONENTIAL,  ///< Exponential with a given mean
+        LOGNORMAL     ///< Lognormal with a given median and shape
+    };
+
+private:
+    Kind kind;      ///< Distribution family
+    double first;   ///< Fixed time, minimum, mean or median in microseconds
+    double second;  ///< Maximum in microseconds, or lognormal sigma
+
+public:
+    /**
+     * @brief Create a model that always answers immediately
+     */
+    ServiceTimeModel();
+
+    /**
+     * @brief Parse a model description
+     * @param spec Description such as "exp:200"
+     * @return Model
+     * @throws std::invalid_argument if the description is malformed
+     */
+    static ServiceTimeModel parse(const std::string& spec);
+
+    /**
+     * @brief Draw a service time
+     * @param engine Random engine of the calling thread
+     * @return Service time in microseconds, never negative
+     */
+    double draw(std::mt19937_64& engine) const;
+
+    /**
+     * @brief Get the mean service time
+     * @return Mean in microseconds
+     */
+    double mean() const;
+
+    /**
+     * @brief Get the distribution family
+     * @return Kind
+     */
+    Kind getKind() const;
+
+    /**
+     * @brief Describe the model in the form parse() accepts
+     * @return Description
+     */
+    std::string describe() const;
+};
+
+#endif // SERVICETIMEMODEL_H
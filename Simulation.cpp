@@ -0,0 +1,187 @@
+/**
+ * @file Simulation.cpp
+ * @brief Batch (non-interactive) simulation runs
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Simulation.h"
+#include "TraceRecorder.h"
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Fill in the end-of-run fields of a result
+ * @param loadBalancer Load balancer after the last cycle
+ * @param result Result with cycles and windows already recorded
+ */
+void summarizeRun(const LoadBalancer& loadBalancer, SimulationResult& result) {
+    double utilizationSum = 0.0;
+    double serverSum = 0.0;
+    for (const auto& window : result.windows.getWindows()) {
+        utilizationSum += window.utilizationSum;
+        serverSum += window.serverSum;
+    }
+    
+    result.processed = loadBalancer.getTotalRequestsProcessed();
+    result.rejected = loadBalancer.getTotalRequestsRejected();
+    result.averageLatency = loadBalancer.getAverageLatency();
+    result.meanUtilization = result.cycles > 0 ? utilizationSum / result.cycles : 0.0;
+    result.finalQueueSize = loadBalancer.getQueueSize();
+    result.finalActiveServers = loadBalancer.getActiveServerCount();
+    result.meanActiveServers = result.cycles > 0 ? serverSum / result.cycles : 0.0;
+    result.latency = loadBalancer.getLatencyHistogram();
+    result.spilledRequests = loadBalancer.getRequestQueue().getTotalRequestsSpilled();
+}
+
+} // namespace
+
+/**
+ * @brief Build a load balancer from a batch configuration
+ * @param config Configuration
+ * @return Configured load balancer with no queued requests
+ */
+LoadBalancer createLoadBalancer(const SimulationConfig& config) {
+    LoadBalancer loadBalancer(config.initialServers, config.maxServers, config.minServers,
+                              config.loadThreshold);
+    loadBalancer.setDistributionPolicy(config.policy);
+    loadBalancer.setMaxQueueSize(config.maxQueueSize);
+    if (config.queueMemoryBudget > 0) {
+        loadBalancer.setQueueMemoryBudget(config.queueMemoryBudget, config.spillDirectory);
+    }
+    return loadBalancer;
+}
+
+/**
+ * @brief Advance a simulation by one cycle
+ * @param loadBalancer Load balancer to advance
+ * @param generator Workload generator supplying arrivals
+ * @param admitArrivals Whether this cycle's arrivals are offered to the queue
+ * @param recorder Optional recorder receiving every offered request
+ * @return Number of requests completed in this cycle
+ */
+int advanceCycle(LoadBalancer& loadBalancer, WorkloadGenerator& generator, bool admitArrivals,
+                 TraceRecorder* recorder) {
+    int arrivals = generator.drawArrivals();
+    std::vector<Request> batch;
+    for (int i = 0; i < arrivals; ++i) {
+        Request request = generator.generateRequest();
+        if (admitArrivals) {
+            if (recorder != nullptr) {
+                // The cycle being advanced; addRequests stamps the previous one
+                recorder->record(request, loadBalancer.getCurrentCycle() + 1);
+            }
+            batch.push_back(std::move(request));
+        }
+    }
+    if (!batch.empty()) {
+        loadBalancer.addRequests(batch);
+    }
+    return loadBalancer.processCycle();
+}
+
+/**
+ * @brief Run one simulation to completion without console output
+ * @param config Load balancer configuration and run length
+ * @param workload Arrival and service-time parameters
+ * @param seed Seed for the workload generator
+ * @param recorder Optional recorder receiving every offered request
+ * @return Summary metrics
+ */
+SimulationResult runSimulation(const SimulationConfig& config, const WorkloadParams& workload,
+                               unsigned int seed, TraceRecorder* recorder) {
+    LoadBalancer loadBalancer = createLoadBalancer(config);
+    WorkloadGenerator generator(workload, seed);
+    
+    for (int i = 0; i < config.initialQueueSize; ++i) {
+        Request request = generator.generateRequest();
+        if (recorder != nullptr) {
+            recorder->record(request, 0);
+        }
+        loadBalancer.addRequest(request);
+    }
+    
+    SimulationResult result;
+    long long arrivalEnd = static_cast<long long>(config.cycles * config.arrivalCutoff);
+    
+    for (long long cycle = 1; cycle <= config.cycles; ++cycle) {
+        advanceCycle(loadBalancer, generator, cycle < arrivalEnd, recorder);
+        result.windows.recordCycle(loadBalancer);
+        if (cycle == config.warmupCycles) {
+            loadBalancer.resetLatencyHistogram();
+        }
+    }
+    
+    result.cycles = config.cycles;
+    summarizeRun(loadBalancer, result);
+    return result;
+}
+
+/**
+ * @brief Replay a recorded request trace through a load balancer
+ * @param config Load balancer configuration and run length
+ * @param source Trace to replay, in non-decreasing cycle order
+ * @return Summary metrics
+ */
+SimulationResult replayTrace(const SimulationConfig& config, TraceSource& source) {
+    LoadBalancer loadBalancer = createLoadBalancer(config);
+    SimulationResult result;
+    
+    TraceRecord record;
+    bool pending = source.next(record);
+    long long cycle = 0;
+    while (config.cycles > 0 ? cycle < config.cycles
+                             : pending || loadBalancer.getQueueSize() > 0 ||
+                               loadBalancer.getSystemUtilization() > 0.0) {
+        ++cycle;
+        while (pending && record.cycle <= cycle) {
+            loadBalancer.addRequest(toRequest(record));
+            pending = source.next(record);
+        }
+        loadBalancer.processCycle();
+        result.windows.recordCycle(loadBalancer);
+        if (cycle == config.warmupCycles) {
+            loadBalancer.resetLatencyHistogram();
+        }
+    }
+    
+    result.cycles = cycle;
+    summarizeRun(loadBalancer, result);
+    return result;
+}
+
+/**
+ * @brief Parse a distribution policy name
+ * @param name "rr"/"round-robin" or "lc"/"least-connections"
+ * @param policy Output policy
+ * @return True if the name was recognised
+ */
+bool parseDistributionPolicy(const std::string& name, DistributionPolicy& policy) {
+    if (name == "rr" || name == "round-robin") {
+        policy = DistributionPolicy::ROUND_ROBIN;
+        return true;
+    }
+    if (name == "lc" || name == "least-connections") {
+        policy = DistributionPolicy::LEAST_CONNECTIONS;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Get a short display name for a distribution policy
+ * @param policy Policy
+ * @return Policy name
+ */
+std::string distributionPolicyName(DistributionPolicy policy) {
+    switch (policy) {
+        case DistributionPolicy::LEAST_CONNECTIONS:
+            return "least-connections";
+        case DistributionPolicy::ROUND_ROBIN:
+        default:
+            return "round-robin";
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file Simulation.h
+ * @brief Batch (non-interactive) simulation runs
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "LoadBalancer.h"
+#include "WorkloadGenerator.h"
+#include "LatencyHistogram.h"
+#include "WindowedStats.h"
+#include "TraceFormat.h"
+#include <string>
+
+class TraceRecorder;
+
+/**
+ * @struct SimulationConfig
+ * @brief Load balancer configuration and run length for one batch run
+ */
+struct SimulationConfig {
+    std::string name = "default";                           ///< Label used in reports
+    int initialServers = 5;                                 ///< Servers at start
+    int maxServers = 10;                                    ///< Upper scaling bound
+    int minServers = 1;                                     ///< Lower scaling bound
+    double loadThreshold = 0.8;                             ///< Scaling threshold (0.0-1.0)
+    DistributionPolicy policy = DistributionPolicy::ROUND_ROBIN; ///< Server selection policy
+    int initialQueueSize = 500;                             ///< Requests queued before cycle 1
+    long long cycles = 10000;                               ///< Cycles to simulate
+    double arrivalCutoff = 0.95;                            ///< Fraction of the run that receives arrivals
+    long long warmupCycles = 0;                             ///< Cycles excluded from the latency histogram
+    int maxQueueSize = 1000;                                ///< Request queue capacity
+    size_t queueMemoryBudget = 0;                           ///< Queue byte budget before spilling (0 = none)
+    std::string spillDirectory = "/tmp";                    ///< Directory for queue spill segments
+};
+
+/**
+ * @struct SimulationResult
+ * @brief Summary metrics of one batch run
+ */
+struct SimulationResult {
+    long long processed = 0;         ///< Requests completed
+    long long rejected = 0;          ///< Requests refused at admission
+    double averageLatency = 0.0;     ///< Mean cycles from admission to completion
+    double meanUtilization = 0.0;    ///< Mean system utilization over all cycles (0-100)
+    int finalQueueSize = 0;          ///< Requests still queued at the end
+    int finalActiveServers = 0;      ///< Active servers at the end
+    double meanActiveServers = 0.0;  ///< Time-averaged active server count
+    LatencyHistogram latency;        ///< End-to-end latencies after the warm-up
+    WindowedStats windows;           ///< Per-window statistics over the whole run
+    long long spilledRequests = 0;   ///< Requests the queue spilled to disk
+    long long cycles = 0;            ///< Cycles simulated
+};
+
+/**
+ * @brief Build a load balancer from a batch configuration
+ * @param config Configuration
+ * @return Configured load balancer with no queued requests
+ */
+LoadBalancer createLoadBalancer(const SimulationConfig& config);
+
+/**
+ * @brief Advance a simulation by one cycle
+ * 
+ * Draws this cycle's arrivals from the generator, offers them to the load
+ * balancer when @p admitArrivals is set, then processes one cycle. Arrivals
+ * are drawn even when not admitted so the random stream stays aligned with
+ * other runs using the same seed.
+ * @param loadBalancer Load balancer to advance
+ * @param generator Workload generator supplying arrivals
+ * @param admitArrivals Whether this cycle's arrivals are offered to the queue
+ * @param recorder Optional recorder receiving every offered request
+ * @return Number of requests completed in this cycle
+ */
+int advanceCycle(LoadBalancer& loadBalancer, WorkloadGenerator& generator, bool admitArrivals,
+                 TraceRecorder* recorder = nullptr);
+
+/**
+ * @brief Run one simulation to completion without console output
+ * 
+ * The workload is driven entirely by a WorkloadGenerator seeded with
+ * @p seed, so runs with equal seeds see identical traffic.
+ * @param config Load balancer configuration and run length
+ * @param workload Arrival and service-time parameters
+ * @param seed Seed for the workload generator
+ * @param recorder Optional recorder receiving every offered request; replaying
+ *                 its trace with the same configuration reproduces the run
+ * @return Summary metrics
+ */
+SimulationResult runSimulation(const SimulationConfig& config, const WorkloadParams& workload,
+                               unsigned int seed, TraceRecorder* recorder = nullptr);
+
+/**
+ * @brief Replay a recorded request trace through a load balancer
+ * 
+ * Each record is offered to the queue at the start of its cycle; records
+ * at cycle 0 or earlier form the initial backlog. config.initialQueueSize
+ * and config.arrivalCutoff are ignored. If config.cycles is positive the
+ * run stops after that many cycles, otherwise it runs until the trace is
+ * exhausted and the queue and servers have drained.
+ * @param config Load balancer configuration and run length
+ * @param source Trace to replay, in non-decreasing cycle order
+ * @return Summary metrics
+ */
+SimulationResult replayTrace(const SimulationConfig& config, TraceSource& source);
+
+/**
+ * @brief Parse a distribution policy name
+ * @param name "rr"/"round-robin" or "lc"/"least-connections"
+ * @param policy Output policy
+ * @return True if the name was recognised
+ */
+bool parseDistributionPolicy(const std::string& name, DistributionPolicy& policy);
+
+/**
+ * @brief Get a short display name for a distribution policy
+ * @param policy Policy
+ * @return Policy name
+ */
+std::string distributionPolicyName(DistributionPolicy policy);
+
+#endif // SIMULATION_H
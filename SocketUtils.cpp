@@ -0,0 +1,183 @@
+/**
+ * @file SocketUtils.cpp
+ * @brief Socket and clock helpers shared by the networked programs
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "SocketUtils.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief Build an IPv4 socket address
+ * @param host Dotted-quad address
+ * @param port Port
+ * @return Socket address
+ * @throws std::runtime_error if host is not an IPv4 address
+ */
+sockaddr_in makeSocketAddress(const std::string& host, int port) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        throw std::runtime_error("invalid IPv4 address: " + host);
+    }
+    return address;
+}
+
+/**
+ * @brief Build the address of a TCP or Unix domain endpoint
+ * @param host Dotted-quad address, ignored if path is set
+ * @param port Port, ignored if path is set
+ * @param path Unix domain socket path, empty for TCP
+ * @return Socket address
+ * @throws std::runtime_error if host is not an IPv4 address or path is too long
+ */
+StreamAddress makeStreamAddress(const std::string& host, int port, const std::string& path) {
+    StreamAddress result;
+    std::memset(&result.storage, 0, sizeof(result.storage));
+    if (path.empty()) {
+        sockaddr_in address = makeSocketAddress(host, port);
+        std::memcpy(&result.storage, &address, sizeof(address));
+        result.length = sizeof(address);
+        return result;
+    }
+    sockaddr_un* address = reinterpret_cast<sockaddr_un*>(&result.storage);
+    if (path.size() >= sizeof(address->sun_path)) {
+        throw std::runtime_error("Unix socket path too long: " + path);
+    }
+    address->sun_family = AF_UNIX;
+    std::memcpy(address->sun_path, path.c_str(), path.size() + 1);
+    result.length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+    return result;
+}
+
+/**
+ * @brief Create a non-blocking listening socket that sibling threads can share
+ * @param host IPv4 address
+ * @param port Port, 0 for any free port
+ * @return Socket descriptor
+ * @throws std::runtime_error if the socket cannot be created or bound
+ */
+int openReusePortListener(const std::string& host, int port) {
+    sockaddr_in address = makeSocketAddress(host, port);
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 4096) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("cannot listen on " + host + ":" + std::to_string(port) + ": " + reason);
+    }
+    return fd;
+}
+
+/**
+ * @brief Create a non-blocking listening Unix domain socket
+ * @param path Socket file path
+ * @return Socket descriptor
+ * @throws std::runtime_error if the path is in use or the socket cannot be created or bound
+ */
+int openUnixListener(const std::string& path) {
+    StreamAddress address = makeStreamAddress("", 0, path);
+    struct stat status;
+    if (::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        // Only a socket nobody is listening on is stale
+        int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = probe >= 0 &&
+                    ::connect(probe, reinterpret_cast<const sockaddr*>(&address.storage), address.length) == 0;
+        if (probe >= 0) {
+            ::close(probe);
+        }
+        if (live) {
+            throw std::runtime_error("cannot listen on " + path + ": another server is listening there");
+        }
+        ::unlink(path.c_str());
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0 ||
+        ::listen(fd, 4096) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("cannot listen on " + path + ": " + reason);
+    }
+    return fd;
+}
+
+/**
+ * @brief Get the local port of a socket
+ * @param fd Bound socket
+ * @return Port, 0 if unknown
+ */
+int getLocalPort(int fd) {
+    sockaddr_in address;
+    socklen_t length = sizeof(address);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+/**
+ * @brief Start a non-blocking TCP connect with Nagle's algorithm disabled
+ * @param address Server address
+ * @return Socket descriptor, connected or connecting, or -1 if the connect failed at once
+ */
+int connectNonBlocking(const sockaddr_in& address) {
+    StreamAddress target;
+    std::memcpy(&target.storage, &address, sizeof(address));
+    target.length = sizeof(address);
+    return connectNonBlocking(target);
+}
+
+/**
+ * @brief Start a non-blocking connect to a TCP or Unix domain endpoint
+ * @param address Server address
+ * @return Socket descriptor, connected or connecting, or -1 if the connect failed at once
+ */
+int connectNonBlocking(const StreamAddress& address) {
+    int family = address.storage.ss_family;
+    int fd = ::socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (family == AF_INET) {
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0 &&
+        errno != EINPROGRESS) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Read the monotonic clock
+ * @return Nanoseconds since an arbitrary start
+ */
+uint64_t monotonicNanoseconds() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
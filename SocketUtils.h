@@ -0,0 +1,100 @@
+/**
+ * @file SocketUtils.h
+ * @brief Socket and clock helpers shared by the networked programs
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef SOCKETUTILS_H
+#define SOCKETUTILS_H
+
+#include <cstdint>
+#include <string>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/**
+ * @struct StreamAddress
+ * @brief Address of a TCP or Unix domain stream socket
+ */
+struct StreamAddress {
+    sockaddr_storage storage;  ///< A sockaddr_in or sockaddr_un
+    socklen_t length = 0;      ///< Bytes of storage in use
+};
+
+/**
+ * @brief Build an IPv4 socket address
+ * @param host Dotted-quad address
+ * @param port Port
+ * @return Socket address
+ * @throws std::runtime_error if host is not an IPv4 address
+ */
+sockaddr_in makeSocketAddress(const std::string& host, int port);
+
+/**
+ * @brief Build the address of a TCP or Unix domain endpoint
+ * @param host Dotted-quad address, ignored if path is set
+ * @param port Port, ignored if path is set
+ * @param path Unix domain socket path, empty for TCP
+ * @return Socket address
+ * @throws std::runtime_error if host is not an IPv4 address or path is too long
+ */
+StreamAddress makeStreamAddress(const std::string& host, int port, const std::string& path);
+
+/**
+ * @brief Create a non-blocking listening socket that sibling threads can share
+ *
+ * SO_REUSEPORT is set, so every thread can bind its own socket to the
+ * same port and the kernel spreads incoming connections between them.
+ * @param host IPv4 address
+ * @param port Port, 0 for any free port
+ * @return Socket descriptor
+ * @throws std::runtime_error if the socket cannot be created or bound
+ */
+int openReusePortListener(const std::string& host, int port);
+
+/**
+ * @brief Create a non-blocking listening Unix domain socket
+ *
+ * A socket file left behind by a server that has exited is replaced, but
+ * one that still accepts connections is not. Unix sockets cannot share a
+ * path the way SO_REUSEPORT shares a port, so threads that each want a
+ * listener should each take a dup() of this one.
+ * @param path Socket file path
+ * @return Socket descriptor
+ * @throws std::runtime_error if the path is in use or the socket cannot be created or bound
+ */
+int openUnixListener(const std::string& path);
+
+/**
+ * @brief Get the local port of a socket
+ * @param fd Bound socket
+ * @return Port, 0 if unknown
+ */
+int getLocalPort(int fd);
+
+/**
+ * @brief Start a non-blocking TCP connect with Nagle's algorithm disabled
+ * @param address Server address
+ * @return Socket descriptor, connected or connecting, or -1 if the connect failed at once
+ */
+int connectNonBlocking(const sockaddr_in& address);
+
+/**
+ * @brief Start a non-blocking connect to a TCP or Unix domain endpoint
+ *
+ * TCP sockets have Nagle's algorithm disabled. A Unix domain connect
+ * completes at once or fails, with EAGAIN if the listener's backlog is full.
+ * @param address Server address
+ * @return Socket descriptor, connected or connecting, or -1 if the connect failed at once
+ */
+int connectNonBlocking(const StreamAddress& address);
+
+/**
+ * @brief Read the monotonic clock
+ * @return Nanoseconds since an arbitrary start
+ */
+uint64_t monotonicNanoseconds();
+
+#endif // SOCKETUTILS_H
@@ -0,0 +1,246 @@
+/**
+ * @file SpillSegment.cpp
+ * @brief Implementation file for the SpillSegment class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "SpillSegment.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Append a fixed-width little-endian integer to a buffer
+ * @param out Output buffer
+ * @param value Value to append
+ */
+template <typename T>
+void putInt(std::vector<char>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * @brief Read a fixed-width little-endian integer from a buffer
+ * @param in Read cursor, advanced past the value
+ * @return Decoded value
+ */
+template <typename T>
+T getInt(const unsigned char*& in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    in += sizeof(T);
+    return static_cast<T>(value);
+}
+
+/**
+ * @brief Append a length-prefixed string to a buffer
+ * @param out Output buffer
+ * @param text String to append
+ */
+void putString(std::vector<char>& out, const std::string& text) {
+    putInt<uint16_t>(out, static_cast<uint16_t>(text.size()));
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+/**
+ * @brief Read a length-prefixed string from a buffer
+ * @param in Read cursor, advanced past the string
+ * @return Decoded string
+ */
+std::string getString(const unsigned char*& in) {
+    uint16_t length = getInt<uint16_t>(in);
+    std::string text(reinterpret_cast<const char*>(in), length);
+    in += length;
+    return text;
+}
+
+} // namespace
+
+/**
+ * @brief Estimate the memory a queued request occupies
+ * @param request Request to measure
+ * @return Bytes including out-of-line string storage
+ */
+size_t estimateRequestBytes(const Request& request) {
+    // Strings longer than the small-string buffer allocate separately
+    const size_t inlineCapacity = 15;
+    size_t bytes = sizeof(Request);
+    size_t typeLength = request.getRequestType().size();
+    if (typeLength > inlineCapacity) bytes += typeLength + 1;
+    return bytes;
+}
+
+/**
+ * @brief Write requests to a new segment file
+ * @param directory Directory for the segment file
+ * @param requests Requests to write, in queue order
+ * @throws std::runtime_error if the file cannot be created or written
+ */
+SpillSegment::SpillSegment(const std::string& directory, const std::deque<Request>& requests)
+    : requestCount(requests.size()), fileSize(0), mapping(nullptr) {
+    std::vector<char> buffer;
+    buffer.reserve(requests.size() * 64);
+    for (const auto& request : requests) {
+        putInt<uint64_t>(buffer, request.getClientAddress().getHigh());
+        putInt<uint64_t>(buffer, request.getClientAddress().getLow());
+        putString(buffer, request.getRequestType());
+        putInt<int32_t>(buffer, request.getPriority());
+        putInt<int32_t>(buffer, request.getProcessingTime());
+        putInt<int32_t>(buffer, request.getServiceTime());
+        putInt<int64_t>(buffer, request.getRequestID());
+        putInt<int64_t>(buffer, request.getArrivalCycle());
+        putInt<int64_t>(buffer, request.getArrivalTime().time_since_epoch().count());
+    }
+    fileSize = buffer.size();
+    
+    std::string pattern = directory + "/lbqueue-XXXXXX";
+    std::vector<char> name(pattern.begin(), pattern.end());
+    name.push_back('\0');
+    int fd = mkstemp(name.data());
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create spill segment in " + directory + ": " + std::strerror(errno));
+    }
+    path = name.data();
+    
+    // Write through a shared mapping so the data goes straight to the page cache.
+    // The blocks are allocated first: a full disk then fails here instead of
+    // raising SIGBUS on the first write to an unbacked page.
+    bool written = fileSize == 0;
+    if (!written && posix_fallocate(fd, 0, static_cast<off_t>(fileSize)) == 0) {
+        void* target = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (target != MAP_FAILED) {
+            std::memcpy(target, buffer.data(), fileSize);
+            munmap(target, fileSize);
+            written = true;
+        }
+    }
+    close(fd);
+    
+    if (!written) {
+        unlink(path.c_str());
+        throw std::runtime_error("Cannot write spill segment " + path);
+    }
+}
+
+/**
+ * @brief Check that segment files can be created in a directory
+ * @param directory Directory for segment files
+ * @throws std::runtime_error naming the directory and the reason if not
+ */
+void SpillSegment::checkDirectory(const std::string& directory) {
+    std::string pattern = directory + "/lbqueue-XXXXXX";
+    std::vector<char> name(pattern.begin(), pattern.end());
+    name.push_back('\0');
+    int fd = mkstemp(name.data());
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create spill segments in " + directory + ": " + std::strerror(errno));
+    }
+    close(fd);
+    unlink(name.data());
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Unmaps and removes the segment file
+ */
+SpillSegment::~SpillSegment() {
+    if (mapping) {
+        munmap(mapping, fileSize);
+    }
+    unlink(path.c_str());
+}
+
+/**
+ * @brief Map the file for reading if it is not mapped yet
+ * @return True if the file is mapped
+ */
+bool SpillSegment::mapLocked() {
+    if (mapping || fileSize == 0) {
+        return mapping != nullptr;
+    }
+    
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    void* target = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (target == MAP_FAILED) {
+        return false;
+    }
+    mapping = target;
+    return true;
+}
+
+/**
+ * @brief Start reading the segment into the page cache in the background
+ */
+void SpillSegment::prefetch() {
+    std::lock_guard<std::mutex> lock(mapMutex);
+    if (mapLocked()) {
+        madvise(mapping, fileSize, MADV_WILLNEED);
+    }
+}
+
+/**
+ * @brief Decode all requests and append them to a queue
+ * @param requests Output queue
+ */
+void SpillSegment::readInto(std::deque<Request>& requests) {
+    std::lock_guard<std::mutex> lock(mapMutex);
+    if (!mapLocked()) {
+        if (fileSize == 0) return;
+        throw std::runtime_error("Cannot read spill segment " + path);
+    }
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+    
+    const unsigned char* in = static_cast<const unsigned char*>(mapping);
+    for (size_t i = 0; i < requestCount; ++i) {
+        uint64_t ipHigh = getInt<uint64_t>(in);
+        uint64_t ipLow = getInt<uint64_t>(in);
+        std::string type = getString(in);
+        int priority = getInt<int32_t>(in);
+        int processing = getInt<int32_t>(in);
+        int service = getInt<int32_t>(in);
+        long long id = getInt<int64_t>(in);
+        long long arrivalCycle = getInt<int64_t>(in);
+        long long ticks = getInt<int64_t>(in);
+        
+        Request request(IPAddress(ipHigh, ipLow), type, priority, service, id);
+        request.setProcessingTime(processing);
+        request.setArrivalCycle(arrivalCycle);
+        request.setArrivalTime(std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(ticks)));
+        requests.push_back(std::move(request));
+    }
+}
+
+/**
+ * @brief Get the number of requests stored
+ * @return Request count
+ */
+size_t SpillSegment::getRequestCount() const {
+    return requestCount;
+}
+
+/**
+ * @brief Get the size of the segment file
+ * @return File size in bytes
+ */
+size_t SpillSegment::getFileSize() const {
+    return fileSize;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file SpillSegment.h
+ * @brief Header file for the SpillSegment class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef SPILLSEGMENT_H
+#define SPILLSEGMENT_H
+
+#include "Request.h"
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @class SpillSegment
+ * @brief Immutable file holding a run of queued requests spilled from memory
+ * 
+ * A segment is written once through a shared memory mapping and read back
+ * through a private mapping. prefetch() maps the file and asks the kernel
+ * to start reading it ahead of time, so the segment is usually resident by
+ * the time the dequeue cursor reaches it. The file is removed when the
+ * segment is destroyed; segments are shared between copies of a queue, so
+ * this happens once the last copy has released it.
+ */
+class SpillSegment {
+private:
+    std::string path;     ///< Segment file path
+    size_t requestCount;  ///< Number of requests stored
+    size_t fileSize;      ///< Size of the file in bytes
+    void* mapping;        ///< Read mapping, or nullptr if not mapped
+    std::mutex mapMutex;  ///< Guards mapping across queue copies in other threads
+
+    /**
+     * @brief Map the file for reading if it is not mapped yet
+     * @return True if the file is mapped
+     */
+    bool mapLocked();
+
+public:
+    /**
+     * @brief Write requests to a new segment file
+     * @param directory Directory for the segment file
+     * @param requests Requests to write, in queue order
+     * @throws std::runtime_error if the file cannot be created or written
+     */
+    SpillSegment(const std::string& directory, const std::deque<Request>& requests);
+
+    /**
+     * @brief Destructor
+     * 
+     * Unmaps and removes the segment file
+     */
+    ~SpillSegment();
+
+    SpillSegment(const SpillSegment&) = delete;
+    SpillSegment& operator=(const SpillSegment&) = delete;
+
+    /**
+     * @brief Check that segment files can be created in a directory
+     * @param directory Directory for segment files
+     * @throws std::runtime_error naming the directory and the reason if not
+     */
+    static void checkDirectory(const std::string& directory);
+
+    /**
+     * @brief Start reading the segment into the page cache in the background
+     */
+    void prefetch();
+
+    /**
+     * @brief Decode all requests and append them to a queue
+     * @param requests Output queue
+     */
+    void readInto(std::deque<Request>& requests);
+
+    /**
+     * @brief Get the number of requests stored
+     * @return Request count
+     */
+    size_t getRequestCount() const;
+
+    /**
+     * @brief Get the size of the segment file
+     * @return File size in bytes
+     */
+    size_t getFileSize() const;
+};
+
+/**
+ * @brief Estimate the memory a queued request occupies
+ * @param request Request to measure
+ * @return Bytes including out-of-line string storage
+ */
+size_t estimateRequestBytes(const Request& request);
+
+#endif // SPILLSEGMENT_H
@@ -0,0 +1,131 @@
+/**
+ * @file Statistics.cpp
+ * @brief Implementation file for the RunningStats class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Statistics.h"
+#include <cmath>
+
+/**
+ * @brief Default constructor
+ */
+RunningStats::RunningStats() : count(0), mean(0.0), m2(0.0), minValue(0.0), maxValue(0.0) {
+}
+
+/**
+ * @brief Add a sample
+ * @param value Sample value
+ */
+void RunningStats::add(double value) {
+    if (count == 0 || value < minValue) minValue = value;
+    if (count == 0 || value > maxValue) maxValue = value;
+    
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+/**
+ * @brief Merge another accumulator into this one
+ * @param other Statistics to merge
+ */
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    
+    // Chan et al. parallel combination
+    long long combined = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / combined;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / combined);
+    count = combined;
+    if (other.minValue < minValue) minValue = other.minValue;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+/**
+ * @brief Get the number of samples
+ * @return Sample count
+ */
+long long RunningStats::getCount() const {
+    return count;
+}
+
+/**
+ * @brief Get the sample mean
+ * @return Mean, or 0 if no samples
+ */
+double RunningStats::getMean() const {
+    return mean;
+}
+
+/**
+ * @brief Get the unbiased sample variance
+ * @return Variance, or 0 with fewer than two samples
+ */
+double RunningStats::getVariance() const {
+    if (count < 2) return 0.0;
+    return m2 / (count - 1);
+}
+
+/**
+ * @brief Get the sample standard deviation
+ * @return Standard deviation
+ */
+double RunningStats::getStdDev() const {
+    return std::sqrt(getVariance());
+}
+
+/**
+ * @brief Get the smallest sample
+ * @return Minimum, or 0 if no samples
+ */
+double RunningStats::getMin() const {
+    return minValue;
+}
+
+/**
+ * @brief Get the largest sample
+ * @return Maximum, or 0 if no samples
+ */
+double RunningStats::getMax() const {
+    return maxValue;
+}
+
+/**
+ * @brief Get the half-width of the 95% confidence interval for the mean
+ * @return Half-width, or 0 with fewer than two samples
+ */
+double RunningStats::getConfidenceHalfWidth() const {
+    if (count < 2) return 0.0;
+    return studentT95(count - 1) * getStdDev() / std::sqrt(static_cast<double>(count));
+}
+
+/**
+ * @brief Two-sided 95% Student-t critical value
+ * @param degreesOfFreedom Degrees of freedom (at least 1)
+ * @return Critical value t such that P(|T| <= t) = 0.95
+ */
+double studentT95(long long degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    
+    if (degreesOfFreedom < 1) return table[0];
+    if (degreesOfFreedom <= 30) return table[degreesOfFreedom - 1];
+    // Beyond the table use the value at the lower end of each band (conservative)
+    if (degreesOfFreedom <= 40) return 2.042;
+    if (degreesOfFreedom <= 60) return 2.021;
+    if (degreesOfFreedom <= 120) return 2.000;
+    if (degreesOfFreedom <= 1000) return 1.980;
+    return 1.962;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file Statistics.h
+ * @brief Header file for the RunningStats class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+/**
+ * @class RunningStats
+ * @brief Accumulates sample statistics in constant memory
+ * 
+ * Uses Welford's online algorithm so mean and variance stay numerically
+ * stable no matter how many samples are added. Also provides a Student-t
+ * confidence interval for the mean, which is what replicated simulation
+ * experiments report.
+ */
+class RunningStats {
+private:
+    long long count;  ///< Number of samples added
+    double mean;      ///< Running mean
+    double m2;        ///< Sum of squared deviations from the mean
+    double minValue;  ///< Smallest sample seen
+    double maxValue;  ///< Largest sample seen
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    RunningStats();
+
+    /**
+     * @brief Add a sample
+     * @param value Sample value
+     */
+    void add(double value);
+
+    /**
+     * @brief Merge another accumulator into this one
+     * @param other Statistics to merge
+     */
+    void merge(const RunningStats& other);
+
+    /**
+     * @brief Get the number of samples
+     * @return Sample count
+     */
+    long long getCount() const;
+
+    /**
+     * @brief Get the sample mean
+     * @return Mean, or 0 if no samples
+     */
+    double getMean() const;
+
+    /**
+     * @brief Get the unbiased sample variance
+     * @return Variance, or 0 with fewer than two samples
+     */
+    double getVariance() const;
+
+    /**
+     * @brief Get the sample standard deviation
+     * @return Standard deviation
+     */
+    double getStdDev() const;
+
+    /**
+     * @brief Get the smallest sample
+     * @return Minimum, or 0 if no samples
+     */
+    double getMin() const;
+
+    /**
+     * @brief Get the largest sample
+     * @return Maximum, or 0 if no samples
+     */
+    double getMax() const;
+
+    /**
+     * @brief Get the half-width of the 95% confidence interval for the mean
+     * @return Half-width, or 0 with fewer than two samples
+     */
+    double getConfidenceHalfWidth() const;
+};
+
+/**
+ * @brief Two-sided 95% Student-t critical value
+ * @param degreesOfFreedom Degrees of freedom (at least 1)
+ * @return Critical value t such that P(|T| <= t) = 0.95
+ */
+double studentT95(long long degreesOfFreedom);
+
+#endif // STATISTICS_H
@@ -0,0 +1,151 @@
+/**
+ * @file StreamingSketches.cpp
+ * @brief Constant-memory sketches for distinct counts and frequent items
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "StreamingSketches.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+/**
+ * @brief Hash a string to 64 well-mixed bits
+ * @param item String to hash
+ * @return Hash value
+ */
+uint64_t hashItem(const std::string& item) {
+    // std::hash may be the identity on some libraries, so finish with a mixer
+    uint64_t x = static_cast<uint64_t>(std::hash<std::string>()(item));
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+} // namespace
+
+/**
+ * @brief Default constructor
+ */
+DistinctCounter::DistinctCounter() : registers(size_t(1) << PRECISION, 0) {
+}
+
+/**
+ * @brief Add an item
+ * @param item Item to count
+ */
+void DistinctCounter::add(const std::string& item) {
+    uint64_t hash = hashItem(item);
+    size_t index = static_cast<size_t>(hash >> (64 - PRECISION));
+    uint64_t rest = (hash << PRECISION) | (uint64_t(1) << (PRECISION - 1));
+    uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers[index] = std::max(registers[index], rank);
+}
+
+/**
+ * @brief Estimate the number of distinct items added
+ * @return Distinct count estimate
+ */
+double DistinctCounter::estimate() const {
+    const double m = static_cast<double>(registers.size());
+    double sum = 0.0;
+    int zeros = 0;
+    for (uint8_t rank : registers) {
+        sum += std::ldexp(1.0, -rank);
+        if (rank == 0) zeros++;
+    }
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+    
+    // Linear counting is more accurate while many registers are empty
+    if (raw <= 2.5 * m && zeros > 0) {
+        return m * std::log(m / zeros);
+    }
+    return raw;
+}
+
+/**
+ * @brief Parameterized constructor
+ * @param maxItems Maximum tracked items
+ */
+HeavyHitters::HeavyHitters(size_t maxItems) : capacity(maxItems > 0 ? maxItems : 1) {
+    heap.reserve(capacity);
+    position.reserve(capacity * 2);
+}
+
+/**
+ * @brief Swap two heap entries and their index entries
+ * @param a First heap index
+ * @param b Second heap index
+ */
+void HeavyHitters::swapEntries(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    position[heap[a].item] = a;
+    position[heap[b].item] = b;
+}
+
+/**
+ * @brief Restore the heap property downwards from an index
+ * @param index Heap index whose count increased
+ */
+void HeavyHitters::siftDown(size_t index) {
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < heap.size() && heap[left].count < heap[smallest].count) smallest = left;
+        if (right < heap.size() && heap[right].count < heap[smallest].count) smallest = right;
+        if (smallest == index) return;
+        swapEntries(index, smallest);
+        index = smallest;
+    }
+}
+
+/**
+ * @brief Add one occurrence of an item
+ * @param item Item to count
+ */
+void HeavyHitters::add(const std::string& item) {
+    auto it = position.find(item);
+    if (it != position.end()) {
+        heap[it->second].count++;
+        siftDown(it->second);
+        return;
+    }
+    
+    if (heap.size() < capacity) {
+        heap.push_back({item, 1, 0});
+        size_t index = heap.size() - 1;
+        position[item] = index;
+        while (index > 0 && heap[(index - 1) / 2].count > heap[index].count) {
+            swapEntries(index, (index - 1) / 2);
+            index = (index - 1) / 2;
+        }
+        return;
+    }
+    
+    // Replace the minimum and inherit its count as the error bound
+    position.erase(heap[0].item);
+    long long floor = heap[0].count;
+    heap[0] = {item, floor + 1, floor};
+    position[item] = 0;
+    siftDown(0);
+}
+
+/**
+ * @brief Get the tracked items, most frequent first
+ * @return Entries sorted by descending count
+ */
+std::vector<HeavyHitters::Entry> HeavyHitters::getTop() const {
+    std::vector<Entry> entries = heap;
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.count > b.count; });
+    return entries;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file StreamingSketches.h
+ * @brief Constant-memory sketches for distinct counts and frequent items
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef STREAMINGSKETCHES_H
+#define STREAMINGSKETCHES_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DistinctCounter
+ * @brief HyperLogLog estimate of the number of distinct strings in a stream
+ * 
+ * Uses 2^14 one-byte registers (16 KB) for a standard error of about 0.8%,
+ * with linear counting for small cardinalities.
+ */
+class DistinctCounter {
+private:
+    static constexpr int PRECISION = 14;  ///< log2 of the register count
+    std::vector<uint8_t> registers;       ///< Maximum leading-zero rank per register
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    DistinctCounter();
+
+    /**
+     * @brief Add an item
+     * @param item Item to count
+     */
+    void add(const std::string& item);
+
+    /**
+     * @brief Estimate the number of distinct items added
+     * @return Distinct count estimate
+     */
+    double estimate() const;
+};
+
+/**
+ * @class HeavyHitters
+ * @brief Space-Saving summary of the most frequent strings in a stream
+ * 
+ * Tracks at most a fixed number of items. When a new item arrives and the
+ * summary is full, it replaces the item with the smallest count and
+ * inherits that count as its error bound, so any item whose true frequency
+ * exceeds total / capacity is guaranteed to be present. Counters live in a
+ * min-heap, making each update O(log capacity).
+ */
+class HeavyHitters {
+public:
+    /**
+     * @struct Entry
+     * @brief Tracked item with its count and overestimation bound
+     */
+    struct Entry {
+        std::string item;  ///< Tracked item
+        long long count;   ///< Estimated count (never below the true count)
+        long long error;   ///< Maximum overestimation of count
+    };
+
+private:
+    size_t capacity;                                  ///< Maximum tracked items
+    std::vector<Entry> heap;                          ///< Min-heap on count
+    std::unordered_map<std::string, size_t> position; ///< Heap index of each item
+
+    /**
+     * @brief Restore the heap property downwards from an index
+     * @param index Heap index whose count increased
+     */
+    void siftDown(size_t index);
+
+    /**
+     * @brief Swap two heap entries and their index entries
+     * @param a First heap index
+     * @param b Second heap index
+     */
+    void swapEntries(size_t a, size_t b);
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param maxItems Maximum tracked items
+     */
+    explicit HeavyHitters(size_t maxItems = 1024);
+
+    /**
+     * @brief Add one occurrence of an item
+     * @param item Item to count
+     */
+    void add(const std::string& item);
+
+    /**
+     * @brief Get the tracked items, most frequent first
+     * @return Entries sorted by descending count
+     */
+    std::vector<Entry> getTop() const;
+};
+
+#endif // STREAMINGSKETCHES_H
@@ -0,0 +1,914 @@
+/**
+ * @file StubServer.cpp
+ * @brief Implementation file for the StubServer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "StubServer.h"
+#include "Http2Connection.h"
+#include "HttpParser.h"
+#include "SocketUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <functional>
+#include <limits>
+#include <netinet/tcp.h>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+const size_t READ_CHUNK = 16 * 1024;            ///< Bytes requested per read
+const size_t MAX_UNPARSED = 4 * 1024 * 1024;    ///< Buffered bytes allowed behind a busy request
+const uint64_t NO_DEADLINE = std::numeric_limits<uint64_t>::max();
+const uint32_t MAX_STREAMS = 1000;              ///< SETTINGS_MAX_CONCURRENT_STREAMS advertised on HTTP/2
+
+/**
+ * @enum ResponseKind
+ * @brief Canned responses prepared once per thread
+ */
+enum ResponseKind {
+    RESPONSE_OK,           ///< 200 with the configured body
+    RESPONSE_OK_HEAD,      ///< 200 headers without the body, for HEAD
+    RESPONSE_ERROR,        ///< Injected 500
+    RESPONSE_UNAVAILABLE,  ///< 503 at capacity
+    RESPONSE_BAD_REQUEST,  ///< 400 for a malformed request
+    RESPONSE_KINDS
+};
+
+/**
+ * @brief Increment a counter only its owning thread writes
+ * @param counter Counter, read by other threads
+ * @param amount Increment
+ */
+void bump(std::atomic<long long>& counter, long long amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Build a canned response
+ * @param status Status line after "HTTP/1.1 "
+ * @param serverID Value of the X-Server header
+ * @param body Body text
+ * @param sendBody False to advertise the body's length without sending it
+ * @param close Whether to announce that the connection closes
+ * @return Response bytes
+ */
+std::string buildResponse(const char* status, int serverID, const std::string& body, bool sendBody, bool close) {
+    std::string response = std::string("HTTP/1.1 ") + status + "\r\nServer: stubserver\r\nX-Server: " +
+                           std::to_string(serverID) + "\r\nContent-Type: text/plain\r\nContent-Length: " +
+                           std::to_string(body.size()) + "\r\n";
+    if (close) {
+        response += "Connection: close\r\n";
+    }
+    response += "\r\n";
+    if (sendBody) {
+        response += body;
+    }
+    return response;
+}
+
+/**
+ * @brief Build the HPACK header block of a canned HTTP/2 response
+ * @param status Status code
+ * @param serverID Value of the x-server header
+ * @param length Body length to advertise
+ * @return Header block
+ */
+std::string buildStreamHeaders(int status, int serverID, size_t length) {
+    std::string block;
+    HpackEncoder::encodeStatus(status, block);
+    HpackEncoder::encode("server", "stubserver", block);
+    HpackEncoder::encode("x-server", std::to_string(serverID), block);
+    HpackEncoder::encode("content-type", "text/plain", block);
+    HpackEncoder::encode("content-length", std::to_string(length), block);
+    return block;
+}
+
+} // namespace
+
+/**
+ * @class StubServer::Worker
+ * @brief One event loop with its own listening socket and connections
+ */
+class StubServer::Worker {
+private:
+    /**
+     * @struct Stream
+     * @brief An HTTP/2 request awaiting its response
+     */
+    struct Stream {
+        ResponseKind pending = RESPONSE_OK; ///< Response to send
+        uint64_t serviceNanoseconds = 0;    ///< Service time
+        bool inService = false;             ///< The request holds a unit of capacity
+    };
+
+    /**
+     * @struct Connection
+     * @brief State of one client connection
+     */
+    struct Connection {
+        int fd = -1;                        ///< Socket
+        uint64_t id = 0;                    ///< Distinguishes reuses of the same descriptor
+        HttpParser parser;                  ///< Request framing state
+        std::vector<char> input;            ///< Receive buffer
+        size_t inputLength = 0;             ///< Valid bytes in input
+        size_t consumed = 0;                ///< Bytes of input already parsed
+        std::string output;                 ///< Responses not yet sent
+        size_t written = 0;                 ///< Bytes of output already sent
+        bool busy = false;                  ///< A request is queued or in service
+        bool inService = false;             ///< The request holds a unit of capacity
+        bool closeAfter = false;            ///< Close once output is sent
+        bool writing = false;               ///< Waiting for the socket to become writable
+        ResponseKind pending = RESPONSE_OK; ///< Response to the busy request
+        uint64_t serviceNanoseconds = 0;    ///< Service time of the busy request
+        bool http1 = false;                 ///< An HTTP/1.1 request was parsed, ruling out HTTP/2
+        std::unique_ptr<Http2Connection> session; ///< HTTP/2 state once the preface arrived
+        std::unordered_map<uint32_t, Stream> streams; ///< HTTP/2 requests not yet answered
+    };
+
+    /**
+     * @struct Ticket
+     * @brief A request waiting for capacity
+     */
+    struct Ticket {
+        int fd;           ///< Connection socket
+        uint64_t id;      ///< Connection identifier
+        uint32_t stream;  ///< HTTP/2 stream, 0 for HTTP/1.1
+    };
+
+    /**
+     * @struct Timer
+     * @brief Completion time of a request in service
+     */
+    struct Timer {
+        uint64_t deadline;  ///< Monotonic completion time
+        int fd;             ///< Connection socket
+        uint64_t id;        ///< Connection identifier
+        uint32_t stream;    ///< HTTP/2 stream, 0 for HTTP/1.1
+
+        /**
+         * @brief Order timers by deadline for a min-heap
+         * @param other Timer to compare with
+         * @return True if this timer fires later
+         */
+        bool operator>(const Timer& other) const { return deadline > other.deadline; }
+    };
+
+    const StubServerConfig& config;  ///< Behaviour shared by all threads
+    int listenFd;                    ///< This thread's listening socket
+    int epollFd;                     ///< Event queue
+    int timerFd;                     ///< Fires at the earliest completion
+    int stopFd;                      ///< Signalled by requestStop()
+    int capacity;                    ///< This thread's share of maxCapacity, 0 for unlimited
+    int inService;                   ///< Requests holding capacity
+    uint64_t nextConnectionID;       ///< Identifier for the next accepted connection
+    uint64_t armedDeadline;          ///< Deadline timerFd is set to
+    std::mt19937_64 engine;          ///< Service times and injected faults
+    std::uniform_real_distribution<double> unit; ///< Draws in [0, 1)
+    std::string responses[RESPONSE_KINDS];       ///< Canned keep-alive responses
+    std::string closingResponses[RESPONSE_KINDS]; ///< Canned responses announcing close
+    std::string streamHeaders[RESPONSE_KINDS];    ///< Canned HTTP/2 header blocks
+    std::string streamBodies[RESPONSE_KINDS];     ///< Canned HTTP/2 bodies
+    std::vector<Http2Message> arrivals; ///< Scratch messages from an HTTP/2 read
+    HttpRequestView view;            ///< Scratch parse result
+    std::unordered_map<int, std::unique_ptr<Connection>> connections; ///< Open connections by socket
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers; ///< Completions
+    std::deque<Ticket> waiting;      ///< Requests waiting for capacity
+
+    std::atomic<long long> connectionCount{0};  ///< Connections accepted
+    std::atomic<long long> requestCount{0};     ///< Requests parsed
+    std::atomic<long long> responseCount{0};    ///< Responses queued
+    std::atomic<long long> errorCount{0};       ///< Injected 500 responses
+    std::atomic<long long> rejectedCount{0};    ///< 503 responses
+    std::atomic<long long> droppedCount{0};     ///< Dropped requests
+    std::atomic<long long> slowCount{0};        ///< Slowed requests
+    std::atomic<long long> invalidCount{0};     ///< 400 responses
+    std::atomic<long long> queuedCount{0};      ///< Requests that waited for capacity
+    std::atomic<long long> maxInService{0};     ///< Peak requests holding capacity
+
+    /**
+     * @brief Find a connection if it is still open
+     * @param fd Socket
+     * @param id Connection identifier
+     * @return Connection, or nullptr if closed
+     */
+    Connection* find(int fd, uint64_t id) {
+        auto it = connections.find(fd);
+        return it != connections.end() && it->second->id == id ? it->second.get() : nullptr;
+    }
+
+    /**
+     * @brief Accept every pending connection
+     */
+    void acceptAll() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            if (config.unixPath.empty()) {
+                int on = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            }
+            epoll_event event;
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = fd;
+            if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                ::close(fd);
+                continue;
+            }
+            std::unique_ptr<Connection> connection(new Connection());
+            connection->fd = fd;
+            connection->id = nextConnectionID++;
+            connection->input.resize(READ_CHUNK);
+            connections[fd] = std::move(connection);
+            bump(connectionCount);
+        }
+    }
+
+    /**
+     * @brief Close a connection and release its capacity
+     * @param connection Connection, destroyed by this call
+     */
+    void closeConnection(Connection& connection) {
+        if (connection.inService) {
+            inService--;
+        }
+        for (const auto& entry : connection.streams) {
+            if (entry.second.inService) {
+                inService--;
+            }
+        }
+        ::close(connection.fd);
+        connections.erase(connection.fd);
+    }
+
+    /**
+     * @brief Queue a canned response
+     * @param connection Connection
+     * @param kind Response
+     */
+    void respond(Connection& connection, ResponseKind kind) {
+        connection.output += connection.closeAfter ? closingResponses[kind] : responses[kind];
+        bump(responseCount);
+        if (kind == RESPONSE_ERROR) {
+            bump(errorCount);
+        }
+    }
+
+    /**
+     * @brief Answer an HTTP/2 request with a canned response
+     * @param connection Connection
+     * @param streamID Stream, forgotten by this call
+     * @param kind Response
+     */
+    void respondStream(Connection& connection, uint32_t streamID, ResponseKind kind) {
+        connection.streams.erase(streamID);
+        connection.session->submitResponse(streamID, streamHeaders[kind], streamBodies[kind], connection.output);
+        bump(responseCount);
+        if (kind == RESPONSE_ERROR) {
+            bump(errorCount);
+        }
+    }
+
+    /**
+     * @brief Send queued responses
+     * @param connection Connection
+     * @return False if the connection was closed
+     */
+    bool flush(Connection& connection) {
+        while (connection.written < connection.output.size()) {
+            ssize_t sent = ::send(connection.fd, connection.output.data() + connection.written,
+                                  connection.output.size() - connection.written, MSG_NOSIGNAL);
+            if (sent > 0) {
+                connection.written += static_cast<size_t>(sent);
+            } else if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!connection.writing) {
+                    epoll_event event;
+                    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+                    event.data.fd = connection.fd;
+                    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+                    connection.writing = true;
+                }
+                return true;
+            } else {
+                closeConnection(connection);
+                return false;
+            }
+        }
+        connection.output.clear();
+        connection.written = 0;
+        if (connection.writing) {
+            epoll_event event;
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = connection.fd;
+            ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+            connection.writing = false;
+        }
+        if (connection.closeAfter && !connection.busy) {
+            closeConnection(connection);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Start serving a connection's busy request
+     * @param connection Connection with a request that has capacity
+     */
+    void startService(Connection& connection) {
+        if (connection.serviceNanoseconds == 0) {
+            connection.busy = false;
+            respond(connection, connection.pending);
+            return;
+        }
+        connection.inService = true;
+        occupy();
+        timers.push(Timer{monotonicNanoseconds() + connection.serviceNanoseconds, connection.fd, connection.id, 0});
+    }
+
+    /**
+     * @brief Start serving an HTTP/2 request
+     * @param connection Connection
+     * @param streamID Stream of a request that has capacity
+     */
+    void startStream(Connection& connection, uint32_t streamID) {
+        Stream& stream = connection.streams[streamID];
+        if (stream.serviceNanoseconds == 0) {
+            respondStream(connection, streamID, stream.pending);
+            return;
+        }
+        stream.inService = true;
+        occupy();
+        timers.push(Timer{monotonicNanoseconds() + stream.serviceNanoseconds, connection.fd, connection.id, streamID});
+    }
+
+    /**
+     * @brief Take a unit of capacity
+     */
+    void occupy() {
+        inService++;
+        if (inService > maxInService.load(std::memory_order_relaxed)) {
+            maxInService.store(inService, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Decide a parsed request's fate
+     * @param head Whether the request is HEAD
+     * @param kind Set to the response to send
+     * @param serviceNanoseconds Set to the service time
+     * @return False if the request is to be dropped unanswered
+     */
+    bool drawOutcome(bool head, ResponseKind& kind, uint64_t& serviceNanoseconds) {
+        double draw = unit(engine);
+        if (draw < config.dropRate) {
+            bump(droppedCount);
+            return false;
+        }
+        kind = draw < config.dropRate + config.errorRate ? RESPONSE_ERROR : (head ? RESPONSE_OK_HEAD : RESPONSE_OK);
+        double microseconds = config.serviceTime.draw(engine);
+        if (config.slowRate > 0 && unit(engine) < config.slowRate) {
+            microseconds *= config.slowFactor;
+            bump(slowCount);
+        }
+        serviceNanoseconds = static_cast<uint64_t>(microseconds * 1000.0);
+        return true;
+    }
+
+    /**
+     * @brief Check whether a new request must wait for capacity
+     * @param serviceNanoseconds Its service time
+     * @return True if the server is full or others are already waiting
+     */
+    bool mustWait(uint64_t serviceNanoseconds) const {
+        // Waiting requests keep their place ahead of newly parsed ones
+        return capacity > 0 && (inService >= capacity || !waiting.empty()) && serviceNanoseconds > 0;
+    }
+
+    /**
+     * @brief Process an HTTP/2 connection's frames and dispatch its requests
+     *
+     * Each stream is one request with its own service time and unit of
+     * capacity; a dropped request has its stream reset rather than the
+     * connection closed.
+     * @param connection Connection with a session
+     * @return True; a connection error closes the connection once GOAWAY is sent
+     */
+    bool serveStreams(Connection& connection) {
+        std::string_view unparsed(connection.input.data() + connection.consumed,
+                                  connection.inputLength - connection.consumed);
+        size_t used = 0;
+        arrivals.clear();
+        bool healthy = connection.session->receive(unparsed, used, connection.output, arrivals);
+        connection.consumed += used;
+        for (const Http2Message& message : arrivals) {
+            uint32_t id = message.streamID;
+            if (message.reset) {
+                auto it = connection.streams.find(id);
+                if (it != connection.streams.end()) {
+                    if (it->second.inService) {
+                        inService--;
+                    }
+                    connection.streams.erase(it);
+                }
+                continue;
+            }
+            bump(requestCount);
+            bool head = false;
+            for (const HpackField& field : message.headers) {
+                head = head || (field.name == ":method" && field.value == "HEAD");
+            }
+            Stream stream;
+            if (!drawOutcome(head, stream.pending, stream.serviceNanoseconds)) {
+                connection.session->resetStream(id, Http2Error::INTERNAL_ERROR, connection.output);
+                continue;
+            }
+            connection.streams[id] = stream;
+            if (mustWait(stream.serviceNanoseconds)) {
+                if (config.rejectWhenFull) {
+                    bump(rejectedCount);
+                    respondStream(connection, id, RESPONSE_UNAVAILABLE);
+                } else {
+                    bump(queuedCount);
+                    waiting.push_back(Ticket{connection.fd, connection.id, id});
+                }
+                continue;
+            }
+            startStream(connection, id);
+        }
+        if (!healthy) {
+            connection.closeAfter = true;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parse and dispatch buffered requests until one has to wait
+     * @param connection Connection
+     * @return False if the connection was closed
+     */
+    bool serve(Connection& connection) {
+        if (connection.session == nullptr && !connection.http1) {
+            std::string_view start(connection.input.data() + connection.consumed,
+                                   connection.inputLength - connection.consumed);
+            if (Http2Connection::isPreface(start)) {
+                if (start.size() < Http2Connection::PREFACE_LENGTH) {
+                    return true;  // Wait for the rest of the preface
+                }
+                connection.session.reset(new Http2Connection(Http2Role::SERVER, MAX_STREAMS));
+                connection.session->start(connection.output);
+            }
+        }
+        if (connection.session != nullptr) {
+            return connection.closeAfter || serveStreams(connection);
+        }
+        while (!connection.busy && !connection.closeAfter) {
+            std::string_view unparsed(connection.input.data() + connection.consumed,
+                                      connection.inputLength - connection.consumed);
+            HttpParseStatus status = connection.parser.parse(unparsed, view);
+            if (status == HttpParseStatus::INCOMPLETE) {
+                break;
+            }
+            if (status == HttpParseStatus::INVALID) {
+                bump(invalidCount);
+                connection.closeAfter = true;
+                respond(connection, RESPONSE_BAD_REQUEST);
+                break;
+            }
+            bump(requestCount);
+            connection.http1 = true;
+            connection.consumed += view.length;
+            if (!view.keepAlive) {
+                connection.closeAfter = true;
+            }
+
+            if (!drawOutcome(view.method == HttpMethod::HEAD, connection.pending, connection.serviceNanoseconds)) {
+                closeConnection(connection);
+                return false;
+            }
+            connection.busy = true;
+
+            if (mustWait(connection.serviceNanoseconds)) {
+                if (config.rejectWhenFull) {
+                    bump(rejectedCount);
+                    connection.busy = false;
+                    respond(connection, RESPONSE_UNAVAILABLE);
+                } else {
+                    bump(queuedCount);
+                    waiting.push_back(Ticket{connection.fd, connection.id, 0});
+                }
+                continue;
+            }
+            startService(connection);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read everything available and serve it
+     * @param connection Connection
+     */
+    void readable(Connection& connection) {
+        while (true) {
+            if (connection.consumed == connection.inputLength) {
+                connection.consumed = 0;
+                connection.inputLength = 0;
+            } else if (connection.consumed > 0 && connection.inputLength + READ_CHUNK > connection.input.size()) {
+                // Move the unparsed tail to the front before growing
+                std::memmove(connection.input.data(), connection.input.data() + connection.consumed,
+                             connection.inputLength - connection.consumed);
+                connection.inputLength -= connection.consumed;
+                connection.consumed = 0;
+            }
+            if (connection.inputLength + READ_CHUNK > connection.input.size()) {
+                connection.input.resize(connection.input.size() * 2);
+            }
+            ssize_t got = ::read(connection.fd, connection.input.data() + connection.inputLength, READ_CHUNK);
+            if (got > 0) {
+                connection.inputLength += static_cast<size_t>(got);
+                if (connection.inputLength - connection.consumed > MAX_UNPARSED) {
+                    closeConnection(connection);
+                    return;
+                }
+                if (static_cast<size_t>(got) < READ_CHUNK) {
+                    break;
+                }
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                // The client went away; nobody is left to answer
+                closeConnection(connection);
+                return;
+            }
+        }
+        if (serve(connection)) {
+            flush(connection);
+        }
+    }
+
+    /**
+     * @brief Answer every request whose service time has elapsed
+     */
+    void expireTimers() {
+        uint64_t now = monotonicNanoseconds();
+        while (!timers.empty() && timers.top().deadline <= now) {
+            Timer timer = timers.top();
+            timers.pop();
+            Connection* connection = find(timer.fd, timer.id);
+            if (!connection) {
+                continue;
+            }
+            if (timer.stream != 0) {
+                auto it = connection->streams.find(timer.stream);
+                if (it == connection->streams.end() || !it->second.inService) {
+                    continue;  // Reset by the client
+                }
+                inService--;
+                respondStream(*connection, timer.stream, it->second.pending);
+                flush(*connection);
+                continue;
+            }
+            connection->inService = false;
+            inService--;
+            connection->busy = false;
+            respond(*connection, connection->pending);
+            if (serve(*connection)) {
+                flush(*connection);
+            }
+        }
+    }
+
+    /**
+     * @brief Start waiting requests while capacity is free
+     */
+    void admitWaiting() {
+        while (!waiting.empty() && (capacity == 0 || inService < capacity)) {
+            Ticket next = waiting.front();
+            waiting.pop_front();
+            Connection* connection = find(next.fd, next.id);
+            if (!connection) {
+                continue;
+            }
+            if (next.stream != 0) {
+                if (connection->streams.count(next.stream) != 0) {
+                    startStream(*connection, next.stream);
+                    flush(*connection);
+                }
+                continue;
+            }
+            startService(*connection);
+            if (!connection->busy && serve(*connection)) {
+                flush(*connection);
+            }
+        }
+    }
+
+    /**
+     * @brief Set the timer to the earliest completion
+     */
+    void armTimer() {
+        uint64_t deadline = timers.empty() ? NO_DEADLINE : timers.top().deadline;
+        if (deadline == armedDeadline) {
+            return;
+        }
+        itimerspec setting;
+        std::memset(&setting, 0, sizeof(setting));
+        if (deadline != NO_DEADLINE) {
+            setting.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000ULL);
+            setting.it_value.tv_nsec = static_cast<long>(deadline % 1000000000ULL);
+            if (setting.it_value.tv_sec == 0 && setting.it_value.tv_nsec == 0) {
+                setting.it_value.tv_nsec = 1;
+            }
+        }
+        ::timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &setting, nullptr);
+        armedDeadline = deadline;
+    }
+
+    /**
+     * @brief Watch a descriptor for input
+     * @param fd Descriptor
+     * @param exclusive Wake only one of the threads watching the same socket
+     */
+    void watch(int fd, bool exclusive = false) {
+        epoll_event event;
+        event.events = EPOLLIN;
+        if (exclusive) {
+            event.events |= EPOLLEXCLUSIVE;
+        }
+        event.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            throw std::runtime_error(std::string("epoll_ctl: ") + std::strerror(errno));
+        }
+    }
+
+    /**
+     * @brief Close the worker's own descriptors
+     */
+    void closeDescriptors() {
+        for (int* fd : {&listenFd, &epollFd, &timerFd, &stopFd}) {
+            if (*fd >= 0) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Create an event loop
+     * @param settings Behaviour, which must outlive the worker
+     * @param index Thread index
+     * @param socket Listening socket, owned by the worker from now on
+     * @throws std::runtime_error if the event descriptors cannot be created
+     */
+    Worker(const StubServerConfig& settings, int index, int socket)
+        : config(settings), listenFd(socket), epollFd(-1), timerFd(-1), stopFd(-1), capacity(0), inService(0),
+          nextConnectionID(0), armedDeadline(NO_DEADLINE), engine(settings.seed + 7919ULL * index), unit(0.0, 1.0) {
+        if (config.maxCapacity > 0) {
+            int threads = std::max(1, config.threads);
+            capacity = std::max(1, config.maxCapacity / threads + (index < config.maxCapacity % threads ? 1 : 0));
+        }
+        std::string body(config.bodyBytes, 'x');
+        if (!body.empty()) {
+            body.back() = '\n';
+        }
+        for (int close = 0; close < 2; ++close) {
+            std::string* target = close ? closingResponses : responses;
+            target[RESPONSE_OK] = buildResponse("200 OK", config.serverID, body, true, close);
+            target[RESPONSE_OK_HEAD] = buildResponse("200 OK", config.serverID, body, false, close);
+            target[RESPONSE_ERROR] =
+                buildResponse("500 Internal Server Error", config.serverID, "injected error\n", true, close);
+            target[RESPONSE_UNAVAILABLE] =
+                buildResponse("503 Service Unavailable", config.serverID, "at capacity\n", true, close);
+            target[RESPONSE_BAD_REQUEST] = buildResponse("400 Bad Request", config.serverID, "", true, true);
+            if (config.sendContinue) {
+                for (int kind = RESPONSE_OK; kind < RESPONSE_BAD_REQUEST; ++kind) {
+                    target[kind].insert(0, "HTTP/1.1 100 Continue\r\n\r\n");
+                }
+            }
+        }
+        streamBodies[RESPONSE_OK] = body;
+        streamBodies[RESPONSE_ERROR] = "injected error\n";
+        streamBodies[RESPONSE_UNAVAILABLE] = "at capacity\n";
+        streamHeaders[RESPONSE_OK] = buildStreamHeaders(200, config.serverID, body.size());
+        streamHeaders[RESPONSE_OK_HEAD] = streamHeaders[RESPONSE_OK];
+        streamHeaders[RESPONSE_ERROR] = buildStreamHeaders(500, config.serverID, streamBodies[RESPONSE_ERROR].size());
+        streamHeaders[RESPONSE_UNAVAILABLE] =
+            buildStreamHeaders(503, config.serverID, streamBodies[RESPONSE_UNAVAILABLE].size());
+        streamHeaders[RESPONSE_BAD_REQUEST] = buildStreamHeaders(400, config.serverID, 0);
+
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || timerFd < 0 || stopFd < 0) {
+            std::string reason = std::strerror(errno);
+            closeDescriptors();
+            throw std::runtime_error("cannot create event loop: " + reason);
+        }
+        try {
+            // Threads share a Unix listener, and one wakeup per connection is enough
+            watch(listenFd, !config.unixPath.empty());
+            watch(timerFd);
+            watch(stopFd);
+        } catch (...) {
+            closeDescriptors();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Close every connection and descriptor
+     */
+    ~Worker() {
+        for (auto& entry : connections) {
+            ::close(entry.first);
+        }
+        closeDescriptors();
+    }
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    /**
+     * @brief Run the event loop until requestStop() is called
+     */
+    void run() {
+        epoll_event events[256];
+        while (true) {
+            int ready = ::epoll_wait(epollFd, events, 256, -1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            for (int i = 0; i < ready; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == stopFd) {
+                    return;
+                }
+                if (fd == listenFd) {
+                    acceptAll();
+                    continue;
+                }
+                if (fd == timerFd) {
+                    uint64_t expirations;
+                    ssize_t ignored = ::read(timerFd, &expirations, sizeof(expirations));
+                    (void)ignored;
+                    armedDeadline = NO_DEADLINE;
+                    expireTimers();
+                    continue;
+                }
+                auto it = connections.find(fd);
+                if (it == connections.end()) {
+                    continue;
+                }
+                Connection& connection = *it->second;
+                uint32_t flags = events[i].events;
+                if ((flags & EPOLLOUT) && !flush(connection)) {
+                    continue;
+                }
+                if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    readable(connection);
+                }
+            }
+            admitWaiting();
+            armTimer();
+        }
+    }
+
+    /**
+     * @brief Ask the event loop to return
+     */
+    void requestStop() {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(stopFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    /**
+     * @brief Add this thread's counters to a total
+     * @param total Counters to add to
+     */
+    void addStats(StubServerStats& total) const {
+        total.connections += connectionCount.load(std::memory_order_relaxed);
+        total.requests += requestCount.load(std::memory_order_relaxed);
+        total.responses += responseCount.load(std::memory_order_relaxed);
+        total.errors += errorCount.load(std::memory_order_relaxed);
+        total.rejected += rejectedCount.load(std::memory_order_relaxed);
+        total.dropped += droppedCount.load(std::memory_order_relaxed);
+        total.slow += slowCount.load(std::memory_order_relaxed);
+        total.invalid += invalidCount.load(std::memory_order_relaxed);
+        total.queued += queuedCount.load(std::memory_order_relaxed);
+        total.maxInService = std::max(total.maxInService, maxInService.load(std::memory_order_relaxed));
+    }
+};
+
+/**
+ * @brief Create a stopped server
+ * @param settings Behaviour
+ */
+StubServer::StubServer(const StubServerConfig& settings) : config(settings), boundPort(settings.port) {
+    if (config.threads < 1) {
+        config.threads = 1;
+    }
+}
+
+/**
+ * @brief Stop the server if running
+ */
+StubServer::~StubServer() {
+    stop();
+}
+
+/**
+ * @brief Bind the listening sockets and start the threads
+ * @throws std::runtime_error if a socket cannot be created or bound
+ */
+void StubServer::start() {
+    if (!threads.empty()) {
+        return;
+    }
+    workers.clear();
+    int listener = config.unixPath.empty() ? -1 : openUnixListener(config.unixPath);
+    for (int i = 0; i < config.threads; ++i) {
+        int fd;
+        if (listener >= 0) {
+            // Unix sockets have no SO_REUSEPORT, so every thread gets a copy of one listener
+            boundPort = 0;
+            fd = i == 0 ? listener : ::fcntl(listener, F_DUPFD_CLOEXEC, 0);
+            if (fd < 0) {
+                throw std::runtime_error(std::string("fcntl: ") + std::strerror(errno));
+            }
+        } else {
+            fd = openReusePortListener(config.host, boundPort);
+            if (boundPort == 0) {
+                // Later threads must join the port the kernel picked for the first
+                boundPort = getLocalPort(fd);
+            }
+        }
+        workers.emplace_back(new Worker(config, i, fd));
+    }
+    for (auto& worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+}
+
+/**
+ * @brief Close all connections and stop the threads
+ */
+void StubServer::stop() {
+    for (auto& worker : workers) {
+        worker->requestStop();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (!threads.empty() && !config.unixPath.empty()) {
+        ::unlink(config.unixPath.c_str());
+    }
+    threads.clear();
+}
+
+/**
+ * @brief Get the port being listened on
+ * @return Port, resolved if 0 was configured
+ */
+int StubServer::getPort() const {
+    return boundPort;
+}
+
+/**
+ * @brief Get the counters so far
+ * @return Counters summed over threads
+ */
+StubServerStats StubServer::getStats() const {
+    StubServerStats total;
+    for (const auto& worker : workers) {
+        worker->addStats(total);
+    }
+    return total;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file StubServer.h
+ * @brief Header file for the StubServer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef STUBSERVER_H
+#define STUBSERVER_H
+
+#include "ServiceTimeModel.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct StubServerConfig
+ * @brief Behaviour of a stub backend
+ */
+struct StubServerConfig {
+    std::string host = "127.0.0.1";  ///< Listening IPv4 address
+    int port = 8081;                 ///< Listening port, 0 for any free port
+    std::string unixPath;            ///< Listen on this Unix domain socket instead of TCP if set
+    int serverID = 0;                ///< Reported in each response's X-Server header
+    int threads = 1;                 ///< Event-loop threads, each with its own listening socket
+    int maxCapacity = 0;             ///< Requests in service at once, 0 for unlimited
+    bool rejectWhenFull = false;     ///< Answer 503 at capacity instead of queueing
+    ServiceTimeModel serviceTime;    ///< Per-request service time
+    double errorRate = 0.0;          ///< Fraction of requests answered 500
+    double dropRate = 0.0;           ///< Fraction of requests whose connection is closed unanswered
+    double slowRate = 0.0;           ///< Fraction of requests whose service time is multiplied
+    double slowFactor = 10.0;        ///< Service time multiplier for slow requests
+    size_t bodyBytes = 64;           ///< Response body size
+    bool sendContinue = false;       ///< Precede each HTTP/1.1 response with 100 Continue
+    unsigned int seed = 1;           ///< Seed for service times and injected faults
+};
+
+/**
+ * @struct StubServerStats
+ * @brief Counters summed over a stub backend's threads
+ */
+struct StubServerStats {
+    long long connections = 0;  ///< Connections accepted
+    long long requests = 0;     ///< Requests parsed
+    long long responses = 0;    ///< Responses queued for sending, of any status
+    long long errors = 0;       ///< Injected 500 responses
+    long long rejected = 0;     ///< 503 responses because the server was at capacity
+    long long dropped = 0;      ///< Requests whose connection was closed unanswered
+    long long slow = 0;         ///< Requests given the slow multiplier
+    long long invalid = 0;      ///< Malformed requests answered 400
+    long long queued = 0;       ///< Requests that waited for capacity
+    long long maxInService = 0; ///< Largest number in service on one thread at once
+};
+
+/**
+ * @class StubServer
+ * @brief Local HTTP/1.1 and HTTP/2 backend emulating WebServer over real sockets
+ *
+ * Stands in for a real service when benchmarking a networked balancer.
+ * Like WebServer, it has a capacity: at most maxCapacity requests are in
+ * service at once, and the rest wait in FIFO order (or are refused with
+ * 503 when rejectWhenFull is set). Each request's service time is drawn
+ * from a ServiceTimeModel, and a response is sent once it has elapsed;
+ * requests with no service time are answered immediately.
+ *
+ * Each thread runs its own epoll loop and SO_REUSEPORT listening socket,
+ * so the kernel spreads connections across threads and the threads share
+ * nothing. Capacity is therefore divided evenly between threads.
+ * Responses on one connection are sent in request order; pipelined
+ * requests wait for the one ahead of them.
+ *
+ * A connection that opens with the HTTP/2 client preface is served as
+ * cleartext HTTP/2 instead. Each stream is then one request with its own
+ * service time and capacity unit, answered as soon as it is done, so a
+ * single connection can keep the whole capacity busy. A dropped request
+ * has its stream reset instead of the connection closed.
+ *
+ * With unixPath set, the server listens on a Unix domain socket instead,
+ * for a balancer on the same host. Such a socket cannot be bound once per
+ * thread, so the threads share one listener and each accept wakes a
+ * single thread. The socket file is removed when the server stops.
+ */
+class StubServer {
+private:
+    class Worker;
+
+    StubServerConfig config;                       ///< Behaviour
+    int boundPort;                                 ///< Port actually listened on
+    std::vector<std::unique_ptr<Worker>> workers;  ///< Event loops
+    std::vector<std::thread> threads;              ///< Threads running the event loops
+
+public:
+    /**
+     * @brief Create a stopped server
+     * @param settings Behaviour
+     */
+    explicit StubServer(const StubServerConfig& settings);
+
+    /**
+     * @brief Stop the server if running
+     */
+    ~StubServer();
+
+    StubServer(const StubServer&) = delete;
+    StubServer& operator=(const StubServer&) = delete;
+
+    /**
+     * @brief Bind the listening sockets and start the threads
+     * @throws std::runtime_error if a socket cannot be created or bound
+     */
+    void start();
+
+    /**
+     * @brief Close all connections and stop the threads
+     */
+    void stop();
+
+    /**
+     * @brief Get the port being listened on
+     * @return Port, resolved if 0 was configured; 0 on a Unix domain socket
+     */
+    int getPort() const;
+
+    /**
+     * @brief Get the counters so far
+     * @return Counters summed over threads
+     */
+    StubServerStats getStats() const;
+};
+
+#endif // STUBSERVER_H
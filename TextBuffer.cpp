@@ -0,0 +1,133 @@
+/**
+ * @file TextBuffer.cpp
+ * @brief Implementation file for the TextBuffer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TextBuffer.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Default constructor
+ */
+TextBuffer::TextBuffer() {
+    text.reserve(256);
+}
+
+/**
+ * @brief Append a formatted field, left-padded to a width
+ * @param digits Formatted characters
+ * @param length Number of characters
+ * @param width Minimum field width
+ */
+void TextBuffer::appendPadded(const char* digits, size_t length, int width) {
+    if (width > 0 && length < static_cast<size_t>(width)) {
+        text.append(static_cast<size_t>(width) - length, ' ');
+    }
+    text.append(digits, length);
+}
+
+/**
+ * @brief Append text
+ * @param value Text to append
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::append(const std::string& value) {
+    text.append(value);
+    return *this;
+}
+
+/**
+ * @brief Append a C string
+ * @param value Null-terminated text
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::append(const char* value) {
+    text.append(value, std::strlen(value));
+    return *this;
+}
+
+/**
+ * @brief Append characters from a buffer
+ * @param value Text, not necessarily null-terminated
+ * @param length Number of characters
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::append(const char* value, size_t length) {
+    text.append(value, length);
+    return *this;
+}
+
+/**
+ * @brief Append one character
+ * @param value Character
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::append(char value) {
+    text.push_back(value);
+    return *this;
+}
+
+/**
+ * @brief Append an integer
+ * @param value Integer
+ * @param width Minimum field width (right-aligned)
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::appendInt(long long value, int width) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    appendPadded(digits, static_cast<size_t>(result.ptr - digits), width);
+    return *this;
+}
+
+/**
+ * @brief Append a floating-point value in fixed notation
+ * @param value Value
+ * @param precision Digits after the decimal point
+ * @param width Minimum field width (right-aligned)
+ * @return This buffer
+ */
+TextBuffer& TextBuffer::appendFixed(double value, int precision, int width) {
+    // Fixed notation of the largest double has 309 integer digits
+    char digits[352];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value,
+                                                std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        // Only reachable for very large precisions; printf gives the same digits
+        int length = std::snprintf(nullptr, 0, "%.*f", precision, value);
+        std::string slow(static_cast<size_t>(length) + 1, '\0');
+        std::snprintf(&slow[0], slow.size(), "%.*f", precision, value);
+        appendPadded(slow.data(), static_cast<size_t>(length), width);
+        return *this;
+    }
+    appendPadded(digits, static_cast<size_t>(result.ptr - digits), width);
+    return *this;
+}
+
+/**
+ * @brief Get the buffered text
+ * @return Text appended since the last clear()
+ */
+const std::string& TextBuffer::str() const {
+    return text;
+}
+
+/**
+ * @brief Get the number of buffered characters
+ * @return Length in bytes
+ */
+size_t TextBuffer::size() const {
+    return text.size();
+}
+
+/**
+ * @brief Discard the text but keep the capacity
+ */
+void TextBuffer::clear() {
+    text.clear();
+}
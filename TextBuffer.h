@@ -0,0 +1,107 @@
+/**
+ * @file TextBuffer.h
+ * @brief Header file for the TextBuffer class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TEXTBUFFER_H
+#define TEXTBUFFER_H
+
+#include <string>
+
+/**
+ * @class TextBuffer
+ * @brief Reusable character buffer with std::to_chars number formatting
+ * 
+ * Produces the same bytes as the equivalent iostream expressions:
+ * appendInt(v, w) matches `<< std::setw(w) << v` and
+ * appendFixed(v, p, w) matches `<< std::setw(w) << std::fixed <<
+ * std::setprecision(p) << v`, both right-aligned with spaces. Unlike a
+ * stringstream it keeps no formatting state and never reallocates once
+ * its capacity has grown to the longest text built in it.
+ */
+class TextBuffer {
+private:
+    std::string text;  ///< Characters appended since the last clear()
+
+    /**
+     * @brief Append a formatted field, left-padded to a width
+     * @param digits Formatted characters
+     * @param length Number of characters
+     * @param width Minimum field width
+     */
+    void appendPadded(const char* digits, size_t length, int width);
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    TextBuffer();
+
+    /**
+     * @brief Append text
+     * @param value Text to append
+     * @return This buffer
+     */
+    TextBuffer& append(const std::string& value);
+
+    /**
+     * @brief Append a C string
+     * @param value Null-terminated text
+     * @return This buffer
+     */
+    TextBuffer& append(const char* value);
+
+    /**
+     * @brief Append characters from a buffer
+     * @param value Text, not necessarily null-terminated
+     * @param length Number of characters
+     * @return This buffer
+     */
+    TextBuffer& append(const char* value, size_t length);
+
+    /**
+     * @brief Append one character
+     * @param value Character
+     * @return This buffer
+     */
+    TextBuffer& append(char value);
+
+    /**
+     * @brief Append an integer
+     * @param value Integer
+     * @param width Minimum field width (right-aligned)
+     * @return This buffer
+     */
+    TextBuffer& appendInt(long long value, int width = 0);
+
+    /**
+     * @brief Append a floating-point value in fixed notation
+     * @param value Value
+     * @param precision Digits after the decimal point
+     * @param width Minimum field width (right-aligned)
+     * @return This buffer
+     */
+    TextBuffer& appendFixed(double value, int precision, int width = 0);
+
+    /**
+     * @brief Get the buffered text
+     * @return Text appended since the last clear()
+     */
+    const std::string& str() const;
+
+    /**
+     * @brief Get the number of buffered characters
+     * @return Length in bytes
+     */
+    size_t size() const;
+
+    /**
+     * @brief Discard the text but keep the capacity
+     */
+    void clear();
+};
+
+#endif // TEXTBUFFER_H
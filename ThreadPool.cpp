@@ -0,0 +1,165 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation file for the ThreadPool class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ThreadPool.h"
+#include "CpuTopology.h"
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
+
+/**
+ * @brief Parameterized constructor
+ * @param threadCount Number of workers (0 selects the hardware concurrency)
+ * @param pinWorkers Bind each worker to one CPU, spread across NUMA nodes
+ */
+ThreadPool::ThreadPool(int threadCount, bool pinWorkers) : outstanding(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+    
+    const CpuTopology& topology = CpuTopology::get();
+    if (pinWorkers) {
+        // More workers than CPUs wrap around the placement order
+        std::vector<int> order = topology.getPlacementOrder();
+        for (int i = 0; i < threadCount; ++i) {
+            workerCpus.push_back(order[i % order.size()]);
+        }
+        for (int cpu : workerCpus) {
+            int node = topology.getNodeOfCpu(cpu);
+            if (node >= static_cast<int>(nodeStats.size())) {
+                nodeStats.resize(node + 1);
+            }
+            nodeStats[node].pinnedWorkers++;
+        }
+    }
+    
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Finishes queued tasks and joins all workers
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Worker thread main loop
+ * @param index Worker index
+ */
+void ThreadPool::workerLoop(int index) {
+    if (!workerCpus.empty()) {
+        // Binding fails only if the CPU went offline; the worker then floats
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(workerCpus[index], &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+#ifdef HAVE_LIBNUMA
+        if (numa_available() >= 0) {
+            numa_set_localalloc();
+        }
+#endif
+    }
+    
+    const CpuTopology& topology = CpuTopology::get();
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return; // Stopping and nothing left to do
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        
+        int node = topology.getCurrentNode();
+        auto start = std::chrono::steady_clock::now();
+        task();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (node >= static_cast<int>(nodeStats.size())) {
+            nodeStats.resize(node + 1);
+        }
+        nodeStats[node].tasks++;
+        nodeStats[node].busySeconds += seconds;
+        if (--outstanding == 0) {
+            allDone.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Queue a task for execution
+ * @param task Task to run on a worker thread
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+        outstanding++;
+    }
+    taskAvailable.notify_one();
+}
+
+/**
+ * @brief Block until all submitted tasks have completed
+ */
+void ThreadPool::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return outstanding == 0; });
+}
+
+/**
+ * @brief Get the number of worker threads
+ * @return Worker count
+ */
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size());
+}
+
+/**
+ * @brief Check whether workers are bound to CPUs
+ * @return True if pinned
+ */
+bool ThreadPool::isPinned() const {
+    return !workerCpus.empty();
+}
+
+/**
+ * @brief Get the work done on each NUMA node so far
+ * @return One entry per node with pinned workers or completed tasks
+ */
+std::vector<NodeThroughput> ThreadPool::getNodeThroughput() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<NodeThroughput> result;
+    for (size_t node = 0; node < nodeStats.size(); ++node) {
+        if (nodeStats[node].pinnedWorkers > 0 || nodeStats[node].tasks > 0) {
+            result.push_back(nodeStats[node]);
+            result.back().node = static_cast<int>(node);
+        }
+    }
+    return result;
+}
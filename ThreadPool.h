@@ -0,0 +1,109 @@
+/**
+ * @file ThreadPool.h
+ * @brief Header file for the ThreadPool class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct NodeThroughput
+ * @brief Work done by a pool on one NUMA node
+ */
+struct NodeThroughput {
+    int node = 0;              ///< NUMA node number
+    int pinnedWorkers = 0;     ///< Workers pinned to the node's CPUs
+    long long tasks = 0;       ///< Tasks that started on the node
+    double busySeconds = 0.0;  ///< Time spent running those tasks
+};
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads executing submitted tasks
+ * 
+ * Used to run independent simulation replicas in parallel. Tasks are
+ * executed in submission order by whichever worker is free; waitAll()
+ * blocks until every submitted task has finished.
+ * 
+ * With pinning, each worker is bound to one CPU, spread across NUMA
+ * nodes. A simulation run allocates its state inside the task, so with
+ * the kernel's first-touch policy (or libnuma's local allocation when
+ * built with NUMA=1) that memory lands on the worker's own node.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;         ///< Worker threads
+    std::queue<std::function<void()>> tasks;  ///< Pending tasks
+    mutable std::mutex mutex;                 ///< Guards tasks and counters
+    std::condition_variable taskAvailable;    ///< Signalled when a task is queued
+    std::condition_variable allDone;          ///< Signalled when outstanding reaches 0
+    int outstanding;                          ///< Tasks queued or running
+    bool stopping;                            ///< Set when the pool shuts down
+    std::vector<int> workerCpus;              ///< CPU per worker, empty if not pinned
+    std::vector<NodeThroughput> nodeStats;    ///< Work done per NUMA node
+
+    /**
+     * @brief Worker thread main loop
+     * @param index Worker index
+     */
+    void workerLoop(int index);
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param threadCount Number of workers (0 selects the hardware concurrency)
+     * @param pinWorkers Bind each worker to one CPU, spread across NUMA nodes
+     */
+    explicit ThreadPool(int threadCount = 0, bool pinWorkers = false);
+
+    /**
+     * @brief Destructor
+     * 
+     * Finishes queued tasks and joins all workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task for execution
+     * @param task Task to run on a worker thread
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Block until all submitted tasks have completed
+     */
+    void waitAll();
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Check whether workers are bound to CPUs
+     * @return True if pinned
+     */
+    bool isPinned() const;
+
+    /**
+     * @brief Get the work done on each NUMA node so far
+     * @return One entry per node with pinned workers or completed tasks
+     */
+    std::vector<NodeThroughput> getNodeThroughput() const;
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,138 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Implementation file for the TimerWheel class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TimerWheel.h"
+
+/**
+ * @brief Create an empty wheel
+ * @param start Time of tick 0, in nanoseconds
+ * @param tickLength Tick length in nanoseconds, the timers' resolution
+ */
+TimerWheel::TimerWheel(uint64_t start, uint64_t tickLength)
+    : tickNanoseconds(tickLength > 0 ? tickLength : 1), origin(start), current(0), armed(0) {
+    for (int level = 0; level < LEVELS; ++level) {
+        for (uint64_t slot = 0; slot < SLOTS; ++slot) {
+            slots[level][slot].prev = slots[level][slot].next = &slots[level][slot];
+        }
+    }
+}
+
+/**
+ * @brief Link a node into the slot its expiry falls in
+ * @param node Unlinked node with expiry > current
+ */
+void TimerWheel::place(TimerNode& node) {
+    const uint64_t span = 1ULL << (SLOT_BITS * LEVELS);
+    if (node.expiry - current >= span) {
+        node.expiry = current + span - 1;
+    }
+    uint64_t delta = node.expiry - current;
+    int level = 0;
+    while (delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    TimerNode& head = slots[level][(node.expiry >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    node.prev = head.prev;
+    node.next = &head;
+    head.prev->next = &node;
+    head.prev = &node;
+}
+
+/**
+ * @brief Unlink a node from its list
+ * @param node Linked node
+ */
+void TimerWheel::unlink(TimerNode& node) {
+    node.prev->next = node.next;
+    node.next->prev = node.prev;
+    node.prev = nullptr;
+    node.next = nullptr;
+}
+
+/**
+ * @brief Move a slot's nodes onto another list
+ * @param from Sentinel of the slot to empty
+ * @param to Sentinel of an empty list
+ */
+void TimerWheel::splice(TimerNode& from, TimerNode& to) {
+    if (from.next == &from) {
+        return;
+    }
+    to.next = from.next;
+    to.prev = from.prev;
+    to.next->prev = &to;
+    to.prev->next = &to;
+    from.prev = from.next = &from;
+}
+
+/**
+ * @brief Process one tick: cascade higher levels and collect due timers
+ * @param due Sentinel of an empty list that receives the due timers
+ */
+void TimerWheel::tick(TimerNode& due) {
+    current++;
+    // At each 256^k boundary, one level-k slot becomes due within 256^k
+    // ticks and is re-sorted into the levels below
+    for (int level = LEVELS - 1; level > 0; --level) {
+        if ((current & ((1ULL << (SLOT_BITS * level)) - 1)) != 0) {
+            continue;
+        }
+        TimerNode moving;
+        moving.prev = moving.next = &moving;
+        splice(slots[level][(current >> (SLOT_BITS * level)) & (SLOTS - 1)], moving);
+        while (moving.next != &moving) {
+            TimerNode& node = *moving.next;
+            unlink(node);
+            if (node.expiry <= current) {
+                node.prev = due.prev;
+                node.next = &due;
+                due.prev->next = &node;
+                due.prev = &node;
+            } else {
+                place(node);
+            }
+        }
+    }
+    TimerNode& slot = slots[0][current & (SLOTS - 1)];
+    while (slot.next != &slot) {
+        TimerNode& node = *slot.next;
+        unlink(node);
+        node.prev = due.prev;
+        node.next = &due;
+        due.prev->next = &node;
+        due.prev = &node;
+    }
+}
+
+/**
+ * @brief Arm or re-arm a timer
+ * @param node Timer
+ * @param deadline Time to fire, in nanoseconds; past deadlines fire on the next advance
+ */
+void TimerWheel::arm(TimerNode& node, uint64_t deadline) {
+    if (node.isArmed()) {
+        unlink(node);
+    } else {
+        armed++;
+    }
+    // Round up so a timer never fires before its deadline
+    uint64_t ticks = deadline <= origin ? 0 : (deadline - origin + tickNanoseconds - 1) / tickNanoseconds;
+    node.expiry = ticks > current ? ticks : current + 1;
+    place(node);
+}
+
+/**
+ * @brief Disarm a timer if armed
+ * @param node Timer
+ */
+void TimerWheel::cancel(TimerNode& node) {
+    if (node.isArmed()) {
+        unlink(node);
+        armed--;
+    }
+}
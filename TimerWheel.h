@@ -0,0 +1,154 @@
+/**
+ * @file TimerWheel.h
+ * @brief Header file for the TimerWheel class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct TimerNode
+ * @brief Intrusive timer embedded in the object it times out
+ *
+ * The owner keeps the node at a stable address and must cancel it before
+ * destroying it. tag tells the expiry callback which object timed out.
+ */
+struct TimerNode {
+    TimerNode* prev = nullptr;  ///< Previous node in the slot, nullptr when not armed
+    TimerNode* next = nullptr;  ///< Next node in the slot
+    uint64_t expiry = 0;        ///< Tick at which the timer fires
+    uint64_t tag = 0;           ///< Owner identifier passed back on expiry
+
+    /**
+     * @brief Check whether the timer is armed
+     * @return True if in a wheel
+     */
+    bool isArmed() const { return prev != nullptr; }
+};
+
+/**
+ * @class TimerWheel
+ * @brief Hierarchical timer wheel for one event-loop thread
+ *
+ * Four levels of 256 slots cover 2^32 ticks; level k holds timers due
+ * within 256^(k+1) ticks, bucketed by 256^k. Arming and cancelling link
+ * or unlink a node in a doubly-linked slot list, so both are O(1) and
+ * never allocate. Advancing expires the current level-0 slot and, every
+ * 256^k ticks, re-sorts one level-k slot into the levels below, so each
+ * timer is touched at most once per level. Deadlines further out than the
+ * wheel spans are clamped to its end. Not thread-safe: each thread owns
+ * its wheel.
+ */
+class TimerWheel {
+private:
+    static const int LEVELS = 4;        ///< Wheel levels
+    static const int SLOT_BITS = 8;     ///< log2 of slots per level
+    static const uint64_t SLOTS = 1ULL << SLOT_BITS; ///< Slots per level
+
+    TimerNode slots[LEVELS][SLOTS];     ///< Circular lists, each headed by a sentinel
+    uint64_t tickNanoseconds;           ///< Length of a tick
+    uint64_t origin;                    ///< Time of tick 0
+    uint64_t current;                   ///< Last tick processed
+    size_t armed;                       ///< Timers in the wheel
+
+    /**
+     * @brief Link a node into the slot its expiry falls in
+     * @param node Unlinked node with expiry > current
+     */
+    void place(TimerNode& node);
+
+    /**
+     * @brief Unlink a node from its list
+     * @param node Linked node
+     */
+    static void unlink(TimerNode& node);
+
+    /**
+     * @brief Move a slot's nodes onto another list
+     * @param from Sentinel of the slot to empty
+     * @param to Sentinel of an empty list
+     */
+    static void splice(TimerNode& from, TimerNode& to);
+
+    /**
+     * @brief Process one tick: cascade higher levels and collect due timers
+     * @param due Sentinel of an empty list that receives the due timers
+     */
+    void tick(TimerNode& due);
+
+public:
+    /**
+     * @brief Create an empty wheel
+     * @param start Time of tick 0, in nanoseconds
+     * @param tickLength Tick length in nanoseconds, the timers' resolution
+     */
+    TimerWheel(uint64_t start, uint64_t tickLength);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Arm or re-arm a timer
+     * @param node Timer
+     * @param deadline Time to fire, in nanoseconds; past deadlines fire on the next advance
+     */
+    void arm(TimerNode& node, uint64_t deadline);
+
+    /**
+     * @brief Disarm a timer if armed
+     * @param node Timer
+     */
+    void cancel(TimerNode& node);
+
+    /**
+     * @brief Fire every timer due by a time
+     *
+     * The callback runs after the timer is disarmed and may arm or cancel
+     * any timer, including the one that fired.
+     * @param now Current time, in nanoseconds
+     * @param onExpire Called as onExpire(TimerNode&) for each due timer
+     * @return Timers fired
+     */
+    template <typename Callback>
+    size_t advance(uint64_t now, Callback&& onExpire);
+
+    /**
+     * @brief Get the number of armed timers
+     * @return Timer count
+     */
+    size_t size() const { return armed; }
+};
+
+template <typename Callback>
+size_t TimerWheel::advance(uint64_t now, Callback&& onExpire) {
+    uint64_t target = now < origin ? 0 : (now - origin) / tickNanoseconds;
+    if (armed == 0) {
+        // Nothing to expire, so skip the idle ticks instead of walking them
+        current = target > current ? target : current;
+        return 0;
+    }
+    size_t fired = 0;
+    TimerNode due;
+    due.prev = due.next = &due;
+    while (current < target && armed > 0) {
+        tick(due);
+        // Disarm each node before its callback so the callback can re-arm it
+        while (due.next != &due) {
+            TimerNode& node = *due.next;
+            unlink(node);
+            armed--;
+            fired++;
+            onExpire(node);
+        }
+    }
+    current = target > current ? target : current;
+    return fired;
+}
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,180 @@
+/**
+ * @file TraceFormat.cpp
+ * @brief Request trace records and helpers shared by the trace readers and writers
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TraceFormat.h"
+#include "JsonlTrace.h"
+#include "TraceReader.h"
+#include "TraceWriter.h"
+#include <stdexcept>
+
+/**
+ * @brief Build a request from a trace record
+ * @param record Trace record
+ * @return Request with the record's fields
+ */
+Request toRequest(const TraceRecord& record) {
+    return Request(record.clientIP, record.requestType, record.priority, record.serviceTime,
+                   record.requestID);
+}
+
+/**
+ * @brief Build a trace record from a request
+ * @param request Request to describe
+ * @param cycle Arrival cycle
+ * @return Trace record
+ */
+TraceRecord fromRequest(const Request& request, long long cycle) {
+    TraceRecord record;
+    record.cycle = cycle;
+    record.requestID = request.getRequestID();
+    record.clientIP = request.getClientIP();
+    record.requestType = request.getRequestType();
+    record.priority = request.getPriority();
+    record.serviceTime = request.getServiceTime();
+    return record;
+}
+
+/**
+ * @brief Append an unsigned LEB128 varint
+ * @param out Output buffer
+ * @param value Value to encode
+ */
+void appendVarint(std::vector<unsigned char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * @brief Append a zigzag-encoded signed varint
+ * @param out Output buffer
+ * @param value Value to encode
+ */
+void appendSignedVarint(std::vector<unsigned char>& out, int64_t value) {
+    appendVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * @brief Decode an unsigned LEB128 varint
+ * @param in Read cursor, advanced past the value
+ * @param end End of the readable range
+ * @return Decoded value
+ * @throws std::runtime_error on truncated input
+ */
+uint64_t readVarint(const unsigned char*& in, const unsigned char* end) {
+    // Fast path: single-byte values dominate delta-encoded traces
+    if (in < end && *in < 0x80) {
+        return *in++;
+    }
+    
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in >= end) {
+            throw std::runtime_error("Truncated varint in trace");
+        }
+        unsigned char byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed varint in trace");
+}
+
+/**
+ * @brief Decode a zigzag-encoded signed varint
+ * @param in Read cursor, advanced past the value
+ * @param end End of the readable range
+ * @return Decoded value
+ * @throws std::runtime_error on truncated input
+ */
+int64_t readSignedVarint(const unsigned char*& in, const unsigned char* end) {
+    uint64_t raw = readVarint(in, end);
+    return static_cast<int64_t>((raw >> 1) ^ (~(raw & 1) + 1));
+}
+
+/**
+ * @brief Pack a dotted-quad IPv4 address into 32 bits
+ * @param text Address text
+ * @param address Output address (first octet in the high byte)
+ * @return False unless the text is a canonical dotted quad that
+ *         formatIPv4() reproduces exactly
+ */
+bool packIPv4(const std::string& text, uint32_t& address) {
+    uint32_t result = 0;
+    size_t pos = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        if (octet > 0) {
+            if (pos >= text.size() || text[pos] != '.') return false;
+            ++pos;
+        }
+        size_t start = pos;
+        unsigned value = 0;
+        while (pos < text.size() && pos - start < 3 && text[pos] >= '0' && text[pos] <= '9') {
+            value = value * 10 + static_cast<unsigned>(text[pos] - '0');
+            ++pos;
+        }
+        // Reject empty octets, leading zeros and out-of-range values
+        if (pos == start || value > 255 || (text[start] == '0' && pos - start > 1)) {
+            return false;
+        }
+        result = (result << 8) | value;
+    }
+    if (pos != text.size()) return false;
+    address = result;
+    return true;
+}
+
+/**
+ * @brief Format a packed IPv4 address as a dotted quad
+ * @param address Packed address
+ * @return Address text
+ */
+std::string formatIPv4(uint32_t address) {
+    char buffer[16];
+    char* out = buffer;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        unsigned value = (address >> shift) & 0xFF;
+        if (value >= 100) *out++ = static_cast<char>('0' + value / 100);
+        if (value >= 10) *out++ = static_cast<char>('0' + value / 10 % 10);
+        *out++ = static_cast<char>('0' + value % 10);
+        if (shift > 0) *out++ = '.';
+    }
+    return std::string(buffer, out);
+}
+
+/**
+ * @brief Open a trace in either format, detected from its contents
+ * @param path Trace file path (binary trace or JSONL)
+ * @return Trace source
+ * @throws std::runtime_error if the file cannot be opened
+ */
+std::unique_ptr<TraceSource> openTrace(const std::string& path) {
+    if (TraceReader::isBinaryTrace(path)) {
+        return std::make_unique<TraceReader>(path);
+    }
+    return std::make_unique<JsonlTraceReader>(path);
+}
+
+/**
+ * @brief Create a trace writer, choosing the format from the file name
+ * @param path Output path; names ending in ".jsonl" get JSONL, others binary
+ * @param compress Whether binary blocks are compressed
+ * @return Trace sink
+ * @throws std::runtime_error if the file cannot be created
+ */
+std::unique_ptr<TraceSink> createTrace(const std::string& path, bool compress) {
+    const std::string suffix = ".jsonl";
+    if (path.size() >= suffix.size() &&
+        path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return std::make_unique<JsonlTraceWriter>(path);
+    }
+    return std::make_unique<TraceWriter>(path, 65536, compress);
+}
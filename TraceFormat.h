@@ -0,0 +1,159 @@
+/**
+ * @file TraceFormat.h
+ * @brief Request trace records and helpers shared by the trace readers and writers
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TRACEFORMAT_H
+#define TRACEFORMAT_H
+
+#include "Request.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct TraceRecord
+ * @brief One request arrival in a request trace
+ */
+struct TraceRecord {
+    long long cycle = 0;       ///< Cycle at which the request arrives
+    long long requestID = 0;   ///< Request identifier
+    std::string clientIP;      ///< Client IP address
+    std::string requestType;   ///< Request type (GET, POST, ...)
+    int priority = 5;          ///< Priority level
+    int serviceTime = 10;      ///< Processing time in cycles
+};
+
+/**
+ * @class TraceSource
+ * @brief Sequential source of trace records
+ * 
+ * Implemented by the JSONL and binary trace readers so replay code does
+ * not depend on the file format.
+ */
+class TraceSource {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~TraceSource() = default;
+
+    /**
+     * @brief Read the next record
+     * @param record Output record
+     * @return False at the end of the trace
+     */
+    virtual bool next(TraceRecord& record) = 0;
+};
+
+/**
+ * @class TraceSink
+ * @brief Sequential destination for trace records
+ * 
+ * Implemented by the JSONL and binary trace writers.
+ */
+class TraceSink {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~TraceSink() = default;
+
+    /**
+     * @brief Append a record
+     * @param record Record to append
+     */
+    virtual void write(const TraceRecord& record) = 0;
+
+    /**
+     * @brief Flush buffered records and finish the file
+     */
+    virtual void close() = 0;
+};
+
+/**
+ * @brief Build a request from a trace record
+ * @param record Trace record
+ * @return Request with the record's fields
+ */
+Request toRequest(const TraceRecord& record);
+
+/**
+ * @brief Build a trace record from a request
+ * @param request Request to describe
+ * @param cycle Arrival cycle
+ * @return Trace record
+ */
+TraceRecord fromRequest(const Request& request, long long cycle);
+
+/**
+ * @brief Append an unsigned LEB128 varint
+ * @param out Output buffer
+ * @param value Value to encode
+ */
+void appendVarint(std::vector<unsigned char>& out, uint64_t value);
+
+/**
+ * @brief Append a zigzag-encoded signed varint
+ * @param out Output buffer
+ * @param value Value to encode
+ */
+void appendSignedVarint(std::vector<unsigned char>& out, int64_t value);
+
+/**
+ * @brief Decode an unsigned LEB128 varint
+ * @param in Read cursor, advanced past the value
+ * @param end End of the readable range
+ * @return Decoded value
+ * @throws std::runtime_error on truncated input
+ */
+uint64_t readVarint(const unsigned char*& in, const unsigned char* end);
+
+/**
+ * @brief Decode a zigzag-encoded signed varint
+ * @param in Read cursor, advanced past the value
+ * @param end End of the readable range
+ * @return Decoded value
+ * @throws std::runtime_error on truncated input
+ */
+int64_t readSignedVarint(const unsigned char*& in, const unsigned char* end);
+
+/**
+ * @brief Pack a dotted-quad IPv4 address into 32 bits
+ * @param text Address text
+ * @param address Output address (first octet in the high byte)
+ * @return False unless the text is a canonical dotted quad that
+ *         formatIPv4() reproduces exactly
+ */
+bool packIPv4(const std::string& text, uint32_t& address);
+
+/**
+ * @brief Format a packed IPv4 address as a dotted quad
+ * @param address Packed address
+ * @return Address text
+ */
+std::string formatIPv4(uint32_t address);
+
+/**
+ * @brief Open a trace in either format, detected from its contents
+ * @param path Trace file path (binary trace or JSONL)
+ * @return Trace source
+ * @throws std::runtime_error if the file cannot be opened
+ */
+std::unique_ptr<TraceSource> openTrace(const std::string& path);
+
+/**
+ * @brief Create a trace writer, choosing the format from the file name
+ * @param path Output path; names ending in ".jsonl" get JSONL, others binary
+ * @param compress Whether binary blocks are compressed
+ * @return Trace sink
+ * @throws std::runtime_error if the file cannot be created
+ */
+std::unique_ptr<TraceSink> createTrace(const std::string& path, bool compress = true);
+
+#endif // TRACEFORMAT_H
@@ -0,0 +1,297 @@
+/**
+ * @file TraceReader.cpp
+ * @brief Implementation file for the TraceReader class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TraceReader.h"
+#include "TraceWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const size_t HEADER_SIZE = 16;   ///< Magic, version, records per block
+const size_t TRAILER_SIZE = 32;  ///< Index offset, block count, record count, magic
+const size_t INDEX_ENTRY_SIZE = 24;
+const size_t BLOCK_HEADER_SIZE = 9;
+
+/**
+ * @brief Read a fixed-width little-endian integer from a buffer
+ * @param in Read cursor, advanced past the value
+ * @return Decoded value
+ */
+template <typename T>
+T getInt(const unsigned char*& in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    in += sizeof(T);
+    return static_cast<T>(value);
+}
+
+/**
+ * @brief Read a dictionary entry
+ * @param in Read cursor, advanced past the entry
+ * @param end End of the readable range
+ * @return Entry text
+ * @throws std::runtime_error on truncated input
+ */
+std::string getDictionaryEntry(const unsigned char*& in, const unsigned char* end) {
+    if (in >= end) {
+        throw std::runtime_error("Truncated trace dictionary");
+    }
+    unsigned char tag = *in++;
+    if (tag == 4) {
+        if (end - in < 4) {
+            throw std::runtime_error("Truncated trace dictionary");
+        }
+        return formatIPv4(getInt<uint32_t>(in));
+    }
+    uint64_t length = readVarint(in, end);
+    if (static_cast<uint64_t>(end - in) < length) {
+        throw std::runtime_error("Truncated trace dictionary");
+    }
+    std::string text(reinterpret_cast<const char*>(in), length);
+    in += length;
+    return text;
+}
+
+} // namespace
+
+/**
+ * @brief Open a binary trace
+ * @param tracePath Trace file path
+ * @throws std::runtime_error if the file is missing or not a valid trace
+ */
+TraceReader::TraceReader(const std::string& tracePath)
+    : path(tracePath), fd(-1), data(nullptr), fileSize(0), recordsPerBlock(0),
+      totalRecords(0), nextBlock(0), position(0) {
+    fd = open(tracePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open trace file " + tracePath);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < HEADER_SIZE + TRAILER_SIZE) {
+        close(fd);
+        throw std::runtime_error("Not a binary trace: " + tracePath);
+    }
+    fileSize = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map trace file " + tracePath);
+    }
+    data = static_cast<const unsigned char*>(mapping);
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+    
+    const unsigned char* trailer = data + fileSize - TRAILER_SIZE;
+    if (std::memcmp(data, "LBTRACE1", 8) != 0 || std::memcmp(trailer + 24, "LBTRIDX1", 8) != 0) {
+        munmap(mapping, fileSize);
+        close(fd);
+        throw std::runtime_error("Not a binary trace or missing index: " + tracePath);
+    }
+    const unsigned char* cursor = data + 8;
+    uint32_t version = getInt<uint32_t>(cursor);
+    recordsPerBlock = getInt<uint32_t>(cursor);
+    uint64_t indexOffset = getInt<uint64_t>(trailer);
+    uint64_t blockCount = getInt<uint64_t>(trailer);
+    totalRecords = static_cast<long long>(getInt<uint64_t>(trailer));
+    if (version != TraceWriter::FORMAT_VERSION ||
+        indexOffset + blockCount * INDEX_ENTRY_SIZE + TRAILER_SIZE != fileSize) {
+        munmap(mapping, fileSize);
+        close(fd);
+        throw std::runtime_error("Unsupported or corrupt trace: " + tracePath);
+    }
+    
+    cursor = data + indexOffset;
+    blocks.reserve(blockCount);
+    for (uint64_t i = 0; i < blockCount; ++i) {
+        BlockInfo block;
+        block.offset = getInt<uint64_t>(cursor);
+        block.firstCycle = getInt<int64_t>(cursor);
+        block.recordCount = getInt<uint64_t>(cursor);
+        if (block.offset + BLOCK_HEADER_SIZE > indexOffset) {
+            munmap(mapping, fileSize);
+            close(fd);
+            throw std::runtime_error("Corrupt trace index: " + tracePath);
+        }
+        const unsigned char* header = data + block.offset;
+        block.encodedSize = getInt<uint32_t>(header);
+        block.storedSize = getInt<uint32_t>(header);
+        block.codec = *header;
+        blocks.push_back(block);
+    }
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Unmaps and closes the file
+ */
+TraceReader::~TraceReader() {
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), fileSize);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+/**
+ * @brief Decode a block into the record buffer
+ * @param blockIndex Index of the block
+ * @throws std::runtime_error on corrupt blocks
+ */
+void TraceReader::loadBlock(size_t blockIndex) {
+    const BlockInfo& block = blocks[blockIndex];
+    const unsigned char* body = data + block.offset + BLOCK_HEADER_SIZE;
+    if (block.offset + BLOCK_HEADER_SIZE + block.storedSize > fileSize) {
+        throw std::runtime_error("Truncated block in trace " + path);
+    }
+    
+    const unsigned char* in = body;
+    if (block.codec == TraceWriter::CODEC_ZLIB) {
+#ifdef HAVE_ZLIB
+        scratch.resize(block.encodedSize);
+        uLongf decodedSize = block.encodedSize;
+        if (uncompress(scratch.data(), &decodedSize, body, block.storedSize) != Z_OK ||
+            decodedSize != block.encodedSize) {
+            throw std::runtime_error("Corrupt compressed block in trace " + path);
+        }
+        in = scratch.data();
+#else
+        throw std::runtime_error("Trace " + path + " is compressed; rebuild with zlib");
+#endif
+    } else if (block.codec != TraceWriter::CODEC_RAW) {
+        throw std::runtime_error("Unknown block codec in trace " + path);
+    }
+    const unsigned char* end = in + block.encodedSize;
+    
+    uint64_t count = readVarint(in, end);
+    std::vector<std::string> ips(readVarint(in, end));
+    for (auto& ip : ips) ip = getDictionaryEntry(in, end);
+    std::vector<std::string> types(readVarint(in, end));
+    for (auto& type : types) type = getDictionaryEntry(in, end);
+    
+    decoded.resize(count);
+    long long cycle = 0;
+    long long id = 0;
+    for (auto& record : decoded) {
+        cycle += readSignedVarint(in, end);
+        id += readSignedVarint(in, end);
+        uint64_t ipCode = readVarint(in, end);
+        uint64_t typeCode = readVarint(in, end);
+        if (ipCode >= ips.size() || typeCode >= types.size()) {
+            throw std::runtime_error("Corrupt dictionary index in trace " + path);
+        }
+        record.cycle = cycle;
+        record.requestID = id;
+        record.clientIP = ips[ipCode];
+        record.requestType = types[typeCode];
+        record.priority = static_cast<int>(readSignedVarint(in, end));
+        record.serviceTime = static_cast<int>(readSignedVarint(in, end));
+    }
+    position = 0;
+    nextBlock = blockIndex + 1;
+}
+
+/**
+ * @brief Read the next record
+ * @param record Output record
+ * @return False at the end of the trace
+ */
+bool TraceReader::next(TraceRecord& record) {
+    while (position >= decoded.size()) {
+        if (nextBlock >= blocks.size()) {
+            return false;
+        }
+        loadBlock(nextBlock);
+    }
+    record = decoded[position++];
+    return true;
+}
+
+/**
+ * @brief Position the reader at the first record at or after a cycle
+ * @param cycle Target cycle
+ */
+void TraceReader::seekToCycle(long long cycle) {
+    // Last block starting strictly before the cycle may still hold it
+    auto it = std::lower_bound(blocks.begin(), blocks.end(), cycle,
+        [](const BlockInfo& block, long long target) { return block.firstCycle < target; });
+    size_t blockIndex = static_cast<size_t>(it - blocks.begin());
+    if (blockIndex > 0) {
+        --blockIndex;
+    }
+    decoded.clear();
+    position = 0;
+    nextBlock = blockIndex;
+    
+    for (; nextBlock < blocks.size();) {
+        loadBlock(nextBlock);
+        while (position < decoded.size() && decoded[position].cycle < cycle) {
+            ++position;
+        }
+        if (position < decoded.size()) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Rewind to the first record
+ */
+void TraceReader::rewind() {
+    decoded.clear();
+    position = 0;
+    nextBlock = 0;
+}
+
+/**
+ * @brief Get the number of records in the trace
+ * @return Record count
+ */
+long long TraceReader::getRecordCount() const {
+    return totalRecords;
+}
+
+/**
+ * @brief Get the block index
+ * @return Per-block offsets, first cycles and sizes
+ */
+const std::vector<TraceReader::BlockInfo>& TraceReader::getBlocks() const {
+    return blocks;
+}
+
+/**
+ * @brief Get the trace file size
+ * @return Size in bytes
+ */
+size_t TraceReader::getFileSize() const {
+    return fileSize;
+}
+
+/**
+ * @brief Check whether a file starts with the binary trace magic
+ * @param tracePath File to check
+ * @return True for binary traces
+ */
+bool TraceReader::isBinaryTrace(const std::string& tracePath) {
+    std::ifstream file(tracePath, std::ios::binary);
+    char magic[8] = {};
+    file.read(magic, sizeof(magic));
+    return file.gcount() == 8 && std::memcmp(magic, "LBTRACE1", 8) == 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file TraceReader.h
+ * @brief Header file for the TraceReader class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TRACEREADER_H
+#define TRACEREADER_H
+
+#include "TraceFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TraceReader
+ * @brief Reads binary request traces written by TraceWriter
+ * 
+ * The file is memory mapped and decoded one block at a time. The footer
+ * index allows seekToCycle() to jump to the block holding a cycle with a
+ * binary search instead of decoding everything before it.
+ */
+class TraceReader : public TraceSource {
+public:
+    /**
+     * @struct BlockInfo
+     * @brief Footer index entry for one block
+     */
+    struct BlockInfo {
+        uint64_t offset;       ///< File offset of the block header
+        long long firstCycle;  ///< Cycle of the block's first record
+        uint64_t recordCount;  ///< Records in the block
+        uint32_t encodedSize;  ///< Uncompressed payload size
+        uint32_t storedSize;   ///< Payload size on disk
+        uint8_t codec;         ///< Block codec
+    };
+
+private:
+    std::string path;                      ///< Trace file path
+    int fd;                                ///< File descriptor
+    const unsigned char* data;             ///< File mapping
+    size_t fileSize;                       ///< Size of the mapping
+    uint32_t recordsPerBlock;              ///< Records per block from the header
+    long long totalRecords;                ///< Records in the trace
+    std::vector<BlockInfo> blocks;         ///< Footer index
+    size_t nextBlock;                      ///< Next block to decode
+    std::vector<TraceRecord> decoded;      ///< Records of the current block
+    size_t position;                       ///< Next record in decoded
+    std::vector<unsigned char> scratch;    ///< Decompression buffer
+
+    /**
+     * @brief Decode a block into the record buffer
+     * @param blockIndex Index of the block
+     * @throws std::runtime_error on corrupt blocks
+     */
+    void loadBlock(size_t blockIndex);
+
+public:
+    /**
+     * @brief Open a binary trace
+     * @param tracePath Trace file path
+     * @throws std::runtime_error if the file is missing or not a valid trace
+     */
+    explicit TraceReader(const std::string& tracePath);
+
+    /**
+     * @brief Destructor
+     * 
+     * Unmaps and closes the file
+     */
+    ~TraceReader() override;
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    /**
+     * @brief Read the next record
+     * @param record Output record
+     * @return False at the end of the trace
+     */
+    bool next(TraceRecord& record) override;
+
+    /**
+     * @brief Position the reader at the first record at or after a cycle
+     * @param cycle Target cycle
+     * 
+     * Assumes records are in non-decreasing cycle order, as produced by
+     * the recorder and the simulator.
+     */
+    void seekToCycle(long long cycle);
+
+    /**
+     * @brief Rewind to the first record
+     */
+    void rewind();
+
+    /**
+     * @brief Get the number of records in the trace
+     * @return Record count
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Get the block index
+     * @return Per-block offsets, first cycles and sizes
+     */
+    const std::vector<BlockInfo>& getBlocks() const;
+
+    /**
+     * @brief Get the trace file size
+     * @return Size in bytes
+     */
+    size_t getFileSize() const;
+
+    /**
+     * @brief Check whether a file starts with the binary trace magic
+     * @param tracePath File to check
+     * @return True for binary traces
+     */
+    static bool isBinaryTrace(const std::string& tracePath);
+};
+
+#endif // TRACEREADER_H
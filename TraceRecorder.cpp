@@ -0,0 +1,137 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief Implementation file for the TraceRecorder class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TraceRecorder.h"
+#include <stdexcept>
+
+/**
+ * @brief Create a trace file and start the writer thread
+ * @param path Output path; ".jsonl" selects JSONL, anything else the binary format
+ * @param batchRecords Records per hand-off batch
+ * @throws std::runtime_error if the file cannot be created
+ */
+TraceRecorder::TraceRecorder(const std::string& path, size_t batchRecords)
+    // Compression only pays off when the writer has a core of its own
+    : sink(createTrace(path, std::thread::hardware_concurrency() > 1)), batchSize(batchRecords > 0 ? batchRecords : 1), recordCount(0),
+      batchPending(false), stopping(false), closed(false) {
+    filling.reserve(batchSize);
+    draining.reserve(batchSize);
+    writer = std::thread(&TraceRecorder::writerLoop, this);
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Finishes the trace if close() has not been called
+ */
+TraceRecorder::~TraceRecorder() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Destructors must not throw; the error was already recorded
+    }
+}
+
+/**
+ * @brief Writer thread main loop
+ */
+void TraceRecorder::writerLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batchReady.wait(lock, [this] { return batchPending || stopping; });
+            if (!batchPending) {
+                return;
+            }
+        }
+        
+        // draining belongs to this thread until batchPending is cleared
+        if (error.empty()) {
+            try {
+                for (const auto& record : draining) {
+                    sink->write(record);
+                }
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+        }
+        draining.clear();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batchPending = false;
+        }
+        batchDone.notify_one();
+    }
+}
+
+/**
+ * @brief Hand the filling batch to the writer thread
+ */
+void TraceRecorder::handOff() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchDone.wait(lock, [this] { return !batchPending; });
+        filling.swap(draining);
+        batchPending = true;
+    }
+    batchReady.notify_one();
+}
+
+/**
+ * @brief Record a request offered to the load balancer
+ * @param request Request as generated
+ * @param cycle Cycle at which it was offered (0 for the initial backlog)
+ */
+void TraceRecorder::record(const Request& request, long long cycle) {
+    filling.push_back(fromRequest(request, cycle));
+    ++recordCount;
+    if (filling.size() >= batchSize) {
+        handOff();
+    }
+}
+
+/**
+ * @brief Write all buffered records and finish the trace file
+ * @throws std::runtime_error if the writer thread failed
+ */
+void TraceRecorder::close() {
+    if (closed) {
+        return;
+    }
+    closed = true;
+    
+    if (!filling.empty()) {
+        handOff();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    batchReady.notify_one();
+    writer.join();
+    
+    if (error.empty()) {
+        try {
+            sink->close();
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+    }
+    if (!error.empty()) {
+        throw std::runtime_error("Trace recording failed: " + error);
+    }
+}
+
+/**
+ * @brief Get the number of records accepted
+ * @return Record count
+ */
+long long TraceRecorder::getRecordCount() const {
+    return recordCount;
+}
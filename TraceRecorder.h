@@ -0,0 +1,97 @@
+/**
+ * @file TraceRecorder.h
+ * @brief Header file for the TraceRecorder class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include "TraceFormat.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class TraceRecorder
+ * @brief Streams offered requests to a trace file from a background thread
+ * 
+ * The simulation thread appends records to an in-memory batch; full
+ * batches are handed to a writer thread that encodes and writes them
+ * while the next batch fills (double buffering). The simulation only
+ * waits if the writer falls a whole batch behind, so no record is ever
+ * dropped and the resulting trace replays the run exactly. Binary
+ * traces are compressed only on machines with more than one hardware
+ * thread, where the writer does not compete with the simulation.
+ */
+class TraceRecorder {
+private:
+    std::unique_ptr<TraceSink> sink;      ///< Trace file writer
+    std::vector<TraceRecord> filling;     ///< Batch being filled by record()
+    std::vector<TraceRecord> draining;    ///< Batch being written by the writer thread
+    size_t batchSize;                     ///< Records per batch
+    long long recordCount;                ///< Records accepted so far
+    std::mutex mutex;                     ///< Guards the hand-off state
+    std::condition_variable batchReady;   ///< Signalled when draining holds a batch
+    std::condition_variable batchDone;    ///< Signalled when draining has been written
+    bool batchPending;                    ///< True while the writer owns draining
+    bool stopping;                        ///< Set by close()
+    bool closed;                          ///< True once the file is finished
+    std::string error;                    ///< First writer error, if any
+    std::thread writer;                   ///< Writer thread
+
+    /**
+     * @brief Writer thread main loop
+     */
+    void writerLoop();
+
+    /**
+     * @brief Hand the filling batch to the writer thread
+     */
+    void handOff();
+
+public:
+    /**
+     * @brief Create a trace file and start the writer thread
+     * @param path Output path; ".jsonl" selects JSONL, anything else the binary format
+     * @param batchRecords Records per hand-off batch
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit TraceRecorder(const std::string& path, size_t batchRecords = 16384);
+
+    /**
+     * @brief Destructor
+     * 
+     * Finishes the trace if close() has not been called
+     */
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * @brief Record a request offered to the load balancer
+     * @param request Request as generated
+     * @param cycle Cycle at which it was offered (0 for the initial backlog)
+     */
+    void record(const Request& request, long long cycle);
+
+    /**
+     * @brief Write all buffered records and finish the trace file
+     * @throws std::runtime_error if the writer thread failed
+     */
+    void close();
+
+    /**
+     * @brief Get the number of records accepted
+     * @return Record count
+     */
+    long long getRecordCount() const;
+};
+
+#endif // TRACERECORDER_H
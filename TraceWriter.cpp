@@ -0,0 +1,268 @@
+/**
+ * @file TraceWriter.cpp
+ * @brief Implementation file for the TraceWriter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TraceWriter.h"
+#include <algorithm>
+#include <stdexcept>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Append a fixed-width little-endian integer to a buffer
+ * @param out Output buffer
+ * @param value Value to append
+ */
+template <typename T>
+void putInt(std::vector<unsigned char>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<unsigned char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * @brief Append a dictionary entry, packing IPv4 addresses when possible
+ * @param out Output buffer
+ * @param text Entry text
+ * @param tryIPv4 Whether to attempt IPv4 packing
+ */
+void putDictionaryEntry(std::vector<unsigned char>& out, const std::string& text, bool tryIPv4) {
+    uint32_t address;
+    if (tryIPv4 && packIPv4(text, address)) {
+        out.push_back(4);
+        putInt<uint32_t>(out, address);
+        return;
+    }
+    out.push_back(0);
+    appendVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+} // namespace
+
+/**
+ * @brief Create a trace file
+ * @param outputPath File to create (truncated if it exists)
+ * @param blockRecords Records per block
+ * @param compressBlocks Whether to zlib compress blocks (ignored without zlib)
+ * @throws std::runtime_error if the file cannot be created
+ */
+TraceWriter::TraceWriter(const std::string& outputPath, size_t blockRecords, bool compressBlocks)
+    : path(outputPath), recordsPerBlock(blockRecords > 0 ? blockRecords : 1),
+      compress(compressBlocks), offset(0), recordCount(0), closed(false) {
+    file.open(outputPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create trace file " + outputPath);
+    }
+    pending.reserve(recordsPerBlock);
+    size_t slots = 16;
+    while (slots < recordsPerBlock * 2) slots *= 2;
+    ipv4Slots.assign(slots, 0);
+    
+    std::vector<unsigned char> header;
+    const char magic[] = "LBTRACE1";
+    header.insert(header.end(), magic, magic + 8);
+    putInt<uint32_t>(header, FORMAT_VERSION);
+    putInt<uint32_t>(header, static_cast<uint32_t>(recordsPerBlock));
+    writeBytes(header.data(), header.size());
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Writes the footer if close() has not been called
+ */
+TraceWriter::~TraceWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Destructors must not throw; an unfinished trace has no footer
+    }
+}
+
+/**
+ * @brief Write raw bytes and advance the offset
+ * @param data Bytes to write
+ * @param size Number of bytes
+ */
+void TraceWriter::writeBytes(const void* data, size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    offset += size;
+}
+
+/**
+ * @brief Append a record
+ * @param record Record to append
+ */
+void TraceWriter::write(const TraceRecord& record) {
+    pending.push_back(record);
+    ++recordCount;
+    if (pending.size() >= recordsPerBlock) {
+        flushBlock();
+    }
+}
+
+/**
+ * @brief Get the block dictionary code of a client IP, adding it if new
+ * @param ip Client IP (must outlive the block)
+ * @return Dictionary code
+ */
+uint32_t TraceWriter::internIP(const std::string& ip) {
+    uint32_t address;
+    if (packIPv4(ip, address)) {
+        // Linear probing on the packed address avoids hashing strings
+        size_t mask = ipv4Slots.size() - 1;
+        size_t slot = static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+        while (ipv4Slots[slot] != 0) {
+            if (static_cast<uint32_t>(ipv4Slots[slot] >> 32) == address) {
+                return static_cast<uint32_t>(ipv4Slots[slot]) - 1;
+            }
+            slot = (slot + 1) & mask;
+        }
+        uint32_t code = static_cast<uint32_t>(ipList.size());
+        ipv4Slots[slot] = (static_cast<uint64_t>(address) << 32) | (code + 1);
+        ipList.push_back(&ip);
+        return code;
+    }
+    
+    auto entry = ipCodes.emplace(ip, static_cast<uint32_t>(ipList.size()));
+    if (entry.second) ipList.push_back(&ip);
+    return entry.first->second;
+}
+
+/**
+ * @brief Get the block dictionary code of a request type, adding it if new
+ * @param type Request type (must outlive the block)
+ * @return Dictionary code
+ */
+uint32_t TraceWriter::internType(const std::string& type) {
+    // Traces have a handful of types, so a short scan beats hashing
+    const size_t scanLimit = 8;
+    for (size_t i = 0; i < typeList.size() && i < scanLimit; ++i) {
+        if (*typeList[i] == type) return static_cast<uint32_t>(i);
+    }
+    if (typeList.size() < scanLimit) {
+        typeList.push_back(&type);
+        return static_cast<uint32_t>(typeList.size() - 1);
+    }
+    auto entry = typeCodes.emplace(type, static_cast<uint32_t>(typeList.size()));
+    if (entry.second) typeList.push_back(&type);
+    return entry.first->second;
+}
+
+/**
+ * @brief Encode and write the pending block
+ */
+void TraceWriter::flushBlock() {
+    if (pending.empty()) {
+        return;
+    }
+    
+    // Encode records first so the dictionaries are complete
+    std::fill(ipv4Slots.begin(), ipv4Slots.end(), 0);
+    ipCodes.clear();
+    typeCodes.clear();
+    ipList.clear();
+    typeList.clear();
+    records.clear();
+    long long previousCycle = 0;
+    long long previousID = 0;
+    for (const auto& record : pending) {
+        appendSignedVarint(records, record.cycle - previousCycle);
+        appendSignedVarint(records, record.requestID - previousID);
+        appendVarint(records, internIP(record.clientIP));
+        appendVarint(records, internType(record.requestType));
+        appendSignedVarint(records, record.priority);
+        appendSignedVarint(records, record.serviceTime);
+        previousCycle = record.cycle;
+        previousID = record.requestID;
+    }
+    
+    payload.clear();
+    appendVarint(payload, pending.size());
+    appendVarint(payload, ipList.size());
+    for (const auto* ip : ipList) putDictionaryEntry(payload, *ip, true);
+    appendVarint(payload, typeList.size());
+    for (const auto* type : typeList) putDictionaryEntry(payload, *type, false);
+    payload.insert(payload.end(), records.begin(), records.end());
+    
+    const unsigned char* body = payload.data();
+    size_t bodySize = payload.size();
+    uint8_t codec = CODEC_RAW;
+#ifdef HAVE_ZLIB
+    if (compress) {
+        uLongf compressedSize = compressBound(static_cast<uLong>(payload.size()));
+        stored.resize(compressedSize);
+        if (compress2(stored.data(), &compressedSize, payload.data(),
+                      static_cast<uLong>(payload.size()), Z_BEST_SPEED) == Z_OK &&
+            compressedSize < payload.size()) {
+            body = stored.data();
+            bodySize = compressedSize;
+            codec = CODEC_ZLIB;
+        }
+    }
+#endif
+    
+    index.push_back({offset, pending.front().cycle, pending.size()});
+    std::vector<unsigned char> blockHeader;
+    putInt<uint32_t>(blockHeader, static_cast<uint32_t>(payload.size()));
+    putInt<uint32_t>(blockHeader, static_cast<uint32_t>(bodySize));
+    blockHeader.push_back(codec);
+    writeBytes(blockHeader.data(), blockHeader.size());
+    writeBytes(body, bodySize);
+    pending.clear();
+}
+
+/**
+ * @brief Flush the last block and write the footer index
+ * @throws std::runtime_error if writing fails
+ */
+void TraceWriter::close() {
+    if (closed) {
+        return;
+    }
+    closed = true;
+    flushBlock();
+    
+    uint64_t indexOffset = offset;
+    std::vector<unsigned char> footer;
+    for (const auto& entry : index) {
+        putInt<uint64_t>(footer, entry.offset);
+        putInt<int64_t>(footer, entry.firstCycle);
+        putInt<uint64_t>(footer, entry.recordCount);
+    }
+    putInt<uint64_t>(footer, indexOffset);
+    putInt<uint64_t>(footer, index.size());
+    putInt<uint64_t>(footer, static_cast<uint64_t>(recordCount));
+    const char magic[] = "LBTRIDX1";
+    footer.insert(footer.end(), magic, magic + 8);
+    writeBytes(footer.data(), footer.size());
+    
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed writing trace file " + path);
+    }
+}
+
+/**
+ * @brief Get the number of records written
+ * @return Record count
+ */
+long long TraceWriter::getRecordCount() const {
+    return recordCount;
+}
+
+/**
+ * @brief Get the number of bytes written
+ * @return File size so far
+ */
+uint64_t TraceWriter::getBytesWritten() const {
+    return offset;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file TraceWriter.h
+ * @brief Header file for the TraceWriter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef TRACEWRITER_H
+#define TRACEWRITER_H
+
+#include "TraceFormat.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TraceWriter
+ * @brief Writes request traces in the compact binary trace format
+ * 
+ * Records are grouped into self-contained blocks. Within a block, cycles
+ * and request IDs are stored as zigzag varint deltas, and client IPs and
+ * request types are replaced by indices into a per-block dictionary (IPv4
+ * addresses are stored as four raw bytes). Each block is optionally zlib
+ * compressed. A footer index records the file offset and first cycle of
+ * every block so readers can seek without decoding the whole trace.
+ * 
+ * File layout (little-endian):
+ *   header:  "LBTRACE1", u32 version, u32 records per block
+ *   block:   u32 encoded size, u32 stored size, u8 codec, payload
+ *   index:   per block u64 offset, i64 first cycle, u64 record count
+ *   trailer: u64 index offset, u64 block count, u64 record count, "LBTRIDX1"
+ */
+class TraceWriter : public TraceSink {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;      ///< Binary format version
+    static constexpr uint8_t CODEC_RAW = 0;            ///< Block stored uncompressed
+    static constexpr uint8_t CODEC_ZLIB = 1;           ///< Block stored zlib compressed
+
+private:
+    /**
+     * @struct BlockEntry
+     * @brief Footer index entry for one block
+     */
+    struct BlockEntry {
+        uint64_t offset;       ///< File offset of the block header
+        long long firstCycle;  ///< Cycle of the block's first record
+        uint64_t recordCount;  ///< Records in the block
+    };
+
+    std::ofstream file;                                 ///< Output file
+    std::string path;                                   ///< Output file path
+    size_t recordsPerBlock;                             ///< Records per block
+    bool compress;                                      ///< Whether to compress blocks
+    uint64_t offset;                                    ///< Bytes written so far
+    long long recordCount;                              ///< Records written so far
+    bool closed;                                        ///< True once the footer is written
+    std::vector<TraceRecord> pending;                   ///< Records of the current block
+    std::vector<BlockEntry> index;                      ///< Footer index
+    std::vector<unsigned char> payload;                 ///< Scratch for encoded blocks
+    std::vector<unsigned char> records;                 ///< Scratch for encoded records
+    std::vector<unsigned char> stored;                  ///< Scratch for compressed blocks
+    std::vector<uint64_t> ipv4Slots;                    ///< Open-addressed IPv4 dictionary (address, code + 1)
+    std::unordered_map<std::string, uint32_t> ipCodes;    ///< Dictionary for non-IPv4 addresses
+    std::unordered_map<std::string, uint32_t> typeCodes;  ///< Dictionary for uncommon request types
+    std::vector<const std::string*> ipList;             ///< Block IP dictionary in code order
+    std::vector<const std::string*> typeList;           ///< Block type dictionary in code order
+
+    /**
+     * @brief Get the block dictionary code of a client IP, adding it if new
+     * @param ip Client IP (must outlive the block)
+     * @return Dictionary code
+     */
+    uint32_t internIP(const std::string& ip);
+
+    /**
+     * @brief Get the block dictionary code of a request type, adding it if new
+     * @param type Request type (must outlive the block)
+     * @return Dictionary code
+     */
+    uint32_t internType(const std::string& type);
+
+    /**
+     * @brief Encode and write the pending block
+     */
+    void flushBlock();
+
+    /**
+     * @brief Write raw bytes and advance the offset
+     * @param data Bytes to write
+     * @param size Number of bytes
+     */
+    void writeBytes(const void* data, size_t size);
+
+public:
+    /**
+     * @brief Create a trace file
+     * @param outputPath File to create (truncated if it exists)
+     * @param blockRecords Records per block
+     * @param compressBlocks Whether to zlib compress blocks (ignored without zlib)
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit TraceWriter(const std::string& outputPath, size_t blockRecords = 65536,
+                         bool compressBlocks = true);
+
+    /**
+     * @brief Destructor
+     * 
+     * Writes the footer if close() has not been called
+     */
+    ~TraceWriter() override;
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief Append a record
+     * @param record Record to append
+     */
+    void write(const TraceRecord& record) override;
+
+    /**
+     * @brief Flush the last block and write the footer index
+     * @throws std::runtime_error if writing fails
+     */
+    void close() override;
+
+    /**
+     * @brief Get the number of records written
+     * @return Record count
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Get the number of bytes written
+     * @return File size so far
+     */
+    uint64_t getBytesWritten() const;
+};
+
+#endif // TRACEWRITER_H
@@ -8,6 +8,7 @@
 
 #include "WebServer.h"
 #include <algorithm>
+#include <utility>
 
 /**
  * @brief Default constructor
@@ -92,7 +93,7 @@ bool WebServer::getIsActive() const {
  * @brief Get total requests processed
  * @return Total number of requests processed
  */
-int WebServer::getTotalRequestsProcessed() const {
+long long WebServer::getTotalRequestsProcessed() const {
     return totalRequestsProcessed;
 }
 
@@ -100,7 +101,7 @@ int WebServer::getTotalRequestsProcessed() const {
  * @brief Get total processing time
  * @return Total processing time used
  */
-int WebServer::getTotalProcessingTime() const {
+long long WebServer::getTotalProcessingTime() const {
     return totalProcessingTime;
 }
 
@@ -129,19 +130,21 @@ bool WebServer::addRequest(const Request& request) {
 
 /**
  * @brief Process one clock cycle of requests
+ * @param completed Optional output vector receiving the requests completed this cycle
  * @return Number of requests completed in this cycle
  */
-int WebServer::processCycle() {
+int WebServer::processCycle(std::vector<Request>* completed) {
     if (!isActive || requestQueue.empty()) {
         return 0;
     }
     
     int completedRequests = 0;
-    std::queue<Request> tempQueue;
     
-    // Process each request in the queue
-    while (!requestQueue.empty()) {
-        Request currentRequest = requestQueue.front();
+    // Rotate through the queue once: finished requests leave, the rest
+    // go back to the end in their original order
+    size_t pending = requestQueue.size();
+    for (size_t i = 0; i < pending; ++i) {
+        Request currentRequest = std::move(requestQueue.front());
         requestQueue.pop();
         
         // Decrease processing time by 1 cycle
@@ -151,18 +154,18 @@ int WebServer::processCycle() {
             // Request completed
             completedRequests++;
             totalRequestsProcessed++;
-            totalProcessingTime += currentRequest.getProcessingTime();
+            totalProcessingTime += currentRequest.getServiceTime();
             currentLoad--;
+            if (completed) {
+                completed->push_back(std::move(currentRequest));
+            }
         } else {
             // Request still needs more processing time
             currentRequest.setProcessingTime(remainingTime);
-            tempQueue.push(currentRequest);
+            requestQueue.push(std::move(currentRequest));
         }
     }
     
-    // Restore requests that still need processing
-    requestQueue = tempQueue;
-    
     return completedRequests;
 }
 
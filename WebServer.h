@@ -12,6 +12,7 @@
 #include "Request.h"
 #include <queue>
 #include <string>
+#include <vector>
 
 /**
  * @class WebServer
@@ -29,8 +30,8 @@ private:
     int currentLoad;                 ///< Current number of requests being processed
     std::queue<Request> requestQueue; ///< Queue of requests waiting to be processed
     bool isActive;                   ///< Whether the server is active/online
-    int totalRequestsProcessed;      ///< Total number of requests processed by this server
-    int totalProcessingTime;         ///< Total processing time used by this server
+    long long totalRequestsProcessed; ///< Total number of requests processed by this server
+    long long totalProcessingTime;   ///< Total processing time used by this server
 
 public:
     /**
@@ -91,13 +92,13 @@ public:
      * @brief Get total requests processed
      * @return Total number of requests processed
      */
-    int getTotalRequestsProcessed() const;
+    long long getTotalRequestsProcessed() const;
 
     /**
      * @brief Get total processing time
      * @return Total processing time used
      */
-    int getTotalProcessingTime() const;
+    long long getTotalProcessingTime() const;
 
     /**
      * @brief Set the server active status
@@ -114,9 +115,10 @@ public:
 
     /**
      * @brief Process one clock cycle of requests
+     * @param completed Optional output vector receiving the requests completed this cycle
      * @return Number of requests completed in this cycle
      */
-    int processCycle();
+    int processCycle(std::vector<Request>* completed = nullptr);
 
     /**
      * @brief Check if server can accept new requests
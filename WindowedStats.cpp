@@ -0,0 +1,95 @@
+/**
+ * @file WindowedStats.cpp
+ * @brief Implementation file for the WindowedStats class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "WindowedStats.h"
+#include <algorithm>
+
+/**
+ * @brief Parameterized constructor
+ * @param maxWindowCount Maximum number of windows kept
+ * @param initialWindowLength Cycles per window before any coarsening
+ */
+WindowedStats::WindowedStats(size_t maxWindowCount, long long initialWindowLength)
+    : maxWindows(std::max<size_t>(2, maxWindowCount & ~static_cast<size_t>(1))),
+      windowLength(std::max(1LL, initialWindowLength)), lastProcessed(0), lastRejected(0),
+      lastLatency(0) {
+    windows.reserve(maxWindows);
+}
+
+/**
+ * @brief Merge adjacent windows pairwise and double the window length
+ */
+void WindowedStats::coarsen() {
+    size_t merged = 0;
+    for (size_t i = 0; i < windows.size(); i += 2) {
+        StatsWindow window = windows[i];
+        if (i + 1 < windows.size()) {
+            const StatsWindow& next = windows[i + 1];
+            window.cycles += next.cycles;
+            window.completed += next.completed;
+            window.rejected += next.rejected;
+            window.latencySum += next.latencySum;
+            window.maxQueueSize = std::max(window.maxQueueSize, next.maxQueueSize);
+            window.utilizationSum += next.utilizationSum;
+            window.serverSum += next.serverSum;
+        }
+        windows[merged++] = window;
+    }
+    windows.resize(merged);
+    windowLength *= 2;
+}
+
+/**
+ * @brief Record the state of a load balancer after it processed a cycle
+ * @param loadBalancer Load balancer to sample
+ */
+void WindowedStats::recordCycle(const LoadBalancer& loadBalancer) {
+    if (windows.empty() || windows.back().cycles >= windowLength) {
+        if (windows.size() >= maxWindows) {
+            coarsen();
+        }
+        if (windows.empty() || windows.back().cycles >= windowLength) {
+            StatsWindow window;
+            window.startCycle = loadBalancer.getCurrentCycle();
+            windows.push_back(window);
+        }
+    }
+    
+    long long processed = loadBalancer.getTotalRequestsProcessed();
+    long long rejected = loadBalancer.getTotalRequestsRejected();
+    long long latency = loadBalancer.getTotalLatency();
+    
+    StatsWindow& window = windows.back();
+    window.cycles++;
+    window.completed += processed - lastProcessed;
+    window.rejected += rejected - lastRejected;
+    window.latencySum += latency - lastLatency;
+    window.maxQueueSize = std::max(window.maxQueueSize, loadBalancer.getQueueSize());
+    window.utilizationSum += loadBalancer.getSystemUtilization();
+    window.serverSum += loadBalancer.getActiveServerCount();
+    
+    lastProcessed = processed;
+    lastRejected = rejected;
+    lastLatency = latency;
+}
+
+/**
+ * @brief Get the windows in cycle order
+ * @return Windows
+ */
+const std::vector<StatsWindow>& WindowedStats::getWindows() const {
+    return windows;
+}
+
+/**
+ * @brief Get the current window length
+ * @return Cycles per window
+ */
+long long WindowedStats::getWindowLength() const {
+    return windowLength;
+}
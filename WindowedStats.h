@@ -0,0 +1,81 @@
+/**
+ * @file WindowedStats.h
+ * @brief Header file for the WindowedStats class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef WINDOWEDSTATS_H
+#define WINDOWEDSTATS_H
+
+#include "LoadBalancer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct StatsWindow
+ * @brief Aggregated statistics for a contiguous range of cycles
+ */
+struct StatsWindow {
+    long long startCycle = 0;      ///< First cycle in the window
+    long long cycles = 0;          ///< Number of cycles aggregated
+    long long completed = 0;       ///< Requests completed in the window
+    long long rejected = 0;        ///< Requests rejected in the window
+    long long latencySum = 0;      ///< Sum of latencies of requests completed in the window
+    int maxQueueSize = 0;          ///< Largest queue size seen
+    double utilizationSum = 0.0;   ///< Sum of per-cycle system utilization
+    double serverSum = 0.0;        ///< Sum of per-cycle active server counts
+};
+
+/**
+ * @class WindowedStats
+ * @brief Time-windowed run statistics in constant memory
+ * 
+ * Cycles are aggregated into fixed-length windows. When the window limit
+ * is reached, adjacent windows are merged pairwise and the window length
+ * doubles, so any run length is covered end to end by at most the
+ * configured number of windows.
+ */
+class WindowedStats {
+private:
+    std::vector<StatsWindow> windows; ///< Windows in cycle order
+    size_t maxWindows;                ///< Window limit (even, at least 2)
+    long long windowLength;           ///< Cycles per window
+    long long lastProcessed;          ///< Processed counter at the previous cycle
+    long long lastRejected;           ///< Rejected counter at the previous cycle
+    long long lastLatency;            ///< Latency sum at the previous cycle
+
+    /**
+     * @brief Merge adjacent windows pairwise and double the window length
+     */
+    void coarsen();
+
+public:
+    /**
+     * @brief Parameterized constructor
+     * @param maxWindowCount Maximum number of windows kept
+     * @param initialWindowLength Cycles per window before any coarsening
+     */
+    WindowedStats(size_t maxWindowCount = 64, long long initialWindowLength = 100);
+
+    /**
+     * @brief Record the state of a load balancer after it processed a cycle
+     * @param loadBalancer Load balancer to sample
+     */
+    void recordCycle(const LoadBalancer& loadBalancer);
+
+    /**
+     * @brief Get the windows in cycle order
+     * @return Windows
+     */
+    const std::vector<StatsWindow>& getWindows() const;
+
+    /**
+     * @brief Get the current window length
+     * @return Cycles per window
+     */
+    long long getWindowLength() const;
+};
+
+#endif // WINDOWEDSTATS_H
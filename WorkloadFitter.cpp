@@ -0,0 +1,239 @@
+/**
+ * @file WorkloadFitter.cpp
+ * @brief Implementation file for the WorkloadFitter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "WorkloadFitter.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Default constructor
+ */
+WorkloadFitter::WorkloadFitter()
+    : binWidth(1), records(0), initialRecords(0), ipv6Records(0), lastCycle(0), minPriority(INT_MAX),
+      maxPriority(INT_MIN), topClients(1024) {
+}
+
+/**
+ * @brief Consume one trace record
+ * @param record Record to add
+ */
+void WorkloadFitter::add(const TraceRecord& record) {
+    records++;
+    minPriority = std::min(minPriority, record.priority);
+    maxPriority = std::max(maxPriority, record.priority);
+    clients.add(record.clientIP);
+    topClients.add(record.clientIP);
+    if (record.clientIP.find(':') != std::string::npos) {
+        ipv6Records++;
+    }
+    
+    TypeSummary* summary = nullptr;
+    for (auto& type : types) {
+        if (type.name == record.requestType) {
+            summary = &type;
+            break;
+        }
+    }
+    if (summary == nullptr) {
+        if (types.size() < MAX_TYPES - 1) {
+            types.push_back(TypeSummary());
+            types.back().name = record.requestType;
+            summary = &types.back();
+        } else {
+            if (types.size() < MAX_TYPES) {
+                types.push_back(TypeSummary());
+                types.back().name = "OTHER";
+            }
+            summary = &types.back();
+        }
+    }
+    summary->count++;
+    summary->service.record(std::max(1, record.serviceTime));
+    
+    if (record.cycle <= 0) {
+        initialRecords++;
+        return;
+    }
+    lastCycle = std::max(lastCycle, record.cycle);
+    size_t bin = static_cast<size_t>((record.cycle - 1) / binWidth);
+    while (bin >= MAX_CURVE_POINTS) {
+        // Halve the resolution: merge neighbouring bins and double the width
+        for (size_t i = 0; i < arrivalBins.size(); i += 2) {
+            long long merged = arrivalBins[i] + (i + 1 < arrivalBins.size() ? arrivalBins[i + 1] : 0);
+            arrivalBins[i / 2] = merged;
+        }
+        arrivalBins.resize((arrivalBins.size() + 1) / 2);
+        binWidth *= 2;
+        bin = static_cast<size_t>((record.cycle - 1) / binWidth);
+    }
+    if (bin >= arrivalBins.size()) {
+        arrivalBins.resize(bin + 1, 0);
+    }
+    arrivalBins[bin]++;
+}
+
+/**
+ * @brief Fit the Zipf exponent of client popularity
+ * @return Exponent, 0 if there is no measurable skew
+ */
+double WorkloadFitter::fitClientSkew() const {
+    // Use ranks whose counts are nearly exact and well above sampling noise
+    std::vector<HeavyHitters::Entry> top = topClients.getTop();
+    std::vector<double> logRank;
+    std::vector<double> logCount;
+    for (size_t i = 0; i < top.size(); ++i) {
+        long long guaranteed = top[i].count - top[i].error;
+        if (guaranteed < 20 || top[i].error * 10 > top[i].count) break;
+        logRank.push_back(std::log(static_cast<double>(i + 1)));
+        logCount.push_back(std::log(static_cast<double>(guaranteed)));
+    }
+    if (logRank.size() < 3) {
+        return 0.0;
+    }
+    
+    double n = static_cast<double>(logRank.size());
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (size_t i = 0; i < logRank.size(); ++i) {
+        meanX += logRank[i] / n;
+        meanY += logCount[i] / n;
+    }
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (size_t i = 0; i < logRank.size(); ++i) {
+        covariance += (logRank[i] - meanX) * (logCount[i] - meanY);
+        variance += (logRank[i] - meanX) * (logRank[i] - meanX);
+    }
+    return variance > 0 ? std::max(0.0, -covariance / variance) : 0.0;
+}
+
+/**
+ * @brief Build generator parameters reproducing the trace
+ * @return Fitted workload parameters
+ */
+WorkloadParams WorkloadFitter::fit() const {
+    WorkloadParams workload;
+    long long arrivals = records - initialRecords;
+    workload.arrivalRate = lastCycle > 0 ? static_cast<double>(arrivals) / lastCycle : 0.0;
+    
+    // Rates per bin relative to the mean; the last bin may be partial
+    if (workload.arrivalRate > 0 && arrivalBins.size() > 1) {
+        double chiSquare = 0.0;
+        for (size_t i = 0; i < arrivalBins.size(); ++i) {
+            long long width = std::min(binWidth, lastCycle - static_cast<long long>(i) * binWidth);
+            double rate = width > 0 ? static_cast<double>(arrivalBins[i]) / width : 0.0;
+            double expected = workload.arrivalRate * width;
+            if (expected > 0) {
+                chiSquare += (arrivalBins[i] - expected) * (arrivalBins[i] - expected) / expected;
+            }
+            workload.arrivalCurve.push_back(rate / workload.arrivalRate);
+        }
+        
+        // Keep the curve only if the variation exceeds Poisson counting noise
+        double freedom = static_cast<double>(arrivalBins.size() - 1);
+        if (chiSquare <= freedom + 3.0 * std::sqrt(2.0 * freedom)) {
+            workload.arrivalCurve.clear();
+        } else {
+            workload.curvePeriod = binWidth;
+        }
+    }
+    
+    if (records > 0) {
+        workload.minPriority = minPriority;
+        workload.maxPriority = maxPriority;
+    }
+    
+    int minService = INT_MAX;
+    int maxService = 0;
+    for (const auto& type : types) {
+        RequestTypeProfile profile;
+        profile.name = type.name;
+        profile.weight = static_cast<double>(type.count) / records;
+        for (int i = 0; i < QUANTILE_POINTS; ++i) {
+            double percentile = 100.0 * i / (QUANTILE_POINTS - 1);
+            int value = static_cast<int>(i == 0 ? type.service.getMin() : type.service.getPercentile(percentile));
+            profile.serviceQuantiles.push_back(value);
+        }
+        minService = std::min(minService, profile.serviceQuantiles.front());
+        maxService = std::max(maxService, profile.serviceQuantiles.back());
+        workload.requestTypes.push_back(profile);
+    }
+    if (!types.empty()) {
+        workload.minProcessingTime = minService;
+        workload.maxProcessingTime = maxService;
+    }
+    
+    // Nearly all-distinct clients are better modelled as random addresses
+    double distinct = clients.estimate();
+    if (records > 0 && distinct < 0.9 * records) {
+        workload.clientCount = static_cast<int>(std::min(distinct, static_cast<double>(INT_MAX)));
+        workload.clientSkew = fitClientSkew();
+    }
+    workload.ipv6Share = records > 0 ? static_cast<double>(ipv6Records) / records : 0.0;
+    return workload;
+}
+
+/**
+ * @brief Get the number of initial-backlog records (cycle <= 0)
+ * @return Backlog size
+ */
+long long WorkloadFitter::getInitialBacklog() const {
+    return initialRecords;
+}
+
+/**
+ * @brief Get a human-readable summary of the fit
+ * @return Report lines, suitable as config comments
+ */
+std::vector<std::string> WorkloadFitter::getReport() const {
+    WorkloadParams workload = fit();
+    std::vector<std::string> lines;
+    std::stringstream line;
+    line << std::fixed << std::setprecision(4);
+    
+    line << "Records: " << records << " (" << initialRecords << " initial backlog, "
+         << records - initialRecords << " arrivals over " << lastCycle << " cycles)";
+    lines.push_back(line.str());
+    line.str("");
+    
+    double peak = 0.0;
+    for (double point : workload.arrivalCurve) peak = std::max(peak, point);
+    line << "Arrival rate: " << workload.arrivalRate << " per cycle";
+    if (workload.arrivalCurve.empty()) {
+        line << ", constant (variation within counting noise)";
+    } else {
+        line << ", curve of " << workload.arrivalCurve.size() << " points x " << workload.curvePeriod
+             << " cycles, peak/mean " << std::setprecision(2) << peak << std::setprecision(4);
+    }
+    lines.push_back(line.str());
+    line.str("");
+    
+    for (const auto& type : types) {
+        line << "Type " << std::left << std::setw(8) << type.name << std::right << std::setprecision(1)
+             << " share " << std::setw(5) << 100.0 * type.count / records << "%, service mean "
+             << std::setw(6) << type.service.getMean() << ", p50 " << type.service.getPercentile(50)
+             << ", p99 " << type.service.getPercentile(99) << ", max " << type.service.getMax();
+        lines.push_back(line.str());
+        line.str("");
+    }
+    
+    line << "Clients: ~" << std::setprecision(0) << clients.estimate() << " distinct";
+    if (workload.clientCount > 0) {
+        line << ", Zipf skew " << std::setprecision(3) << workload.clientSkew;
+    } else {
+        line << ", modelled as random addresses";
+    }
+    if (ipv6Records > 0) {
+        line << ", " << std::setprecision(1) << 100.0 * ipv6Records / records << "% IPv6";
+    }
+    lines.push_back(line.str());
+    return lines;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file WorkloadFitter.h
+ * @brief Header file for the WorkloadFitter class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef WORKLOADFITTER_H
+#define WORKLOADFITTER_H
+
+#include "TraceFormat.h"
+#include "WorkloadGenerator.h"
+#include "LatencyHistogram.h"
+#include "StreamingSketches.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class WorkloadFitter
+ * @brief Derives workload generator parameters from a request trace
+ * 
+ * Records are consumed one at a time and only fixed-size summaries are
+ * kept, so memory does not grow with the trace:
+ * - arrivals are counted in at most MAX_CURVE_POINTS time bins whose width
+ *   doubles (merging neighbours) as the trace gets longer; the bins become
+ *   an arrival curve unless a chi-square test finds them flat;
+ * - each request type keeps a log-bucketed service-time histogram, from
+ *   which evenly spaced quantiles are read;
+ * - client popularity uses a HyperLogLog distinct count and a Space-Saving
+ *   summary of the most frequent clients, and the Zipf exponent is the
+ *   least-squares slope of log frequency against log rank.
+ * Records at cycle 0 or earlier are counted as the initial backlog rather
+ * than as arrivals.
+ */
+class WorkloadFitter {
+public:
+    static constexpr size_t MAX_CURVE_POINTS = 128;  ///< Upper bound on arrival bins
+    static constexpr size_t MAX_TYPES = 32;          ///< Further types are merged into OTHER
+    static constexpr int QUANTILE_POINTS = 101;      ///< Service-time quantiles per type (every 1%)
+
+private:
+    /**
+     * @struct TypeSummary
+     * @brief Service-time summary of one request type
+     */
+    struct TypeSummary {
+        std::string name;          ///< Request type
+        long long count = 0;       ///< Requests of this type
+        LatencyHistogram service;  ///< Service-time distribution
+    };
+
+    std::vector<long long> arrivalBins;  ///< Arrivals per bin
+    long long binWidth;                  ///< Cycles per bin
+    long long records;                   ///< Records seen
+    long long initialRecords;            ///< Records at cycle <= 0
+    long long ipv6Records;               ///< Records from IPv6 clients
+    long long lastCycle;                 ///< Latest arrival cycle seen
+    int minPriority;                     ///< Smallest priority seen
+    int maxPriority;                     ///< Largest priority seen
+    std::vector<TypeSummary> types;      ///< Per-type summaries
+    DistinctCounter clients;             ///< Distinct client estimate
+    HeavyHitters topClients;             ///< Most frequent clients
+
+    /**
+     * @brief Fit the Zipf exponent of client popularity
+     * @return Exponent, 0 if there is no measurable skew
+     */
+    double fitClientSkew() const;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    WorkloadFitter();
+
+    /**
+     * @brief Consume one trace record
+     * @param record Record to add
+     */
+    void add(const TraceRecord& record);
+
+    /**
+     * @brief Build generator parameters reproducing the trace
+     * @return Fitted workload parameters
+     */
+    WorkloadParams fit() const;
+
+    /**
+     * @brief Get the number of initial-backlog records (cycle <= 0)
+     * @return Backlog size
+     */
+    long long getInitialBacklog() const;
+
+    /**
+     * @brief Get a human-readable summary of the fit
+     * @return Report lines, suitable as config comments
+     */
+    std::vector<std::string> getReport() const;
+};
+
+#endif // WORKLOADFITTER_H
@@ -0,0 +1,468 @@
+/**
+ * @file WorkloadGenerator.cpp
+ * @brief Implementation file for the WorkloadGenerator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief log1p(x) / x, accurate near zero
+ * @param x Argument
+ * @return Value of the helper
+ */
+double log1pOverX(double x) {
+    if (std::fabs(x) > 1e-8) return std::log1p(x) / x;
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+/**
+ * @brief expm1(x) / x, accurate near zero
+ * @param x Argument
+ * @return Value of the helper
+ */
+double expm1OverX(double x) {
+    if (std::fabs(x) > 1e-8) return std::expm1(x) / x;
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+/**
+ * @brief Integral of the Zipf hat function x^-s
+ * @param x Upper limit
+ * @param s Zipf exponent
+ * @return H(x)
+ */
+double zipfIntegral(double x, double s) {
+    double logX = std::log(x);
+    return expm1OverX((1.0 - s) * logX) * logX;
+}
+
+/**
+ * @brief Inverse of zipfIntegral()
+ * @param x Integral value
+ * @param s Zipf exponent
+ * @return H^-1(x)
+ */
+double zipfIntegralInverse(double x, double s) {
+    double t = std::max(-1.0, x * (1.0 - s));
+    return std::exp(log1pOverX(t) * x);
+}
+
+/**
+ * @brief Mean of the piecewise-linear distribution defined by a quantile table
+ * @param quantiles Evenly spaced quantiles
+ * @return Mean value
+ */
+double quantileTableMean(const std::vector<int>& quantiles) {
+    if (quantiles.size() == 1) return quantiles[0];
+    double sum = 0.0;
+    for (size_t i = 0; i + 1 < quantiles.size(); ++i) {
+        sum += (quantiles[i] + quantiles[i + 1]) / 2.0;
+    }
+    return sum / (quantiles.size() - 1);
+}
+
+/**
+ * @brief CDF of the piecewise-linear distribution defined by a quantile table
+ * @param quantiles Evenly spaced quantiles
+ * @param x Value
+ * @return P(X <= x)
+ */
+double quantileTableCdf(const std::vector<int>& quantiles, double x) {
+    if (x < quantiles.front()) return 0.0;
+    if (x >= quantiles.back()) return 1.0;
+    size_t segment = static_cast<size_t>(
+        std::upper_bound(quantiles.begin(), quantiles.end(), x) - quantiles.begin()) - 1;
+    double low = quantiles[segment];
+    double high = quantiles[segment + 1];
+    double within = high > low ? (x - low) / (high - low) : 1.0;
+    return (segment + within) / (quantiles.size() - 1);
+}
+
+/**
+ * @brief Parse a comma-separated list of numbers
+ * @param text List text
+ * @return Parsed values
+ */
+std::vector<double> parseNumberList(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.find_first_not_of(" \t") != std::string::npos) {
+            values.push_back(std::stod(item));
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+/**
+ * @brief Get the mean service time
+ * @return Mean cycles per request
+ */
+double WorkloadParams::meanServiceTime() const {
+    if (requestTypes.empty()) {
+        return (minProcessingTime + maxProcessingTime) / 2.0;
+    }
+    double weighted = 0.0;
+    double totalWeight = 0.0;
+    for (const auto& type : requestTypes) {
+        weighted += type.weight * quantileTableMean(type.serviceQuantiles);
+        totalWeight += type.weight;
+    }
+    return totalWeight > 0 ? weighted / totalWeight : 0.0;
+}
+
+/**
+ * @brief Get a service-time quantile
+ * @param fraction Quantile in [0, 1]
+ * @return Service time in cycles
+ */
+double WorkloadParams::serviceTimeQuantile(double fraction) const {
+    fraction = std::min(1.0, std::max(0.0, fraction));
+    if (requestTypes.empty()) {
+        return minProcessingTime + fraction * (maxProcessingTime - minProcessingTime);
+    }
+    
+    // Invert the mixture CDF by bisection
+    double low = requestTypes.front().serviceQuantiles.front();
+    double high = requestTypes.front().serviceQuantiles.back();
+    double totalWeight = 0.0;
+    for (const auto& type : requestTypes) {
+        low = std::min(low, static_cast<double>(type.serviceQuantiles.front()));
+        high = std::max(high, static_cast<double>(type.serviceQuantiles.back()));
+        totalWeight += type.weight;
+    }
+    for (int i = 0; i < 60 && high - low > 1e-6; ++i) {
+        double middle = (low + high) / 2.0;
+        double cdf = 0.0;
+        for (const auto& type : requestTypes) {
+            cdf += type.weight * quantileTableCdf(type.serviceQuantiles, middle);
+        }
+        if (cdf / totalWeight < fraction) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return high;
+}
+
+/**
+ * @brief Write workload parameters as a generator config
+ * @param out Output stream
+ * @param workload Parameters to write
+ */
+void writeWorkloadParams(std::ostream& out, const WorkloadParams& workload) {
+    out << "arrival_rate = " << workload.arrivalRate << "\n";
+    out << "min_service = " << workload.minProcessingTime << "\n";
+    out << "max_service = " << workload.maxProcessingTime << "\n";
+    out << "min_priority = " << workload.minPriority << "\n";
+    out << "max_priority = " << workload.maxPriority << "\n";
+    if (!workload.arrivalCurve.empty()) {
+        out << "arrival_period = " << workload.curvePeriod << "\n";
+        out << "arrival_curve = ";
+        for (size_t i = 0; i < workload.arrivalCurve.size(); ++i) {
+            out << (i > 0 ? "," : "") << workload.arrivalCurve[i];
+        }
+        out << "\n";
+    }
+    out << "client_count = " << workload.clientCount << "\n";
+    out << "client_skew = " << workload.clientSkew << "\n";
+    out << "ipv6_share = " << workload.ipv6Share << "\n";
+    for (const auto& type : workload.requestTypes) {
+        out << "type = " << type.name << " " << type.weight << " ";
+        for (size_t i = 0; i < type.serviceQuantiles.size(); ++i) {
+            out << (i > 0 ? "," : "") << type.serviceQuantiles[i];
+        }
+        out << "\n";
+    }
+}
+
+/**
+ * @brief Read workload parameters from a generator config
+ * @param path Config file written by writeWorkloadParams() or by hand
+ * @return Parameters; settings missing from the file keep their defaults
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+WorkloadParams readWorkloadParams(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open workload config " + path);
+    }
+    
+    WorkloadParams workload;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        size_t equals = line.find('=');
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        const std::string where = path + ":" + std::to_string(lineNumber);
+        if (equals == std::string::npos) {
+            throw std::runtime_error(where + ": expected key = value");
+        }
+        
+        std::string key;
+        std::stringstream(line.substr(0, equals)) >> key;
+        std::string value = line.substr(equals + 1);
+        try {
+            if (key == "arrival_rate") workload.arrivalRate = std::stod(value);
+            else if (key == "min_service") workload.minProcessingTime = std::stoi(value);
+            else if (key == "max_service") workload.maxProcessingTime = std::stoi(value);
+            else if (key == "min_priority") workload.minPriority = std::stoi(value);
+            else if (key == "max_priority") workload.maxPriority = std::stoi(value);
+            else if (key == "arrival_period") workload.curvePeriod = std::stoll(value);
+            else if (key == "arrival_curve") workload.arrivalCurve = parseNumberList(value);
+            else if (key == "client_count") workload.clientCount = std::stoi(value);
+            else if (key == "client_skew") workload.clientSkew = std::stod(value);
+            else if (key == "ipv6_share") workload.ipv6Share = std::stod(value);
+            else if (key == "type") {
+                RequestTypeProfile profile;
+                std::string quantiles;
+                std::stringstream(value) >> profile.name >> profile.weight >> quantiles;
+                for (double quantile : parseNumberList(quantiles)) {
+                    profile.serviceQuantiles.push_back(static_cast<int>(quantile));
+                }
+                if (profile.name.empty() || profile.weight < 0 || profile.serviceQuantiles.empty() ||
+                    !std::is_sorted(profile.serviceQuantiles.begin(), profile.serviceQuantiles.end())) {
+                    throw std::invalid_argument("bad type profile");
+                }
+                workload.requestTypes.push_back(profile);
+            } else {
+                throw std::runtime_error(where + ": unknown setting " + key);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(where + ": invalid value for " + key);
+        }
+    }
+    
+    if (!workload.arrivalCurve.empty() && workload.curvePeriod <= 0) {
+        throw std::runtime_error(path + ": arrival_curve needs a positive arrival_period");
+    }
+    return workload;
+}
+
+/**
+ * @brief Default constructor
+ * 
+ * Uses default parameters and a nondeterministic seed
+ */
+WorkloadGenerator::WorkloadGenerator() : engine(std::random_device{}()), nextRequestID(1), cycle(0) {
+    prepare();
+}
+
+/**
+ * @brief Parameterized constructor
+ * @param workload Workload parameters
+ * @param seed Seed for the random engine
+ */
+WorkloadGenerator::WorkloadGenerator(const WorkloadParams& workload, unsigned int seed)
+    : params(workload), engine(seed), nextRequestID(1), cycle(0) {
+    prepare();
+}
+
+/**
+ * @brief Precompute sampling tables for the optional refinements
+ */
+void WorkloadGenerator::prepare() {
+    std::vector<double> weights;
+    for (const auto& type : params.requestTypes) {
+        weights.push_back(type.weight);
+    }
+    typeChooser = std::discrete_distribution<int>(weights.begin(), weights.end());
+    
+    // Constants of Hormann and Derflinger's rejection-inversion Zipf sampler
+    double s = params.clientSkew;
+    zipfIntegralFirst = zipfIntegral(1.5, s) - 1.0;
+    zipfIntegralLast = zipfIntegral(params.clientCount + 0.5, s);
+    zipfThreshold = 2.0 - zipfIntegralInverse(zipfIntegral(2.5, s) - std::exp(-s * std::log(2.0)), s);
+}
+
+/**
+ * @brief Draw a client popularity rank
+ * @return Rank in [1, clientCount]
+ */
+int WorkloadGenerator::drawClientRank() {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    double s = params.clientSkew;
+    if (s <= 0.0) {
+        std::uniform_int_distribution<> uniform(1, params.clientCount);
+        return uniform(engine);
+    }
+    
+    while (true) {
+        double u = zipfIntegralLast + dis(engine) * (zipfIntegralFirst - zipfIntegralLast);
+        double x = zipfIntegralInverse(u, s);
+        int k = static_cast<int>(x + 0.5);
+        k = std::min(params.clientCount, std::max(1, k));
+        if (k - x <= zipfThreshold ||
+            u >= zipfIntegral(k + 0.5, s) - std::exp(-s * std::log(static_cast<double>(k)))) {
+            return k;
+        }
+    }
+}
+
+/**
+ * @brief Draw a service time from a request type profile
+ * @param profile Type profile
+ * @return Service time in cycles
+ */
+int WorkloadGenerator::drawServiceTime(const RequestTypeProfile& profile) {
+    const auto& quantiles = profile.serviceQuantiles;
+    if (quantiles.size() == 1) {
+        return std::max(1, quantiles[0]);
+    }
+    // Inverse-CDF sampling with linear interpolation between quantiles
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    double position = dis(engine) * (quantiles.size() - 1);
+    size_t segment = std::min(static_cast<size_t>(position), quantiles.size() - 2);
+    double value = quantiles[segment] + (position - segment) * (quantiles[segment + 1] - quantiles[segment]);
+    return std::max(1, static_cast<int>(std::lround(value)));
+}
+
+/**
+ * @brief Generate a random client IP address
+ * @return Client address
+ */
+IPAddress WorkloadGenerator::generateIP() {
+    const uint64_t documentationPrefix = 0x20010DB8ull << 32;  // 2001:db8::/32
+    if (params.clientCount > 0) {
+        // Spread ranks over the address space so popular clients look unrelated
+        uint32_t rank = static_cast<uint32_t>(drawClientRank());
+        uint32_t mixed = rank * 0x9E3779B1u;
+        if (params.ipv6Share > 0.0) {
+            // A second hash decides the family, so each client keeps one address
+            uint32_t family = rank * 0xC2B2AE35u;
+            family ^= family >> 16;
+            if (family < params.ipv6Share * 4294967296.0) {
+                return IPAddress(documentationPrefix | mixed, rank * 0x9E3779B97F4A7C15ull);
+            }
+        }
+        uint32_t address = 0;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            address = (address << 8) | (1 + ((mixed >> shift) & 0xFF) % 254);
+        }
+        return IPAddress::fromIPv4(address);
+    }
+    
+    // Only draw the family when IPv6 is configured, so IPv4-only streams are unchanged
+    if (params.ipv6Share > 0.0 && std::uniform_real_distribution<>(0.0, 1.0)(engine) < params.ipv6Share) {
+        uint64_t high = documentationPrefix | engine();
+        uint64_t low = (static_cast<uint64_t>(engine()) << 32) | engine();
+        return IPAddress(high, low);
+    }
+    std::uniform_int_distribution<> dis(1, 254);
+    uint32_t address = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        address = (address << 8) | static_cast<uint32_t>(dis(engine));
+    }
+    return IPAddress::fromIPv4(address);
+}
+
+/**
+ * @brief Generate a random request type
+ * @return One of GET, POST, PUT, DELETE
+ */
+std::string WorkloadGenerator::generateRequestType() {
+    if (!params.requestTypes.empty()) {
+        return params.requestTypes[typeChooser(engine)].name;
+    }
+    static const char* types[] = {"GET", "POST", "PUT", "DELETE"};
+    std::uniform_int_distribution<> dis(0, 3);
+    return types[dis(engine)];
+}
+
+/**
+ * @brief Generate a random request with an explicit identifier
+ * @param requestID Unique identifier for the request
+ * @return Generated request
+ */
+Request WorkloadGenerator::generateRequest(long long requestID) {
+    IPAddress clientIP = generateIP();
+    if (!params.requestTypes.empty()) {
+        const RequestTypeProfile& profile = params.requestTypes[typeChooser(engine)];
+        std::uniform_int_distribution<> priorityDis(params.minPriority, params.maxPriority);
+        int priority = priorityDis(engine);
+        return Request(clientIP, profile.name, priority, drawServiceTime(profile), requestID);
+    }
+    std::string requestType = generateRequestType();
+    
+    std::uniform_int_distribution<> priorityDis(params.minPriority, params.maxPriority);
+    std::uniform_int_distribution<> timeDis(params.minProcessingTime, params.maxProcessingTime);
+    
+    int priority = priorityDis(engine);
+    int processingTime = timeDis(engine);
+    
+    return Request(clientIP, requestType, priority, processingTime, requestID);
+}
+
+/**
+ * @brief Generate a random request with the next sequential identifier
+ * @return Generated request
+ */
+Request WorkloadGenerator::generateRequest() {
+    return generateRequest(nextRequestID++);
+}
+
+/**
+ * @brief Draw the number of requests arriving in one cycle
+ * @return Number of arrivals this cycle
+ */
+int WorkloadGenerator::drawArrivals() {
+    double rate = params.arrivalRate;
+    if (!params.arrivalCurve.empty()) {
+        size_t point = static_cast<size_t>(cycle / params.curvePeriod) % params.arrivalCurve.size();
+        rate *= params.arrivalCurve[point];
+    }
+    ++cycle;
+    
+    double whole = std::floor(rate);
+    double fraction = rate - whole;
+    
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    int arrivals = static_cast<int>(whole);
+    if (dis(engine) < fraction) {
+        arrivals++;
+    }
+    return arrivals;
+}
+
+/**
+ * @brief Restart the random stream from a new seed
+ * @param seed New seed
+ */
+void WorkloadGenerator::reseed(unsigned int seed) {
+    engine.seed(seed);
+}
+
+/**
+ * @brief Set the identifier given to the next generated request
+ * @param id Next request identifier
+ */
+void WorkloadGenerator::setNextRequestID(long long id) {
+    nextRequestID = id;
+}
+
+/**
+ * @brief Get the workload parameters
+ * @return Workload parameters
+ */
+const WorkloadParams& WorkloadGenerator::getParams() const {
+    return params;
+}
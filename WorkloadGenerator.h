@@ -0,0 +1,195 @@
+/**
+ * @file WorkloadGenerator.h
+ * @brief Header file for the WorkloadGenerator class
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ */
+
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "Request.h"
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RequestTypeProfile
+ * @brief Share of traffic and service-time distribution of one request type
+ */
+struct RequestTypeProfile {
+    std::string name;                 ///< Request type (GET, POST, ...)
+    double weight = 1.0;              ///< Relative share of requests
+    std::vector<int> serviceQuantiles; ///< Evenly spaced service-time quantiles, minimum to maximum
+};
+
+/**
+ * @struct WorkloadParams
+ * @brief Parameters describing the synthetic arrival and service process
+ * 
+ * The first five fields describe the original uniform workload. The
+ * remaining fields are optional refinements, usually fitted from a trace;
+ * when they are empty the generator behaves exactly as before.
+ */
+struct WorkloadParams {
+    double arrivalRate = 0.15;     ///< Mean new requests per cycle
+    int minProcessingTime = 10;    ///< Shortest service time in cycles
+    int maxProcessingTime = 100;   ///< Longest service time in cycles
+    int minPriority = 1;           ///< Lowest priority level
+    int maxPriority = 10;          ///< Highest priority level
+    std::vector<double> arrivalCurve;  ///< Rate multipliers (mean 1) per period, repeated cyclically
+    long long curvePeriod = 0;     ///< Cycles per arrival curve point
+    std::vector<RequestTypeProfile> requestTypes; ///< Type mix with per-type service times
+    int clientCount = 0;           ///< Distinct clients (0 = a random IP per request)
+    double clientSkew = 0.0;       ///< Zipf exponent of client popularity (0 = uniform)
+    double ipv6Share = 0.0;        ///< Fraction of clients with IPv6 addresses
+
+    /**
+     * @brief Get the mean service time
+     * @return Mean cycles per request
+     */
+    double meanServiceTime() const;
+
+    /**
+     * @brief Get a service-time quantile
+     * @param fraction Quantile in [0, 1]
+     * @return Service time in cycles
+     */
+    double serviceTimeQuantile(double fraction) const;
+};
+
+/**
+ * @brief Write workload parameters as a generator config
+ * 
+ * The format is one "key = value" setting per line, with one "type" line
+ * per request type profile; '#' starts a comment.
+ * @param out Output stream
+ * @param workload Parameters to write
+ */
+void writeWorkloadParams(std::ostream& out, const WorkloadParams& workload);
+
+/**
+ * @brief Read workload parameters from a generator config
+ * @param path Config file written by writeWorkloadParams() or by hand
+ * @return Parameters; settings missing from the file keep their defaults
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+WorkloadParams readWorkloadParams(const std::string& path);
+
+/**
+ * @class WorkloadGenerator
+ * @brief Produces a reproducible stream of random requests
+ * 
+ * All randomness comes from a single seeded engine, so two generators built
+ * with the same parameters and seed produce exactly the same arrival and
+ * service-time stream. The stream never depends on load balancer state,
+ * which is what allows common random numbers across configurations.
+ */
+class WorkloadGenerator {
+private:
+    WorkloadParams params; ///< Workload parameters
+    std::mt19937 engine;   ///< Random engine for all draws
+    long long nextRequestID; ///< Identifier given to the next generated request
+    long long cycle;       ///< Cycles drawn so far, for the arrival curve
+    std::discrete_distribution<int> typeChooser; ///< Draws a request type profile
+    double zipfIntegralFirst; ///< Rejection-inversion constant H(1.5) - 1
+    double zipfIntegralLast;  ///< Rejection-inversion constant H(n + 0.5)
+    double zipfThreshold;     ///< Rejection-inversion acceptance shortcut
+
+    /**
+     * @brief Precompute sampling tables for the optional refinements
+     */
+    void prepare();
+
+    /**
+     * @brief Draw a client popularity rank
+     * @return Rank in [1, clientCount]
+     */
+    int drawClientRank();
+
+    /**
+     * @brief Draw a service time from a request type profile
+     * @param profile Type profile
+     * @return Service time in cycles
+     */
+    int drawServiceTime(const RequestTypeProfile& profile);
+
+public:
+    /**
+     * @brief Default constructor
+     * 
+     * Uses default parameters and a nondeterministic seed
+     */
+    WorkloadGenerator();
+
+    /**
+     * @brief Parameterized constructor
+     * @param workload Workload parameters
+     * @param seed Seed for the random engine
+     */
+    WorkloadGenerator(const WorkloadParams& workload, unsigned int seed);
+
+    /**
+     * @brief Generate a random client IP address
+     * 
+     * With a client population configured, addresses are drawn from a
+     * fixed set of clients with Zipf-distributed popularity. A share of
+     * clients given by ipv6Share get addresses in 2001:db8::/32.
+     * @return Client address
+     */
+    IPAddress generateIP();
+
+    /**
+     * @brief Generate a random request type
+     * @return One of GET, POST, PUT, DELETE, or a profiled type if configured
+     */
+    std::string generateRequestType();
+
+    /**
+     * @brief Generate a random request with an explicit identifier
+     * @param requestID Unique identifier for the request
+     * @return Generated request
+     */
+    Request generateRequest(long long requestID);
+
+    /**
+     * @brief Generate a random request with the next sequential identifier
+     * @return Generated request
+     */
+    Request generateRequest();
+
+    /**
+     * @brief Draw the number of requests arriving in one cycle
+     * 
+     * The integer part of the arrival rate always arrives; the fractional
+     * part is a Bernoulli trial, so a rate of 0.15 is a 15% chance per cycle.
+     * With an arrival curve, the rate is scaled by the curve point of the
+     * current cycle.
+     * @return Number of arrivals this cycle
+     */
+    int drawArrivals();
+
+    /**
+     * @brief Restart the random stream from a new seed
+     * 
+     * Used to make cloned generators diverge from their parent.
+     * @param seed New seed
+     */
+    void reseed(unsigned int seed);
+
+    /**
+     * @brief Set the identifier given to the next generated request
+     * @param id Next request identifier
+     */
+    void setNextRequestID(long long id);
+
+    /**
+     * @brief Get the workload parameters
+     * @return Workload parameters
+     */
+    const WorkloadParams& getParams() const;
+};
+
+#endif // WORKLOADGENERATOR_H
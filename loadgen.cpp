@@ -0,0 +1,143 @@
+/**
+ * @file loadgen.cpp
+ * @brief Open-loop HTTP load generator for benchmarking a networked load balancer
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ *
+ * Sends requests to a target on a schedule fixed in advance (Poisson,
+ * constant rate, or the simulator's own per-cycle arrival process) and
+ * reports latency percentiles measured from each request's intended send
+ * time, so a stalled target cannot hide its stalls by slowing the load.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "LoadGenerator.h"
+
+/**
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: loadgen [options]" << std::endl;
+    std::cout << "  --host ADDR          Target address (default 127.0.0.1)" << std::endl;
+    std::cout << "  --port N             Target port (default 8080)" << std::endl;
+    std::cout << "  --threads N          Event-loop threads (default 1)" << std::endl;
+    std::cout << "  --connections N      Keep-alive connections over all threads (default 16)" << std::endl;
+    std::cout << "  --process P          poisson, constant or cycles (default poisson)" << std::endl;
+    std::cout << "  --rate R             Requests per second for poisson and constant (default 1000)" << std::endl;
+    std::cout << "  --workload FILE      Generator config for the request mix and cycle arrivals" << std::endl;
+    std::cout << "  --arrival-rate R     Requests per cycle for the cycles process" << std::endl;
+    std::cout << "  --cycle-us U         Microseconds per simulator cycle (default 100)" << std::endl;
+    std::cout << "  --path PATH          Request target (default /)" << std::endl;
+    std::cout << "  --duration S         Seconds of sending (default 10)" << std::endl;
+    std::cout << "  --warmup S           Leading seconds excluded from latency (default 0)" << std::endl;
+    std::cout << "  --drain S            Seconds to wait for late responses (default 2)" << std::endl;
+    std::cout << "  --seed N             Seed for the schedule and request contents (default 1)" << std::endl;
+}
+
+/**
+ * @brief Print the latency percentiles of a histogram
+ * @param label Row label
+ * @param histogram Nanosecond histogram
+ */
+void printLatency(const std::string& label, const LatencyHistogram& histogram) {
+    std::cout << std::left << std::setw(16) << label << std::right;
+    for (double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        std::cout << std::setw(11) << histogram.getPercentile(percentile) / 1000.0;
+    }
+    std::cout << std::setw(11) << histogram.getMax() / 1000.0 << std::setw(11) << histogram.getMean() / 1000.0
+              << std::endl;
+}
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    LoadGenConfig config;
+    double arrivalRate = -1.0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--host" && hasValue) {
+                config.host = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                config.port = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                config.threads = std::stoi(argv[++i]);
+            } else if (arg == "--connections" && hasValue) {
+                config.connections = std::stoi(argv[++i]);
+            } else if (arg == "--process" && hasValue) {
+                config.process = ArrivalSchedule::parseProcess(argv[++i]);
+            } else if (arg == "--rate" && hasValue) {
+                config.rate = std::stod(argv[++i]);
+            } else if (arg == "--workload" && hasValue) {
+                config.workload = readWorkloadParams(argv[++i]);
+            } else if (arg == "--arrival-rate" && hasValue) {
+                arrivalRate = std::stod(argv[++i]);
+            } else if (arg == "--cycle-us" && hasValue) {
+                config.cycleMicroseconds = std::stod(argv[++i]);
+            } else if (arg == "--path" && hasValue) {
+                config.path = argv[++i];
+            } else if (arg == "--duration" && hasValue) {
+                config.duration = std::stod(argv[++i]);
+            } else if (arg == "--warmup" && hasValue) {
+                config.warmup = std::stod(argv[++i]);
+            } else if (arg == "--drain" && hasValue) {
+                config.drainTimeout = std::stod(argv[++i]);
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        if (arrivalRate >= 0) {
+            config.workload.arrivalRate = arrivalRate;
+        }
+        if (config.port <= 0 || config.port > 65535 || config.threads < 1 || config.connections < 1 ||
+            !(config.duration > 0) || config.warmup < 0 || config.warmup >= config.duration ||
+            config.drainTimeout < 0 || config.path.empty() || config.path[0] != '/') {
+            throw std::invalid_argument("option out of range");
+        }
+
+        double rate = ArrivalSchedule::meanRate(config.workload, config.process, config.rate,
+                                                config.cycleMicroseconds);
+        std::cout << "Sending " << std::fixed << std::setprecision(0) << rate << " requests/s for "
+                  << std::setprecision(1) << config.duration << " s to " << config.host << ":" << config.port
+                  << " over " << config.connections << " connections, " << config.threads << " threads" << std::endl;
+
+        LoadGenerator generator(config);
+        LoadGenResult result = generator.run();
+
+        double measured = config.duration - config.warmup;
+        std::cout << std::setprecision(1);
+        std::cout << "Sent: " << result.sent << " (" << result.sent / config.duration << "/s), completed: "
+                  << result.completed << ", failed: " << result.failed << ", connections opened: " << result.connects
+                  << std::endl;
+        std::cout << "Status: 2xx " << result.status2xx << ", 3xx " << result.status3xx << ", 4xx "
+                  << result.status4xx << ", 5xx " << result.status5xx << std::endl;
+        std::cout << "Recorded " << result.latency.getCount() << " responses over the last " << measured
+                  << " s; largest send lag " << std::setprecision(3) << result.maxSendLag * 1000.0 << " ms"
+                  << std::endl;
+        std::cout << std::setprecision(1);
+        std::cout << "Latency (us)          p50        p90        p99      p99.9     p99.99        max       mean"
+                  << std::endl;
+        printLatency("from intended", result.latency);
+        printLatency("from sent", result.responseTime);
+        return result.failed > 0 ? 2 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
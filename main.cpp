@@ -12,40 +12,72 @@
  */
 
 #include <iostream>
-#include <random>
 #include <chrono>
 #include <thread>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include "LoadBalancer.h"
 #include "Request.h"
+#include "WorkloadGenerator.h"
+#include "Simulation.h"
+#include "PairedComparison.h"
+#include "RareEventEstimator.h"
+#include "FleetSizer.h"
+#include "ThreadPool.h"
+#include "TraceRecorder.h"
+#include "CycleEngine.h"
+#include "FastEngine.h"
+#include "EquivalenceChecker.h"
+#include "HugePages.h"
+#include "SpillSegment.h"
+#include "LogWriter.h"
+#include "TextBuffer.h"
+#include "ConsoleSink.h"
+#include "BlocklistReloader.h"
 
 /**
- * @brief Generate a random IP address
- * @return Random IP address as string
+ * @brief Get the workload generator shared by the interactive simulation
+ * @return Reference to the generator
  */
-std::string generateRandomIP() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(1, 254);
-    
-    return std::to_string(dis(gen)) + "." + 
-           std::to_string(dis(gen)) + "." + 
-           std::to_string(dis(gen)) + "." + 
-           std::to_string(dis(gen));
+WorkloadGenerator& sharedGenerator() {
+    static WorkloadGenerator generator;
+    return generator;
 }
 
 /**
- * @brief Generate a random request type
- * @return Random request type as string
+ * @brief Get the console the interactive simulation prints through
+ * @return Reference to the shared console sink
  */
-std::string generateRandomRequestType() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 3);
-    
-    std::vector<std::string> types = {"GET", "POST", "PUT", "DELETE"};
-    return types[dis(gen)];
+ConsoleSink& sharedConsole() {
+    static ConsoleSink console;
+    return console;
+}
+
+/**
+ * @brief Get the recorder capturing the interactive simulation's traffic
+ * @return Reference to the recorder, empty unless --record was given
+ */
+std::unique_ptr<TraceRecorder>& sharedRecorder() {
+    static std::unique_ptr<TraceRecorder> recorder;
+    return recorder;
+}
+
+/**
+ * @brief Get the blocklist file the interactive simulation watches
+ * @return Reference to the path, empty unless --blocklist was given
+ */
+std::string& sharedBlocklistPath() {
+    static std::string path;
+    return path;
 }
 
 /**
@@ -53,19 +85,8 @@ std::string generateRandomRequestType() {
  * @param requestID Unique identifier for the request
  * @return Generated Request object
  */
-Request generateRandomRequest(int requestID) {
-    std::string clientIP = generateRandomIP();
-    std::string requestType = generateRandomRequestType();
-    
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> priorityDis(1, 10);
-    static std::uniform_int_distribution<> timeDis(10, 100);
-    
-    int priority = priorityDis(gen);
-    int processingTime = timeDis(gen);
-    
-    return Request(clientIP, requestType, priority, processingTime, requestID);
+Request generateRandomRequest(long long requestID) {
+    return sharedGenerator().generateRequest(requestID);
 }
 
 /**
@@ -74,77 +95,76 @@ Request generateRandomRequest(int requestID) {
  * @param queueSize Number of requests to generate
  */
 void initializeQueue(LoadBalancer& loadBalancer, int queueSize) {
-    std::cout << "Generating " << queueSize << " initial requests..." << std::endl;
+    ConsoleSink& console = sharedConsole();
+    console.write("Generating " + std::to_string(queueSize) + " initial requests...\n", ConsoleVerbosity::NORMAL);
     
     for (int i = 1; i <= queueSize; ++i) {
         Request request = generateRandomRequest(i);
+        if (sharedRecorder()) {
+            sharedRecorder()->record(request, 0);
+        }
         if (!loadBalancer.addRequest(request)) {
-            std::cout << "Warning: Could not add request " << i << " - queue may be full" << std::endl;
+            console.write("Warning: Could not add request " + std::to_string(i) + " - queue may be full\n");
             break;
         }
     }
     
-    std::cout << "Queue initialized with " << loadBalancer.getQueueSize() << " requests" << std::endl;
+    console.write("Queue initialized with " + std::to_string(loadBalancer.getQueueSize()) + " requests\n");
 }
 
 /**
- * @brief Add new requests at random intervals
+ * @brief Add the requests arriving in this cycle
  * @param loadBalancer Reference to the load balancer
  * @param cycle Current cycle number
  * @param maxCycles Maximum number of cycles
  */
-void addRandomRequests(LoadBalancer& loadBalancer, int cycle, int maxCycles) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(1, 100);
-    
-    // 15% chance to add a new request each cycle
-    if (dis(gen) <= 15 && cycle < maxCycles * 0.95) { // Stop adding requests near the end
-        static int nextRequestID = 1001; // Start after initial requests
+void addRandomRequests(LoadBalancer& loadBalancer, long long cycle, long long maxCycles) {
+    // Arrivals per cycle follow the configured rate and arrival curve (0.15 by default)
+    int arrivals = sharedGenerator().drawArrivals();
+    for (int i = 0; i < arrivals && cycle < maxCycles * 0.95; ++i) { // Stop adding requests near the end
+        static long long nextRequestID = 1001; // Start after initial requests
         Request newRequest = generateRandomRequest(nextRequestID++);
-        
-        if (loadBalancer.addRequest(newRequest)) {
-            std::cout << "  [Cycle " << cycle << "] New request added from " 
-                      << newRequest.getClientIP() << std::endl;
+        if (sharedRecorder()) {
+            sharedRecorder()->record(newRequest, cycle);
         }
+        
+        // Counted into periodic summaries; per-request lines only when verbose
+        bool admitted = loadBalancer.addRequest(newRequest);
+        sharedConsole().requestOffered(cycle, newRequest.getClientAddress(), admitted);
     }
 }
 
 /**
  * @brief Log simulation statistics to file
- * @param filename Output filename
+ * @param log Open simulation log
  * @param loadBalancer Reference to the load balancer
  * @param cycle Current cycle number
  */
-void logStatistics(const std::string& filename, const LoadBalancer& loadBalancer, int cycle) {
-    std::ofstream logFile(filename, std::ios::app);
-    if (logFile.is_open()) {
-        // Get server statistics to count active/inactive servers
-        auto serverStats = loadBalancer.getServerStats();
-        int activeServers = 0;
-        int inactiveServers = 0;
-        
-        for (const auto& stat : serverStats) {
-            if (stat.find("Active: Yes") != std::string::npos) {
-                activeServers++;
-            } else {
-                inactiveServers++;
-            }
+void logStatistics(LogWriter& log, const LoadBalancer& loadBalancer, long long cycle) {
+    if (!log.isOpen()) {
+        return;
+    }
+    
+    int activeServers = 0;
+    int inactiveServers = 0;
+    for (int i = 0; i < loadBalancer.getServerCount(); ++i) {
+        if (loadBalancer.getServer(i).getIsActive()) {
+            activeServers++;
+        } else {
+            inactiveServers++;
         }
-        
-        logFile << "Cycle " << std::setw(5) << cycle << " | "
-                << "Servers: " << std::setw(2) << loadBalancer.getActiveServerCount() << " | "
-                << "Queue: " << std::setw(4) << loadBalancer.getQueueSize() << " | "
-                << "Processed: " << std::setw(6) << loadBalancer.getTotalRequestsProcessed() << " | "
-                << "System Util: " << std::setw(5) << std::fixed << std::setprecision(1) 
-                << loadBalancer.getSystemUtilization() << "% | "
-                << "Queue Util: " << std::setw(5) << std::fixed << std::setprecision(1) 
-                << loadBalancer.getQueueUtilization() << "% | "
-                << "Active: " << std::setw(2) << activeServers << " | "
-                << "Inactive: " << std::setw(2) << inactiveServers << " | "
-                << "Rejected: " << std::setw(2) << "0" << std::endl;
-        logFile.close();
     }
+    
+    log.line().append("Cycle ").appendInt(cycle, 5).append(" | ")
+        .append("Servers: ").appendInt(loadBalancer.getActiveServerCount(), 2).append(" | ")
+        .append("Queue: ").appendInt(loadBalancer.getQueueSize(), 4).append(" | ")
+        .append("Processed: ").appendInt(loadBalancer.getTotalRequestsProcessed(), 6).append(" | ")
+        .append("System Util: ").appendFixed(loadBalancer.getSystemUtilization(), 1, 5).append("% | ")
+        .append("Queue Util: ").appendFixed(loadBalancer.getQueueUtilization(), 1, 5).append("% | ")
+        .append("Active: ").appendInt(activeServers, 2).append(" | ")
+        .append("Inactive: ").appendInt(inactiveServers, 2).append(" | ")
+        .append("Rejected:  0");
+    log.endLine();
 }
 
 /**
@@ -152,31 +172,414 @@ void logStatistics(const std::string& filename, const LoadBalancer& loadBalancer
  * @param loadBalancer Reference to the load balancer
  * @param cycle Current cycle number
  */
-void displayStatus(const LoadBalancer& loadBalancer, int cycle) {
-    std::cout << "\n=== Cycle " << cycle << " Status ===" << std::endl;
-    std::cout << "Active Servers: " << loadBalancer.getActiveServerCount() << std::endl;
-    std::cout << "Queue Size: " << loadBalancer.getQueueSize() << std::endl;
-    std::cout << "Total Processed: " << loadBalancer.getTotalRequestsProcessed() << std::endl;
-    std::cout << "System Utilization: " << std::fixed << std::setprecision(1) 
-              << loadBalancer.getSystemUtilization() << "%" << std::endl;
-    std::cout << "Queue Utilization: " << std::fixed << std::setprecision(1) 
-              << loadBalancer.getQueueUtilization() << "%" << std::endl;
-    
+void displayStatus(const LoadBalancer& loadBalancer, long long cycle) {
+    if (!sharedConsole().shows(ConsoleVerbosity::NORMAL)) {
+        return;
+    }
+    static TextBuffer status;
+    status.clear();
+    status.append("\n=== Cycle ").appendInt(cycle).append(" Status ===\n")
+        .append("Active Servers: ").appendInt(loadBalancer.getActiveServerCount()).append('\n')
+        .append("Queue Size: ").appendInt(loadBalancer.getQueueSize()).append('\n')
+        .append("Total Processed: ").appendInt(loadBalancer.getTotalRequestsProcessed()).append('\n')
+        .append("System Utilization: ").appendFixed(loadBalancer.getSystemUtilization(), 1).append("%\n")
+        .append("Queue Utilization: ").appendFixed(loadBalancer.getQueueUtilization(), 1).append("%\n");
     if (loadBalancer.isOverloaded()) {
-        std::cout << "*** SYSTEM OVERLOADED ***" << std::endl;
+        status.append("*** SYSTEM OVERLOADED ***\n");
     }
+    sharedConsole().write(status.str(), ConsoleVerbosity::NORMAL);
 }
 
 /**
- * @brief Main function
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: loadbalancer                    Interactive simulation" << std::endl;
+    std::cout << "       loadbalancer --compare P1,P2,... Paired comparison of policies (rr, lc)" << std::endl;
+    std::cout << "       loadbalancer --rare-event E      Splitting estimate of P(E), E = overload|queue-full" << std::endl;
+    std::cout << "       loadbalancer --slo CYCLES        Minimum fleet meeting a latency SLO" << std::endl;
+    std::cout << "       loadbalancer --run               Single long-horizon run with windowed statistics" << std::endl;
+    std::cout << "       loadbalancer --replay FILE       Replay a request trace (binary or JSONL)" << std::endl;
+    std::cout << "       loadbalancer --record FILE       Interactive simulation, recording its traffic" << std::endl;
+    std::cout << "       loadbalancer --console LEVEL     Interactive simulation printing quiet, normal or verbose" << std::endl;
+    std::cout << "       loadbalancer --blocklist FILE    Interactive simulation refusing addresses listed in FILE," << std::endl;
+    std::cout << "                                        reloaded whenever the file changes" << std::endl;
+    std::cout << "       loadbalancer --check-engines     Check the fast engine against the reference, cycle by cycle" << std::endl;
+    std::cout << "Options for batch modes:" << std::endl;
+    std::cout << "  --servers N        Initial servers (default 5)" << std::endl;
+    std::cout << "  --cycles N         Cycles per run (default 10000)" << std::endl;
+    std::cout << "  --arrival-rate X   Mean new requests per cycle (default 0.15)" << std::endl;
+    std::cout << "  --ipv6-share F     Fraction of clients with IPv6 addresses (default 0)" << std::endl;
+    std::cout << "  --replications N   Replications (default 30 for --compare, 8 for --slo)" << std::endl;
+    std::cout << "  --seed N           Seed of the first replication (default 1)" << std::endl;
+    std::cout << "  --threads N        Worker threads (default: hardware concurrency)" << std::endl;
+    std::cout << "  --pin-threads      Bind workers to CPUs spread across NUMA nodes; report per-node throughput" << std::endl;
+    std::cout << "  --initial-queue N  Requests queued before cycle 1 (default servers x 100)" << std::endl;
+    std::cout << "  --policy P         Distribution policy for single-policy modes (default rr)" << std::endl;
+    std::cout << "  --max-queue N      Request queue capacity (default 1000)" << std::endl;
+    std::cout << "  --queue-budget MB  Spill the queue's cold middle to disk beyond this many MB" << std::endl;
+    std::cout << "  --spill-dir DIR    Directory for queue spill segments (default /tmp)" << std::endl;
+    std::cout << "  --workload FILE    Generator config, e.g. from tracetool fit (--arrival-rate rescales it)" << std::endl;
+    std::cout << "  --record FILE      Record offered requests of --run (.jsonl or binary trace)" << std::endl;
+    std::cout << "Options for --check-engines:" << std::endl;
+    std::cout << "  --huge-pages M     Back the fast engine's large arrays with 2 MB pages: off, thp or hugetlb" << std::endl;
+    std::cout << "Options for --rare-event (--cycles is the horizon):" << std::endl;
+    std::cout << "  --levels N         Evenly spaced splitting levels (default 0 = adaptive)" << std::endl;
+    std::cout << "  --trajectories N   Trajectories per level (default 500)" << std::endl;
+    std::cout << "  --repetitions N    Independent repetitions (default 10)" << std::endl;
+    std::cout << "Options for --slo (the run starts empty and receives arrivals throughout):" << std::endl;
+    std::cout << "  --percentile P     SLO percentile (default 99)" << std::endl;
+    std::cout << "  --warmup N         Cycles excluded from latency (default cycles / 10)" << std::endl;
+    std::cout << "  --autoscale        Size the autoscaler cap instead of a fixed fleet" << std::endl;
+}
+
+/**
+ * @brief Split a comma-separated list
+ * @param text Input text
+ * @return List items
+ */
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Format the accepted range of a numeric option
+ * @param minimum Smallest accepted value
+ * @param maximum Largest accepted value, or the type's largest for no limit
+ * @param unbounded Whether @p maximum means no limit
+ * @return Range as "at least MIN" or "between MIN and MAX"
+ */
+template <typename T>
+std::string describeRange(T minimum, T maximum, bool unbounded) {
+    std::ostringstream text;
+    if (unbounded) {
+        text << "at least " << minimum;
+    } else {
+        text << "between " << minimum << " and " << maximum;
+    }
+    return text.str();
+}
+
+/**
+ * @brief Parse an integer option value, printing an error if it is invalid
+ * @param flag Option name
+ * @param text Value as given
+ * @param value Set to the parsed value on success
+ * @param minimum Smallest accepted value
+ * @param maximum Largest accepted value; also capped at what @p value can hold
+ * @return True if @p text is a whole integer in range
+ */
+template <typename T>
+bool parseInteger(const std::string& flag, const std::string& text, T& value, long long minimum,
+                  long long maximum = std::numeric_limits<long long>::max()) {
+    if (static_cast<unsigned long long>(std::numeric_limits<T>::max()) <
+        static_cast<unsigned long long>(maximum)) {
+        maximum = static_cast<long long>(std::numeric_limits<T>::max());
+    }
+    bool unbounded = maximum == std::numeric_limits<long long>::max();
+    size_t used = 0;
+    long long parsed = 0;
+    try {
+        parsed = std::stoll(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != text.size()) {
+        std::cerr << "invalid value for " << flag << ": " << text << std::endl;
+        return false;
+    }
+    if (parsed < minimum || parsed > maximum) {
+        std::cerr << "invalid value for " << flag << ": " << text << " (must be "
+                  << describeRange(minimum, maximum, unbounded) << ")" << std::endl;
+        return false;
+    }
+    value = static_cast<T>(parsed);
+    return true;
+}
+
+/**
+ * @brief Parse a real option value, printing an error if it is invalid
+ * @param flag Option name
+ * @param text Value as given
+ * @param value Set to the parsed value on success
+ * @param minimum Smallest accepted value
+ * @param maximum Largest accepted value, infinity for no limit
+ * @return True if @p text is a finite number in range
+ */
+bool parseReal(const std::string& flag, const std::string& text, double& value, double minimum,
+               double maximum = std::numeric_limits<double>::infinity()) {
+    size_t used = 0;
+    double parsed = 0.0;
+    try {
+        parsed = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != text.size() || !std::isfinite(parsed)) {
+        std::cerr << "invalid value for " << flag << ": " << text << std::endl;
+        return false;
+    }
+    if (parsed < minimum || parsed > maximum) {
+        std::cerr << "invalid value for " << flag << ": " << text << " (must be "
+                  << describeRange(minimum, maximum, std::isinf(maximum)) << ")" << std::endl;
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Print per-NUMA-node task throughput of a pool
+ * 
+ * Only printed for pinned pools or multi-node machines, where placement
+ * can explain throughput differences.
+ * @param pool Pool whose work is reported
+ */
+void printNodeThroughput(const ThreadPool& pool) {
+    std::vector<NodeThroughput> nodes = pool.getNodeThroughput();
+    if (!pool.isPinned() && nodes.size() < 2) {
+        return;
+    }
+    std::cout << "Worker placement (" << (pool.isPinned() ? "pinned" : "unpinned") << "):" << std::endl;
+    for (const auto& node : nodes) {
+        std::cout << "  Node " << node.node << ": pinned workers " << node.pinnedWorkers << ", runs "
+                  << node.tasks << ", busy " << std::fixed << std::setprecision(2) << node.busySeconds << " s";
+        if (node.busySeconds > 0.0) {
+            std::cout << ", " << node.tasks / node.busySeconds << " runs per busy second";
+        }
+        std::cout << std::endl;
+    }
+}
+
+/**
+ * @brief Run the paired policy comparison mode
+ * @param policies Policy names to compare; the first is the baseline
+ * @param config Base configuration shared by all policies
+ * @param workload Workload parameters
+ * @param replications Number of paired replications
+ * @param seed Seed of the first replication
+ * @param threads Worker thread count
+ * @param pinThreads Bind workers to CPUs spread across NUMA nodes
+ * @return Exit status
+ */
+int runComparison(const std::vector<std::string>& policies, const SimulationConfig& config,
+                  const WorkloadParams& workload, int replications, unsigned int seed, int threads,
+                  bool pinThreads) {
+    PairedComparison comparison(workload, replications, seed);
+    
+    for (const auto& name : policies) {
+        SimulationConfig policyConfig = config;
+        if (!parseDistributionPolicy(name, policyConfig.policy)) {
+            std::cerr << "Unknown policy: " << name << std::endl;
+            return 1;
+        }
+        policyConfig.name = name;
+        comparison.addConfiguration(policyConfig);
+    }
+    
+    ThreadPool pool(threads, pinThreads);
+    std::cout << "Running " << replications << " x " << policies.size() << " simulations on "
+              << pool.getThreadCount() << " threads..." << std::endl;
+    comparison.run(pool);
+    
+    for (const auto& line : comparison.getReport()) {
+        std::cout << line << std::endl;
+    }
+    printNodeThroughput(pool);
+    return 0;
+}
+
+/**
+ * @brief Run the rare-event estimation mode
+ * @param eventName "overload" or "queue-full"
+ * @param config Load balancer configuration; cycles is the horizon
+ * @param workload Workload parameters
+ * @param levels Number of splitting levels
+ * @param trajectories Trajectories per level
+ * @param repetitions Independent repetitions
+ * @param seed Seed of the first repetition
+ * @param threads Worker thread count
+ * @param pinThreads Bind workers to CPUs spread across NUMA nodes
+ * @return Exit status
+ */
+int runRareEvent(const std::string& eventName, const SimulationConfig& config,
+                 const WorkloadParams& workload, int levels, int trajectories, int repetitions,
+                 unsigned int seed, int threads, bool pinThreads) {
+    RareEvent event;
+    if (eventName == "overload") {
+        event = RareEvent::OVERLOAD;
+    } else if (eventName == "queue-full") {
+        event = RareEvent::QUEUE_FULL;
+    } else {
+        std::cerr << "Unknown rare event: " << eventName << std::endl;
+        return 1;
+    }
+    
+    RareEventEstimator estimator(config, workload, event);
+    estimator.setLevelCount(levels);
+    estimator.setTrajectoriesPerLevel(trajectories);
+    estimator.setRepetitions(repetitions);
+    estimator.setSeed(seed);
+    
+    ThreadPool pool(threads, pinThreads);
+    estimator.run(pool);
+    
+    for (const auto& line : estimator.getReport()) {
+        std::cout << line << std::endl;
+    }
+    printNodeThroughput(pool);
+    return 0;
+}
+
+/**
+ * @brief Run the fleet-size search mode
+ * @param slo Latency objective
+ * @param config Base configuration (run length, warm-up, policy)
+ * @param workload Workload parameters
+ * @param replications Replications per candidate
+ * @param seed Seed of the first replication
+ * @param threads Worker thread count
+ * @param autoscale Size the autoscaler cap instead of a fixed fleet
+ * @param pinThreads Bind workers to CPUs spread across NUMA nodes
  * @return Exit status
  */
-int main() {
+int runFleetSizing(const LatencySLO& slo, const SimulationConfig& config, const WorkloadParams& workload,
+                   int replications, unsigned int seed, int threads, bool autoscale, bool pinThreads) {
+    FleetSizer sizer(workload, slo, config);
+    sizer.setReplications(replications);
+    sizer.setSeed(seed);
+    sizer.setAutoscale(autoscale);
+    
+    ThreadPool pool(threads, pinThreads);
+    int servers = sizer.solve(pool);
+    
+    for (const auto& line : sizer.getReport()) {
+        std::cout << line << std::endl;
+    }
+    printNodeThroughput(pool);
+    return servers > 0 ? 0 : 2;
+}
+
+/**
+ * @brief Print the windowed statistics of a batch run
+ * @param config Configuration the run used
+ * @param result Run result
+ * @param seconds Wall-clock duration of the run
+ */
+void printRunReport(const SimulationConfig& config, const SimulationResult& result, double seconds) {
+    std::cout << "Cycle range              | Completed | Rejected | Avg Latency | Max Queue | Util  | Servers" << std::endl;
+    for (const auto& window : result.windows.getWindows()) {
+        double cycles = static_cast<double>(window.cycles);
+        std::cout << std::setw(11) << window.startCycle << "-" << std::setw(12) << window.startCycle + window.cycles - 1
+                  << " | " << std::setw(9) << window.completed
+                  << " | " << std::setw(8) << window.rejected
+                  << " | " << std::setw(11) << std::fixed << std::setprecision(2)
+                  << (window.completed > 0 ? static_cast<double>(window.latencySum) / window.completed : 0.0)
+                  << " | " << std::setw(9) << window.maxQueueSize
+                  << " | " << std::setw(5) << std::setprecision(1) << window.utilizationSum / cycles
+                  << " | " << std::setw(7) << std::setprecision(2) << window.serverSum / cycles << std::endl;
+    }
+    
+    std::cout << "Total processed: " << result.processed << ", rejected: " << result.rejected
+              << ", p99 latency: " << result.latency.getPercentile(99.0) << " cycles" << std::endl;
+    if (config.queueMemoryBudget > 0) {
+        std::cout << "Requests spilled to disk: " << result.spilledRequests << std::endl;
+    }
+    std::cout << "Simulated " << result.cycles << " cycles in " << std::setprecision(2) << seconds
+              << " s (" << std::setprecision(0) << (seconds > 0 ? result.cycles / seconds : 0.0)
+              << " cycles/s)" << std::endl;
+}
+
+/**
+ * @brief Run one batch simulation and print its windowed statistics
+ * @param config Load balancer configuration and run length
+ * @param workload Workload parameters
+ * @param seed Workload seed
+ * @param recorder Optional recorder for the offered traffic
+ * @return Exit status
+ */
+int runSingle(const SimulationConfig& config, const WorkloadParams& workload, unsigned int seed,
+              TraceRecorder* recorder) {
+    auto start = std::chrono::steady_clock::now();
+    SimulationResult result;
+    try {
+        result = runSimulation(config, workload, seed, recorder);
+        if (recorder != nullptr) {
+            recorder->close();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printRunReport(config, result, seconds);
+    if (recorder != nullptr) {
+        std::cout << "Recorded " << recorder->getRecordCount() << " requests" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Replay a request trace and print its windowed statistics
+ * @param path Trace file (binary or JSONL)
+ * @param config Load balancer configuration; cycles 0 runs until drained
+ * @return Exit status
+ */
+int runReplay(const std::string& path, const SimulationConfig& config) {
+    try {
+        std::unique_ptr<TraceSource> source = openTrace(path);
+        auto start = std::chrono::steady_clock::now();
+        SimulationResult result = replayTrace(config, *source);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printRunReport(config, result, seconds);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Run the reference and fast engines side by side and report the first divergence
+ * @param config Load balancer configuration
+ * @param workload Workload parameters
+ * @param seed Workload seed
+ * @return Exit status (3 if the engines diverged)
+ */
+int runEngineCheck(const SimulationConfig& config, const WorkloadParams& workload, unsigned int seed) {
+    ReferenceEngine reference(createLoadBalancer(config));
+    FastEngine candidate(config);
+    EquivalenceChecker checker(config, workload, seed);
+    bool equivalent = checker.run(reference, candidate);
+    for (const auto& line : checker.getReport()) {
+        std::cout << line << std::endl;
+    }
+    if (HugePages::getMode() != HugePageMode::OFF) {
+        // Read while the engine's arrays are still mapped
+        std::cout << "  Huge pages: " << HugePages::describe(HugePages::getReport()) << std::endl;
+    }
+    return equivalent ? 0 : 3;
+}
+
+/**
+ * @brief Run the interactive simulation
+ * @return Exit status
+ */
+int runInteractive() {
     std::cout << "=== Load Balancer Simulation ===" << std::endl;
     std::cout << "This program simulates a load balancer with multiple web servers." << std::endl;
     
     // Get user input
-    int numServers, simulationTime;
+    int numServers;
+    long long simulationTime;
     
     std::cout << "\nEnter the number of servers (1-50): ";
     std::cin >> numServers;
@@ -186,10 +589,10 @@ int main() {
         numServers = 5;
     }
     
-    std::cout << "Enter the simulation time in clock cycles (100-50000): ";
+    std::cout << "Enter the simulation time in clock cycles (100-1000000000000): ";
     std::cin >> simulationTime;
     
-    if (simulationTime < 100 || simulationTime > 50000) {
+    if (simulationTime < 100 || simulationTime > 1000000000000LL) {
         std::cout << "Invalid simulation time. Using default value of 10000." << std::endl;
         simulationTime = 10000;
     }
@@ -210,27 +613,52 @@ int main() {
     
     // Set up logging
     std::string logFilename = "loadbalancer_log.txt";
-    std::ofstream logFile(logFilename);
-    if (logFile.is_open()) {
-        logFile << "Load Balancer Simulation Log" << std::endl;
-        logFile << "Servers: " << numServers << ", Cycles: " << simulationTime << std::endl;
-        logFile << "Task Time Range: 10-100 clock cycles" << std::endl;
-        logFile << "Starting Queue Size: " << queueSize << " requests" << std::endl;
-        logFile << "Dynamic Scaling: Enabled (80% threshold for scale up, 40% for scale down)" << std::endl;
-        logFile << "Request Types: GET, POST, PUT, DELETE" << std::endl;
-        logFile << "Priority Levels: 1-10" << std::endl;
-        logFile << "Server Capacity: 10 concurrent requests per server" << std::endl;
-        logFile << "----------------------------------------" << std::endl;
-        logFile << "Cycle    | Servers | Queue | Processed | System Util | Queue Util | Active | Inactive | Rejected" << std::endl;
-        logFile << "---------|---------|-------|-----------|-------------|-----------|--------|----------|---------" << std::endl;
-        logFile.close();
-    }
-    
-    std::cout << "\nStarting simulation..." << std::endl;
-    std::cout << "Logging to: " << logFilename << std::endl;
+    LogWriter log(logFilename, false);
+    if (log.isOpen()) {
+        log.line().append("Load Balancer Simulation Log");
+        log.endLine();
+        log.line().append("Servers: ").appendInt(numServers).append(", Cycles: ").appendInt(simulationTime);
+        log.endLine();
+        log.line().append("Task Time Range: 10-100 clock cycles");
+        log.endLine();
+        log.line().append("Starting Queue Size: ").appendInt(queueSize).append(" requests");
+        log.endLine();
+        log.line().append("Dynamic Scaling: Enabled (80% threshold for scale up, 40% for scale down)");
+        log.endLine();
+        log.line().append("Request Types: GET, POST, PUT, DELETE");
+        log.endLine();
+        log.line().append("Priority Levels: 1-10");
+        log.endLine();
+        log.line().append("Server Capacity: 10 concurrent requests per server");
+        log.endLine();
+        log.line().append("----------------------------------------");
+        log.endLine();
+        log.line().append("Cycle    | Servers | Queue | Processed | System Util | Queue Util | Active | Inactive | Rejected");
+        log.endLine();
+        log.line().append("---------|---------|-------|-----------|-------------|-----------|--------|----------|---------");
+        log.endLine();
+    }
+    
+    ConsoleSink& console = sharedConsole();
+    console.write("\nStarting simulation...\nLogging to: " + logFilename + "\n");
+    
+    // Edits to the blocklist file take effect mid-run without pausing admission
+    std::unique_ptr<BlocklistReloader> blocklistReloader;
+    if (!sharedBlocklistPath().empty()) {
+        blocklistReloader = std::make_unique<BlocklistReloader>(loadBalancer.getBlocklistStore(),
+                                                                sharedBlocklistPath());
+        BlocklistReloadStats reload = blocklistReloader->getStats();
+        console.write(reload.failures > 0 ? "Blocklist: " + reload.lastError + ", watching for it\n"
+                                          : "Blocklist: " + std::to_string(reload.entries) +
+                                                " addresses from " + sharedBlocklistPath() + ", watching\n");
+    }
+    
+    // Long runs log and display less often so the log stays around 10,000 lines
+    long long logInterval = std::max(100LL, simulationTime / 10000 / 100 * 100);
+    long long displayInterval = logInterval * 10;
     
     // Main simulation loop
-    for (int cycle = 1; cycle <= simulationTime; ++cycle) {
+    for (long long cycle = 1; cycle <= simulationTime; ++cycle) {
         // Add random new requests
         addRandomRequests(loadBalancer, cycle, simulationTime);
         
@@ -238,59 +666,344 @@ int main() {
         loadBalancer.processCycle();
         
         // Log statistics every 100 cycles or at the end
-        if (cycle % 100 == 0 || cycle == simulationTime) {
-            logStatistics(logFilename, loadBalancer, cycle);
+        if (cycle % logInterval == 0 || cycle == simulationTime) {
+            logStatistics(log, loadBalancer, cycle);
             
             // Display status every 1000 cycles
-            if (cycle % 1000 == 0 || cycle == simulationTime) {
+            if (cycle % displayInterval == 0 || cycle == simulationTime) {
+                console.summarize(cycle);
                 displayStatus(loadBalancer, cycle);
             }
         }
         
-        // Small delay to make simulation visible (optional)
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Small delay to make simulation visible (optional); skipped for long runs
+        if (simulationTime <= 50000) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
     }
     
     // Final statistics
-    std::cout << "\n=== Simulation Complete ===" << std::endl;
-    std::cout << "Final Statistics:" << std::endl;
-    std::cout << "- Total requests processed: " << loadBalancer.getTotalRequestsProcessed() << std::endl;
-    std::cout << "- Average processing time: " << std::fixed << std::setprecision(2) 
-              << loadBalancer.getAverageProcessingTime() << " cycles" << std::endl;
-    std::cout << "- Final system utilization: " << std::fixed << std::setprecision(1) 
-              << loadBalancer.getSystemUtilization() << "%" << std::endl;
-    std::cout << "- Final queue size: " << loadBalancer.getQueueSize() << std::endl;
+    TextBuffer summary;
+    summary.append("\n=== Simulation Complete ===\n")
+        .append("Final Statistics:\n")
+        .append("- Total requests processed: ").appendInt(loadBalancer.getTotalRequestsProcessed()).append('\n')
+        .append("- Average processing time: ").appendFixed(loadBalancer.getAverageProcessingTime(), 2)
+        .append(" cycles\n")
+        .append("- Final system utilization: ").appendFixed(loadBalancer.getSystemUtilization(), 1).append("%\n")
+        .append("- Final queue size: ").appendInt(loadBalancer.getQueueSize()).append('\n');
+    if (blocklistReloader) {
+        BlocklistReloadStats reload = blocklistReloader->getStats();
+        const BlocklistLookupStats& lookups = loadBalancer.getRequestQueue().getBlocklistStats();
+        summary.append("- Blocklist: ").appendInt(reload.reloads).append(" loads, ")
+            .appendInt(static_cast<long long>(reload.entries)).append(" addresses, ")
+            .appendInt(static_cast<long long>(lookups.filterPasses - lookups.falsePositives))
+            .append(" requests refused\n");
+    }
+    console.write(summary.str());
     
     // Log final statistics
-    {
-        std::ofstream finalLogFile(logFilename, std::ios::app);
-        if (finalLogFile.is_open()) {
-            finalLogFile << "----------------------------------------" << std::endl;
-            finalLogFile << "ENDING QUEUE SIZE: " << loadBalancer.getQueueSize() << " requests" << std::endl;
-            finalLogFile << "FINAL STATUS:" << std::endl;
-            finalLogFile << "- Total requests processed: " << loadBalancer.getTotalRequestsProcessed() << std::endl;
-            finalLogFile << "- Average processing time: " << std::fixed << std::setprecision(2) 
-                        << loadBalancer.getAverageProcessingTime() << " cycles" << std::endl;
-            finalLogFile << "- Final system utilization: " << std::fixed << std::setprecision(1) 
-                        << loadBalancer.getSystemUtilization() << "%" << std::endl;
-            finalLogFile << "- Final active servers: " << loadBalancer.getActiveServerCount() << std::endl;
-            finalLogFile << "- Remaining requests in queue: " << loadBalancer.getQueueSize() << std::endl;
-            finalLogFile << "- Rejected/discarded requests: 0" << std::endl;
-            finalLogFile.close();
-        }
+    if (log.isOpen()) {
+        log.line().append("----------------------------------------");
+        log.endLine();
+        log.line().append("ENDING QUEUE SIZE: ").appendInt(loadBalancer.getQueueSize()).append(" requests");
+        log.endLine();
+        log.line().append("FINAL STATUS:");
+        log.endLine();
+        log.line().append("- Total requests processed: ").appendInt(loadBalancer.getTotalRequestsProcessed());
+        log.endLine();
+        log.line().append("- Average processing time: ")
+            .appendFixed(loadBalancer.getAverageProcessingTime(), 2).append(" cycles");
+        log.endLine();
+        log.line().append("- Final system utilization: ")
+            .appendFixed(loadBalancer.getSystemUtilization(), 1).append("%");
+        log.endLine();
+        log.line().append("- Final active servers: ").appendInt(loadBalancer.getActiveServerCount());
+        log.endLine();
+        log.line().append("- Remaining requests in queue: ").appendInt(loadBalancer.getQueueSize());
+        log.endLine();
+        log.line().append("- Rejected/discarded requests: 0");
+        log.endLine();
+        log.flush();
     }
     
     // Display server statistics
-    std::cout << "\nServer Statistics:" << std::endl;
-    auto serverStats = loadBalancer.getServerStats();
-    for (const auto& stat : serverStats) {
-        std::cout << "  " << stat << std::endl;
+    summary.clear();
+    summary.append("\nServer Statistics:\n");
+    for (const auto& stat : loadBalancer.getServerStats()) {
+        summary.append("  ").append(stat).append('\n');
     }
-    
-    std::cout << "\nLog file saved as: " << logFilename << std::endl;
+    summary.append("\nLog file saved as: ").append(logFilename).append('\n');
+    console.write(summary.str());
+    if (sharedRecorder()) {
+        try {
+            sharedRecorder()->close();
+            console.write("Recorded " + std::to_string(sharedRecorder()->getRecordCount()) + " requests\n");
+        } catch (const std::exception& e) {
+            console.flush();
+            std::cerr << e.what() << std::endl;
+        }
+    }
+    long long dropped = console.getDroppedMessages();
+    if (dropped > 0) {
+        console.write(std::to_string(dropped) + " console messages were dropped because the terminal fell behind\n");
+    }
+    console.flush();
     std::cout << "Press Enter to exit...";
     std::cin.ignore();
     std::cin.get();
     
     return 0;
-} 
\ No newline at end of file
+} 
+
+/**
+ * @brief Dispatch a batch mode selected on the command line
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return Exit status
+ */
+int runBatchMode(int argc, char* argv[]) {
+    SimulationConfig config;
+    WorkloadParams workload;
+    std::vector<std::string> policies;
+    std::string rareEvent;
+    int replications = -1;
+    unsigned int seed = 1;
+    int threads = 0;
+    bool pinThreads = false;
+    int initialQueue = -1;
+    int levels = 0;
+    int trajectories = 500;
+    int repetitions = 10;
+    LatencySLO slo;
+    bool sizeFleet = false;
+    bool autoscale = false;
+    long long warmup = -1;
+    bool singleRun = false;
+    bool cyclesGiven = false;
+    std::string replayPath;
+    std::string recordPath;
+    std::string workloadPath;
+    double ipv6Share = -1.0;
+    bool rateGiven = false;
+    bool checkEngines = false;
+    bool hugePagesGiven = false;
+    bool consoleGiven = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--compare" && hasValue) {
+            policies = splitList(argv[++i]);
+        } else if (arg == "--servers" && hasValue) {
+            // Up to twice as many servers may be added
+            if (!parseInteger(arg, argv[++i], config.initialServers, 1, std::numeric_limits<int>::max() / 2)) {
+                return 1;
+            }
+        } else if (arg == "--cycles" && hasValue) {
+            if (!parseInteger(arg, argv[++i], config.cycles, 1)) {
+                return 1;
+            }
+            cyclesGiven = true;
+        } else if (arg == "--arrival-rate" && hasValue) {
+            if (!parseReal(arg, argv[++i], workload.arrivalRate, 0.0)) {
+                return 1;
+            }
+            rateGiven = true;
+        } else if (arg == "--ipv6-share" && hasValue) {
+            if (!parseReal(arg, argv[++i], ipv6Share, 0.0, 1.0)) {
+                return 1;
+            }
+        } else if (arg == "--replications" && hasValue) {
+            if (!parseInteger(arg, argv[++i], replications, 1)) {
+                return 1;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            if (!parseInteger(arg, argv[++i], seed, 0)) {
+                return 1;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            if (!parseInteger(arg, argv[++i], threads, 0)) {
+                return 1;
+            }
+        } else if (arg == "--pin-threads") {
+            pinThreads = true;
+        } else if (arg == "--initial-queue" && hasValue) {
+            if (!parseInteger(arg, argv[++i], initialQueue, 0)) {
+                return 1;
+            }
+        } else if (arg == "--policy" && hasValue) {
+            if (!parseDistributionPolicy(argv[++i], config.policy)) {
+                std::cerr << "Unknown policy: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--rare-event" && hasValue) {
+            rareEvent = argv[++i];
+        } else if (arg == "--levels" && hasValue) {
+            if (!parseInteger(arg, argv[++i], levels, 0)) {
+                return 1;
+            }
+        } else if (arg == "--trajectories" && hasValue) {
+            if (!parseInteger(arg, argv[++i], trajectories, 1)) {
+                return 1;
+            }
+        } else if (arg == "--repetitions" && hasValue) {
+            if (!parseInteger(arg, argv[++i], repetitions, 1)) {
+                return 1;
+            }
+        } else if (arg == "--slo" && hasValue) {
+            if (!parseInteger(arg, argv[++i], slo.maxLatency, 1)) {
+                return 1;
+            }
+            sizeFleet = true;
+        } else if (arg == "--percentile" && hasValue) {
+            if (!parseReal(arg, argv[++i], slo.percentile, 0.0, 100.0)) {
+                return 1;
+            }
+        } else if (arg == "--warmup" && hasValue) {
+            if (!parseInteger(arg, argv[++i], warmup, 0)) {
+                return 1;
+            }
+        } else if (arg == "--autoscale") {
+            autoscale = true;
+        } else if (arg == "--max-queue" && hasValue) {
+            if (!parseInteger(arg, argv[++i], config.maxQueueSize, 1)) {
+                return 1;
+            }
+        } else if (arg == "--queue-budget" && hasValue) {
+            size_t megabytes = 0;
+            if (!parseInteger(arg, argv[++i], megabytes, 0, static_cast<long long>(SIZE_MAX >> 20))) {
+                return 1;
+            }
+            config.queueMemoryBudget = megabytes << 20;
+        } else if (arg == "--spill-dir" && hasValue) {
+            config.spillDirectory = argv[++i];
+        } else if (arg == "--run") {
+            singleRun = true;
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg == "--workload" && hasValue) {
+            workloadPath = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--console" && hasValue) {
+            ConsoleVerbosity level;
+            if (!ConsoleSink::parseVerbosity(argv[++i], level)) {
+                std::cerr << "Unknown console verbosity: " << argv[i] << std::endl;
+                return 1;
+            }
+            sharedConsole().setVerbosity(level);
+            consoleGiven = true;
+        } else if (arg == "--blocklist" && hasValue) {
+            sharedBlocklistPath() = argv[++i];
+        } else if (arg == "--check-engines") {
+            checkEngines = true;
+        } else if (arg == "--huge-pages" && hasValue) {
+            HugePageMode mode;
+            if (!HugePages::parseMode(argv[++i], mode)) {
+                std::cerr << "Unknown huge page mode: " << argv[i] << std::endl;
+                return 1;
+            }
+            HugePages::setMode(mode);
+            hugePagesGiven = true;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    
+    if (hugePagesGiven && !checkEngines) {
+        // Only the fast engine allocates through HugePages
+        std::cerr << "--huge-pages applies only to --check-engines" << std::endl;
+        return 1;
+    }
+    
+    if (!workloadPath.empty()) {
+        double rate = workload.arrivalRate;
+        try {
+            workload = readWorkloadParams(workloadPath);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        if (rateGiven) {
+            workload.arrivalRate = rate;
+        }
+    }
+    if (ipv6Share >= 0.0) {
+        workload.ipv6Share = ipv6Share;
+    }
+    
+    // Same sizing rules as the interactive mode
+    config.maxServers = config.initialServers * 2;
+    config.initialQueueSize = initialQueue >= 0 ? initialQueue : config.initialServers * 100;
+    if (config.queueMemoryBudget > 0) {
+        try {
+            SpillSegment::checkDirectory(config.spillDirectory);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!replayPath.empty()) {
+        // The trace supplies the backlog and the run length unless --cycles caps it
+        config.cycles = cyclesGiven ? config.cycles : 0;
+        config.warmupCycles = warmup >= 0 ? warmup : 0;
+        return runReplay(replayPath, config);
+    }
+    if (checkEngines && recordPath.empty()) {
+        return runEngineCheck(config, workload, seed);
+    }
+    std::unique_ptr<TraceRecorder> recorder;
+    if (!recordPath.empty()) {
+        try {
+            recorder = std::make_unique<TraceRecorder>(recordPath);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (singleRun) {
+        return runSingle(config, workload, seed, recorder.get());
+    }
+    if ((recorder || consoleGiven || !sharedBlocklistPath().empty()) && policies.empty() && rareEvent.empty() && !sizeFleet && !checkEngines) {
+        sharedRecorder() = std::move(recorder);
+        return runInteractive();
+    }
+    if (recorder) {
+        std::cerr << "--record applies to --run and the interactive simulation" << std::endl;
+        return 1;
+    }
+    if (sizeFleet) {
+        config.initialQueueSize = initialQueue >= 0 ? initialQueue : 0;
+        config.arrivalCutoff = 1.0;
+        config.warmupCycles = warmup >= 0 ? warmup : config.cycles / 10;
+        return runFleetSizing(slo, config, workload, replications > 0 ? replications : 8, seed,
+                              threads, autoscale, pinThreads);
+    }
+    if (!rareEvent.empty()) {
+        return runRareEvent(rareEvent, config, workload, levels, trajectories, repetitions, seed, threads,
+                            pinThreads);
+    }
+    if (policies.empty()) {
+        printUsage();
+        return 1;
+    }
+    return runComparison(policies, config, workload, replications > 0 ? replications : 30, seed, threads,
+                         pinThreads);
+}
+
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatchMode(argc, argv);
+    }
+    return runInteractive();
+}
@@ -0,0 +1,470 @@
+/**
+ * @file microbench.cpp
+ * @brief Microbenchmarks for the blocklist, HTTP parser and timer wheel
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ *
+ * Times the hot paths that admission and the networked programs depend
+ * on, each in isolation and with self-checks: blocklist lookups during
+ * reloads, HTTP/1.1 request parsing, and connection timeouts in a
+ * TimerWheel. Kept apart from the simulator so it links only what the
+ * benchmarks exercise.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "BlocklistStore.h"
+#include "HttpParser.h"
+#include "IPAddress.h"
+#include "IPBlocklist.h"
+#include "Request.h"
+#include "RequestQueue.h"
+#include "TimerWheel.h"
+
+/**
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: microbench blocklist N [--seed S]  Time admission checks against N blocked addresses"
+              << std::endl;
+    std::cout << "       microbench http N [--seed S]       Time parsing N pipelined HTTP/1.1 requests" << std::endl;
+    std::cout << "       microbench timers N [--seed S]     Time arming and expiring N connection timeouts"
+              << std::endl;
+    std::cout << "Each benchmark exits non-zero if its self-checks fail." << std::endl;
+}
+
+/**
+ * @brief Time blocklist checks in batches, recording the slowest batch
+ * @param queue Queue whose blocklist is checked
+ * @param probes Addresses to check
+ * @param rounds Passes over the probes
+ * @param hits Incremented for each blocked address
+ * @param slowestBatch Set to the slowest batch's duration in seconds
+ * @return Total seconds
+ */
+double timeBlocklistChecks(const RequestQueue& queue, const std::vector<IPAddress>& probes, int rounds,
+                           long long& hits, double& slowestBatch) {
+    using Clock = std::chrono::steady_clock;
+    const size_t batchSize = 1024;
+    double total = 0.0;
+    slowestBatch = 0.0;
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t first = 0; first < probes.size(); first += batchSize) {
+            size_t last = std::min(probes.size(), first + batchSize);
+            auto start = Clock::now();
+            for (size_t i = first; i < last; ++i) {
+                hits += queue.isIPBlocked(probes[i]) ? 1 : 0;
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            slowestBatch = std::max(slowestBatch, seconds);
+            total += seconds;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Time blocklist checks pinning one snapshot per batch, as RequestQueue::addRequests does
+ * @param store Blocklist store
+ * @param probes Addresses to check
+ * @param rounds Passes over the probes
+ * @param hits Incremented for each blocked address
+ * @return Total seconds
+ */
+double timePinnedChecks(const BlocklistStore& store, const std::vector<IPAddress>& probes, int rounds,
+                        long long& hits) {
+    using Clock = std::chrono::steady_clock;
+    const size_t batchSize = 1024;
+    auto start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t first = 0; first < probes.size(); first += batchSize) {
+            size_t last = std::min(probes.size(), first + batchSize);
+            BlocklistStore::Snapshot blocklist = store.acquire();
+            for (size_t i = first; i < last; ++i) {
+                hits += blocklist->contains(probes[i]) ? 1 : 0;
+            }
+        }
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Time admission-time blocklist checks against a large blocklist
+ * 
+ * Also republishes the blocklist from another thread while checks run, as
+ * a reload mid-incident would, to show admission is not paused by it.
+ * @param entries Number of blocked addresses
+ * @param seed Seed for the random addresses
+ * @return Exit status
+ */
+int runBlocklistBenchmark(long long entries, unsigned int seed) {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 engine(seed);
+    // Mostly IPv6 clients, as in production traffic
+    auto randomAddress = [&engine]() {
+        if (engine() % 5 < 3) {
+            uint64_t high = (0x20010DB8ull << 32) | engine();
+            return IPAddress(high, (static_cast<uint64_t>(engine()) << 32) | engine());
+        }
+        return IPAddress::fromIPv4(static_cast<uint32_t>(engine()));
+    };
+    
+    std::vector<IPAddress> addresses;
+    addresses.reserve(static_cast<size_t>(std::max(0LL, entries)));
+    for (long long i = 0; i < entries; ++i) {
+        addresses.push_back(randomAddress());
+    }
+    auto buildBlocklist = [&addresses]() {
+        std::unique_ptr<IPBlocklist> blocklist(new IPBlocklist(addresses.size()));
+        for (const auto& ip : addresses) {
+            blocklist->add(ip);
+        }
+        return blocklist;
+    };
+    
+    RequestQueue queue;
+    BlocklistStore& store = queue.getBlocklistStore();
+    auto start = Clock::now();
+    store.publish(buildBlocklist());
+    double buildSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::unordered_set<IPAddress, IPAddressHash> plainSet(addresses.begin(), addresses.end());
+    
+    // Mostly unblocked clients, as in normal traffic, plus 1% blocked ones
+    const int probeCount = 1 << 20;
+    std::vector<IPAddress> probes;
+    probes.reserve(probeCount);
+    for (int i = 0; i < probeCount; ++i) {
+        probes.push_back(randomAddress());
+    }
+    auto blocked = plainSet.begin();
+    for (int i = 0; i < probeCount && blocked != plainSet.end(); i += 100, ++blocked) {
+        probes[i] = *blocked;
+    }
+    
+    const int rounds = 8;
+    long long hits = 0;
+    double idleSlowest = 0.0;
+    double filterSeconds = timeBlocklistChecks(queue, probes, rounds, hits, idleSlowest);
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const auto& ip : probes) {
+            hits -= plainSet.count(ip);
+        }
+    }
+    double setSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    // The same lookups keyed by address text, as before addresses were packed
+    std::unordered_set<std::string> textSet;
+    textSet.reserve(addresses.size());
+    for (const auto& ip : addresses) {
+        textSet.insert(ip.toString());
+    }
+    std::vector<std::string> probeTexts;
+    probeTexts.reserve(probeCount);
+    for (const auto& ip : probes) {
+        probeTexts.push_back(ip.toString());
+    }
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const auto& text : probeTexts) {
+            hits -= textSet.count(text);
+        }
+    }
+    double textSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    hits += rounds * static_cast<long long>(std::count_if(
+        probes.begin(), probes.end(), [&plainSet](const IPAddress& ip) { return plainSet.count(ip) > 0; }));
+    BlocklistLookupStats idleStats = queue.getBlocklistStats();
+    long long pinnedHits = 0;
+    double pinnedSeconds = timePinnedChecks(store, probes, rounds, pinnedHits);
+    RequestQueue emptyQueue;
+    long long emptyHits = 0;
+    double emptySlowest = 0.0;
+    double emptySeconds = timeBlocklistChecks(emptyQueue, probes, rounds, emptyHits, emptySlowest);
+    
+    // Republish the same list repeatedly while checking, so the results must not change
+    const int reloads = 4;
+    double reloadSeconds = 0.0;
+    std::thread reloader([&]() {
+        auto reloadStart = Clock::now();
+        for (int i = 0; i < reloads; ++i) {
+            store.publish(buildBlocklist());
+        }
+        reloadSeconds = std::chrono::duration<double>(Clock::now() - reloadStart).count();
+    });
+    long long reloadHits = 0;
+    long long reloadChecks = 0;
+    double reloadCheckSeconds = 0.0;
+    double reloadSlowest = 0.0;
+    while (store.getVersion() < static_cast<uint64_t>(reloads) + 1 || reloadChecks == 0) {
+        double slowest = 0.0;
+        reloadCheckSeconds += timeBlocklistChecks(queue, probes, 1, reloadHits, slowest);
+        reloadSlowest = std::max(reloadSlowest, slowest);
+        reloadChecks += probeCount;
+    }
+    reloader.join();
+    long long expectedHits = static_cast<long long>(std::count_if(
+        probes.begin(), probes.end(), [&plainSet](const IPAddress& ip) { return plainSet.count(ip) > 0; }));
+    
+    BlocklistStore::Snapshot blocklist = store.acquire();
+    double checks = static_cast<double>(probeCount) * rounds;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Blocklist: " << blocklist->size() << " addresses, built in " << buildSeconds << " s, filter "
+              << blocklist->getFilterBytes() / 1024.0 << " KB" << std::endl;
+    std::cout << "Admission check: " << filterSeconds / checks * 1e9 << " ns with filter, "
+              << setSeconds / checks * 1e9 << " ns address set only, " << textSeconds / checks * 1e9
+              << " ns text set; slowest 1024 checks "
+              << idleSlowest * 1e6 << " us" << std::endl;
+    std::cout << "Pinned once per 1024 checks: " << pinnedSeconds / checks * 1e9 << " ns; empty blocklist: "
+              << emptySeconds / checks * 1e9 << " ns" << std::endl;
+    std::cout << std::setprecision(4) << "False-positive rate: " << idleStats.getFalsePositiveRate() * 100.0
+              << "% observed, " << blocklist->getFilterFalsePositiveRate() * 100.0 << "% from filter bits"
+              << std::endl;
+    std::cout << std::setprecision(2) << "During " << reloads << " reloads (" << reloadSeconds / reloads
+              << " s each): " << reloadChecks << " checks at " << reloadCheckSeconds / reloadChecks * 1e9
+              << " ns, slowest 1024 checks " << reloadSlowest * 1e6 << " us, "
+              << store.getPendingSnapshots() << " retired snapshots pending" << std::endl;
+    bool consistent = hits == 0 && reloadHits == expectedHits * (reloadChecks / probeCount) &&
+                      pinnedHits == expectedHits * rounds && emptyHits == 0;
+    return consistent ? 0 : 1;
+}
+
+/**
+ * @brief Time arming, re-arming and expiring connection timeouts in a TimerWheel
+ * @param timers Number of concurrent timers
+ * @param seed Seed for deadlines and re-arm order
+ * @return Exit status
+ */
+int runTimerBenchmark(long long timers, unsigned int seed) {
+    using Clock = std::chrono::steady_clock;
+    const uint64_t millisecond = 1000000;
+    const uint64_t step = 10 * millisecond;  // Event-loop timer period
+    std::mt19937_64 engine(seed);
+    std::vector<TimerNode> nodes(static_cast<size_t>(timers));
+    std::vector<uint64_t> deadlines(nodes.size());
+    TimerWheel wheel(0, millisecond);
+    uint64_t now = 0;
+    
+    // One idle timeout per connection, spread over a minute
+    auto start = Clock::now();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].tag = i;
+        deadlines[i] = 1000 * millisecond + engine() % (60000 * millisecond);
+        wheel.arm(nodes[i], deadlines[i]);
+    }
+    double armSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    // Activity pushes deadlines back; a quarter of connections also change state
+    std::vector<size_t> order(nodes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = engine() % nodes.size();
+    }
+    start = Clock::now();
+    for (size_t i = 0; i < order.size(); ++i) {
+        size_t index = order[i];
+        if (i % 4 == 0) {
+            wheel.cancel(nodes[index]);
+        }
+        deadlines[index] += (i % 7) * millisecond;
+        wheel.arm(nodes[index], deadlines[index]);
+    }
+    double rearmSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    // Run the clock as an event loop would until every timer has fired
+    long long fired = 0;
+    long long early = 0;
+    uint64_t latest = 0;
+    start = Clock::now();
+    while (wheel.size() > 0) {
+        now += step;
+        fired += static_cast<long long>(wheel.advance(now, [&](TimerNode& node) {
+            uint64_t deadline = deadlines[node.tag];
+            early += now < deadline;
+            latest = std::max(latest, now - std::min(now, deadline));
+        }));
+    }
+    double expireSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Timers: " << timers << " connections, 1 ms ticks, advanced every " << step / millisecond
+              << " ms" << std::endl;
+    std::cout << "Arm: " << armSeconds / timers * 1e9 << " ns, re-arm: " << rearmSeconds / timers * 1e9
+              << " ns, expire: " << expireSeconds / timers * 1e9 << " ns per timer" << std::endl;
+    std::cout << "Fired " << fired << ", latest " << static_cast<double>(latest) / millisecond
+              << " ms after its deadline" << std::endl;
+    if (fired != timers || early != 0) {
+        std::cerr << "Fired " << fired << " of " << timers << " timers, " << early << " early" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Time HTTP/1.1 parsing of pipelined requests arriving in partial reads
+ * @param requests Number of requests to parse
+ * @param seed Seed for the request mix and read sizes
+ * @return Exit status
+ */
+int runHttpBenchmark(long long requests, unsigned int seed) {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 engine(seed);
+    static const char* methods[] = {"GET", "GET", "GET", "POST", "PUT", "DELETE", "HEAD", "PATCH"};
+    
+    // A browser-like mix: mostly bodiless GETs, some uploads, a few chunked
+    std::string wire;
+    std::vector<std::string> expectedTypes;
+    for (long long i = 0; i < requests; ++i) {
+        const char* method = methods[engine() % 8];
+        std::string body = std::string(method) == "POST" || std::string(method) == "PUT"
+                               ? std::string(2 + engine() % 510, 'x') : std::string();
+        bool chunked = !body.empty() && engine() % 4 == 0;
+        wire += std::string(method) + " /api/v1/items/" + std::to_string(engine() % 100000) + "?page=" +
+                std::to_string(engine() % 50) + " HTTP/1.1\r\n";
+        wire += "Host: shop.example.com\r\n";
+        wire += "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n";
+        wire += "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n";
+        wire += "Accept-Encoding: gzip, deflate, br\r\n";
+        wire += "X-Forwarded-For: 2001:db8::" + std::to_string(engine() % 10000) + ", 10.0.0.1\r\n";
+        if (chunked) {
+            wire += "Transfer-Encoding: chunked\r\n\r\n";
+            size_t half = body.size() / 2;
+            char size[32];
+            std::snprintf(size, sizeof(size), "%zx\r\n", half);
+            wire += size + body.substr(0, half) + "\r\n";
+            std::snprintf(size, sizeof(size), "%zx\r\n", body.size() - half);
+            wire += size + body.substr(half) + "\r\n0\r\n\r\n";
+        } else {
+            if (!body.empty()) {
+                wire += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+            }
+            wire += "\r\n" + body;
+        }
+        expectedTypes.push_back(HttpParser::requestTypeOf(HttpParser::parseMethod(method)));
+    }
+    
+    // Read sizes as a socket would deliver them, split anywhere
+    std::vector<size_t> reads;
+    for (size_t offset = 0; offset < wire.size();) {
+        size_t size = std::min<size_t>(wire.size() - offset, 1 + engine() % 16384);
+        reads.push_back(size);
+        offset += size;
+    }
+    
+    const IPAddress peer = IPAddress::fromIPv4(0x0A000001);
+    HttpRequestView view;
+    long long mismatches = 0;
+    
+    // Whole buffer at once: pure parsing cost
+    HttpParser parser;
+    long long parsed = 0;
+    auto start = Clock::now();
+    std::string_view remaining(wire);
+    while (parser.parse(remaining, view) == HttpParseStatus::COMPLETE) {
+        remaining.remove_prefix(view.length);
+        parsed++;
+    }
+    double wholeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (parsed != requests) {
+        std::cerr << "Parsed " << parsed << " of " << requests << " requests: " << parser.getError() << std::endl;
+        return 1;
+    }
+    
+    // Partial reads into a compacting receive buffer, converted to queued requests
+    parsed = 0;
+    std::string buffer;
+    size_t consumed = 0;
+    size_t offset = 0;
+    start = Clock::now();
+    for (size_t size : reads) {
+        if (consumed > 0 && consumed >= buffer.size() / 2) {
+            buffer.erase(0, consumed);
+            consumed = 0;
+        }
+        buffer.append(wire, offset, size);
+        offset += size;
+        while (true) {
+            HttpParseStatus status = parser.parse(std::string_view(buffer).substr(consumed), view);
+            if (status == HttpParseStatus::INVALID) {
+                std::cerr << "Invalid request " << parsed << ": " << parser.getError() << std::endl;
+                return 1;
+            }
+            if (status == HttpParseStatus::INCOMPLETE) {
+                break;
+            }
+            Request request = toRequest(view, peer, 10, parsed);
+            mismatches += request.getRequestType() != expectedTypes[static_cast<size_t>(parsed)] ||
+                          request.getClientAddress().isIPv4();
+            consumed += view.length;
+            parsed++;
+        }
+    }
+    double readSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    
+    double megabytes = wire.size() / 1e6;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "HTTP: " << requests << " pipelined requests, " << megabytes << " MB" << std::endl;
+    std::cout << "Whole buffer: " << megabytes / wholeSeconds << " MB/s, " << wholeSeconds / requests * 1e9
+              << " ns per request" << std::endl;
+    std::cout << reads.size() << " partial reads with toRequest(): " << megabytes / readSeconds << " MB/s, "
+              << readSeconds / requests * 1e9 << " ns per request" << std::endl;
+    if (parsed != requests || mismatches != 0) {
+        std::cerr << "Parsed " << parsed << " requests, " << mismatches << " mismatched" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string command = argv[1];
+    unsigned int seed = 1;
+    long long count = 0;
+    try {
+        count = std::stoll(argv[2]);
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--seed" && i + 1 < argc) {
+                seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+        if (count < 0) {
+            throw std::invalid_argument("N must not be negative");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    if (command == "blocklist") {
+        return runBlocklistBenchmark(count, seed);
+    }
+    if (command == "http") {
+        return runHttpBenchmark(count, seed);
+    }
+    if (command == "timers") {
+        return runTimerBenchmark(count, seed);
+    }
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file proxy.cpp
+ * @brief Networked HTTP/1.1 load balancer in front of real backends
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ *
+ * Listens on a local port and spreads HTTP/1.1 requests over the
+ * --backend servers with one shared-nothing worker per core. Runs until
+ * interrupted or for --duration seconds, then prints its counters.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <iostream>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include "ProxyServer.h"
+#include "Simulation.h"
+
+/**
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: proxy --backend ADDR [--backend ADDR ...] [options]" << std::endl;
+    std::cout << "  --host ADDR          Listen address (default 127.0.0.1)" << std::endl;
+    std::cout << "  --port N             Listen port, 0 for any free port (default 8080)" << std::endl;
+    std::cout << "  --backend ADDR       Upstream server, HOST:PORT or unix:PATH; repeat for each backend" << std::endl;
+    std::cout << "  --workers N          Worker threads, 0 for one per usable CPU (default 0)" << std::endl;
+    std::cout << "  --pin-threads        Bind each worker to its own CPU" << std::endl;
+    std::cout << "  --policy P           Backend selection: rr or lc (default rr)" << std::endl;
+    std::cout << "  --max-queue N        Queued requests per worker before 503 (default 10000)" << std::endl;
+    std::cout << "  --pool N             Upstream connections per worker and backend (default 32)" << std::endl;
+    std::cout << "  --upstream-http2     Multiplex requests over HTTP/2 (h2c) backend connections" << std::endl;
+    std::cout << "  --streams N          Concurrent streams per HTTP/2 backend connection (default 100)" << std::endl;
+    std::cout << "  --trust-forwarded-for Take the client address from X-Forwarded-For (only behind a trusted proxy)" << std::endl;
+    std::cout << "  --sync-ms N          Interval between load exchanges and timeout checks (default 10)" << std::endl;
+    std::cout << "  --idle-timeout MS    Close keep-alive connections idle this long (default 60000)" << std::endl;
+    std::cout << "  --header-timeout MS  Close with 408 if a request is incomplete this long (default 10000)" << std::endl;
+    std::cout << "  --request-timeout MS Answer 504 if a request is unanswered this long (default 30000)" << std::endl;
+    std::cout << "  --duration S         Stop after S seconds instead of on SIGINT/SIGTERM" << std::endl;
+}
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    ProxyConfig config;
+    double duration = 0.0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--host" && hasValue) {
+                config.host = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                config.port = std::stoi(argv[++i]);
+            } else if (arg == "--backend" && hasValue) {
+                config.backends.push_back(BackendAddress::parse(argv[++i]));
+            } else if (arg == "--workers" && hasValue) {
+                config.workers = std::stoi(argv[++i]);
+            } else if (arg == "--pin-threads") {
+                config.pinWorkers = true;
+            } else if (arg == "--policy" && hasValue) {
+                if (!parseDistributionPolicy(argv[++i], config.policy)) {
+                    throw std::invalid_argument(std::string("unknown policy: ") + argv[i]);
+                }
+            } else if (arg == "--max-queue" && hasValue) {
+                config.queueLimit = std::stoi(argv[++i]);
+            } else if (arg == "--pool" && hasValue) {
+                config.connectionsPerBackend = std::stoi(argv[++i]);
+            } else if (arg == "--upstream-http2") {
+                config.upstreamHttp2 = true;
+            } else if (arg == "--streams" && hasValue) {
+                config.maxStreamsPerConnection = std::stoi(argv[++i]);
+            } else if (arg == "--trust-forwarded-for") {
+                config.trustForwardedFor = true;
+            } else if (arg == "--sync-ms" && hasValue) {
+                config.syncMilliseconds = std::stoi(argv[++i]);
+            } else if (arg == "--idle-timeout" && hasValue) {
+                config.idleTimeoutMilliseconds = std::stoi(argv[++i]);
+            } else if (arg == "--header-timeout" && hasValue) {
+                config.headerTimeoutMilliseconds = std::stoi(argv[++i]);
+            } else if (arg == "--request-timeout" && hasValue) {
+                config.requestTimeoutMilliseconds = std::stoi(argv[++i]);
+            } else if (arg == "--duration" && hasValue) {
+                duration = std::stod(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        if (config.backends.empty()) {
+            throw std::invalid_argument("at least one --backend is required");
+        }
+        if (config.port < 0 || config.port > 65535 || config.workers < 0 || config.queueLimit < 1 ||
+            config.connectionsPerBackend < 1 || config.syncMilliseconds < 1 || config.idleTimeoutMilliseconds < 1 ||
+            config.headerTimeoutMilliseconds < 1 || config.requestTimeoutMilliseconds < 1 ||
+            config.maxStreamsPerConnection < 1) {
+            throw std::invalid_argument("option out of range");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Block the stop signals before any thread starts so only sigtimedwait sees them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ProxyServer proxy(config);
+    try {
+        proxy.start();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "proxy listening on " << config.host << ":" << proxy.getPort() << " (" << proxy.getWorkerCount()
+              << " workers, " << config.backends.size() << " backends, "
+              << (config.policy == DistributionPolicy::LEAST_CONNECTIONS ? "least connections" : "round robin")
+              << (config.upstreamHttp2 ? ", HTTP/2 upstream" : "") << ")" << std::endl;
+
+    if (duration > 0) {
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(duration);
+        timeout.tv_nsec = static_cast<long>((duration - static_cast<double>(timeout.tv_sec)) * 1e9);
+        while (sigtimedwait(&stopSignals, nullptr, &timeout) < 0 && errno == EINTR) {
+        }
+    } else {
+        int signal = 0;
+        sigwait(&stopSignals, &signal);
+    }
+    proxy.stop();
+
+    ProxyStats stats = proxy.getStats();
+    std::cout << "Connections: " << stats.connections << std::endl;
+    std::cout << "Requests: " << stats.requests << " (" << stats.responses << " relayed, " << stats.rejected
+              << " rejected, " << stats.upstreamErrors << " upstream errors, " << stats.invalid << " invalid)"
+              << std::endl;
+    std::cout << "Upstream connects: " << stats.upstreamConnects << ", load exchanges: " << stats.loadSyncs
+              << std::endl;
+    std::cout << "Timeouts: " << stats.idleTimeouts << " idle or incomplete connections closed, "
+              << stats.requestTimeouts << " requests answered 504" << std::endl;
+    std::cout << "I/O buffers: " << stats.bufferBytes / 1024 << " KB of slabs, peak " << stats.peakBufferBytes / 1024
+              << " KB in use" << std::endl;
+    for (size_t b = 0; b < config.backends.size(); ++b) {
+        std::cout << "  backend " << config.backends[b].toString() << ": "
+                  << stats.backendResponses[b] << " responses" << std::endl;
+    }
+    for (size_t w = 0; w < stats.workerRequests.size(); ++w) {
+        std::cout << "  worker " << w << ": " << stats.workerRequests[w] << " requests" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file stubserver.cpp
+ * @brief Local stub backend for benchmarking a networked load balancer
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ *
+ * Serves HTTP/1.1 on a local port with WebServer-like capacity, a
+ * configurable service-time distribution, and injected errors, dropped
+ * connections and slow responses, so a balancer can be benchmarked
+ * without outside services. Runs until interrupted or for --duration
+ * seconds, then prints its counters.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <iostream>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include "StubServer.h"
+
+/**
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: stubserver [options]" << std::endl;
+    std::cout << "  --host ADDR          Listen address (default 127.0.0.1)" << std::endl;
+    std::cout << "  --port N             Listen port, 0 for any free port (default 8081)" << std::endl;
+    std::cout << "  --unix PATH          Listen on a Unix domain socket instead of TCP" << std::endl;
+    std::cout << "  --id N               Server ID reported in the X-Server header (default 0)" << std::endl;
+    std::cout << "  --threads N          Event-loop threads (default 1)" << std::endl;
+    std::cout << "  --capacity N         Requests in service at once, 0 for unlimited (default 0)" << std::endl;
+    std::cout << "  --reject             Answer 503 at capacity instead of queueing" << std::endl;
+    std::cout << "  --service MODEL      fixed:US, uniform:MIN:MAX, exp:MEAN or lognormal:MEDIAN:SIGMA," << std::endl;
+    std::cout << "                       in microseconds (default fixed:0)" << std::endl;
+    std::cout << "  --error-rate F       Fraction of requests answered 500" << std::endl;
+    std::cout << "  --drop-rate F        Fraction of requests whose connection is closed unanswered" << std::endl;
+    std::cout << "  --slow-rate F        Fraction of requests served --slow-factor times slower" << std::endl;
+    std::cout << "  --slow-factor X      Service time multiplier for slow requests (default 10)" << std::endl;
+    std::cout << "  --body N             Response body bytes (default 64)" << std::endl;
+    std::cout << "  --continue           Send 100 Continue ahead of every HTTP/1.1 response" << std::endl;
+    std::cout << "  --seed N             Seed for service times and faults (default 1)" << std::endl;
+    std::cout << "  --duration S         Stop after S seconds instead of on SIGINT/SIGTERM" << std::endl;
+}
+
+/**
+ * @brief Parse a fraction argument
+ * @param text Argument
+ * @param name Option name for the error message
+ * @return Value in [0, 1]
+ * @throws std::invalid_argument if out of range
+ */
+double parseFraction(const std::string& text, const std::string& name) {
+    double value = std::stod(text);
+    if (!(value >= 0.0 && value <= 1.0)) {
+        throw std::invalid_argument(name + " must be between 0 and 1");
+    }
+    return value;
+}
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    StubServerConfig config;
+    double duration = 0.0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--host" && hasValue) {
+                config.host = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                config.port = std::stoi(argv[++i]);
+            } else if (arg == "--unix" && hasValue) {
+                config.unixPath = argv[++i];
+            } else if (arg == "--id" && hasValue) {
+                config.serverID = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                config.threads = std::stoi(argv[++i]);
+            } else if (arg == "--capacity" && hasValue) {
+                config.maxCapacity = std::stoi(argv[++i]);
+            } else if (arg == "--reject") {
+                config.rejectWhenFull = true;
+            } else if (arg == "--service" && hasValue) {
+                config.serviceTime = ServiceTimeModel::parse(argv[++i]);
+            } else if (arg == "--error-rate" && hasValue) {
+                config.errorRate = parseFraction(argv[++i], arg);
+            } else if (arg == "--drop-rate" && hasValue) {
+                config.dropRate = parseFraction(argv[++i], arg);
+            } else if (arg == "--slow-rate" && hasValue) {
+                config.slowRate = parseFraction(argv[++i], arg);
+            } else if (arg == "--slow-factor" && hasValue) {
+                config.slowFactor = std::stod(argv[++i]);
+            } else if (arg == "--body" && hasValue) {
+                config.bodyBytes = static_cast<size_t>(std::stoul(argv[++i]));
+            } else if (arg == "--continue") {
+                config.sendContinue = true;
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--duration" && hasValue) {
+                duration = std::stod(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        if (config.port < 0 || config.port > 65535 || config.threads < 1 || config.maxCapacity < 0 ||
+            config.slowFactor < 0 || config.errorRate + config.dropRate > 1.0) {
+            throw std::invalid_argument("option out of range");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Block the stop signals before any thread starts so only sigtimedwait sees them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    StubServer server(config);
+    try {
+        server.start();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "stubserver " << config.serverID << " listening on "
+              << (config.unixPath.empty() ? config.host + ":" + std::to_string(server.getPort()) : config.unixPath)
+              << " (" << config.threads << " threads, service " << config.serviceTime.describe() << " us, capacity "
+              << (config.maxCapacity > 0 ? std::to_string(config.maxCapacity) : std::string("unlimited")) << ")"
+              << std::endl;
+
+    if (duration > 0) {
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(duration);
+        timeout.tv_nsec = static_cast<long>((duration - static_cast<double>(timeout.tv_sec)) * 1e9);
+        while (sigtimedwait(&stopSignals, nullptr, &timeout) < 0 && errno == EINTR) {
+        }
+    } else {
+        int signal = 0;
+        sigwait(&stopSignals, &signal);
+    }
+    server.stop();
+
+    StubServerStats stats = server.getStats();
+    std::cout << "Connections: " << stats.connections << std::endl;
+    std::cout << "Requests: " << stats.requests << " (" << stats.responses << " answered, " << stats.errors
+              << " injected errors, " << stats.rejected << " rejected, " << stats.dropped << " dropped, "
+              << stats.invalid << " invalid)" << std::endl;
+    std::cout << "Slowed: " << stats.slow << ", queued for capacity: " << stats.queued
+              << ", peak in service per thread: " << stats.maxInService << std::endl;
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_interim_responses.cpp
+ * @brief Checks that interim 1xx responses are framed and relayed correctly
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ *
+ * Covers HttpParser::parseResponse on interim responses, whole and fed in
+ * pieces, and a proxy in front of a backend that sends 100 Continue ahead
+ * of every response. Exits non-zero if any check fails.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "HttpParser.h"
+#include "ProxyServer.h"
+#include "SocketUtils.h"
+#include "StubServer.h"
+
+namespace {
+
+int failures = 0;  ///< Checks failed so far
+
+/**
+ * @brief Record the outcome of one check
+ * @param passed Whether the check held
+ * @param what Description printed on failure
+ */
+void check(bool passed, const std::string& what) {
+    if (!passed) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+const std::string CONTINUE = "HTTP/1.1 100 Continue\r\n\r\n";
+const std::string FINAL = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+/**
+ * @brief Parse a 100 Continue and its final response from one buffer
+ */
+void testWholeResponse() {
+    std::string data = CONTINUE + FINAL;
+    HttpParser parser;
+    HttpResponseView response;
+    check(parser.parseResponse(data, false, response) == HttpParseStatus::COMPLETE, "interim + final is COMPLETE");
+    check(response.status == 200, "status is the final response's");
+    check(response.interimLength == CONTINUE.size(), "interim length covers the 100 Continue");
+    check(response.length == data.size(), "length covers both responses");
+}
+
+/**
+ * @brief Feed the same bytes one at a time, as a slow upstream would
+ */
+void testIncrementalResponse() {
+    std::string data = CONTINUE + "HTTP/1.1 103 Early Hints\r\nLink: </a.css>; rel=preload\r\n\r\n" + FINAL;
+    HttpParser parser;
+    HttpResponseView response;
+    for (size_t length = 1; length < data.size(); ++length) {
+        if (parser.parseResponse(std::string_view(data).substr(0, length), false, response) !=
+            HttpParseStatus::INCOMPLETE) {
+            check(false, "prefix of " + std::to_string(length) + " bytes is INCOMPLETE");
+            return;
+        }
+    }
+    check(parser.parseResponse(data, false, response) == HttpParseStatus::COMPLETE, "fed bytewise is COMPLETE");
+    check(response.status == 200, "bytewise status is the final response's");
+    check(response.length == data.size(), "bytewise length covers all three responses");
+}
+
+/**
+ * @brief Frame two pipelined responses that each start with 100 Continue
+ */
+void testPipelinedResponses() {
+    std::string data = CONTINUE + FINAL + CONTINUE + "HTTP/1.1 204 No Content\r\n\r\n";
+    HttpParser parser;
+    HttpResponseView response;
+    check(parser.parseResponse(data, false, response) == HttpParseStatus::COMPLETE, "first pipelined response");
+    check(response.length == CONTINUE.size() + FINAL.size(), "first response ends at its body");
+    std::string_view rest = std::string_view(data).substr(response.length);
+    check(parser.parseResponse(rest, false, response) == HttpParseStatus::COMPLETE, "second pipelined response");
+    check(response.status == 204 && response.length == rest.size(), "second response is the 204");
+}
+
+/**
+ * @brief Reject a protocol switch, which a pooled relay cannot follow
+ */
+void testSwitchingProtocols() {
+    HttpParser parser;
+    HttpResponseView response;
+    std::string data = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n";
+    check(parser.parseResponse(data, false, response) == HttpParseStatus::INVALID, "101 is INVALID");
+}
+
+/**
+ * @brief Send a pipelined POST with Expect: 100-continue and a GET through a proxy
+ *
+ * The backend answers 100 Continue ahead of each response. The client
+ * must receive both final responses and no interim one.
+ */
+void testProxyRelay() {
+    StubServerConfig stubConfig;
+    stubConfig.port = 0;
+    stubConfig.sendContinue = true;
+    StubServer stub(stubConfig);
+    stub.start();
+
+    ProxyConfig proxyConfig;
+    proxyConfig.port = 0;
+    proxyConfig.workers = 1;
+    proxyConfig.backends.push_back(BackendAddress::parse("127.0.0.1:" + std::to_string(stub.getPort())));
+    ProxyServer proxy(proxyConfig);
+    proxy.start();
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address = makeSocketAddress("127.0.0.1", proxy.getPort());
+    check(fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0, "connect to proxy");
+    timeval timeout = {5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::string requests = "POST / HTTP/1.1\r\nHost: test\r\nExpect: 100-continue\r\nContent-Length: 5\r\n\r\nhello"
+                           "GET / HTTP/1.1\r\nHost: test\r\n\r\n";
+    check(::send(fd, requests.data(), requests.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(requests.size()),
+          "send requests");
+
+    std::string received;
+    HttpParser parser;
+    int finals = 0;
+    int interims = 0;
+    char chunk[4096];
+    while (finals < 2) {
+        ssize_t count = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) {
+            break;
+        }
+        received.append(chunk, static_cast<size_t>(count));
+        HttpResponseView response;
+        while (parser.parseResponse(received, false, response) == HttpParseStatus::COMPLETE) {
+            finals += response.status == 200 ? 1 : 0;
+            interims += response.interimLength > 0 ? 1 : 0;
+            received.erase(0, response.length);
+        }
+    }
+    ::close(fd);
+    proxy.stop();
+    stub.stop();
+
+    check(finals == 2, "client got both final responses (got " + std::to_string(finals) + ")");
+    check(interims == 0, "interim responses are not relayed");
+    ProxyStats stats = proxy.getStats();
+    check(stats.responses == 2 && stats.upstreamErrors == 0, "proxy relayed two responses without errors");
+}
+
+} // namespace
+
+/**
+ * @brief Run every check
+ * @return 0 if all passed, 1 otherwise
+ */
+int main() {
+    testWholeResponse();
+    testIncrementalResponse();
+    testPipelinedResponses();
+    testSwitchingProtocols();
+    testProxyRelay();
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "test_interim_responses: all checks passed" << std::endl;
+    return 0;
+}
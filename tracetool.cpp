@@ -0,0 +1,246 @@
+/**
+ * @file tracetool.cpp
+ * @brief Command-line converter and inspector for request traces
+ * @author Your Name
+ * @date 2024
+ * @version 1.0
+ * 
+ * Converts request traces between the line-oriented JSONL format and the
+ * compact binary trace format, prints binary trace statistics, and dumps
+ * records from any cycle using the binary trace's seek index. The fit
+ * command derives a workload generator config from a trace.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include "TraceFormat.h"
+#include "TraceReader.h"
+#include "TraceWriter.h"
+#include "JsonlTrace.h"
+#include "WorkloadFitter.h"
+
+/**
+ * @brief Print command-line usage
+ */
+void printUsage() {
+    std::cout << "Usage: tracetool to-binary IN OUT [--block N] [--no-compress]" << std::endl;
+    std::cout << "       tracetool to-jsonl IN OUT" << std::endl;
+    std::cout << "       tracetool info FILE" << std::endl;
+    std::cout << "       tracetool cat FILE [--from-cycle N] [--limit N]" << std::endl;
+    std::cout << "       tracetool fit FILE [-o CONFIG]   Fit a workload generator config" << std::endl;
+    std::cout << "Input traces may be binary or JSONL; the format is detected from the file." << std::endl;
+}
+
+/**
+ * @brief Convert a trace to the binary format
+ * @param input Input trace
+ * @param output Output file
+ * @param blockRecords Records per block
+ * @param compress Whether to compress blocks
+ * @return Exit status
+ */
+int toBinary(const std::string& input, const std::string& output, size_t blockRecords, bool compress) {
+    std::unique_ptr<TraceSource> source = openTrace(input);
+    TraceWriter writer(output, blockRecords, compress);
+    TraceRecord record;
+    while (source->next(record)) {
+        writer.write(record);
+    }
+    writer.close();
+    std::cout << "Wrote " << writer.getRecordCount() << " records, " << writer.getBytesWritten()
+              << " bytes (" << std::fixed << std::setprecision(2)
+              << (writer.getRecordCount() > 0
+                      ? static_cast<double>(writer.getBytesWritten()) / writer.getRecordCount()
+                      : 0.0)
+              << " bytes/record)" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Convert a trace to JSONL
+ * @param input Input trace
+ * @param output Output file
+ * @return Exit status
+ */
+int toJsonl(const std::string& input, const std::string& output) {
+    std::unique_ptr<TraceSource> source = openTrace(input);
+    JsonlTraceWriter writer(output);
+    TraceRecord record;
+    long long count = 0;
+    while (source->next(record)) {
+        writer.write(record);
+        ++count;
+    }
+    writer.close();
+    std::cout << "Wrote " << count << " records" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Print the block index and size of a binary trace
+ * @param path Trace file
+ * @return Exit status
+ */
+int showInfo(const std::string& path) {
+    TraceReader reader(path);
+    const auto& blocks = reader.getBlocks();
+    uint64_t encoded = 0;
+    uint64_t stored = 0;
+    int compressed = 0;
+    for (const auto& block : blocks) {
+        encoded += block.encodedSize;
+        stored += block.storedSize;
+        if (block.codec == TraceWriter::CODEC_ZLIB) ++compressed;
+    }
+    
+    std::cout << "Records:        " << reader.getRecordCount() << std::endl;
+    std::cout << "Blocks:         " << blocks.size() << " (" << compressed << " compressed)" << std::endl;
+    std::cout << "File size:      " << reader.getFileSize() << " bytes" << std::endl;
+    std::cout << "Encoded blocks: " << encoded << " bytes, stored " << stored << " bytes" << std::endl;
+    if (reader.getRecordCount() > 0) {
+        std::cout << "Bytes/record:   " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(reader.getFileSize()) / reader.getRecordCount() << std::endl;
+    }
+    if (!blocks.empty()) {
+        std::cout << "First cycle:    " << blocks.front().firstCycle << std::endl;
+        std::cout << "Last block at:  cycle " << blocks.back().firstCycle << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Print records as JSONL, optionally starting from a cycle
+ * @param path Trace file
+ * @param fromCycle First cycle to print (seeks in binary traces)
+ * @param limit Maximum records to print (negative for all)
+ * @return Exit status
+ */
+int catTrace(const std::string& path, long long fromCycle, long long limit) {
+    std::unique_ptr<TraceSource> source;
+    if (TraceReader::isBinaryTrace(path)) {
+        auto reader = std::make_unique<TraceReader>(path);
+        reader->seekToCycle(fromCycle);
+        source = std::move(reader);
+    } else {
+        source = std::make_unique<JsonlTraceReader>(path);
+    }
+    
+    JsonlTraceWriter writer("/dev/stdout");
+    TraceRecord record;
+    for (long long count = 0; limit < 0 || count < limit;) {
+        if (!source->next(record)) break;
+        if (record.cycle < fromCycle) continue;
+        writer.write(record);
+        ++count;
+    }
+    writer.close();
+    return 0;
+}
+
+/**
+ * @brief Fit a workload generator config to a trace
+ * @param path Trace file
+ * @param output Config file, or empty for standard output
+ * @return Exit status
+ */
+int fitTrace(const std::string& path, const std::string& output) {
+    std::unique_ptr<TraceSource> source = openTrace(path);
+    WorkloadFitter fitter;
+    TraceRecord record;
+    while (source->next(record)) {
+        fitter.add(record);
+    }
+    
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file.is_open()) {
+            std::cerr << "Cannot create " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    out << "# Workload fitted from " << path << std::endl;
+    for (const auto& line : fitter.getReport()) {
+        out << "# " << line << std::endl;
+    }
+    if (fitter.getInitialBacklog() > 0) {
+        out << "# Replay the backlog with --initial-queue " << fitter.getInitialBacklog() << std::endl;
+    }
+    writeWorkloadParams(out, fitter.fit());
+    
+    if (!output.empty()) {
+        for (const auto& line : fitter.getReport()) {
+            std::cout << line << std::endl;
+        }
+        std::cout << "Wrote " << output << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Main function
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return Exit status
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string command = argv[1];
+    
+    try {
+        if (command == "to-binary" && argc >= 4) {
+            size_t blockRecords = 65536;
+            bool compress = true;
+            for (int i = 4; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg == "--block" && i + 1 < argc) {
+                    blockRecords = static_cast<size_t>(std::stoull(argv[++i]));
+                } else if (arg == "--no-compress") {
+                    compress = false;
+                } else {
+                    printUsage();
+                    return 1;
+                }
+            }
+            return toBinary(argv[2], argv[3], blockRecords, compress);
+        }
+        if (command == "to-jsonl" && argc == 4) {
+            return toJsonl(argv[2], argv[3]);
+        }
+        if (command == "info" && argc == 3) {
+            return showInfo(argv[2]);
+        }
+        if (command == "cat") {
+            long long fromCycle = 0;
+            long long limit = -1;
+            for (int i = 3; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg == "--from-cycle" && i + 1 < argc) {
+                    fromCycle = std::stoll(argv[++i]);
+                } else if (arg == "--limit" && i + 1 < argc) {
+                    limit = std::stoll(argv[++i]);
+                } else {
+                    printUsage();
+                    return 1;
+                }
+            }
+            return catTrace(argv[2], fromCycle, limit);
+        }
+        if (command == "fit" && (argc == 3 || (argc == 5 && std::string(argv[3]) == "-o"))) {
+            return fitTrace(argv[2], argc == 5 ? argv[4] : "");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    
+    printUsage();
+    return 1;
+}